@@ -50,6 +50,14 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "adxl362_app.h"
 #include <stdio.h>
 #include <common/adi_timestamp.h>
+#include <common/adi_time.h>
+#include <common/adi_common.h>
+#include <common/adi_stream.h>
+#include <base_sensor/adi_report_policy.h>
+#include <base_sensor/adi_adaptive_sampler.h>
+#include <base_sensor/adi_window_stats.h>
+#include <axl/adi_vibration.h>
+#include <axl/adi_orientation.h>
 
 using namespace adi_sensor_swpack;
 
@@ -71,9 +79,21 @@ static void AxlBluetoothMode(Accelerometer *pAxl);
 static void AxlStandaloneMode(Accelerometer *pAxl);
 #endif
 
+/* Skips x, y, z readings that barely moved, in the Bluetooth and stream modes */
+static ReportPolicy       gReportPolicy;
+
+/* Sets the sample period and output data rate from the activity of the axes */
+static AdaptiveSampler    gSampler;
+
 /* Local Functions */
 static void InitSystem(void);
+static void InitReportPolicy(void);
+static void InitAdaptiveSampler(void);
 static void Trap(void);
+#if (ADI_APP_USE_BLUETOOTH == 1u) || (ADI_APP_USE_UART_STREAM == 1u)
+static void ReadingToFloat(const ADI_DATA_PACKET *pData, float *pValues);
+static void ApplySampleRate(Accelerometer *pAxl);
+#endif
 
 /*!
  * @brief      Main
@@ -111,6 +131,10 @@ int main(int argc, char *argv[])
         PRINT_SENSOR_ERROR(eSensorResult);
         Trap();
     }
+
+    InitReportPolicy();
+    InitAdaptiveSampler();
+
 #if(ADI_APP_USE_BLUETOOTH == 1u)
     AxlBluetoothMode(pAxl);
 #else
@@ -148,8 +172,8 @@ static void InitSystem(void)
     /* Init timestamping */
     INIT_TIME();
 
-#ifndef ADI_DEBUG
-    /* Initialize UART redirection in release mode only */
+#if !defined(ADI_DEBUG) || ((ADI_APP_USE_BLUETOOTH == 0u) && (ADI_APP_USE_UART_STREAM == 1u))
+    /* Initialize UART redirection in release mode, the packet stream needs it in debug mode too */
     common_Init();
 #endif
 
@@ -157,6 +181,72 @@ static void InitSystem(void)
 
 }
 
+/*!
+ * @brief      Sets the x, y, z deadband and heartbeat
+ */
+static void InitReportPolicy(void)
+{
+#if (ADI_APP_USE_REPORT_POLICY == 1u)
+    gReportPolicy.setDeadband(ADI_APP_REPORT_DEADBAND_ABS, ADI_APP_REPORT_DEADBAND_REL);
+    gReportPolicy.setInterval(ADI_APP_REPORT_MIN_INTERVAL, ADI_APP_REPORT_HEARTBEAT);
+#endif
+}
+
+/*!
+ * @brief      Sets the range of the Bluetooth sample period
+ */
+static void InitAdaptiveSampler(void)
+{
+#if (ADI_APP_USE_ADAPTIVE_RATE == 1u)
+    gSampler.setPeriod(ADI_APP_ADAPTIVE_MIN_PERIOD, ADI_APP_DISPATCH_TIMEOUT);
+    gSampler.setThreshold(ADI_APP_ADAPTIVE_ACTIVE, ADI_APP_ADAPTIVE_QUIET);
+    gSampler.setTracking(ADI_APP_ADAPTIVE_WEIGHT, ADI_APP_ADAPTIVE_HOLD);
+#else
+    gSampler.setPeriod(ADI_APP_DISPATCH_TIMEOUT, ADI_APP_DISPATCH_TIMEOUT);
+#endif
+}
+
+#if (ADI_APP_USE_BLUETOOTH == 1u) || (ADI_APP_USE_UART_STREAM == 1u)
+/*!
+ * @brief      Extracts the x, y and z counts of a data packet for the report policy
+ */
+static void ReadingToFloat(const ADI_DATA_PACKET *pData, float *pValues)
+{
+    int16_t aAxis[3];
+
+    memcpy(aAxis, pData->aPayload, sizeof(aAxis));
+    pValues[0] = (float) aAxis[0];
+    pValues[1] = (float) aAxis[1];
+    pValues[2] = (float) aAxis[2];
+}
+
+/*!
+ * @brief      Reprograms the output data rate after the sampler changed step
+ *
+ * @details    Every step doubles the rate, as does every AXL_ODR value.
+ */
+static void ApplySampleRate(Accelerometer *pAxl)
+{
+    uint32_t        nOdr = (uint32_t) ADI_APP_ADAPTIVE_ODR_MIN + gSampler.getStep();
+    SENSOR_RESULT   eSensorResult;
+
+    if(nOdr > (uint32_t) ADI_APP_ADAPTIVE_ODR_MAX)
+    {
+        nOdr = (uint32_t) ADI_APP_ADAPTIVE_ODR_MAX;
+    }
+
+    if(nOdr != (uint32_t) pAxl->getOutputDataRate())
+    {
+        eSensorResult = pAxl->setOutputDataRate((Accelerometer::AXL_ODR) nOdr);
+
+        if(eSensorResult != SENSOR_ERROR_NONE)
+        {
+            PRINT_SENSOR_ERROR(eSensorResult);
+        }
+    }
+}
+#endif
+
 /*!
  * @brief      Trap function    
  *
@@ -180,6 +270,7 @@ static void AxlBluetoothMode(Accelerometer *pAxl)
     ADI_BLER_RESULT     eResult;
     uint32_t            nTime = 0ul;
     ADI_BLER_CONN_INFO  sConnInfo;
+    float               aValues[3];
 
     /* Initialize Bluetooth */
     InitBluetoothLowEnergy();
@@ -193,8 +284,8 @@ static void AxlBluetoothMode(Accelerometer *pAxl)
     /* WHILE(forever) */
     while(1u)
     {
-        /* Dispatch events for two seconds - they will arrive in the application callback */
-        eResult = adi_ble_DispatchEvents(ADI_APP_DISPATCH_TIMEOUT);
+        /* Dispatch events for one sample period - they will arrive in the application callback */
+        eResult = adi_ble_DispatchEvents(gSampler.getPeriod());
         PRINT_ERROR("Error dispatching events to the callback.\r\n", eResult, ADI_BLER_SUCCESS);
 
         /* If connected, send data */
@@ -209,8 +300,19 @@ static void AxlBluetoothMode(Accelerometer *pAxl)
             /* Get x,y,x accelerometer data */
             pAxl->getXYZ((uint8_t*)&gSensorData.aPayload,6u);
 
-            eResult = adi_radio_DE_SendData(sConnInfo.nConnHandle, DATAEXCHANGE_PACKET_SIZE, (uint8_t*)&gSensorData);
-            PRINT_ERROR("Error sending the data.\r\n", eResult, ADI_BLER_SUCCESS);
+            /* Only send readings that moved past the deadband, or a heartbeat */
+            ReadingToFloat(&gSensorData, aValues);
+            if(gReportPolicy.shouldReport(nTime, aValues, 3u))
+            {
+                eResult = adi_radio_DE_SendData(sConnInfo.nConnHandle, DATAEXCHANGE_PACKET_SIZE, (uint8_t*)&gSensorData);
+                PRINT_ERROR("Error sending the data.\r\n", eResult, ADI_BLER_SUCCESS);
+            }
+
+            /* Sample faster while the axes are moving */
+            if(gSampler.update(aValues, 3u))
+            {
+                ApplySampleRate(pAxl);
+            }
         }
         /* If disconnected switch to advertising mode */
         else
@@ -304,6 +406,8 @@ static void ApplicationCallback(void * pCBParam, uint32_t Event, void * pArg)
         case GAP_EVENT_CONNECTED:
             PRINTF(("Connected!\r\n"));
             gbConnected = true;
+            /* A new central gets the current reading right away */
+            gReportPolicy.force();
             break;
 
         case GAP_EVENT_DISCONNECTED:
@@ -351,6 +455,298 @@ static void ApplicationCallback(void * pCBParam, uint32_t Event, void * pArg)
             break;
     }
 }
+#elif (ADI_APP_USE_UART_STREAM == 1u) && (ADI_APP_USE_8BIT_STREAM == 1u)
+/*!
+ * @brief      Standalone Accelerometer demo, 8-bit binary stream
+ *
+ * @details    Packs four 8-bit readings into each #ADI_ACCELEROMETER_8BIT_TYPE packet,
+ *             5 bytes per reading on the wire instead of 20. Every reading is sent,
+ *             the sample rate still follows the adaptive sampler.
+ */
+static void AxlStandaloneMode(Accelerometer *pAxl)
+{
+    ADXL362                     *pAdxl = static_cast<ADXL362 *>(pAxl);
+    ADI_REGISTRATION_PACKET     sRegistration;
+    ADI_DATA_PACKET             sData;
+    ADI_ACCELEROMETER_8BIT_DATA sSamples;
+    uint32_t                    nTime;
+    uint8_t                     nCount = 0u;
+    float                       aValues[3];
+
+    memset(&sRegistration, 0, sizeof(sRegistration));
+    sRegistration.nPacketHeader   = ADI_SET_HEADER(ADI_REGISTRATION_PACKET_TYPE, ADI_ACCELEROMETER_ID);
+    sRegistration.eSensorType     = ADI_ACCELEROMETER_8BIT_TYPE;
+    sRegistration.nNumDataTypes   = sizeof(ADI_ACCELEROMETER_8BIT_DATA);
+    for(uint32_t i = 0u; i < sizeof(ADI_ACCELEROMETER_8BIT_DATA); i++)
+    {
+        sRegistration.aDataTypeKey[i] = ADI_BYTE_TYPE;
+    }
+
+    memset(&sData, 0, sizeof(sData));
+    sData.nPacketHeader = ADI_SET_HEADER(ADI_DATA_PACKET_TYPE, ADI_ACCELEROMETER_ID);
+    sData.eSensorType   = ADI_ACCELEROMETER_8BIT_TYPE;
+
+    memset(&sSamples, 0, sizeof(sSamples));
+
+    adi_stream_Init();
+
+    /* WHILE(forever) */
+    while(1u)
+    {
+        /* One 3-byte burst, paced by the accelerometer data ready flag */
+        pAdxl->getXYZ8((uint8_t*)sSamples.aSample[sSamples.nCount], 3u);
+        nTime = GET_TIME();
+
+        /* The sampler thresholds are in 12-bit counts */
+        aValues[0] = 16.0f * sSamples.aSample[sSamples.nCount][0];
+        aValues[1] = 16.0f * sSamples.aSample[sSamples.nCount][1];
+        aValues[2] = 16.0f * sSamples.aSample[sSamples.nCount][2];
+
+        if(++sSamples.nCount == 4u)
+        {
+            if(nCount++ == 0u)
+            {
+                adi_stream_Send(&sRegistration, sizeof(sRegistration));
+            }
+            sSamples.nRange = (uint8_t) pAxl->getRange();
+            memcpy(&sData.aTimestamp, &nTime, 4u);
+            memcpy(sData.aPayload, &sSamples, sizeof(sSamples));
+            adi_stream_Send(&sData, sizeof(sData));
+            sSamples.nCount = 0u;
+        }
+
+        if(gSampler.update(aValues, 3u))
+        {
+            ApplySampleRate(pAxl);
+        }
+    } /* ENDWHILE */
+}
+#elif (ADI_APP_USE_UART_STREAM == 1u)
+/*!
+ * @brief      Standalone Accelerometer demo, binary stream
+ *
+ * @details    Sends the readings as COBS framed #ADI_DATA_PACKET structures over the UART.
+ *             The registration packet is repeated every 256 data packets so a receiver
+ *             started late still learns the payload layout. With ADI_APP_USE_STATISTICS
+ *             the packets carry the statistics of each axis per window instead, with
+ *             ADI_APP_USE_VIBRATION its spectrum summary at a fixed output data rate, and
+ *             with ADI_APP_USE_ORIENTATION only orientation changes are sent.
+ *             ADI_APP_USE_AXL_TEMPERATURE adds the temperature of the same bursts as
+ *             a second sensor.
+ */
+static void AxlStandaloneMode(Accelerometer *pAxl)
+{
+    ADI_REGISTRATION_PACKET sRegistration;
+    ADI_DATA_PACKET         sData;
+    uint32_t                nTime;
+    uint8_t                 nCount = 0u;
+    float                   aValues[3];
+#if (ADI_APP_USE_STATISTICS == 1u)
+    WindowStats             aStats[3];
+    ADI_STATS_RESULT        sResult;
+    ADI_DATA_PACKET         sStats;
+    int16_t                 aAxis[3];
+
+    for(uint8_t nAxis = 0u; nAxis < 3u; nAxis++)
+    {
+        aStats[nAxis].setWindow(ADI_APP_STATS_WINDOW);
+    }
+    WindowStats::fillRegistration(ADI_ACCELEROMETER_ID, &sRegistration);
+#elif (ADI_APP_USE_VIBRATION == 1u)
+    /* Static, the analyzer holds the window and spectrum buffers */
+    static VibrationAnalyzer    analyzer;
+    static const uint16_t       aEdges[ADI_VIBRATION_NUM_BANDS + 1u] = ADI_APP_VIBRATION_BANDS;
+    ADI_VIBRATION_AXIS          aResult[ADI_VIBRATION_NUM_AXES];
+    ADI_DATA_PACKET             sSpectrum;
+    int16_t                     aAxis[3];
+    SENSOR_RESULT               eSensorResult;
+
+    if(!analyzer.setup(ADI_APP_VIBRATION_POINTS, ADI_APP_VIBRATION_RATE))
+    {
+        PRINTF(("Unsupported vibration window.\r\n"));
+        Trap();
+    }
+    analyzer.setBands(aEdges);
+    VibrationAnalyzer::fillRegistration(ADI_ACCELEROMETER_ID, &sRegistration);
+
+    /* The bins are only valid at the rate the analyzer was set up for */
+    eSensorResult = pAxl->setOutputDataRate(ADI_APP_VIBRATION_ODR);
+
+    if(eSensorResult != SENSOR_ERROR_NONE)
+    {
+        PRINT_SENSOR_ERROR(eSensorResult);
+        Trap();
+    }
+#elif (ADI_APP_USE_ORIENTATION == 1u)
+    OrientationEngine           orientation;
+    int16_t                     aFrames[ADI_APP_ORIENTATION_BATCH][3];
+    uint32_t                    nFrames = 0u;
+    uint32_t                    nEvents;
+    ADI_DATA_PACKET             sOrientation;
+
+    orientation.setDeadband(ADI_APP_ORIENTATION_DEADBAND);
+    orientation.setTiltAlarm(ADI_APP_TILT_TRIP, ADI_APP_TILT_CLEAR);
+    OrientationEngine::fillRegistration(ADI_ACCELEROMETER_ID, &sRegistration);
+#else
+    memset(&sRegistration, 0, sizeof(sRegistration));
+    sRegistration.nPacketHeader   = ADI_SET_HEADER(ADI_REGISTRATION_PACKET_TYPE, ADI_ACCELEROMETER_ID);
+    sRegistration.eSensorType     = ADI_ACCELEROMETER_2G_TYPE;
+    sRegistration.nNumDataTypes   = 3u;
+    sRegistration.aDataTypeKey[0] = ADI_SHORT_TYPE;
+    sRegistration.aDataTypeKey[1] = ADI_SHORT_TYPE;
+    sRegistration.aDataTypeKey[2] = ADI_SHORT_TYPE;
+#endif
+#if (ADI_APP_USE_AXL_TEMPERATURE == 1u)
+    /* getXYZT() is specific to the ADXL362 */
+    ADXL362                 *pAdxl = static_cast<ADXL362 *>(pAxl);
+    ADI_REGISTRATION_PACKET sTempRegistration;
+    ADI_DATA_PACKET         sTemp;
+    int16_t                 aSample[4];
+    uint32_t                nReadings = 0u;
+    uint8_t                 nTempCount = 0u;
+    float                   fTemp;
+
+    memset(&sTempRegistration, 0, sizeof(sTempRegistration));
+    sTempRegistration.nPacketHeader   = ADI_SET_HEADER(ADI_REGISTRATION_PACKET_TYPE, ADI_AXL_TEMPERATURE_ID);
+    sTempRegistration.eSensorType     = ADI_TEMPERATURE_TYPE;
+    sTempRegistration.nNumDataTypes   = 1u;
+    sTempRegistration.aDataTypeKey[0] = ADI_FLOAT_TYPE;
+
+    memset(&sTemp, 0, sizeof(sTemp));
+    sTemp.nPacketHeader = ADI_SET_HEADER(ADI_DATA_PACKET_TYPE, ADI_AXL_TEMPERATURE_ID);
+    sTemp.eSensorType   = ADI_TEMPERATURE_TYPE;
+#endif
+
+#if (ADI_APP_USE_SAMPLE_TIME == 1u)
+    uint64_t                nSampleTime;
+    SENSOR_RESULT           eIntResult;
+
+    /* The readings stay paced by the status register, INT1 only stamps the conversions */
+    eIntResult = static_cast<ADXL362 *>(pAxl)->enableInterrupt(ADXL362_INT_DATA_READY, NULL, NULL);
+
+    if(eIntResult != SENSOR_ERROR_NONE)
+    {
+        PRINT_SENSOR_ERROR(eIntResult);
+        Trap();
+    }
+#endif
+
+    memset(&sData, 0, sizeof(sData));
+    sData.nPacketHeader = ADI_SET_HEADER(ADI_DATA_PACKET_TYPE, ADI_ACCELEROMETER_ID);
+    sData.eSensorType   = ADI_ACCELEROMETER_2G_TYPE;
+
+    adi_stream_Init();
+
+    /* WHILE(forever) */
+    while(1u)
+    {
+#if (ADI_APP_USE_SAMPLE_TIME == 0u)
+        /* Get timestamp */
+        nTime = GET_TIME();
+#endif
+
+        /* Get x,y,z accelerometer data, paced by the accelerometer data ready flag */
+#if (ADI_APP_USE_AXL_TEMPERATURE == 1u)
+        pAdxl->getXYZT((uint8_t*)aSample, sizeof(aSample));
+        memcpy(sData.aPayload, aSample, 6u);
+#else
+        pAxl->getXYZ((uint8_t*)&sData.aPayload, 6u);
+#endif
+
+#if (ADI_APP_USE_SAMPLE_TIME == 1u)
+        /* The data ready edge of the sample just read, moved back from now by its age so the
+           packets and the report policy stay on the GET_TIME() base of the registration packets */
+        nTime = GET_TIME();
+        if(static_cast<ADXL362 *>(pAxl)->getEdgeTime(&nSampleTime) != 0u)
+        {
+            nTime -= (uint32_t) ((adi_time_GetUs64() - nSampleTime) / 1000u);
+        }
+#endif
+        memcpy(&sData.aTimestamp, &nTime, 4u);
+
+        ReadingToFloat(&sData, aValues);
+#if (ADI_APP_USE_STATISTICS == 1u)
+        /* One packet per axis and window replaces the readings */
+        memcpy(aAxis, sData.aPayload, sizeof(aAxis));
+        for(uint8_t nAxis = 0u; nAxis < 3u; nAxis++)
+        {
+            if(aStats[nAxis].add(aAxis[nAxis]) && aStats[nAxis].getResult(&sResult))
+            {
+                if(nCount++ == 0u)
+                {
+                    adi_stream_Send(&sRegistration, sizeof(sRegistration));
+                }
+                WindowStats::fillPacket(ADI_ACCELEROMETER_ID, nAxis, nTime, &sResult, &sStats);
+                adi_stream_Send(&sStats, sizeof(sStats));
+            }
+        }
+#elif (ADI_APP_USE_VIBRATION == 1u)
+        /* Readings that arrive during the analysis are dropped, the next window starts after it */
+        memcpy(aAxis, sData.aPayload, sizeof(aAxis));
+        if(analyzer.add(aAxis))
+        {
+            analyzer.analyze(aResult);
+            if(nCount++ == 0u)
+            {
+                adi_stream_Send(&sRegistration, sizeof(sRegistration));
+            }
+            for(uint8_t nAxis = 0u; nAxis < ADI_VIBRATION_NUM_AXES; nAxis++)
+            {
+                VibrationAnalyzer::fillPacket(ADI_ACCELEROMETER_ID, nAxis, nTime, &aResult[nAxis], &sSpectrum);
+                adi_stream_Send(&sSpectrum, sizeof(sSpectrum));
+            }
+        }
+#elif (ADI_APP_USE_ORIENTATION == 1u)
+        memcpy(aFrames[nFrames++], sData.aPayload, sizeof(aFrames[0]));
+        if(nFrames == ADI_APP_ORIENTATION_BATCH)
+        {
+            nFrames = 0u;
+            nEvents = orientation.update(&aFrames[0][0], ADI_APP_ORIENTATION_BATCH);
+            if(nEvents != ADI_ORIENTATION_EVENT_NONE)
+            {
+                if(nCount++ == 0u)
+                {
+                    adi_stream_Send(&sRegistration, sizeof(sRegistration));
+                }
+                orientation.fillPacket(ADI_ACCELEROMETER_ID, nEvents, nTime, &sOrientation);
+                adi_stream_Send(&sOrientation, sizeof(sOrientation));
+            }
+        }
+#else
+        if(gReportPolicy.shouldReport(nTime, aValues, 3u))
+        {
+            if(nCount++ == 0u)
+            {
+                adi_stream_Send(&sRegistration, sizeof(sRegistration));
+            }
+            adi_stream_Send(&sData, sizeof(sData));
+        }
+#if (ADI_APP_USE_AXL_TEMPERATURE == 1u)
+        /* The temperature changes slowly, only every few readings are sent */
+        if(++nReadings == ADI_APP_AXL_TEMPERATURE_PERIOD)
+        {
+            nReadings = 0u;
+            if(nTempCount++ == 0u)
+            {
+                adi_stream_Send(&sTempRegistration, sizeof(sTempRegistration));
+            }
+            fTemp = ADXL362::temperatureToMilliCelsius(aSample[3]) / 1000.0F;
+            memcpy(&sTemp.aTimestamp, &nTime, 4u);
+            memcpy(&sTemp.aPayload[0], &fTemp, 4u);
+            adi_stream_Send(&sTemp, sizeof(sTemp));
+        }
+#endif
+#endif
+
+#if (ADI_APP_USE_VIBRATION == 0u)
+        /* The output data rate paces this loop, raise it while the axes are moving */
+        if(gSampler.update(aValues, 3u))
+        {
+            ApplySampleRate(pAxl);
+        }
+#endif
+    } /* ENDWHILE */
+}
 #else
 /*!
  * @brief      Standalone Accelerometer demo
@@ -360,6 +756,7 @@ static void ApplicationCallback(void * pCBParam, uint32_t Event, void * pArg)
 static void AxlStandaloneMode(Accelerometer *pAxl)
 {
     int16_t x,y,z;
+    uint32_t nDuty;
 
     /* WHILE(forever) */
     while(1u)
@@ -373,8 +770,11 @@ static void AxlStandaloneMode(Accelerometer *pAxl)
         PRINTF(("\tY value = %d \t\t\r\n", y));
         PRINTF(("\tZ value = %d \t\t\r\n", z));
 
-        /* delay */
-        for(volatile uint32_t i = 0; i < 0xfff; i++);
+        /* Awake share of the last loop, the remainder was flexi mode sleep */
+        nDuty = adi_time_GetDutyCycle();
+        PRINTF(("\tAwake = %d.%d %% \t\t\r\n", (int) (nDuty / 10u), (int) (nDuty % 10u)));
+
+        adi_time_DelayMs(ADI_APP_SAMPLE_PERIOD);
     } /* ENDWHILE */
 }
 #endif
@@ -72,12 +72,176 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #define ADI_APP_USE_BLUETOOTH   (1u)
 
+/*
+ * Binary streaming of the sensor packets, only used when Bluetooth is disabled.
+ *
+ *  ADI_APP_USE_UART_STREAM 1 - ADI_DATA_PACKETs are sent COBS framed over the UART at 115200 baud
+ *                              as fast as the sensor produces them. Receive them with Host/Tools/stream_rx.
+ *  ADI_APP_USE_UART_STREAM 0 - Sensor readings are printed as text.
+ */
+#define ADI_APP_USE_UART_STREAM (0u)
+
+/*
+ * Report-by-exception for the Bluetooth and stream modes.
+ *
+ *  ADI_APP_USE_REPORT_POLICY 1 - A reading is only sent when an axis moved by the deadband since
+ *                                the last packet sent, or when the heartbeat interval has passed.
+ *  ADI_APP_USE_REPORT_POLICY 0 - Every reading is sent.
+ */
+#define ADI_APP_USE_REPORT_POLICY   (1u)
+
+/* Deadband in raw counts (1 mg per count in the 2g range), and as a fraction of the last value sent */
+#define ADI_APP_REPORT_DEADBAND_ABS (50.0f)
+#define ADI_APP_REPORT_DEADBAND_REL (0.0f)
+
+/* Minimum time between packets and heartbeat, in GET_TIME() units. 0 disables either */
+#define ADI_APP_REPORT_MIN_INTERVAL (0u)
+#define ADI_APP_REPORT_HEARTBEAT    (30000u)
+
+/*
+ * Adaptive sampling for the Bluetooth and stream modes.
+ *
+ *  ADI_APP_USE_ADAPTIVE_RATE 1 - The sample period drops to ADI_APP_ADAPTIVE_MIN_PERIOD and the
+ *                                output data rate rises while the axes are moving, then both back
+ *                                off one step at a time when the signal is quiet again.
+ *  ADI_APP_USE_ADAPTIVE_RATE 0 - Fixed ADI_APP_DISPATCH_TIMEOUT period and ADI_CFG_ADXL362_RATE.
+ */
+#define ADI_APP_USE_ADAPTIVE_RATE    (1u)
+
+/* Fastest sample period in ms, the slowest is ADI_APP_DISPATCH_TIMEOUT */
+#define ADI_APP_ADAPTIVE_MIN_PERIOD  (250u)
+
+/* Variance of any axis, in counts squared, above which the signal is active and below which it is quiet */
+#define ADI_APP_ADAPTIVE_ACTIVE      (2500.0f)
+#define ADI_APP_ADAPTIVE_QUIET       (400.0f)
+
+/* Weight of a new reading in the running variance, and quiet readings before backing off a step */
+#define ADI_APP_ADAPTIVE_WEIGHT      (0.25f)
+#define ADI_APP_ADAPTIVE_HOLD        (8u)
+
+/* Output data rate at the slowest step; each faster step doubles it up to ADI_APP_ADAPTIVE_ODR_MAX */
+#define ADI_APP_ADAPTIVE_ODR_MIN     (adi_sensor_swpack::Accelerometer::AXL_ODR_12_5)
+#define ADI_APP_ADAPTIVE_ODR_MAX     (adi_sensor_swpack::Accelerometer::AXL_ODR_100)
+
+/*
+ * Window statistics for the stream mode.
+ *
+ *  ADI_APP_USE_STATISTICS 1 - Instead of the readings, one ADI_STATISTICS_TYPE packet per axis is sent for
+ *                             every ADI_APP_STATS_WINDOW readings, with the min, max, mean and standard deviation.
+ *  ADI_APP_USE_STATISTICS 0 - Every reading is sent, subject to the report policy.
+ */
+#define ADI_APP_USE_STATISTICS       (0u)
+
+/* Readings per statistics window */
+#define ADI_APP_STATS_WINDOW         (100u)
+
+/*
+ * Vibration analysis for the stream mode.
+ *
+ *  ADI_APP_USE_VIBRATION 1 - The accelerometer runs at ADI_APP_VIBRATION_ODR and every ADI_APP_VIBRATION_POINTS
+ *                            readings one ADI_VIBRATION_TYPE packet per axis is sent, with the peak frequency and
+ *                            amplitude and the RMS of the ADI_APP_VIBRATION_BANDS (see Host/Tools/vibration).
+ *  ADI_APP_USE_VIBRATION 0 - No spectrum analysis.
+ */
+#define ADI_APP_USE_VIBRATION        (0u)
+
+/* Readings per window, a power of two from 16 to 256 */
+#define ADI_APP_VIBRATION_POINTS     (256u)
+
+/* Output data rate while analyzing, and the same rate in 0.1 Hz */
+#define ADI_APP_VIBRATION_ODR        (adi_sensor_swpack::Accelerometer::AXL_ODR_400)
+#define ADI_APP_VIBRATION_RATE       (4000u)
+
+/* Band edges in 0.1 Hz: 1-10 Hz, 10-50 Hz, 50-100 Hz and 100 Hz up to the Nyquist frequency */
+#define ADI_APP_VIBRATION_BANDS      {10u, 100u, 500u, 1000u, 2000u}
+
+/*
+ * Orientation events for the stream mode.
+ *
+ *  ADI_APP_USE_ORIENTATION 1 - Every ADI_APP_ORIENTATION_BATCH readings are reduced to pitch, roll and tilt, and an
+ *                              ADI_ORIENTATION_TYPE packet is only sent when they moved by ADI_APP_ORIENTATION_DEADBAND
+ *                              or the tilt alarm changed.
+ *  ADI_APP_USE_ORIENTATION 0 - No orientation packets.
+ */
+#define ADI_APP_USE_ORIENTATION      (0u)
+
+/* Readings averaged per evaluation */
+#define ADI_APP_ORIENTATION_BATCH    (8u)
+
+/* Pitch or roll change reported, 0.01 degree */
+#define ADI_APP_ORIENTATION_DEADBAND (500u)
+
+/* Tilt of Z from the vertical that raises and clears the alarm, 0.01 degree */
+#define ADI_APP_TILT_TRIP            (4500u)
+#define ADI_APP_TILT_CLEAR           (3500u)
+
+/*
+ * Reduced resolution for the stream mode.
+ *
+ *  ADI_APP_USE_8BIT_STREAM 1 - Only the 8 most significant bits of each axis are read, in one burst, and four
+ *                              readings are packed into one ADI_ACCELEROMETER_8BIT_TYPE packet.
+ *  ADI_APP_USE_8BIT_STREAM 0 - 12-bit readings, one per packet.
+ */
+#define ADI_APP_USE_8BIT_STREAM      (0u)
+
+/*
+ * Temperature of the accelerometer for the 12-bit stream mode.
+ *
+ *  ADI_APP_USE_AXL_TEMPERATURE 1 - The axes and the temperature are read in one burst, the axes with the offset
+ *                                  drift of adi_adxl362_cfg.h removed, and every ADI_APP_AXL_TEMPERATURE_PERIOD
+ *                                  readings an ADI_TEMPERATURE_TYPE packet in degree C is sent as well.
+ *  ADI_APP_USE_AXL_TEMPERATURE 0 - Only the axes are read.
+ */
+#define ADI_APP_USE_AXL_TEMPERATURE    (0u)
+#define ADI_APP_AXL_TEMPERATURE_PERIOD (100u)
+
+/*
+ * Sample timestamps for the stream mode.
+ *
+ *  ADI_APP_USE_SAMPLE_TIME 1 - INT1 of the ADXL362 signals data ready and each edge is stamped, see
+ *                              ADI_CFG_ADXL362_INT1_* in adi_adxl362_cfg.h. Packets carry the time the
+ *                              sample was converted, in GET_TIME() ms like every other packet: the age of
+ *                              the edge, measured with adi_time_GetUs64(), is taken off GET_TIME().
+ *  ADI_APP_USE_SAMPLE_TIME 0 - Packets carry GET_TIME() from before the sample was read.
+ */
+#define ADI_APP_USE_SAMPLE_TIME        (0u)
+
+/* Time between the printed readings of the text mode, ms. The core sleeps in flexi mode in between */
+#define ADI_APP_SAMPLE_PERIOD          (100u)
+
 /* Accelerometer instance ID */
 #define ADI_ACCELEROMETER_ID    (1u)
 
+/* Instance ID of the accelerometer temperature sensor */
+#define ADI_AXL_TEMPERATURE_ID  (2u)
+
 /* BLE event processing dispatcher timeout. Waits for 2sec for BLE events */
 #define ADI_APP_DISPATCH_TIMEOUT (2000)
 
+/*********** Macro Validation *********/
+
+
+#if (ADI_APP_USE_STATISTICS + ADI_APP_USE_VIBRATION + ADI_APP_USE_ORIENTATION + ADI_APP_USE_8BIT_STREAM) > 1u
+#error "Only one of ADI_APP_USE_STATISTICS, ADI_APP_USE_VIBRATION, ADI_APP_USE_ORIENTATION and ADI_APP_USE_8BIT_STREAM can be set to 1"
+#endif
+
+#if (ADI_APP_USE_AXL_TEMPERATURE == 1u) && \
+    ((ADI_APP_USE_STATISTICS + ADI_APP_USE_VIBRATION + ADI_APP_USE_ORIENTATION + ADI_APP_USE_8BIT_STREAM) != 0u)
+#error "ADI_APP_USE_AXL_TEMPERATURE only applies to the 12-bit reading stream"
+#endif
+
+#if (ADI_APP_USE_AXL_TEMPERATURE == 1u) && (ADI_APP_AXL_TEMPERATURE_PERIOD == 0u)
+#error "ADI_APP_AXL_TEMPERATURE_PERIOD must not be 0"
+#endif
+
+#if (ADI_APP_USE_SAMPLE_TIME == 1u) && (ADI_APP_USE_8BIT_STREAM == 1u)
+#error "ADI_APP_USE_SAMPLE_TIME only applies to the 12-bit reading stream"
+#endif
+
+#if ADI_APP_TILT_CLEAR > ADI_APP_TILT_TRIP
+#error "ADI_APP_TILT_CLEAR must not be above ADI_APP_TILT_TRIP"
+#endif
+
 /* Defined in pinmux.c */
 extern "C" int32_t adi_initpinmux(void);
 
@@ -52,11 +52,17 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <drivers/pwr/adi_pwr.h>
 #include <radio/adi_ble_radio.h>
 #include <common/adi_timestamp.h>
+#include <common/adi_time.h>
+#include <common/adi_common.h>
+#include <common/adi_stream.h>
 #include <gas/cn0357/adi_cn0357.h>
 #include <common/adi_error_handling.h>
 #include <framework/noos/adi_ble_noos.h>
 #include <base_sensor/adi_sensor_packet.h>
 #include <base_sensor/adi_sensor_errors.h>
+#include <base_sensor/adi_report_policy.h>
+#include <base_sensor/adi_adaptive_sampler.h>
+#include <base_sensor/adi_uplink_scheduler.h>
 
 
 using namespace adi_sensor_swpack;
@@ -79,12 +85,37 @@ static void ApplicationCallback(void * pCBParam, uint32_t Event, void * pArg);
 static void SetAdvertisingMode(void);
 static void InitBluetooth(void);
 static uint8_t GasSensorBluetoothMode(Gas *gas);
+
+#if ADI_APP_USE_UPLINK_SCHEDULER == 1u
+/* Uplink queue of the CO readings */
+#define ADI_APP_GAS_QUEUE (0u)
+
+/* Orders the packets onto the link, alarms first */
+static UplinkScheduler    gUplink;
+static bool               gbAlarm;
+/* Alarm refused by the full alarm queue, pushed again after the next sends */
+static ADI_DATA_PACKET    gAlarmPacket;
+static uint32_t           gnAlarmTime;
+static bool               gbAlarmHeld;
+
+static void InitUplink(void);
+static void SendQueued(void);
+static void PrintUplinkStats(void);
+#endif
 #else
 static uint8_t GasSensorStandaloneMode(Gas *gas);
 #endif
 
+/* Holds back CO readings inside the deadband */
+static ReportPolicy       gReportPolicy;
+
+/* Speeds up sampling while the CO level changes */
+static AdaptiveSampler    gSampler;
+
 /* Local Functions */
 static void InitSystem(void);
+static void InitReportPolicy(void);
+static void InitAdaptiveSampler(void);
 
 
 /* Defined in pinmux.c */
@@ -107,6 +138,9 @@ int main(void)
         return (1u);
     }
 
+    InitReportPolicy();
+    InitAdaptiveSampler();
+
 #if (ADI_APP_USE_BLUETOOTH == 1u)
     if(GasSensorBluetoothMode(gas) == 1u)
     {
@@ -132,7 +166,7 @@ int main(void)
 /*!
  * @brief      Hardware Initialization
  *
- * @details    Setups up the power subsystem and the pinmuxing.
+ * @details    Setups up the power subsystem, the pinmuxing and the timestamp clock.
  *
  */
 static void InitSystem(void)
@@ -155,13 +189,40 @@ static void InitSystem(void)
     ePwr = adi_pwr_SetClockDivider(ADI_CLOCK_PCLK, 1u);
     PRINT_ERROR("Error configuring the peripheral clock.\r\n", ePwr, ADI_PWR_SUCCESS);
 
-#ifndef ADI_DEBUG
-    /* Initialize UART redirection in release mode only */
+#if !defined(ADI_DEBUG) || ((ADI_APP_USE_BLUETOOTH == 0u) && (ADI_APP_USE_UART_STREAM == 1u))
+    /* Initialize UART redirection in release mode, the packet stream needs it in debug mode too */
     common_Init();
 #endif
 
     PRINTF(("Starting CN0357 Demo application\r\n"));
 
+    /* Init timestamping, the stream packets carry it too */
+    INIT_TIME();
+}
+
+/*!
+ * @brief      Sets the ppm deadband and heartbeat
+ */
+static void InitReportPolicy(void)
+{
+#if (ADI_APP_USE_REPORT_POLICY == 1u)
+    gReportPolicy.setDeadband(ADI_APP_REPORT_DEADBAND_ABS, ADI_APP_REPORT_DEADBAND_REL);
+    gReportPolicy.setInterval(ADI_APP_REPORT_MIN_INTERVAL, ADI_APP_REPORT_HEARTBEAT);
+#endif
+}
+
+/*!
+ * @brief      Sets how fast the CO readings may be taken
+ */
+static void InitAdaptiveSampler(void)
+{
+#if (ADI_APP_USE_ADAPTIVE_RATE == 1u)
+    gSampler.setPeriod(ADI_APP_ADAPTIVE_MIN_PERIOD, ADI_APP_DISPATCH_TIMEOUT);
+    gSampler.setThreshold(ADI_APP_ADAPTIVE_ACTIVE, ADI_APP_ADAPTIVE_QUIET);
+    gSampler.setTracking(ADI_APP_ADAPTIVE_WEIGHT, ADI_APP_ADAPTIVE_HOLD);
+#else
+    gSampler.setPeriod(ADI_APP_DISPATCH_TIMEOUT, ADI_APP_DISPATCH_TIMEOUT);
+#endif
 }
 
 
@@ -182,11 +243,14 @@ uint8_t GasSensorBluetoothMode(Gas *gas)
 
     
     InitBluetooth();
+#if (ADI_APP_USE_UPLINK_SCHEDULER == 1u)
+    InitUplink();
+#endif
 
     while(1u)
     {
-        /* Dispatch events for two seconds - they will arrive in the application callback */
-        eResult = adi_ble_DispatchEvents(ADI_APP_DISPATCH_TIMEOUT);
+        /* Dispatch events for one sample period - they will arrive in the application callback */
+        eResult = adi_ble_DispatchEvents(gSampler.getPeriod());
         PRINT_ERROR("Error dispatching events to the callback.\r\n", eResult, ADI_BLER_SUCCESS);
 
         /* If connected, send data */
@@ -211,21 +275,123 @@ uint8_t GasSensorBluetoothMode(Gas *gas)
 
             memcpy(&gSensorData.aPayload, &fConcentration, sizeof(float));
     
-            /* Send to host */
-            eResult = adi_radio_DE_SendData(sConnInfo.nConnHandle, DATAEXCHANGE_PACKET_SIZE, (uint8_t*)&gSensorData);
-            PRINT_ERROR("Error sending the data.\r\n", eResult, ADI_BLER_SUCCESS);
+#if (ADI_APP_USE_UPLINK_SCHEDULER == 1u)
+            /* Entering the alarm level is reported at once, readings during the alarm keep alarm priority */
+            bool bAlarm = (fConcentration >= ADI_APP_ALARM_PPM);
+            if(bAlarm && !gbAlarm)
+            {
+                gReportPolicy.force();
+            }
+            gbAlarm = bAlarm;
+
+            /* A held alarm goes ahead of the new reading, once the sends made room */
+            if(gbAlarmHeld)
+            {
+                SendQueued();
+                gbAlarmHeld = !gUplink.push(ADI_APP_GAS_QUEUE, &gAlarmPacket, gnAlarmTime, true);
+            }
+
+            if(gReportPolicy.shouldReport(nTime, &fConcentration, 1u))
+            {
+                if(!gUplink.push(ADI_APP_GAS_QUEUE, &gSensorData, nTime, bAlarm))
+                {
+                    if(!gbAlarmHeld)
+                    {
+                        gAlarmPacket = gSensorData;
+                        gnAlarmTime  = nTime;
+                        gbAlarmHeld  = true;
+                    }
+                    else
+                    {
+                        PRINTF(("Alarm queue full.\r\n"));
+                    }
+                }
+            }
+
+            SendQueued();
+#else
+            /* Send to host, only when the reading moved past the deadband or for a heartbeat */
+            if(gReportPolicy.shouldReport(nTime, &fConcentration, 1u))
+            {
+                eResult = adi_radio_DE_SendData(sConnInfo.nConnHandle, DATAEXCHANGE_PACKET_SIZE, (uint8_t*)&gSensorData);
+                PRINT_ERROR("Error sending the data.\r\n", eResult, ADI_BLER_SUCCESS);
+            }
+#endif
+
+            /* Shorten the period while the concentration is changing */
+            gSampler.update(&fConcentration, 1u);
         }
         /* If disconnected switch to advertising mode */
         else
         {
             if (geMode != PERIPHERAL_ADV_MODE)
             {
+#if (ADI_APP_USE_UPLINK_SCHEDULER == 1u)
+                /* Readings queued for the old central are stale by the next connection */
+                PrintUplinkStats();
+                gUplink.clear();
+                gbAlarm     = false;
+                gbAlarmHeld = false;
+#endif
                 SetAdvertisingMode();
             }
         }
     }
 }
 
+#if (ADI_APP_USE_UPLINK_SCHEDULER == 1u)
+
+/*!
+ * @brief      Configures the uplink scheduler
+ *
+ * @details    The CO readings get the only queue, at the highest priority.
+ */
+static void InitUplink(void)
+{
+    gUplink.setQueue(ADI_APP_GAS_QUEUE, 0u, ADI_APP_UPLINK_RATE, ADI_APP_UPLINK_BURST);
+}
+
+/*!
+ * @brief      Sends the queued packets
+ *
+ * @details    Sends until the scheduler has nothing due or the radio refuses a packet.
+ *             A refused packet stays queued and is sent after the next sample period.
+ */
+static void SendQueued(void)
+{
+    ADI_BLER_RESULT         eResult;
+    const ADI_DATA_PACKET * pPacket;
+
+    while((pPacket = gUplink.peek(GET_TIME())) != NULL)
+    {
+        eResult = adi_radio_DE_SendData(sConnInfo.nConnHandle, DATAEXCHANGE_PACKET_SIZE, (uint8_t*)pPacket);
+        PRINT_ERROR("Error sending the data.\r\n", eResult, ADI_BLER_SUCCESS);
+
+        if(eResult != ADI_BLER_SUCCESS)
+        {
+            break;
+        }
+        gUplink.pop(GET_TIME());
+    }
+}
+
+/*!
+ * @brief      Prints the uplink statistics of the last connection
+ */
+static void PrintUplinkStats(void)
+{
+    ADI_UPLINK_STATS sStats;
+
+    gUplink.getStats(ADI_APP_GAS_QUEUE, &sStats);
+    PRINTF(("Sent %u (%u alarms), dropped %u, alarms refused %u, latency %u ms mean, %u ms max.\r\n",
+            (unsigned int) sStats.nSent, (unsigned int) sStats.nAlarms, (unsigned int) sStats.nDropped,
+            (unsigned int) sStats.nAlarmsRefused,
+            (unsigned int) sStats.nLatencyMean, (unsigned int) sStats.nLatencyMax));
+    gUplink.resetStats();
+}
+
+#endif
+
 /*!
  * @brief      Application Callback
  *
@@ -250,6 +416,8 @@ static void ApplicationCallback(void * pCBParam, uint32_t Event, void * pArg)
         case GAP_EVENT_CONNECTED:
             PRINTF(("Connected!\r\n"));
             gbConnected = true;
+            /* A new central gets the current reading right away */
+            gReportPolicy.force();
             break;
 
         case GAP_EVENT_DISCONNECTED:
@@ -344,9 +512,6 @@ static void InitBluetooth(void)
     ADI_BLER_RESULT eResult;
     uint8_t *       aDataExchangeName = (unsigned char *) "CN0357 Demo";
 
-    /* Init timestamping */
-    INIT_TIME();
-
     /* Initialize radio and framework layer */
     eResult = adi_ble_Init(ApplicationCallback, NULL);
     PRINT_ERROR("Error initializing the radio.\r\n", eResult, ADI_BLER_SUCCESS);
@@ -367,6 +532,63 @@ static void InitBluetooth(void)
     /* Now enter infinite loop waiting for connection and then data exchange events */
     PRINTF(("Waiting for connection. Initiate connection on central device please.\r\n"));
 }
+#elif (ADI_APP_USE_UART_STREAM == 1u)
+/*!
+ * @brief      Standalone C0 gas demo, binary stream
+ *
+ * @details    Sends the readings as COBS framed #ADI_DATA_PACKET structures over the UART.
+ *             The registration packet is repeated every 256 data packets so a receiver
+ *             started late still learns the payload layout.
+ */
+uint8_t GasSensorStandaloneMode(Gas *gas)
+{
+    ADI_REGISTRATION_PACKET sRegistration;
+    ADI_DATA_PACKET         sData;
+    uint32_t                nTime;
+    uint8_t                 nCount = 0u;
+    float                   fConcentration;
+    SENSOR_RESULT           eSensorResult;
+
+    memset(&sRegistration, 0, sizeof(sRegistration));
+    sRegistration.nPacketHeader   = ADI_SET_HEADER(ADI_REGISTRATION_PACKET_TYPE, ADI_GAS_ID);
+    sRegistration.eSensorType     = ADI_CO_TYPE;
+    sRegistration.nNumDataTypes   = 1u;
+    sRegistration.aDataTypeKey[0] = ADI_FLOAT_TYPE;
+
+    memset(&sData, 0, sizeof(sData));
+    sData.nPacketHeader = ADI_SET_HEADER(ADI_DATA_PACKET_TYPE, ADI_GAS_ID);
+    sData.eSensorType   = ADI_CO_TYPE;
+
+    adi_stream_Init();
+
+    /* WHILE(forever) */
+    while(1u)
+    {
+        /* Get timestamp */
+        nTime = GET_TIME();
+        memcpy(&sData.aTimestamp, &nTime, 4u);
+
+        /* Read gas sensor */
+        eSensorResult = gas->getPPM(&fConcentration);
+        if (eSensorResult != SENSOR_ERROR_NONE)
+        {
+            PRINT_SENSOR_ERROR(eSensorResult);
+            return (1u);
+        }
+        memcpy(&sData.aPayload[0], &fConcentration, sizeof(float));
+
+        if(gReportPolicy.shouldReport(nTime, &fConcentration, 1u))
+        {
+            if(nCount++ == 0u)
+            {
+                adi_stream_Send(&sRegistration, sizeof(sRegistration));
+            }
+            adi_stream_Send(&sData, sizeof(sData));
+        }
+
+        adi_time_DelayMs(ADI_APP_SAMPLE_PERIOD);
+    } /* ENDWHILE */
+}
 #else
 /*!
  * @brief      Standalone C0 gas demo.
@@ -378,7 +600,7 @@ uint8_t GasSensorStandaloneMode(Gas *gas)
 {
     float         fConcentration;
     SENSOR_RESULT eSensorResult;
-
+    uint32_t      nDuty;
 
     while(1u)
     {
@@ -392,7 +614,11 @@ uint8_t GasSensorStandaloneMode(Gas *gas)
 
         PRINTF(("Gas Concentration = %f PPM\r\n", fConcentration));
 
-        for (volatile uint32_t i = 0u; i < 0xFFFFul; i++);
+        /* Time awake since the last print, in per mille */
+        nDuty = adi_time_GetDutyCycle();
+        PRINTF(("Awake: %d.%d %%\r\n", (int) (nDuty / 10u), (int) (nDuty % 10u)));
+
+        adi_time_DelayMs(ADI_APP_SAMPLE_PERIOD);
     }
 }
 #endif
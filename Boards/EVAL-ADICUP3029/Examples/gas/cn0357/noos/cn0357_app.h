@@ -61,6 +61,75 @@ POSSIBILITY OF SUCH DAMAGE.
  */
 #define ADI_APP_USE_BLUETOOTH (1u)
 
+/*
+ * Binary streaming of the sensor packets, only used when Bluetooth is disabled.
+ *
+ *  ADI_APP_USE_UART_STREAM 1 - ADI_DATA_PACKETs are sent COBS framed over the UART at 115200 baud
+ *                              as fast as the sensor produces them. Receive them with Host/Tools/stream_rx.
+ *  ADI_APP_USE_UART_STREAM 0 - Sensor readings are printed as text.
+ */
+#define ADI_APP_USE_UART_STREAM (0u)
+
+/*
+ * Report-by-exception for the Bluetooth and stream modes.
+ *      - 1: A reading is only sent when it moved by the deadband since the last packet sent,
+ *           or when the heartbeat interval has passed
+ *      - 0: Every reading is sent
+ */
+#define ADI_APP_USE_REPORT_POLICY   (1u)
+
+/* Deadband in ppm, and as a fraction of the last value sent */
+#define ADI_APP_REPORT_DEADBAND_ABS (1.0f)
+#define ADI_APP_REPORT_DEADBAND_REL (0.02f)
+
+/* Minimum time between packets and heartbeat, in GET_TIME() units. 0 disables either */
+#define ADI_APP_REPORT_MIN_INTERVAL (0u)
+#define ADI_APP_REPORT_HEARTBEAT    (60000u)
+
+/*
+ * Adaptive sampling for the Bluetooth mode.
+ *
+ *  ADI_APP_USE_ADAPTIVE_RATE 1 - The sample period drops towards ADI_APP_ADAPTIVE_MIN_PERIOD while
+ *                                the reading is changing, and backs off one step at a time when it settles.
+ *  ADI_APP_USE_ADAPTIVE_RATE 0 - Fixed ADI_APP_DISPATCH_TIMEOUT period.
+ */
+#define ADI_APP_USE_ADAPTIVE_RATE    (1u)
+
+/* Fastest sample period in ms, the slowest is ADI_APP_DISPATCH_TIMEOUT */
+#define ADI_APP_ADAPTIVE_MIN_PERIOD  (250u)
+
+/* Variance, in ppm squared, above which the reading is active and below which it is quiet */
+#define ADI_APP_ADAPTIVE_ACTIVE      (4.0f)
+#define ADI_APP_ADAPTIVE_QUIET       (0.25f)
+
+/* Weight of a new reading in the running variance, and quiet readings before backing off a step */
+#define ADI_APP_ADAPTIVE_WEIGHT      (0.25f)
+#define ADI_APP_ADAPTIVE_HOLD        (8u)
+
+/*
+ * Uplink scheduling for the Bluetooth mode.
+ *
+ *  ADI_APP_USE_UPLINK_SCHEDULER 1 - Readings are queued in an UplinkScheduler and sent at most ADI_APP_UPLINK_RATE
+ *                                   per second, ADI_APP_UPLINK_BURST back to back. A reading at or above
+ *                                   ADI_APP_ALARM_PPM is an alarm, sent ahead of the queue and past the rate limit.
+ *  ADI_APP_USE_UPLINK_SCHEDULER 0 - Readings are sent as they are taken.
+ */
+#define ADI_APP_USE_UPLINK_SCHEDULER (1u)
+#define ADI_APP_UPLINK_RATE          (2u)
+#define ADI_APP_UPLINK_BURST         (4u)
+
+/* CO alarm level in ppm, the 8 hour exposure limit */
+#define ADI_APP_ALARM_PPM            (35.0f)
+
+/*
+ * Time between readings when Bluetooth is disabled, ms. The core sleeps in flexi mode in between.
+ * The AD7790 converts at 9.5 Hz, one reading every 105 ms.
+ */
+#define ADI_APP_SAMPLE_PERIOD        (100u)
+
+/* CO sensor instance ID, the same header the Bluetooth mode sends */
+#define ADI_GAS_ID (0x7Fu)
+
 
 /*********** Macro Validation *********/
 
@@ -69,5 +138,25 @@ POSSIBILITY OF SUCH DAMAGE.
 #error "ADI_APP_USE_BLUETOOTH must be set to 0 or 1"
 #endif
 
+#if ADI_APP_USE_UART_STREAM != 0u && ADI_APP_USE_UART_STREAM != 1u
+#error "ADI_APP_USE_UART_STREAM must be set to 0 or 1"
+#endif
+
+#if ADI_APP_USE_REPORT_POLICY != 0u && ADI_APP_USE_REPORT_POLICY != 1u
+#error "ADI_APP_USE_REPORT_POLICY must be set to 0 or 1"
+#endif
+
+#if ADI_APP_USE_ADAPTIVE_RATE != 0u && ADI_APP_USE_ADAPTIVE_RATE != 1u
+#error "ADI_APP_USE_ADAPTIVE_RATE must be set to 0 or 1"
+#endif
+
+#if ADI_APP_USE_UPLINK_SCHEDULER != 0u && ADI_APP_USE_UPLINK_SCHEDULER != 1u
+#error "ADI_APP_USE_UPLINK_SCHEDULER must be set to 0 or 1"
+#endif
+
+#if ADI_APP_USE_UPLINK_SCHEDULER == 1u && ADI_APP_UPLINK_BURST == 0u
+#error "ADI_APP_UPLINK_BURST must be at least 1"
+#endif
+
 
 #endif /* CN0357_APP_H */
@@ -50,7 +50,13 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "adt7420_app.h"
 #include <stdio.h>
 #include <common/adi_timestamp.h>
+#include <common/adi_time.h>
+#include <common/adi_common.h>
+#include <common/adi_stream.h>
 #include <base_sensor/adi_sensor_errors.h>
+#include <base_sensor/adi_report_policy.h>
+#include <base_sensor/adi_adaptive_sampler.h>
+#include <base_sensor/adi_window_stats.h>
 
 using namespace adi_sensor_swpack;
 
@@ -68,12 +74,30 @@ static void ApplicationCallback(void * pCBParam, uint32_t Event, void * pArg);
 static void InitBluetoothLowEnergy(void);
 static void SetAdvertisingMode(void);
 static void TempBluetoothMode(Temperature *pTemp);
+#if (ADI_APP_USE_ASYNC_READ == 1u)
+static void TempReadCallback(void * pCBParam, uint32_t Event, void * pArg);
+static volatile int32_t   gnMilliCelsius;
+#endif
 #else
 static void TempStandaloneMode(Temperature *pTemp);
+#if (ADI_APP_USE_UART_STREAM == 1u) && (ADI_APP_USE_ALARM == 1u)
+static void AlarmWakeCallback(void * pCBParam, uint32_t Event, void * pArg);
+#endif
 #endif
 
+/* Sensors on the I2C bus, the first one is used unless the stream mode reads them all */
+static ADT7420            gSensors[ADI_APP_NUM_SENSORS];
+
+/* Sends a temperature only when it changed or the heartbeat is due */
+static ReportPolicy       gReportPolicy;
+
+/* Shortens the Bluetooth period while the temperature moves */
+static AdaptiveSampler    gSampler;
+
 /* Local Functions */
 static void InitSystem(void);
+static void InitReportPolicy(void);
+static void InitAdaptiveSampler(void);
 static void Trap(void);
 
 /*!
@@ -88,30 +112,39 @@ static void Trap(void);
  */
 int main(int argc, char *argv[])
 {
-    ADT7420         adt7420;
-    Temperature     *pTemp = &adt7420;
+    Temperature     *pTemp = &gSensors[0];
     SENSOR_RESULT   eSensorResult;
 
     /* Initialize the system */
     InitSystem();
 
-    /* Open Temperature sensor */
-    eSensorResult = pTemp->open();
-
-    if(eSensorResult != SENSOR_ERROR_NONE)
+    for(uint32_t nSensor = 0u; nSensor < ADI_APP_NUM_SENSORS; nSensor++)
     {
-        PRINT_SENSOR_ERROR(eSensorResult);
-        Trap();
-    }
+        /* The sensors share the I2C bus, each shield has its own address */
+        gSensors[nSensor].setSlaveAddress((uint8_t)(ADT7420_ADDRESS_BASE + nSensor));
 
-    /* Start measurement */
-    eSensorResult = pTemp->start();
+        /* Open Temperature sensor */
+        eSensorResult = gSensors[nSensor].open();
 
-    if (pTemp->start() != SENSOR_ERROR_NONE)
-    {
-        PRINT_SENSOR_ERROR(eSensorResult);
-        Trap();
+        if(eSensorResult != SENSOR_ERROR_NONE)
+        {
+            PRINT_SENSOR_ERROR(eSensorResult);
+            Trap();
+        }
+
+        /* Start measurement */
+        eSensorResult = gSensors[nSensor].start();
+
+        if (eSensorResult != SENSOR_ERROR_NONE)
+        {
+            PRINT_SENSOR_ERROR(eSensorResult);
+            Trap();
+        }
     }
+
+    InitReportPolicy();
+    InitAdaptiveSampler();
+
 #if(ADI_APP_USE_BLUETOOTH == 1u)
     TempBluetoothMode(pTemp);
 #else
@@ -146,8 +179,8 @@ static void InitSystem(void)
     ePwr = adi_pwr_SetClockDivider(ADI_CLOCK_PCLK, 1u);
     PRINT_ERROR("Error configuring the peripheral clock.\r\n", ePwr, ADI_PWR_SUCCESS);
 
-#ifndef ADI_DEBUG
-    /* Initialize UART redirection in release mode only */
+#if !defined(ADI_DEBUG) || ((ADI_APP_USE_BLUETOOTH == 0u) && (ADI_APP_USE_UART_STREAM == 1u))
+    /* Initialize UART redirection in release mode, the packet stream needs it in debug mode too */
     common_Init();
 #endif
 
@@ -157,6 +190,31 @@ static void InitSystem(void)
     INIT_TIME();
 }
 
+/*!
+ * @brief      Sets the temperature deadband and heartbeat
+ */
+static void InitReportPolicy(void)
+{
+#if (ADI_APP_USE_REPORT_POLICY == 1u)
+    gReportPolicy.setDeadband(ADI_APP_REPORT_DEADBAND_ABS, ADI_APP_REPORT_DEADBAND_REL);
+    gReportPolicy.setInterval(ADI_APP_REPORT_MIN_INTERVAL, ADI_APP_REPORT_HEARTBEAT);
+#endif
+}
+
+/*!
+ * @brief      Sets the bounds of the adaptive sample period
+ */
+static void InitAdaptiveSampler(void)
+{
+#if (ADI_APP_USE_ADAPTIVE_RATE == 1u)
+    gSampler.setPeriod(ADI_APP_ADAPTIVE_MIN_PERIOD, ADI_APP_DISPATCH_TIMEOUT);
+    gSampler.setThreshold(ADI_APP_ADAPTIVE_ACTIVE, ADI_APP_ADAPTIVE_QUIET);
+    gSampler.setTracking(ADI_APP_ADAPTIVE_WEIGHT, ADI_APP_ADAPTIVE_HOLD);
+#else
+    gSampler.setPeriod(ADI_APP_DISPATCH_TIMEOUT, ADI_APP_DISPATCH_TIMEOUT);
+#endif
+}
+
 /*!
  * @brief      Trap function    
  *
@@ -181,7 +239,9 @@ static void TempBluetoothMode(Temperature *pTemp)
     uint32_t            nTime = 0ul;
     ADI_BLER_CONN_INFO  sConnInfo;
     float nTempCel,nTempFar;
+#if (ADI_APP_USE_ASYNC_READ == 0u)
     uint16_t   nTemp;
+#endif
 
     /* Initialize Bluetooth */
     InitBluetoothLowEnergy();
@@ -195,10 +255,20 @@ static void TempBluetoothMode(Temperature *pTemp)
     /* WHILE(forever) */
     while(1u)
     {
-        /* Dispatch events for two seconds - they will arrive in the application callback */
-        eResult = adi_ble_DispatchEvents(ADI_APP_DISPATCH_TIMEOUT);
+#if (ADI_APP_USE_ASYNC_READ == 1u)
+        /* In one-shot mode the reading converts while the radio events are dispatched */
+        gSensors[0].startConversion();
+#endif
+
+        /* Dispatch events for one sample period - they will arrive in the application callback */
+        eResult = adi_ble_DispatchEvents(gSampler.getPeriod());
         PRINT_ERROR("Error dispatching events to the callback.\r\n", eResult, ADI_BLER_SUCCESS);
 
+#if (ADI_APP_USE_ASYNC_READ == 1u)
+        /* Queue the reading of that conversion, also while disconnected so none is left pending */
+        gSensors[0].readTemperatureAsync(TempReadCallback, NULL);
+#endif
+
         /* If connected, send data */
         if (gbConnected == true)
         {
@@ -208,10 +278,16 @@ static void TempBluetoothMode(Temperature *pTemp)
             nTime = GET_TIME();
             memcpy(&gSensorData.aTimestamp,&nTime,4u);
 
+#if (ADI_APP_USE_ASYNC_READ == 1u)
+            /* Done within a few hundred microseconds, a hung bus fails the read */
+            (void) adi_i2c_bus_WaitIdle();
+            nTempCel = gnMilliCelsius / 1000.0F;
+#else
             pTemp->getTemperature((uint8_t*)&gSensorData.aPayload[0],2);
 
             nTemp = (gSensorData.aPayload[0] << 8) | (gSensorData.aPayload[1]);
             nTempCel = (nTemp >> 3u) / 16.0F;
+#endif
             nTempFar = (9.0F / 5.0F) * nTempCel + 32.0F;
 
             memcpy((uint8_t*)&gSensorData.aPayload[0],(uint8_t*)&nTempCel,4);
@@ -219,9 +295,16 @@ static void TempBluetoothMode(Temperature *pTemp)
             PRINTF(("Current temperature: %05.1f C.\r\n", nTempCel));
             PRINTF(("Current temperature: %05.1f F.\r\n", nTempFar));
 
-            eResult = adi_radio_DE_SendData(sConnInfo.nConnHandle, DATAEXCHANGE_PACKET_SIZE, (uint8_t*)&gSensorData);
+            /* Only send readings that moved past the deadband, or a heartbeat */
+            if(gReportPolicy.shouldReport(nTime, &nTempCel, 1u))
+            {
+                eResult = adi_radio_DE_SendData(sConnInfo.nConnHandle, DATAEXCHANGE_PACKET_SIZE, (uint8_t*)&gSensorData);
 
-            PRINT_ERROR("Error sending the data.\r\n", eResult, ADI_BLER_SUCCESS);
+                PRINT_ERROR("Error sending the data.\r\n", eResult, ADI_BLER_SUCCESS);
+            }
+
+            /* Shorten the period while the temperature is changing */
+            gSampler.update(&nTempCel, 1u);
             nTempCel = (nTempFar - 32) / 1.8;
         }
         /* If disconnected switch to advertising mode */
@@ -232,9 +315,31 @@ static void TempBluetoothMode(Temperature *pTemp)
                 SetAdvertisingMode();
             }
         }
+
+#if (ADI_APP_USE_ASYNC_READ == 1u)
+        /* Complete the read made while disconnected */
+        (void) adi_i2c_bus_WaitIdle();
+#endif
     } /* ENDWHILE */
 }
 
+#if (ADI_APP_USE_ASYNC_READ == 1u)
+/*!
+ * @brief      Completion of the queued temperature read
+ *
+ * @details    Runs from adi_i2c_bus_Process(). A failed read keeps the previous value.
+ */
+static void TempReadCallback(void * pCBParam, uint32_t Event, void * pArg)
+{
+    if(Event == SENSOR_ERROR_NONE)
+    {
+        gnMilliCelsius = *(int32_t*) pArg;
+    }
+
+    PRINT_ERROR("Error reading the temperature.\r\n", Event, SENSOR_ERROR_NONE);
+}
+#endif
+
 /*!
  * @brief      Set Advertising Mode
  *
@@ -316,6 +421,8 @@ static void ApplicationCallback(void * pCBParam, uint32_t Event, void * pArg)
             case GAP_EVENT_CONNECTED:
                 PRINTF(("Connected!\r\n"));
                 gbConnected = true;
+                /* A new central gets the current reading right away */
+                gReportPolicy.force();
                 break;
 
             case GAP_EVENT_DISCONNECTED:
@@ -363,6 +470,183 @@ static void ApplicationCallback(void * pCBParam, uint32_t Event, void * pArg)
                 break;
     }
 }
+#elif (ADI_APP_USE_UART_STREAM == 1u)
+/*!
+ * @brief      Standalone Temperature demo, binary stream
+ *
+ * @details    Sends the readings as COBS framed #ADI_DATA_PACKET structures over the UART.
+ *             The registration packet is repeated every 256 data packets so a receiver
+ *             started late still learns the payload layout. With ADI_APP_USE_STATISTICS
+ *             the packets carry the statistics of each window instead, and with
+ *             ADI_APP_USE_ALARM only limit crossings and periodic log readings are sent.
+ *             With ADI_APP_NUM_SENSORS above 1 every sensor gets its own packets.
+ */
+static void TempStandaloneMode(Temperature *pTemp)
+{
+    ADI_REGISTRATION_PACKET sRegistration;
+    ADI_DATA_PACKET         sData;
+    uint32_t                nTime;
+    uint8_t                 nCount = 0u;
+    float                   fTemp;
+#if (ADI_APP_USE_STATISTICS == 1u)
+    WindowStats             sStats;
+    ADI_STATS_RESULT        sResult;
+
+    sStats.setWindow(ADI_APP_STATS_WINDOW);
+    WindowStats::fillRegistration(ADI_TEMPERATURE_ID, &sRegistration);
+#elif (ADI_APP_USE_ALARM == 1u)
+    /* The limits are specific to the ADT7420 */
+    ADT7420                 *pAdt = (ADT7420*) pTemp;
+    SENSOR_RESULT           eSensorResult;
+    uint32_t                nLogDeadline = adi_time_Deadline(ADI_APP_ALARM_LOG_PERIOD * 1000u);
+    uint8_t                 nAlarm;
+
+    /* 1 SPS is the lowest power mode that still compares every second */
+    eSensorResult = pAdt->setOperationMode(ADT7420::MODE_1SPS);
+
+    if(eSensorResult == SENSOR_ERROR_NONE)
+    {
+        eSensorResult = pAdt->setAlarmLimits(ADI_APP_ALARM_LOW, ADI_APP_ALARM_HIGH,
+                                             ADI_APP_ALARM_CRITICAL, ADI_APP_ALARM_HYSTERESIS);
+    }
+    if(eSensorResult == SENSOR_ERROR_NONE)
+    {
+        eSensorResult = pAdt->enableAlarm(AlarmWakeCallback, NULL);
+    }
+    if(eSensorResult != SENSOR_ERROR_NONE)
+    {
+        PRINT_SENSOR_ERROR(eSensorResult);
+        Trap();
+    }
+
+    memset(&sRegistration, 0, sizeof(sRegistration));
+    sRegistration.nPacketHeader   = ADI_SET_HEADER(ADI_REGISTRATION_PACKET_TYPE, ADI_TEMPERATURE_ID);
+    sRegistration.eSensorType     = ADI_TEMPERATURE_TYPE;
+    sRegistration.nNumDataTypes   = 2u;
+    sRegistration.aDataTypeKey[0] = ADI_FLOAT_TYPE;
+    sRegistration.aDataTypeKey[1] = ADI_BYTE_TYPE;
+#elif (ADI_APP_NUM_SENSORS > 1u)
+    ADT7420                 *aSensors[ADI_APP_NUM_SENSORS];
+    int32_t                 aMilliCelsius[ADI_APP_NUM_SENSORS];
+    SENSOR_RESULT           eSensorResult;
+
+    for(uint32_t nSensor = 0u; nSensor < ADI_APP_NUM_SENSORS; nSensor++)
+    {
+        aSensors[nSensor] = &gSensors[nSensor];
+    }
+
+    /* The instance ID is set per sensor before sending */
+    memset(&sRegistration, 0, sizeof(sRegistration));
+    sRegistration.eSensorType     = ADI_TEMPERATURE_TYPE;
+    sRegistration.nNumDataTypes   = 1u;
+    sRegistration.aDataTypeKey[0] = ADI_FLOAT_TYPE;
+#else
+    memset(&sRegistration, 0, sizeof(sRegistration));
+    sRegistration.nPacketHeader   = ADI_SET_HEADER(ADI_REGISTRATION_PACKET_TYPE, ADI_TEMPERATURE_ID);
+    sRegistration.eSensorType     = ADI_TEMPERATURE_TYPE;
+    sRegistration.nNumDataTypes   = 1u;
+    sRegistration.aDataTypeKey[0] = ADI_FLOAT_TYPE;
+#endif
+
+    memset(&sData, 0, sizeof(sData));
+    sData.nPacketHeader = ADI_SET_HEADER(ADI_DATA_PACKET_TYPE, ADI_TEMPERATURE_ID);
+    sData.eSensorType   = ADI_TEMPERATURE_TYPE;
+
+    adi_stream_Init();
+
+    /* WHILE(forever) */
+    while(1u)
+    {
+        /* Get timestamp */
+        nTime = GET_TIME();
+        memcpy(&sData.aTimestamp, &nTime, 4u);
+
+#if (ADI_APP_USE_ALARM == 1u)
+        /* No sensor traffic until INT fires or the log period is over */
+        if(pAdt->isAlarmPending() || adi_time_IsExpired(nLogDeadline))
+        {
+            nLogDeadline = adi_time_Deadline(ADI_APP_ALARM_LOG_PERIOD * 1000u);
+            if((pAdt->getAlarmStatus(&nAlarm) == SENSOR_ERROR_NONE) &&
+               (pTemp->getTemperatureInCelsius(&fTemp) == SENSOR_ERROR_NONE))
+            {
+                memcpy(&sData.aPayload[0], &fTemp, 4u);
+                sData.aPayload[4] = nAlarm;
+
+                if(nCount++ == 0u)
+                {
+                    adi_stream_Send(&sRegistration, sizeof(sRegistration));
+                }
+                adi_stream_Send(&sData, sizeof(sData));
+            }
+        }
+#elif (ADI_APP_NUM_SENSORS > 1u)
+        /* All sensors in one batch, in turn on the bus */
+        eSensorResult = ADT7420::readTemperatures(aSensors, ADI_APP_NUM_SENSORS, aMilliCelsius);
+
+        if(eSensorResult == SENSOR_ERROR_NONE)
+        {
+            bool bRegister = (nCount++ == 0u);
+
+            for(uint32_t nSensor = 0u; nSensor < ADI_APP_NUM_SENSORS; nSensor++)
+            {
+                if(bRegister)
+                {
+                    sRegistration.nPacketHeader = ADI_SET_HEADER(ADI_REGISTRATION_PACKET_TYPE, (ADI_TEMPERATURE_ID + nSensor));
+                    adi_stream_Send(&sRegistration, sizeof(sRegistration));
+                }
+                fTemp = aMilliCelsius[nSensor] / 1000.0F;
+                sData.nPacketHeader = ADI_SET_HEADER(ADI_DATA_PACKET_TYPE, (ADI_TEMPERATURE_ID + nSensor));
+                memcpy(&sData.aPayload[0], &fTemp, 4u);
+                adi_stream_Send(&sData, sizeof(sData));
+            }
+        }
+#else
+        /* Get temperature in Celsius */
+        pTemp->getTemperatureInCelsius(&fTemp);
+        memcpy(&sData.aPayload[0], &fTemp, 4u);
+
+#if (ADI_APP_USE_STATISTICS == 1u)
+        /* One packet per window replaces the readings */
+        if(sStats.add((int16_t)(fTemp * ADI_APP_STATS_SCALE)) && sStats.getResult(&sResult))
+        {
+            if(nCount++ == 0u)
+            {
+                adi_stream_Send(&sRegistration, sizeof(sRegistration));
+            }
+            WindowStats::fillPacket(ADI_TEMPERATURE_ID, 0u, nTime, &sResult, &sData);
+            adi_stream_Send(&sData, sizeof(sData));
+        }
+#else
+        if(gReportPolicy.shouldReport(nTime, &fTemp, 1u))
+        {
+            if(nCount++ == 0u)
+            {
+                adi_stream_Send(&sRegistration, sizeof(sRegistration));
+            }
+            adi_stream_Send(&sData, sizeof(sData));
+        }
+#endif
+#endif
+
+#if (ADI_APP_USE_ALARM == 1u)
+        /* Sleep until the next log reading, AlarmWakeCallback ends the sleep on INT */
+        adi_time_SleepUntil(nLogDeadline);
+#else
+        /* Sleep until the next reading */
+        adi_time_DelayMs(ADI_APP_SAMPLE_PERIOD);
+#endif
+    } /* ENDWHILE */
+}
+
+#if (ADI_APP_USE_ALARM == 1u)
+/*!
+ * @brief      INT pin callback, wakes the sample loop to read the alarm status
+ */
+static void AlarmWakeCallback(void * pCBParam, uint32_t Event, void * pArg)
+{
+    adi_time_Wake();
+}
+#endif
 #else
 /*!
  * @brief      Standalone Temperature demo
@@ -373,6 +657,7 @@ static void TempStandaloneMode(Temperature *pTemp)
 {
     float nTempCel,nTempFar;
     SENSOR_RESULT eSensorResult;
+    uint32_t nDuty;
 
     /* WHILE(forever) */
     while(1u)
@@ -393,8 +678,11 @@ static void TempStandaloneMode(Temperature *pTemp)
             PRINTF(("Current temperature: %05.1f F.\r\n", nTempFar));
         }
 
-        /* delay */
-        for(volatile uint32_t i = 0; i < 0xfff; i++);
+        /* Share of the last period the core was awake, the rest was spent in flexi mode */
+        nDuty = adi_time_GetDutyCycle();
+        PRINTF(("Awake: %d.%d %%\r\n", (int) (nDuty / 10u), (int) (nDuty % 10u)));
+
+        adi_time_DelayMs(ADI_APP_SAMPLE_PERIOD);
     } /* ENDWHILE */
 }
 #endif
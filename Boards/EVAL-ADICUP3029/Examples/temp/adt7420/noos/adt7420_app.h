@@ -61,6 +61,109 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /* Macro to enable or disable Bluetooth */
 #define ADI_APP_USE_BLUETOOTH   (1u)
 
+/*
+ * Binary streaming of the sensor packets, only used when Bluetooth is disabled.
+ *
+ *  ADI_APP_USE_UART_STREAM 1 - ADI_DATA_PACKETs are sent COBS framed over the UART at 115200 baud
+ *                              as fast as the sensor produces them. Receive them with Host/Tools/stream_rx.
+ *  ADI_APP_USE_UART_STREAM 0 - Sensor readings are printed as text.
+ */
+#define ADI_APP_USE_UART_STREAM (0u)
+
+/*
+ * Report-by-exception for the Bluetooth and stream modes.
+ *
+ *  ADI_APP_USE_REPORT_POLICY 1 - A reading is only sent when it moved by the deadband since the
+ *                                last packet sent, or when the heartbeat interval has passed.
+ *  ADI_APP_USE_REPORT_POLICY 0 - Every reading is sent.
+ */
+#define ADI_APP_USE_REPORT_POLICY   (1u)
+
+/* Deadband in degrees Celsius, and as a fraction of the last value sent */
+#define ADI_APP_REPORT_DEADBAND_ABS (0.25f)
+#define ADI_APP_REPORT_DEADBAND_REL (0.0f)
+
+/* Minimum time between packets and heartbeat, in GET_TIME() units. 0 disables either */
+#define ADI_APP_REPORT_MIN_INTERVAL (0u)
+#define ADI_APP_REPORT_HEARTBEAT    (60000u)
+
+/*
+ * Adaptive sampling for the Bluetooth mode.
+ *
+ *  ADI_APP_USE_ADAPTIVE_RATE 1 - The sample period drops towards ADI_APP_ADAPTIVE_MIN_PERIOD while
+ *                                the reading is changing, and backs off one step at a time when it settles.
+ *  ADI_APP_USE_ADAPTIVE_RATE 0 - Fixed ADI_APP_DISPATCH_TIMEOUT period.
+ */
+#define ADI_APP_USE_ADAPTIVE_RATE    (1u)
+
+/* Fastest sample period in ms, the slowest is ADI_APP_DISPATCH_TIMEOUT */
+#define ADI_APP_ADAPTIVE_MIN_PERIOD  (250u)
+
+/* Variance, in degrees C squared, above which the reading is active and below which it is quiet */
+#define ADI_APP_ADAPTIVE_ACTIVE      (0.04f)
+#define ADI_APP_ADAPTIVE_QUIET       (0.0025f)
+
+/* Weight of a new reading in the running variance, and quiet readings before backing off a step */
+#define ADI_APP_ADAPTIVE_WEIGHT      (0.25f)
+#define ADI_APP_ADAPTIVE_HOLD        (8u)
+
+/*
+ * Window statistics for the stream mode.
+ *
+ *  ADI_APP_USE_STATISTICS 1 - Instead of the readings, one ADI_STATISTICS_TYPE packet is sent for every
+ *                             ADI_APP_STATS_WINDOW readings, with the min, max, mean and standard deviation.
+ *  ADI_APP_USE_STATISTICS 0 - Every reading is sent, subject to the report policy.
+ */
+#define ADI_APP_USE_STATISTICS       (0u)
+
+/* Readings per statistics window */
+#define ADI_APP_STATS_WINDOW         (100u)
+
+/* Statistics are kept in hundredths of a degree C */
+#define ADI_APP_STATS_SCALE          (100.0f)
+
+/*
+ * Threshold alarms for the stream mode.
+ *
+ *  ADI_APP_USE_ALARM 1 - The sensor converts once per second and compares every result with the limits below.
+ *                        A reading is only sent when the INT pin reports a limit crossing, and every
+ *                        ADI_APP_ALARM_LOG_PERIOD for logging. The payload is the temperature and the ADT7420::ALARM flags.
+ *  ADI_APP_USE_ALARM 0 - The temperature is polled every loop.
+ */
+#define ADI_APP_USE_ALARM            (0u)
+
+/* Alarm limits in m degree C and hysteresis in degree C */
+#define ADI_APP_ALARM_LOW            (2000)
+#define ADI_APP_ALARM_HIGH           (8000)
+#define ADI_APP_ALARM_CRITICAL       (15000)
+#define ADI_APP_ALARM_HYSTERESIS     (1u)
+
+/* Logging period between alarms, ms. The core sleeps in flexi mode until it ends or INT fires */
+#define ADI_APP_ALARM_LOG_PERIOD     (60000u)
+
+/*
+ * Number of ADT7420 shields on the I2C bus, 1 to 4, with the addresses from ADT7420_ADDRESS_BASE up.
+ * With more than one sensor the stream mode reads all of them in every loop with ADT7420::readTemperatures()
+ * and sends one packet per sensor, with the instance IDs ADI_TEMPERATURE_ID upwards. The other modes
+ * only use the first sensor.
+ */
+#define ADI_APP_NUM_SENSORS          (1u)
+
+/*
+ * Temperature reads in Bluetooth mode.
+ *
+ *  ADI_APP_USE_ASYNC_READ 1 - The reading is queued on the I2C bus before the radio events are dispatched
+ *                             and completed after, so the transfer overlaps the dispatch.
+ *  ADI_APP_USE_ASYNC_READ 0 - The reading waits for the I2C transfer after the dispatch.
+ */
+#define ADI_APP_USE_ASYNC_READ       (1u)
+
+/*
+ * Time between readings when Bluetooth is disabled and ADI_APP_USE_ALARM is 0, ms. The core sleeps in flexi mode in between.
+ * 240 ms is the conversion time of the ADT7420, reading faster returns the same result again.
+ */
+#define ADI_APP_SAMPLE_PERIOD        (240u)
+
 /* Accelerometer instance ID */
 #define ADI_TEMPERATURE_ID    (1u)
 
@@ -73,4 +176,26 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /* Defined in pinmux.c */
 extern "C" int32_t adi_initpinmux(void);
 
+/*********** Macro Validation *********/
+
+#if (ADI_APP_USE_ALARM == 1u) && (ADI_APP_USE_STATISTICS == 1u)
+#error "ADI_APP_USE_ALARM and ADI_APP_USE_STATISTICS can not both be set to 1"
+#endif
+
+#if (ADI_APP_NUM_SENSORS < 1u) || (ADI_APP_NUM_SENSORS > 4u)
+#error "ADI_APP_NUM_SENSORS must be between 1 and 4"
+#endif
+
+#if (ADI_APP_NUM_SENSORS > 1u) && ((ADI_APP_USE_ALARM + ADI_APP_USE_STATISTICS) != 0u)
+#error "Several sensors are only supported without ADI_APP_USE_ALARM and ADI_APP_USE_STATISTICS"
+#endif
+
+#if (ADI_APP_USE_ALARM == 1u) && ((ADI_APP_ALARM_LOG_PERIOD == 0u) || (ADI_APP_ALARM_LOG_PERIOD > 2147483u))
+#error "ADI_APP_ALARM_LOG_PERIOD must be between 1 and 2147483 ms"
+#endif
+
+#if ADI_APP_ALARM_LOW >= ADI_APP_ALARM_HIGH
+#error "ADI_APP_ALARM_LOW must be below ADI_APP_ALARM_HIGH"
+#endif
+
 #endif /* ADT7420_APP_H */
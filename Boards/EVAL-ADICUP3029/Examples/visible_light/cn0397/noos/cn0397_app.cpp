@@ -48,6 +48,11 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include "cn0397_app.h"
+#include <common/adi_common.h>
+#include <common/adi_time.h>
+#include <common/adi_stream.h>
+#include <base_sensor/adi_report_policy.h>
+#include <base_sensor/adi_adaptive_sampler.h>
 
 using namespace adi_sensor_swpack;
 
@@ -67,7 +72,7 @@ static void SetAdvertisingMode(void);
 static void VisibleLightBluetoothMode(VisibleLight *pLight);
 
 #else
-#ifndef ADI_DEBUG
+#if !defined(ADI_DEBUG) && (ADI_APP_USE_UART_STREAM == 0u)
 /* Static standalone data for release mode UART redirection*/
 static  int  BarLine[3];
 
@@ -79,8 +84,16 @@ static void VisibleLightStandaloneMode(VisibleLight *pLight);
 
 #endif
 
+/* Filters out RGB readings that did not change */
+static ReportPolicy       gReportPolicy;
+
+/* Sets the Bluetooth sample period from the activity of the readings */
+static AdaptiveSampler    gSampler;
+
 /* Local functions */
 static void InitSystem(void);
+static void InitReportPolicy(void);
+static void InitAdaptiveSampler(void);
 static void Trap(void);
 
 /*!
@@ -112,8 +125,7 @@ int main(int argc, char *argv[])
 
     PRINTF(("Please cover the sensor for the calibrations. \r\n"));
 
-    /* Delay for approx 5 seconds */
-    for(volatile uint32_t i = 0; i < 12000000u; i++);
+    adi_time_DelayMs(ADI_APP_COVER_DELAY);
 
 
     /* Run calibrations */
@@ -126,6 +138,9 @@ int main(int argc, char *argv[])
 
     PRINTF(("Calibration complete. You no longer need to cover the sensor.\r\n"));
 
+    InitReportPolicy();
+    InitAdaptiveSampler();
+
 #if(ADI_APP_USE_BLUETOOTH == 1u)
     VisibleLightBluetoothMode(pLight);
 #else
@@ -160,13 +175,40 @@ static void InitSystem(void)
     ePwr = adi_pwr_SetClockDivider(ADI_CLOCK_PCLK, 1u);
     PRINT_ERROR("Error configuring the peripheral clock.\r\n", ePwr, ADI_PWR_SUCCESS);
 
-#ifndef ADI_DEBUG
-    /* Initialize UART redirection in release mode only */
+#if !defined(ADI_DEBUG) || ((ADI_APP_USE_BLUETOOTH == 0u) && (ADI_APP_USE_UART_STREAM == 1u))
+    /* Initialize UART redirection in release mode, the packet stream needs it in debug mode too */
     common_Init();
 #endif
 
     PRINTF(("Starting visual light sensor demo application\r\n"));
 
+    /* Init timestamping */
+    INIT_TIME();
+}
+
+/*!
+ * @brief      Sets the RGB deadband and heartbeat
+ */
+static void InitReportPolicy(void)
+{
+#if (ADI_APP_USE_REPORT_POLICY == 1u)
+    gReportPolicy.setDeadband(ADI_APP_REPORT_DEADBAND_ABS, ADI_APP_REPORT_DEADBAND_REL);
+    gReportPolicy.setInterval(ADI_APP_REPORT_MIN_INTERVAL, ADI_APP_REPORT_HEARTBEAT);
+#endif
+}
+
+/*!
+ * @brief      Sets the fastest and slowest light sample period
+ */
+static void InitAdaptiveSampler(void)
+{
+#if (ADI_APP_USE_ADAPTIVE_RATE == 1u)
+    gSampler.setPeriod(ADI_APP_ADAPTIVE_MIN_PERIOD, ADI_APP_DISPATCH_TIMEOUT);
+    gSampler.setThreshold(ADI_APP_ADAPTIVE_ACTIVE, ADI_APP_ADAPTIVE_QUIET);
+    gSampler.setTracking(ADI_APP_ADAPTIVE_WEIGHT, ADI_APP_ADAPTIVE_HOLD);
+#else
+    gSampler.setPeriod(ADI_APP_DISPATCH_TIMEOUT, ADI_APP_DISPATCH_TIMEOUT);
+#endif
 }
 
 /*!
@@ -206,6 +248,8 @@ static void ApplicationCallback(void * pCBParam, uint32_t Event, void * pArg)
         case GAP_EVENT_CONNECTED:
         	PRINTF(("Connected!\r\n"));
             gbConnected = true;
+            /* A new central gets the current reading right away */
+            gReportPolicy.force();
             break;
 
         case GAP_EVENT_DISCONNECTED:
@@ -290,9 +334,6 @@ static void InitBluetoothLowEnergy(void)
     ADI_BLER_RESULT eResult;
     uint8_t *       aDataExchangeName = (unsigned char *) "CN0397 Light Demo";
 
-    /* Init timestamping */
-    INIT_TIME();
-
     /* Initialize radio and framework layer */
     eResult = adi_ble_Init(ApplicationCallback, NULL);
     PRINT_ERROR("Error initializing the radio.\r\n", eResult, ADI_BLER_SUCCESS);
@@ -325,6 +366,7 @@ void VisibleLightBluetoothMode(VisibleLight *pLight)
     ADI_BLER_RESULT eResult;
     ADI_BLER_CONN_INFO sConnInfo;
     uint32_t        nTime = 0ul;
+    float           aLight[3];
 
     /* Initialize Bluetooth */
     InitBluetoothLowEnergy();
@@ -339,8 +381,8 @@ void VisibleLightBluetoothMode(VisibleLight *pLight)
     while(1u)
     {
 
-        /* Dispatch events for two seconds - they will arrive in the application callback */
-        eResult = adi_ble_DispatchEvents(ADI_APP_DISPATCH_TIMEOUT);
+        /* Dispatch events for one sample period - they will arrive in the application callback */
+        eResult = adi_ble_DispatchEvents(gSampler.getPeriod());
         PRINT_ERROR("Error dispatching events to the callback.\r\n", eResult, ADI_BLER_SUCCESS);
 
         /* If connected, send data */
@@ -354,11 +396,18 @@ void VisibleLightBluetoothMode(VisibleLight *pLight)
             memcpy(&gSensorData.aTimestamp,&nTime,4u);
 
             /* Get the red, green and blue visual light data */
-            pLight->getLightIntensity((float *)&gSensorData.aPayload[0]);
+            pLight->getLightIntensity(aLight);
+            memcpy(&gSensorData.aPayload[0], aLight, sizeof(aLight));
 
-            /* Send the data packet to the remote device */
-            eResult = adi_radio_DE_SendData(sConnInfo.nConnHandle, DATAEXCHANGE_PACKET_SIZE, (uint8_t*)&gSensorData);
-            PRINT_ERROR("Error sending the data.\r\n", eResult, ADI_BLER_SUCCESS);
+            /* Send the data packet to the remote device when a color moved past the deadband, or for a heartbeat */
+            if(gReportPolicy.shouldReport(nTime, aLight, 3u))
+            {
+                eResult = adi_radio_DE_SendData(sConnInfo.nConnHandle, DATAEXCHANGE_PACKET_SIZE, (uint8_t*)&gSensorData);
+                PRINT_ERROR("Error sending the data.\r\n", eResult, ADI_BLER_SUCCESS);
+            }
+
+            /* Shorten the period while any color is changing */
+            gSampler.update(aLight, 3u);
 
         }
         /* If disconnected, switch to advertising mode */
@@ -372,6 +421,59 @@ void VisibleLightBluetoothMode(VisibleLight *pLight)
 
     } /* ENDWHILE */
 }
+#elif (ADI_APP_USE_UART_STREAM == 1u)
+/*!
+ * @brief      Standalone visible light demo, binary stream
+ *
+ * @details    Sends the readings as COBS framed #ADI_DATA_PACKET structures over the UART.
+ *             The registration packet is repeated every 256 data packets so a receiver
+ *             started late still learns the payload layout.
+ */
+void VisibleLightStandaloneMode(VisibleLight *pLight)
+{
+    ADI_REGISTRATION_PACKET sRegistration;
+    ADI_DATA_PACKET         sData;
+    uint32_t                nTime;
+    uint8_t                 nCount = 0u;
+    float                   aLight[3];
+
+    memset(&sRegistration, 0, sizeof(sRegistration));
+    sRegistration.nPacketHeader   = ADI_SET_HEADER(ADI_REGISTRATION_PACKET_TYPE, ADI_VISIBLE_LIGHT_ID);
+    sRegistration.eSensorType     = ADI_VISIBLELIGHT_TYPE;
+    sRegistration.nNumDataTypes   = 3u;
+    sRegistration.aDataTypeKey[0] = ADI_FLOAT_TYPE;
+    sRegistration.aDataTypeKey[1] = ADI_FLOAT_TYPE;
+    sRegistration.aDataTypeKey[2] = ADI_FLOAT_TYPE;
+
+    memset(&sData, 0, sizeof(sData));
+    sData.nPacketHeader = ADI_SET_HEADER(ADI_DATA_PACKET_TYPE, ADI_VISIBLE_LIGHT_ID);
+    sData.eSensorType   = ADI_VISIBLELIGHT_TYPE;
+
+    adi_stream_Init();
+
+    /* WHILE(forever) */
+    while(1u)
+    {
+        /* Get timestamp */
+        nTime = GET_TIME();
+        memcpy(&sData.aTimestamp, &nTime, 4u);
+
+        /* Get the red, green and blue visual light data */
+        pLight->getLightIntensity(aLight);
+        memcpy(&sData.aPayload[0], aLight, sizeof(aLight));
+
+        if(gReportPolicy.shouldReport(nTime, aLight, 3u))
+        {
+            if(nCount++ == 0u)
+            {
+                adi_stream_Send(&sRegistration, sizeof(sRegistration));
+            }
+            adi_stream_Send(&sData, sizeof(sData));
+        }
+
+        adi_time_DelayMs(ADI_APP_SAMPLE_PERIOD);
+    } /* ENDWHILE */
+}
 #else
 /*!
  * @brief      Standalone visible light demo.
@@ -381,6 +483,8 @@ void VisibleLightBluetoothMode(VisibleLight *pLight)
  */
 void VisibleLightStandaloneMode(VisibleLight *pLight)
 {
+    uint32_t nDuty;
+
     /* WHILE(forever) */
     while(1u)
     {
@@ -452,9 +556,13 @@ void VisibleLightStandaloneMode(VisibleLight *pLight)
         PRINTF(("\tLight Concentration = %.2f %c\t\t", (float )eConcentration.fData_Green, 37));
         PRINTF(("\tLight Concentration = %.2f %c\t\t", (float )eConcentration.fData_Blue, 37));
         PRINTF(("\r\n"));
+
+        /* Share of the last period the core was awake, the rest was spent in flexi mode */
+        nDuty = adi_time_GetDutyCycle();
+        PRINTF(("\tAwake: %d.%d %%\r\n", (int) (nDuty / 10u), (int) (nDuty % 10u)));
         PRINTF(("\r\n"));
-        /* Delay for approx 5 seconds*/
-        for(volatile uint32_t i = 0; i < 12000000; i++);
+
+        adi_time_DelayMs(ADI_APP_SAMPLE_PERIOD);
 
     } /* ENDWHILE */
 }
@@ -69,6 +69,58 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /* To use Bluetooth for this test, set this to 1. To use the console for output set this to 0. */
 #define ADI_APP_USE_BLUETOOTH (1u)
 
+/*
+ * Binary streaming of the sensor packets, only used when Bluetooth is disabled.
+ *
+ *  ADI_APP_USE_UART_STREAM 1 - ADI_DATA_PACKETs are sent COBS framed over the UART at 115200 baud
+ *                              as fast as the sensor produces them. Receive them with Host/Tools/stream_rx.
+ *  ADI_APP_USE_UART_STREAM 0 - Sensor readings are printed as text.
+ */
+#define ADI_APP_USE_UART_STREAM (0u)
+
+/*
+ * Report-by-exception for the Bluetooth and stream modes.
+ *
+ *  ADI_APP_USE_REPORT_POLICY 1 - A reading is only sent when a color moved by the deadband since
+ *                                the last packet sent, or when the heartbeat interval has passed.
+ *  ADI_APP_USE_REPORT_POLICY 0 - Every reading is sent.
+ */
+#define ADI_APP_USE_REPORT_POLICY   (1u)
+
+/* Deadband in lux, and as a fraction of the last value sent */
+#define ADI_APP_REPORT_DEADBAND_ABS (2.0f)
+#define ADI_APP_REPORT_DEADBAND_REL (0.05f)
+
+/* Minimum time between packets and heartbeat, in GET_TIME() units. 0 disables either */
+#define ADI_APP_REPORT_MIN_INTERVAL (0u)
+#define ADI_APP_REPORT_HEARTBEAT    (60000u)
+
+/*
+ * Adaptive sampling for the Bluetooth mode.
+ *
+ *  ADI_APP_USE_ADAPTIVE_RATE 1 - The sample period drops towards ADI_APP_ADAPTIVE_MIN_PERIOD while
+ *                                the reading is changing, and backs off one step at a time when it settles.
+ *  ADI_APP_USE_ADAPTIVE_RATE 0 - Fixed ADI_APP_DISPATCH_TIMEOUT period.
+ */
+#define ADI_APP_USE_ADAPTIVE_RATE    (1u)
+
+/* Fastest sample period in ms, the slowest is ADI_APP_DISPATCH_TIMEOUT */
+#define ADI_APP_ADAPTIVE_MIN_PERIOD  (250u)
+
+/* Variance, in lux squared, above which the reading is active and below which it is quiet */
+#define ADI_APP_ADAPTIVE_ACTIVE      (100.0f)
+#define ADI_APP_ADAPTIVE_QUIET       (4.0f)
+
+/* Weight of a new reading in the running variance, and quiet readings before backing off a step */
+#define ADI_APP_ADAPTIVE_WEIGHT      (0.25f)
+#define ADI_APP_ADAPTIVE_HOLD        (8u)
+
+/* Time given to cover the sensor before the calibrations, ms */
+#define ADI_APP_COVER_DELAY          (5000u)
+
+/* Time between readings when Bluetooth is disabled, text or stream, ms. The core sleeps in flexi mode in between */
+#define ADI_APP_SAMPLE_PERIOD        (5000u)
+
 /* Defined in pinmux.c */
 extern "C" int32_t adi_initpinmux(void);
 
@@ -0,0 +1,227 @@
+/*!
+ *****************************************************************************
+  @file adi_packet_decoder.h
+
+  @brief Host side decoder for ADI_DATA_PACKET and ADI_REGISTRATION_PACKET streams.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#ifndef ADI_PACKET_DECODER_H
+#define ADI_PACKET_DECODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include <base_sensor/adi_sensor_packet.h>
+
+/*! @addtogroup host_packet_decoder Host Packet Decoder
+ *  @brief Decodes captured sensor packets into typed samples on the host.
+ *
+ *  @details The firmware structures cannot be overlaid on the capture on the
+ *           host: enums are one byte wide on the target but four bytes wide
+ *           here. The decoder therefore reads the wire layout through the
+ *           offsets below.
+ *  @{
+ */
+
+/*! Size of every packet on the wire, registration and data alike */
+#define ADI_PACKET_WIRE_SIZE            (20u)
+/*! Offset of the 32-bit little endian timestamp in a data packet */
+#define ADI_PACKET_TIMESTAMP_OFFSET     (2u)
+/*! Offset of the payload in a data packet */
+#define ADI_PACKET_PAYLOAD_OFFSET       (6u)
+/*! Size of the payload of a data packet */
+#define ADI_PACKET_PAYLOAD_SIZE         (14u)
+/*! Offset of nNumDataTypes in a registration packet */
+#define ADI_PACKET_NUM_TYPES_OFFSET     (2u)
+/*! Offset of the first data type key in a registration packet */
+#define ADI_PACKET_KEYS_OFFSET          (3u)
+/*! Maximum number of data type keys in a registration packet */
+#define ADI_PACKET_MAX_DATA_TYPES       (17u)
+/*! Number of sensor IDs that fit in the 7-bit header field */
+#define ADI_PACKET_MAX_SENSOR_IDS       (128u)
+
+namespace adi_sensor_swpack
+{
+    /*!
+     * @struct ADI_PACKET_SAMPLE
+     *
+     * @brief  One field of one data packet.
+     *
+     * @details Integer keys (#ADI_BYTE_TYPE to #ADI_LONG_TYPE and #ADI_CHAR_TYPE)
+     *          are sign extended into nInteger, floating point keys are stored
+     *          in fReal. nKey tells which member is valid.
+     */
+    typedef struct
+    {
+        uint32_t    nTimestamp;     /*!< Timestamp of the packet                     */
+        uint8_t     nSensorId;      /*!< Sensor ID from the packet header            */
+        uint8_t     nSensorType;    /*!< #ADI_SENSOR_TYPE of the packet              */
+        uint8_t     nField;         /*!< Index of the field in the payload           */
+        uint8_t     nKey;           /*!< #ADI_DATA_TYPE_KEY of the field             */
+        union
+        {
+            int64_t nInteger;       /*!< Value of an integer field                   */
+            double  fReal;          /*!< Value of a floating point field             */
+        } uValue;
+    } ADI_PACKET_SAMPLE;
+
+    /*!
+     * @struct ADI_PACKET_SCHEMA
+     *
+     * @brief  Payload layout of one sensor ID, taken from its registration packet.
+     */
+    typedef struct
+    {
+        bool        bValid;                                 /*!< A layout is known for this ID        */
+        uint8_t     nSensorType;                            /*!< #ADI_SENSOR_TYPE that registered      */
+        uint8_t     nNumFields;                             /*!< Number of fields in the payload       */
+        uint8_t     aKey[ADI_PACKET_MAX_DATA_TYPES];        /*!< #ADI_DATA_TYPE_KEY of each field      */
+        uint8_t     aOffset[ADI_PACKET_MAX_DATA_TYPES];     /*!< Byte offset of each field in payload  */
+    } ADI_PACKET_SCHEMA;
+
+    /*!
+     * @struct ADI_PACKET_STATS
+     *
+     * @brief  Decoder counters.
+     */
+    typedef struct
+    {
+        uint64_t    nPackets;           /*!< Whole packets consumed                               */
+        uint64_t    nDataPackets;       /*!< Data packets decoded into samples                    */
+        uint64_t    nRegistrations;     /*!< Valid registration packets                           */
+        uint64_t    nStrings;           /*!< #ADI_PRINTSTRING_TYPE packets, not turned into samples */
+        uint64_t    nSamples;           /*!< Samples produced                                     */
+        uint64_t    nUnregistered;      /*!< Data packets without a registered or default layout  */
+        uint64_t    nBadRegistrations;  /*!< Registrations whose fields do not fit in 14 bytes    */
+        uint64_t    nTypeMismatches;    /*!< Data packets whose type differs from the registration */
+    } ADI_PACKET_STATS;
+
+    /**
+     * @class PacketDecoder
+     *
+     * @brief Stateful decoder for a stream of back to back 20-byte packets.
+     *
+     * @details Registration packets update the layout of their sensor ID, data
+     *          packets are decoded with the current layout of their ID. Until
+     *          an ID registers, or when its packets carry another sensor type
+     *          than the one registered, the default layout of the sensor type
+     *          is used. The defaults match the example applications so a capture
+     *          that starts between two registrations still decodes. One instance
+     *          decodes one stream; use one instance per thread.
+     */
+    class PacketDecoder
+    {
+        public:
+            PacketDecoder();
+
+            /*!
+             * @brief   Forgets every registration and clears the counters.
+             *
+             * @param [in] bDefaults : load the default layouts of the sensor types used
+             *                         by the example applications.
+             */
+            void reset(bool bDefaults = true);
+
+            /*!
+             * @brief   Sets the layout of a sensor ID as a registration packet would.
+             *
+             * @param [in] nSensorId   : sensor ID, 0 to 127.
+             * @param [in] eSensorType : sensor type.
+             * @param [in] pKeys       : data type key of each field.
+             * @param [in] nNumKeys    : number of fields.
+             *
+             * @return  false if the fields do not fit in the payload.
+             */
+            bool setSchema(uint8_t nSensorId, ADI_SENSOR_TYPE eSensorType, const ADI_DATA_TYPE_KEY *pKeys, uint32_t nNumKeys);
+
+            /*!
+             * @brief   Decodes every whole packet in a buffer.
+             *
+             * @param [in]  pData    : packets, back to back.
+             * @param [in]  nSize    : size of the buffer in bytes.
+             * @param [out] samples  : decoded samples are appended.
+             *
+             * @return  Number of bytes consumed, a multiple of #ADI_PACKET_WIRE_SIZE.
+             *          The remaining bytes are the start of the next packet.
+             */
+            size_t decode(const uint8_t *pData, size_t nSize, std::vector<ADI_PACKET_SAMPLE> &samples);
+
+            /*!
+             * @brief   Returns the layout of a sensor ID.
+             */
+            const ADI_PACKET_SCHEMA &getSchema(uint8_t nSensorId) const { return m_schema[nSensorId & 0x7Fu]; }
+
+            /*!
+             * @brief   Returns the layout used for a data packet of a sensor ID and type.
+             *
+             * @return  The registered layout, the default layout of the type, or
+             *          nullptr if neither is known.
+             */
+            const ADI_PACKET_SCHEMA *findSchema(uint8_t nSensorId, uint8_t nSensorType) const;
+
+            /*!
+             * @brief   Returns the decoder counters.
+             */
+            const ADI_PACKET_STATS &getStats() const { return m_stats; }
+
+            /*!
+             * @brief   Returns the size in bytes of a data type key, 0 if unknown.
+             */
+            static uint32_t getKeySize(uint8_t nKey);
+
+        private:
+            static bool BuildSchema(ADI_PACKET_SCHEMA &schema, uint8_t nSensorType, const uint8_t *pKeys, uint32_t nNumKeys);
+            void Register(const uint8_t *pPacket);
+            void DecodeData(const uint8_t *pPacket, std::vector<ADI_PACKET_SAMPLE> &samples);
+
+            ADI_PACKET_SCHEMA m_schema[ADI_PACKET_MAX_SENSOR_IDS];
+            ADI_PACKET_SCHEMA m_default[256];
+            ADI_PACKET_STATS  m_stats;
+    };
+}
+
+/*! @} */
+
+#endif /* ADI_PACKET_DECODER_H */
@@ -0,0 +1,270 @@
+/*!
+ *****************************************************************************
+  @file adi_sensor_store.h
+
+  @brief Columnar on-disk store for decoded sensor samples.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#ifndef ADI_SENSOR_STORE_H
+#define ADI_SENSOR_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+#include <adi_packet_decoder.h>
+
+/*! @addtogroup host_sensor_store Host Sensor Store
+ *  @brief Columnar storage of decoded samples.
+ *
+ *  @details A store file holds one series per sensor ID, sensor type and
+ *           payload field. Each series is cut into blocks of at most
+ *           #ADI_STORE_BLOCK_SAMPLES samples. A block is two columns: the
+ *           64-bit timestamps, then the values at the native width of the
+ *           #ADI_DATA_TYPE_KEY of the field. The index of all blocks, with the
+ *           time range of each, is written at the end of the file:
+ *
+ *           | header | block | block | ... | series table | block table | trailer |
+ *
+ *           All integers are little endian and every column starts on an
+ *           8-byte boundary, so a reader on a little endian host maps the file
+ *           and uses the columns in place. A field whose data type key changes
+ *           with a new registration starts a new series.
+ *  @{
+ */
+
+/*! File magic at the start of the header and of the trailer */
+#define ADI_STORE_MAGIC             "ADISTORE"
+/*! File format version */
+#define ADI_STORE_VERSION           (1u)
+/*! Maximum number of samples in a block */
+#define ADI_STORE_BLOCK_SAMPLES     (4096u)
+
+namespace adi_sensor_swpack
+{
+    /*!
+     * @struct ADI_STORE_SERIES
+     *
+     * @brief  Series table entry.
+     */
+    typedef struct
+    {
+        uint8_t     nSensorId;      /*!< Sensor ID                                */
+        uint8_t     nSensorType;    /*!< #ADI_SENSOR_TYPE                         */
+        uint8_t     nField;         /*!< Field index in the payload               */
+        uint8_t     nKey;           /*!< #ADI_DATA_TYPE_KEY of the values         */
+        uint32_t    nNumBlocks;     /*!< Number of blocks of the series           */
+        uint32_t    nFirstBlock;    /*!< Index of the first block in block table  */
+        uint32_t    nReserved;      /*!< Zero                                     */
+        uint64_t    nNumSamples;    /*!< Number of samples of the series          */
+    } ADI_STORE_SERIES;
+
+    /*!
+     * @struct ADI_STORE_BLOCK
+     *
+     * @brief  Block table entry. The blocks of a series are consecutive and in time order.
+     */
+    typedef struct
+    {
+        uint64_t    nOffset;        /*!< File offset of the timestamp column      */
+        uint64_t    nFirstTime;     /*!< Timestamp of the first sample            */
+        uint64_t    nLastTime;      /*!< Timestamp of the last sample             */
+        uint32_t    nNumSamples;    /*!< Number of samples in the block           */
+        uint32_t    nReserved;      /*!< Zero                                     */
+    } ADI_STORE_BLOCK;
+
+    /*!
+     * @struct ADI_STORE_COLUMNS
+     *
+     * @brief  Columns of one block, pointing into the mapped file.
+     */
+    typedef struct
+    {
+        const uint64_t *pTime;      /*!< Timestamp column                         */
+        const void     *pValues;    /*!< Value column, type given by the series   */
+        uint32_t        nNumSamples;/*!< Number of samples                        */
+    } ADI_STORE_COLUMNS;
+
+    /**
+     * @class StoreWriter
+     *
+     * @brief Writes decoded samples to a store file.
+     *
+     * @details Samples are buffered per series and a block is written each time
+     *          a series collects #ADI_STORE_BLOCK_SAMPLES samples. The 32-bit
+     *          packet timestamps are extended to 64 bits per series: whenever a
+     *          timestamp goes back, from a wrap or a reset of the node, the upper
+     *          32 bits are incremented. Samples must be appended in capture order.
+     */
+    class StoreWriter
+    {
+        public:
+            StoreWriter();
+            ~StoreWriter();
+
+            /*!
+             * @brief   Creates the file and writes the header.
+             *
+             * @return  false if the file could not be created.
+             */
+            bool open(const char *pPath);
+
+            /*!
+             * @brief   Adds samples, as produced by PacketDecoder::decode().
+             *
+             * @return  false on a write error.
+             */
+            bool append(const ADI_PACKET_SAMPLE *pSamples, size_t nNumSamples);
+
+            /*!
+             * @brief   Writes the remaining blocks and the index and closes the file.
+             *
+             * @return  false on a write error. The file is not usable in that case.
+             */
+            bool close();
+
+        private:
+            struct Series
+            {
+                ADI_STORE_SERIES      sInfo;
+                uint32_t              nLastRaw;
+                uint64_t              nEpoch;
+                std::vector<uint64_t> time;
+                std::vector<uint8_t>  values;
+                std::vector<uint32_t> blocks;
+            };
+
+            Series *Find(const ADI_PACKET_SAMPLE &sample);
+            bool    FlushBlock(Series &series);
+            bool    Write(const void *pData, size_t nSize);
+            bool    Pad();
+
+            FILE                         *m_file;
+            uint64_t                      m_offset;
+            bool                          m_error;
+            std::vector<Series *>         m_series;
+            Series                       *m_lookup[ADI_PACKET_MAX_SENSOR_IDS][ADI_PACKET_MAX_DATA_TYPES];
+            std::vector<ADI_STORE_BLOCK>  m_blocks;
+    };
+
+    /**
+     * @class StoreReader
+     *
+     * @brief Maps a store file and gives direct access to its columns.
+     */
+    class StoreReader
+    {
+        public:
+            StoreReader();
+            ~StoreReader();
+
+            /*!
+             * @brief   Maps the file and checks the header, trailer and index.
+             *
+             * @return  false if the file is missing or not a valid store.
+             */
+            bool open(const char *pPath);
+
+            /*!
+             * @brief   Unmaps the file. Column pointers are no longer valid.
+             */
+            void close();
+
+            /*!
+             * @brief   Returns the number of series.
+             */
+            uint32_t getNumSeries() const { return m_nNumSeries; }
+
+            /*!
+             * @brief   Returns a series table entry.
+             */
+            const ADI_STORE_SERIES &getSeries(uint32_t nSeries) const { return m_pSeries[nSeries]; }
+
+            /*!
+             * @brief   Finds a series.
+             *
+             * @return  Index of the series, or -1 if the store does not hold it.
+             */
+            int32_t findSeries(uint8_t nSensorId, uint8_t nSensorType, uint8_t nField) const;
+
+            /*!
+             * @brief   Returns a block table entry of a series.
+             */
+            const ADI_STORE_BLOCK &getBlock(uint32_t nSeries, uint32_t nBlock) const
+            {
+                return m_pBlocks[m_pSeries[nSeries].nFirstBlock + nBlock];
+            }
+
+            /*!
+             * @brief   Returns the columns of a block of a series.
+             */
+            ADI_STORE_COLUMNS getColumns(uint32_t nSeries, uint32_t nBlock) const;
+
+            /*!
+             * @brief   Finds the blocks of a series that overlap a time range.
+             *
+             * @param [in]  nSeries : series index.
+             * @param [in]  nStart  : first timestamp of the range, inclusive.
+             * @param [in]  nEnd    : last timestamp of the range, inclusive.
+             * @param [out] nFirst  : first overlapping block.
+             *
+             * @return  Number of overlapping blocks, starting at nFirst. The first and
+             *          last of them may hold samples outside the range.
+             */
+            uint32_t findBlocks(uint32_t nSeries, uint64_t nStart, uint64_t nEnd, uint32_t &nFirst) const;
+
+        private:
+            const uint8_t          *m_pMap;
+            size_t                  m_nSize;
+            const ADI_STORE_SERIES *m_pSeries;
+            const ADI_STORE_BLOCK  *m_pBlocks;
+            uint32_t                m_nNumSeries;
+            uint32_t                m_nNumBlocks;
+    };
+}
+
+/*! @} */
+
+#endif /* ADI_SENSOR_STORE_H */
@@ -0,0 +1,303 @@
+/*!
+ *****************************************************************************
+  @file adi_packet_decoder.cpp
+
+  @brief Host side decoder for ADI_DATA_PACKET and ADI_REGISTRATION_PACKET streams.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#include <string.h>
+#include <adi_packet_decoder.h>
+
+namespace adi_sensor_swpack
+{
+    namespace
+    {
+        /* Little endian loads, independent of the host byte order */
+        inline uint16_t Load16(const uint8_t *p)
+        {
+            return static_cast<uint16_t>(p[0] | (p[1] << 8));
+        }
+
+        inline uint32_t Load32(const uint8_t *p)
+        {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                   (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        inline uint64_t Load64(const uint8_t *p)
+        {
+            return static_cast<uint64_t>(Load32(p)) | (static_cast<uint64_t>(Load32(p + 4)) << 32);
+        }
+
+        /* Layouts sent by the example applications */
+        const uint8_t kShort3[] = { ADI_SHORT_TYPE, ADI_SHORT_TYPE, ADI_SHORT_TYPE };
+        const uint8_t kFloat1[] = { ADI_FLOAT_TYPE };
+        const uint8_t kFloat3[] = { ADI_FLOAT_TYPE, ADI_FLOAT_TYPE, ADI_FLOAT_TYPE };
+        const uint8_t kStats[]  = { ADI_BYTE_TYPE, ADI_SHORT_TYPE, ADI_SHORT_TYPE, ADI_SHORT_TYPE,
+                                    ADI_INT_TYPE, ADI_SHORT_TYPE, ADI_BYTE_TYPE };
+        const uint8_t kVibration[] = { ADI_BYTE_TYPE, ADI_SHORT_TYPE, ADI_SHORT_TYPE, ADI_SHORT_TYPE,
+                                       ADI_SHORT_TYPE, ADI_SHORT_TYPE, ADI_SHORT_TYPE, ADI_BYTE_TYPE };
+        const uint8_t kOrientation[] = { ADI_SHORT_TYPE, ADI_SHORT_TYPE, ADI_SHORT_TYPE, ADI_BYTE_TYPE };
+        const uint8_t kByte14[] = { ADI_BYTE_TYPE, ADI_BYTE_TYPE, ADI_BYTE_TYPE, ADI_BYTE_TYPE, ADI_BYTE_TYPE,
+                                    ADI_BYTE_TYPE, ADI_BYTE_TYPE, ADI_BYTE_TYPE, ADI_BYTE_TYPE, ADI_BYTE_TYPE,
+                                    ADI_BYTE_TYPE, ADI_BYTE_TYPE, ADI_BYTE_TYPE, ADI_BYTE_TYPE };
+    }
+
+    PacketDecoder::PacketDecoder()
+    {
+        reset(true);
+    }
+
+    void PacketDecoder::reset(bool bDefaults)
+    {
+        memset(m_schema, 0, sizeof(m_schema));
+        memset(m_default, 0, sizeof(m_default));
+        memset(&m_stats, 0, sizeof(m_stats));
+
+        if(bDefaults)
+        {
+            BuildSchema(m_default[ADI_ACCELEROMETER_2G_TYPE], ADI_ACCELEROMETER_2G_TYPE, kShort3, 3u);
+            BuildSchema(m_default[ADI_ACCELEROMETER_4G_TYPE], ADI_ACCELEROMETER_4G_TYPE, kShort3, 3u);
+            BuildSchema(m_default[ADI_ACCELEROMETER_8G_TYPE], ADI_ACCELEROMETER_8G_TYPE, kShort3, 3u);
+            BuildSchema(m_default[ADI_CO_TYPE],               ADI_CO_TYPE,               kFloat1, 1u);
+            BuildSchema(m_default[ADI_TEMPERATURE_TYPE],      ADI_TEMPERATURE_TYPE,      kFloat1, 1u);
+            BuildSchema(m_default[ADI_VISIBLELIGHT_TYPE],     ADI_VISIBLELIGHT_TYPE,     kFloat3, 3u);
+            BuildSchema(m_default[ADI_STATISTICS_TYPE],       ADI_STATISTICS_TYPE,       kStats,  7u);
+            BuildSchema(m_default[ADI_VIBRATION_TYPE],        ADI_VIBRATION_TYPE,        kVibration, 8u);
+            BuildSchema(m_default[ADI_ORIENTATION_TYPE],      ADI_ORIENTATION_TYPE,      kOrientation, 4u);
+            BuildSchema(m_default[ADI_ACCELEROMETER_8BIT_TYPE], ADI_ACCELEROMETER_8BIT_TYPE, kByte14, 14u);
+        }
+    }
+
+    uint32_t PacketDecoder::getKeySize(uint8_t nKey)
+    {
+        switch(nKey)
+        {
+            case ADI_BYTE_TYPE:
+            case ADI_CHAR_TYPE:
+                return 1u;
+            case ADI_SHORT_TYPE:
+                return 2u;
+            case ADI_INT_TYPE:
+            case ADI_FLOAT_TYPE:
+                return 4u;
+            case ADI_LONG_TYPE:
+            case ADI_DOUBLE_TYPE:
+                return 8u;
+            default:
+                return 0u;
+        }
+    }
+
+    bool PacketDecoder::BuildSchema(ADI_PACKET_SCHEMA &schema, uint8_t nSensorType, const uint8_t *pKeys, uint32_t nNumKeys)
+    {
+        uint32_t nOffset = 0u;
+
+        if(nNumKeys > ADI_PACKET_MAX_DATA_TYPES)
+        {
+            return false;
+        }
+
+        for(uint32_t i = 0u; i < nNumKeys; i++)
+        {
+            const uint32_t nSize = getKeySize(pKeys[i]);
+
+            if((nSize == 0u) || ((nOffset + nSize) > ADI_PACKET_PAYLOAD_SIZE))
+            {
+                return false;
+            }
+            schema.aKey[i]    = pKeys[i];
+            schema.aOffset[i] = static_cast<uint8_t>(nOffset);
+            nOffset += nSize;
+        }
+
+        schema.nSensorType = nSensorType;
+        schema.nNumFields  = static_cast<uint8_t>(nNumKeys);
+        schema.bValid      = true;
+        return true;
+    }
+
+    bool PacketDecoder::setSchema(uint8_t nSensorId, ADI_SENSOR_TYPE eSensorType, const ADI_DATA_TYPE_KEY *pKeys, uint32_t nNumKeys)
+    {
+        uint8_t aKeys[ADI_PACKET_MAX_DATA_TYPES];
+
+        if(nNumKeys > ADI_PACKET_MAX_DATA_TYPES)
+        {
+            return false;
+        }
+        for(uint32_t i = 0u; i < nNumKeys; i++)
+        {
+            aKeys[i] = static_cast<uint8_t>(pKeys[i]);
+        }
+        return BuildSchema(m_schema[nSensorId & 0x7Fu], static_cast<uint8_t>(eSensorType), aKeys, nNumKeys);
+    }
+
+    void PacketDecoder::Register(const uint8_t *pPacket)
+    {
+        ADI_PACKET_SCHEMA schema;
+
+        memset(&schema, 0, sizeof(schema));
+        if(BuildSchema(schema, pPacket[1], &pPacket[ADI_PACKET_KEYS_OFFSET], pPacket[ADI_PACKET_NUM_TYPES_OFFSET]))
+        {
+            m_schema[pPacket[0] & 0x7Fu] = schema;
+            m_stats.nRegistrations++;
+        }
+        else
+        {
+            /* Keep the previous layout, a corrupt registration must not break the ID */
+            m_stats.nBadRegistrations++;
+        }
+    }
+
+    const ADI_PACKET_SCHEMA *PacketDecoder::findSchema(uint8_t nSensorId, uint8_t nSensorType) const
+    {
+        const ADI_PACKET_SCHEMA *pSchema = &m_schema[nSensorId & 0x7Fu];
+
+        if(pSchema->bValid && (pSchema->nSensorType == nSensorType))
+        {
+            return pSchema;
+        }
+        pSchema = &m_default[nSensorType];
+        return pSchema->bValid ? pSchema : nullptr;
+    }
+
+    void PacketDecoder::DecodeData(const uint8_t *pPacket, std::vector<ADI_PACKET_SAMPLE> &samples)
+    {
+        const uint8_t            nSensorId   = pPacket[0] & 0x7Fu;
+        const uint8_t            nSensorType = pPacket[1];
+        const uint8_t           *pPayload    = &pPacket[ADI_PACKET_PAYLOAD_OFFSET];
+        const ADI_PACKET_SCHEMA *pSchema     = &m_schema[nSensorId];
+        ADI_PACKET_SAMPLE        sSample;
+
+        if(nSensorType == ADI_PRINTSTRING_TYPE)
+        {
+            m_stats.nStrings++;
+            return;
+        }
+
+        if(!pSchema->bValid || (pSchema->nSensorType != nSensorType))
+        {
+            if(pSchema->bValid)
+            {
+                m_stats.nTypeMismatches++;
+            }
+            pSchema = &m_default[nSensorType];
+            if(!pSchema->bValid)
+            {
+                m_stats.nUnregistered++;
+                return;
+            }
+        }
+
+        sSample.nTimestamp  = Load32(&pPacket[ADI_PACKET_TIMESTAMP_OFFSET]);
+        sSample.nSensorId   = nSensorId;
+        sSample.nSensorType = nSensorType;
+
+        for(uint8_t i = 0u; i < pSchema->nNumFields; i++)
+        {
+            const uint8_t *pField = &pPayload[pSchema->aOffset[i]];
+
+            sSample.nField = i;
+            sSample.nKey   = pSchema->aKey[i];
+
+            switch(sSample.nKey)
+            {
+                case ADI_BYTE_TYPE:
+                case ADI_CHAR_TYPE:
+                    sSample.uValue.nInteger = static_cast<int8_t>(pField[0]);
+                    break;
+                case ADI_SHORT_TYPE:
+                    sSample.uValue.nInteger = static_cast<int16_t>(Load16(pField));
+                    break;
+                case ADI_INT_TYPE:
+                    sSample.uValue.nInteger = static_cast<int32_t>(Load32(pField));
+                    break;
+                case ADI_LONG_TYPE:
+                    sSample.uValue.nInteger = static_cast<int64_t>(Load64(pField));
+                    break;
+                case ADI_FLOAT_TYPE:
+                {
+                    const uint32_t nBits = Load32(pField);
+                    float          fValue;
+                    memcpy(&fValue, &nBits, sizeof(fValue));
+                    sSample.uValue.fReal = fValue;
+                    break;
+                }
+                default: /* ADI_DOUBLE_TYPE, BuildSchema() rejects unknown keys */
+                {
+                    const uint64_t nBits = Load64(pField);
+                    memcpy(&sSample.uValue.fReal, &nBits, sizeof(double));
+                    break;
+                }
+            }
+            samples.push_back(sSample);
+        }
+
+        m_stats.nDataPackets++;
+        m_stats.nSamples += pSchema->nNumFields;
+    }
+
+    size_t PacketDecoder::decode(const uint8_t *pData, size_t nSize, std::vector<ADI_PACKET_SAMPLE> &samples)
+    {
+        const size_t nPackets = nSize / ADI_PACKET_WIRE_SIZE;
+
+        for(size_t n = 0u; n < nPackets; n++)
+        {
+            const uint8_t *pPacket = &pData[n * ADI_PACKET_WIRE_SIZE];
+
+            if((pPacket[0] & 0x80u) != 0u)
+            {
+                DecodeData(pPacket, samples);
+            }
+            else
+            {
+                Register(pPacket);
+            }
+        }
+
+        m_stats.nPackets += nPackets;
+        return nPackets * ADI_PACKET_WIRE_SIZE;
+    }
+}
@@ -0,0 +1,460 @@
+/*!
+ *****************************************************************************
+  @file adi_sensor_store.cpp
+
+  @brief Columnar on-disk store for decoded sensor samples.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <adi_sensor_store.h>
+
+namespace adi_sensor_swpack
+{
+    namespace
+    {
+        typedef struct
+        {
+            char        aMagic[8];
+            uint32_t    nVersion;
+            uint32_t    nReserved;
+        } STORE_HEADER;
+
+        typedef struct
+        {
+            uint64_t    nSeriesOffset;
+            uint64_t    nBlocksOffset;
+            uint32_t    nNumSeries;
+            uint32_t    nNumBlocks;
+            char        aMagic[8];
+        } STORE_TRAILER;
+
+        const uint8_t kZero[8] = { 0u };
+    }
+
+    /****************************** StoreWriter ******************************/
+
+    StoreWriter::StoreWriter() :
+        m_file(nullptr),
+        m_offset(0u),
+        m_error(false)
+    {
+        memset(m_lookup, 0, sizeof(m_lookup));
+    }
+
+    StoreWriter::~StoreWriter()
+    {
+        if(m_file != nullptr)
+        {
+            close();
+        }
+    }
+
+    bool StoreWriter::Write(const void *pData, size_t nSize)
+    {
+        if(!m_error && (fwrite(pData, 1u, nSize, m_file) != nSize))
+        {
+            m_error = true;
+        }
+        m_offset += nSize;
+        return !m_error;
+    }
+
+    bool StoreWriter::Pad()
+    {
+        const size_t nPad = static_cast<size_t>((8u - (m_offset & 7u)) & 7u);
+        return Write(kZero, nPad);
+    }
+
+    bool StoreWriter::open(const char *pPath)
+    {
+        STORE_HEADER sHeader;
+
+        if((m_file = fopen(pPath, "wb")) == nullptr)
+        {
+            return false;
+        }
+        setvbuf(m_file, nullptr, _IOFBF, 1u << 20);
+
+        memset(&sHeader, 0, sizeof(sHeader));
+        memcpy(sHeader.aMagic, ADI_STORE_MAGIC, sizeof(sHeader.aMagic));
+        sHeader.nVersion = ADI_STORE_VERSION;
+
+        m_offset = 0u;
+        m_error  = false;
+        return Write(&sHeader, sizeof(sHeader));
+    }
+
+    StoreWriter::Series *StoreWriter::Find(const ADI_PACKET_SAMPLE &sample)
+    {
+        Series *&pCached = m_lookup[sample.nSensorId & 0x7Fu][sample.nField];
+
+        if((pCached != nullptr) && (pCached->sInfo.nSensorType == sample.nSensorType) && (pCached->sInfo.nKey == sample.nKey))
+        {
+            return pCached;
+        }
+
+        for(Series *pSeries : m_series)
+        {
+            if((pSeries->sInfo.nSensorId   == sample.nSensorId)   &&
+               (pSeries->sInfo.nSensorType == sample.nSensorType) &&
+               (pSeries->sInfo.nField      == sample.nField)      &&
+               (pSeries->sInfo.nKey        == sample.nKey))
+            {
+                pCached = pSeries;
+                return pSeries;
+            }
+        }
+
+        Series *pSeries = new Series();
+        memset(&pSeries->sInfo, 0, sizeof(pSeries->sInfo));
+        pSeries->sInfo.nSensorId   = sample.nSensorId;
+        pSeries->sInfo.nSensorType = sample.nSensorType;
+        pSeries->sInfo.nField      = sample.nField;
+        pSeries->sInfo.nKey        = sample.nKey;
+        pSeries->nLastRaw          = sample.nTimestamp;
+        pSeries->nEpoch            = 0u;
+        pSeries->time.reserve(ADI_STORE_BLOCK_SAMPLES);
+        pSeries->values.reserve(ADI_STORE_BLOCK_SAMPLES * PacketDecoder::getKeySize(sample.nKey));
+        m_series.push_back(pSeries);
+        pCached = pSeries;
+        return pSeries;
+    }
+
+    bool StoreWriter::FlushBlock(Series &series)
+    {
+        ADI_STORE_BLOCK sBlock;
+
+        if(series.time.empty())
+        {
+            return true;
+        }
+
+        Pad();
+        sBlock.nOffset     = m_offset;
+        sBlock.nFirstTime  = series.time.front();
+        sBlock.nLastTime   = series.time.back();
+        sBlock.nNumSamples = static_cast<uint32_t>(series.time.size());
+        sBlock.nReserved   = 0u;
+
+        Write(series.time.data(), series.time.size() * sizeof(uint64_t));
+        Write(series.values.data(), series.values.size());
+
+        series.blocks.push_back(static_cast<uint32_t>(m_blocks.size()));
+        series.sInfo.nNumSamples += sBlock.nNumSamples;
+        m_blocks.push_back(sBlock);
+
+        series.time.clear();
+        series.values.clear();
+        return !m_error;
+    }
+
+    bool StoreWriter::append(const ADI_PACKET_SAMPLE *pSamples, size_t nNumSamples)
+    {
+        for(size_t i = 0u; i < nNumSamples; i++)
+        {
+            const ADI_PACKET_SAMPLE &s       = pSamples[i];
+            Series                  &series  = *Find(s);
+            const uint32_t           nSize   = PacketDecoder::getKeySize(s.nKey);
+            uint8_t                  aValue[8];
+
+            /* Extend the 32-bit timestamp. A step back is a wrap or a node reset,
+             * both start a new epoch so the blocks stay in time order. */
+            if(s.nTimestamp < series.nLastRaw)
+            {
+                series.nEpoch += 0x100000000ull;
+            }
+            series.nLastRaw = s.nTimestamp;
+            series.time.push_back(series.nEpoch | s.nTimestamp);
+
+            switch(s.nKey)
+            {
+                case ADI_FLOAT_TYPE:
+                {
+                    const float fValue = static_cast<float>(s.uValue.fReal);
+                    memcpy(aValue, &fValue, sizeof(fValue));
+                    break;
+                }
+                case ADI_DOUBLE_TYPE:
+                    memcpy(aValue, &s.uValue.fReal, sizeof(double));
+                    break;
+                default:
+                {
+                    /* Truncate to the native width, the host is little endian */
+                    const int64_t nValue = s.uValue.nInteger;
+                    memcpy(aValue, &nValue, sizeof(nValue));
+                    break;
+                }
+            }
+            series.values.insert(series.values.end(), aValue, aValue + nSize);
+
+            if((series.time.size() >= ADI_STORE_BLOCK_SAMPLES) && !FlushBlock(series))
+            {
+                return false;
+            }
+        }
+        return !m_error;
+    }
+
+    bool StoreWriter::close()
+    {
+        std::vector<ADI_STORE_BLOCK> blocks;
+        std::vector<ADI_STORE_SERIES> series;
+        STORE_TRAILER                 sTrailer;
+
+        if(m_file == nullptr)
+        {
+            return false;
+        }
+
+        for(Series *pSeries : m_series)
+        {
+            FlushBlock(*pSeries);
+        }
+
+        /* Reorder the block table so the blocks of a series are consecutive */
+        for(Series *pSeries : m_series)
+        {
+            pSeries->sInfo.nFirstBlock = static_cast<uint32_t>(blocks.size());
+            pSeries->sInfo.nNumBlocks  = static_cast<uint32_t>(pSeries->blocks.size());
+            for(uint32_t nBlock : pSeries->blocks)
+            {
+                blocks.push_back(m_blocks[nBlock]);
+            }
+            series.push_back(pSeries->sInfo);
+            delete pSeries;
+        }
+        m_series.clear();
+        m_blocks.clear();
+        memset(m_lookup, 0, sizeof(m_lookup));
+
+        Pad();
+        memset(&sTrailer, 0, sizeof(sTrailer));
+        sTrailer.nSeriesOffset = m_offset;
+        Write(series.data(), series.size() * sizeof(ADI_STORE_SERIES));
+        sTrailer.nBlocksOffset = m_offset;
+        Write(blocks.data(), blocks.size() * sizeof(ADI_STORE_BLOCK));
+        sTrailer.nNumSeries = static_cast<uint32_t>(series.size());
+        sTrailer.nNumBlocks = static_cast<uint32_t>(blocks.size());
+        memcpy(sTrailer.aMagic, ADI_STORE_MAGIC, sizeof(sTrailer.aMagic));
+        Write(&sTrailer, sizeof(sTrailer));
+
+        if(fclose(m_file) != 0)
+        {
+            m_error = true;
+        }
+        m_file = nullptr;
+        return !m_error;
+    }
+
+    /****************************** StoreReader ******************************/
+
+    StoreReader::StoreReader() :
+        m_pMap(nullptr),
+        m_nSize(0u),
+        m_pSeries(nullptr),
+        m_pBlocks(nullptr),
+        m_nNumSeries(0u),
+        m_nNumBlocks(0u)
+    {
+    }
+
+    StoreReader::~StoreReader()
+    {
+        close();
+    }
+
+    bool StoreReader::open(const char *pPath)
+    {
+        struct stat   st;
+        STORE_HEADER  sHeader;
+        STORE_TRAILER sTrailer;
+
+        close();
+
+        const int fd = ::open(pPath, O_RDONLY);
+        if(fd < 0)
+        {
+            return false;
+        }
+        if((fstat(fd, &st) != 0) || (static_cast<size_t>(st.st_size) < (sizeof(sHeader) + sizeof(sTrailer))))
+        {
+            ::close(fd);
+            return false;
+        }
+
+        void *pMap = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if(pMap == MAP_FAILED)
+        {
+            return false;
+        }
+        m_pMap  = static_cast<const uint8_t *>(pMap);
+        m_nSize = static_cast<size_t>(st.st_size);
+
+        memcpy(&sHeader, m_pMap, sizeof(sHeader));
+        memcpy(&sTrailer, &m_pMap[m_nSize - sizeof(sTrailer)], sizeof(sTrailer));
+
+        const uint64_t nIndexEnd = m_nSize - sizeof(sTrailer);
+        if((memcmp(sHeader.aMagic, ADI_STORE_MAGIC, sizeof(sHeader.aMagic)) != 0)   ||
+           (sHeader.nVersion != ADI_STORE_VERSION)                                  ||
+           (memcmp(sTrailer.aMagic, ADI_STORE_MAGIC, sizeof(sTrailer.aMagic)) != 0) ||
+           ((sTrailer.nSeriesOffset & 7u) != 0u)                                    ||
+           ((sTrailer.nSeriesOffset + (static_cast<uint64_t>(sTrailer.nNumSeries) * sizeof(ADI_STORE_SERIES))) != sTrailer.nBlocksOffset) ||
+           ((sTrailer.nBlocksOffset + (static_cast<uint64_t>(sTrailer.nNumBlocks) * sizeof(ADI_STORE_BLOCK))) != nIndexEnd))
+        {
+            close();
+            return false;
+        }
+
+        m_pSeries    = reinterpret_cast<const ADI_STORE_SERIES *>(&m_pMap[sTrailer.nSeriesOffset]);
+        m_pBlocks    = reinterpret_cast<const ADI_STORE_BLOCK *>(&m_pMap[sTrailer.nBlocksOffset]);
+        m_nNumSeries = sTrailer.nNumSeries;
+        m_nNumBlocks = sTrailer.nNumBlocks;
+
+        /* Check once here so the accessors do not have to */
+        for(uint32_t i = 0u; i < m_nNumSeries; i++)
+        {
+            const ADI_STORE_SERIES &s = m_pSeries[i];
+            const uint32_t          nValueSize = PacketDecoder::getKeySize(s.nKey);
+
+            if((nValueSize == 0u) || (s.nFirstBlock > m_nNumBlocks) || (s.nNumBlocks > (m_nNumBlocks - s.nFirstBlock)))
+            {
+                close();
+                return false;
+            }
+            for(uint32_t b = 0u; b < s.nNumBlocks; b++)
+            {
+                const ADI_STORE_BLOCK &block = m_pBlocks[s.nFirstBlock + b];
+                const uint64_t         nEnd  = block.nOffset + (static_cast<uint64_t>(block.nNumSamples) * (sizeof(uint64_t) + nValueSize));
+
+                if(((block.nOffset & 7u) != 0u) || (nEnd > sTrailer.nSeriesOffset))
+                {
+                    close();
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void StoreReader::close()
+    {
+        if(m_pMap != nullptr)
+        {
+            munmap(const_cast<uint8_t *>(m_pMap), m_nSize);
+        }
+        m_pMap       = nullptr;
+        m_nSize      = 0u;
+        m_pSeries    = nullptr;
+        m_pBlocks    = nullptr;
+        m_nNumSeries = 0u;
+        m_nNumBlocks = 0u;
+    }
+
+    int32_t StoreReader::findSeries(uint8_t nSensorId, uint8_t nSensorType, uint8_t nField) const
+    {
+        for(uint32_t i = 0u; i < m_nNumSeries; i++)
+        {
+            if((m_pSeries[i].nSensorId == nSensorId) && (m_pSeries[i].nSensorType == nSensorType) && (m_pSeries[i].nField == nField))
+            {
+                return static_cast<int32_t>(i);
+            }
+        }
+        return -1;
+    }
+
+    ADI_STORE_COLUMNS StoreReader::getColumns(uint32_t nSeries, uint32_t nBlock) const
+    {
+        const ADI_STORE_BLOCK &block = getBlock(nSeries, nBlock);
+        ADI_STORE_COLUMNS      sColumns;
+
+        sColumns.pTime       = reinterpret_cast<const uint64_t *>(&m_pMap[block.nOffset]);
+        sColumns.pValues     = &m_pMap[block.nOffset + (block.nNumSamples * sizeof(uint64_t))];
+        sColumns.nNumSamples = block.nNumSamples;
+        return sColumns;
+    }
+
+    uint32_t StoreReader::findBlocks(uint32_t nSeries, uint64_t nStart, uint64_t nEnd, uint32_t &nFirst) const
+    {
+        const ADI_STORE_BLOCK *pBlocks = &m_pBlocks[m_pSeries[nSeries].nFirstBlock];
+        uint32_t               nLow    = 0u;
+        uint32_t               nHigh   = m_pSeries[nSeries].nNumBlocks;
+
+        /* First block that ends at or after nStart */
+        while(nLow < nHigh)
+        {
+            const uint32_t nMid = nLow + ((nHigh - nLow) / 2u);
+            if(pBlocks[nMid].nLastTime < nStart)
+            {
+                nLow = nMid + 1u;
+            }
+            else
+            {
+                nHigh = nMid;
+            }
+        }
+        nFirst = nLow;
+
+        /* Up to the first block that starts after nEnd */
+        nHigh = m_pSeries[nSeries].nNumBlocks;
+        while(nLow < nHigh)
+        {
+            const uint32_t nMid = nLow + ((nHigh - nLow) / 2u);
+            if(pBlocks[nMid].nFirstTime <= nEnd)
+            {
+                nLow = nMid + 1u;
+            }
+            else
+            {
+                nHigh = nMid;
+            }
+        }
+        return nLow - nFirst;
+    }
+}
@@ -0,0 +1,316 @@
+/*!
+ *****************************************************************************
+  @file adi_i2c_bus_bench.cpp
+
+  @brief Host bench for the I2C request queue on the simulated bus.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+/*
+ * Builds the shared I2C bus (Source/common/adi_i2c_bus.c) with
+ * ADI_I2C_BUS_HOST, attaches simulated ADT7420 sensors and compares two
+ * ways of reading all of them once per loop while the loop also does other
+ * work, as the examples do with the radio:
+ *
+ *   blocking  adi_i2c_bus_ReadWrite() for every sensor, then the work
+ *   queued    adi_i2c_bus_Submit() for every sensor, then the work in
+ *             slices with adi_i2c_bus_Process() between them, as a main
+ *             loop polls, and Process() until the callbacks have run
+ *
+ * The queue starts the next transfer from Process(), so the slice sets how
+ * much of the bus time the work hides.
+ *
+ *   adi_i2c_bus_bench [-b bit rate] [-n sensors] [-w work us] [-s slice us] [-l loops]
+ *
+ *   -b  bus bit rate in Hz (default 400000)
+ *   -n  number of sensors, 1 to 4 (default 4)
+ *   -w  other work per loop in us (default 500)
+ *   -s  work between two adi_i2c_bus_Process() calls in us (default 50)
+ *   -l  number of loops (default 200)
+ *
+ * Prints the bus time of one read from the timing model and as measured,
+ * the loop time of both ways, the slave address changes per loop and
+ * checks that every reading arrived with the value of its sensor.
+ */
+
+#include <common/adi_i2c_bus.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include <unistd.h>
+
+namespace {
+
+/* Simulated ADT7420, every read of the temperature loads the next conversion */
+struct SimSensor
+{
+    ADI_I2C_BUS_SIM_DEVICE sDevice;
+    uint8_t                aRegisters[16];
+    int16_t                nTemp;          /* 1/128 degree C */
+    uint32_t               nReads;
+};
+
+void SimHook(void *pParam, uint8_t nRegister, bool bRead)
+{
+    SimSensor *pSensor = static_cast<SimSensor*>(pParam);
+
+    if(bRead && (nRegister == 0x00u))
+    {
+        pSensor->nReads++;
+        pSensor->nTemp = (int16_t)(pSensor->nTemp + 1);
+        pSensor->aRegisters[0] = (uint8_t)((uint16_t) pSensor->nTemp >> 8);
+        pSensor->aRegisters[1] = (uint8_t) pSensor->nTemp;
+    }
+}
+
+/* A queued read of one sensor, as ADT7420::readTemperatureAsync() sets it up */
+struct Read
+{
+    ADI_I2C_BUS_REQUEST sRequest;
+    uint8_t             nRegister;
+    uint8_t             aData[2];
+    uint32_t            nDone;
+    uint32_t            nErrors;
+};
+
+void ReadDone(ADI_I2C_BUS_REQUEST *pRequest)
+{
+    Read *pRead = static_cast<Read*>(pRequest->pCBParam);
+
+    pRead->nDone++;
+    if(pRequest->eResult != ADI_I2C_SUCCESS)
+    {
+        pRead->nErrors++;
+    }
+}
+
+void Setup(Read &sRead, uint16_t nAddress)
+{
+    sRead.nRegister                      = 0x00u;
+    sRead.sRequest.nAddress              = nAddress;
+    sRead.sRequest.sTransaction.pPrologue     = &sRead.nRegister;
+    sRead.sRequest.sTransaction.nPrologueSize = 1u;
+    sRead.sRequest.sTransaction.pData         = sRead.aData;
+    sRead.sRequest.sTransaction.nDataSize     = 2u;
+    sRead.sRequest.sTransaction.bReadNotWrite = true;
+    sRead.sRequest.sTransaction.bRepeatStart  = true;
+    sRead.sRequest.pfCallback            = ReadDone;
+    sRead.sRequest.pCBParam              = &sRead;
+    sRead.sRequest.eState                = ADI_I2C_BUS_IDLE;
+}
+
+/* The other work of a loop, busy so it competes with nothing but the bus */
+void Work(uint32_t nMicroseconds)
+{
+    const uint64_t nEnd = adi_i2c_bus_SimTime() + (uint64_t) nMicroseconds * 1000u;
+
+    while(adi_i2c_bus_SimTime() < nEnd)
+    {
+    }
+}
+
+/* True when the read returned the conversion before the one the hook loaded */
+bool Check(const uint8_t *pData, const SimSensor &sSensor)
+{
+    return (int16_t)((pData[0] << 8) | pData[1]) == (int16_t)(sSensor.nTemp - 1);
+}
+
+void Usage()
+{
+    std::fprintf(stderr, "usage: adi_i2c_bus_bench [-b bit rate] [-n sensors] [-w work us] [-s slice us] [-l loops]\n");
+    std::exit(2);
+}
+
+} /* namespace */
+
+int main(int argc, char *argv[])
+{
+    uint32_t  nBitRate = 400000u;
+    uint32_t  nSensors = 4u;
+    uint32_t  nWork    = 500u;
+    uint32_t  nSlice   = 50u;
+    uint32_t  nLoops   = 200u;
+    int       opt;
+
+    while((opt = getopt(argc, argv, "b:n:w:s:l:")) != -1)
+    {
+        switch(opt)
+        {
+            case 'b': nBitRate = (uint32_t) std::strtoul(optarg, NULL, 0); break;
+            case 'n': nSensors = (uint32_t) std::strtoul(optarg, NULL, 0); break;
+            case 'w': nWork    = (uint32_t) std::strtoul(optarg, NULL, 0); break;
+            case 's': nSlice   = (uint32_t) std::strtoul(optarg, NULL, 0); break;
+            case 'l': nLoops   = (uint32_t) std::strtoul(optarg, NULL, 0); break;
+            default:  Usage();
+        }
+    }
+    if((nBitRate == 0u) || (nSensors < 1u) || (nSensors > 4u) || (nSlice == 0u) || (nLoops == 0u))
+    {
+        Usage();
+    }
+
+    static SimSensor aSensors[4];
+    static Read      aReads[4];
+
+    for(uint32_t i = 0u; i < nSensors; i++)
+    {
+        aSensors[i].sDevice.nAddress   = (uint16_t)(0x48u + i);
+        aSensors[i].sDevice.pRegisters = aSensors[i].aRegisters;
+        aSensors[i].sDevice.nSize      = sizeof(aSensors[i].aRegisters);
+        aSensors[i].sDevice.pfHook     = SimHook;
+        aSensors[i].sDevice.pParam     = &aSensors[i];
+        aSensors[i].nTemp              = (int16_t)((20 + 5 * i) * 128);
+        SimHook(&aSensors[i], 0x00u, true);
+        adi_i2c_bus_SimAttach(&aSensors[i].sDevice);
+        Setup(aReads[i], aSensors[i].sDevice.nAddress);
+    }
+
+    if(adi_i2c_bus_Open(nBitRate) != ADI_I2C_SUCCESS)
+    {
+        std::fprintf(stderr, "adi_i2c_bus_Open failed\n");
+        return 1;
+    }
+
+    /* Start, address, register, repeated start, address, 2 data bytes, stop */
+    const double fModel = (((1 + 1 + 1 + 2) * 9 + 2) * 1e6) / nBitRate;
+    uint32_t     nMismatch = 0u;
+
+    /* One read on an idle bus */
+    {
+        uint32_t nHwErrors;
+        uint64_t nStart = adi_i2c_bus_SimTime();
+
+        (void) adi_i2c_bus_ReadWrite(0x48u, &aReads[0].sRequest.sTransaction, &nHwErrors);
+        std::printf("one read at %u Hz: model %.1f us, measured %.1f us\n", nBitRate, fModel,
+                    (adi_i2c_bus_SimTime() - nStart) / 1e3);
+    }
+
+    /* Blocking reads, then the work */
+    uint32_t nChanges = adi_i2c_bus_GetAddressChanges();
+    uint64_t nStart   = adi_i2c_bus_SimTime();
+
+    for(uint32_t nLoop = 0u; nLoop < nLoops; nLoop++)
+    {
+        for(uint32_t i = 0u; i < nSensors; i++)
+        {
+            uint32_t nHwErrors;
+            uint32_t nBefore = aSensors[i].nReads;
+
+            if((adi_i2c_bus_ReadWrite(aReads[i].sRequest.nAddress, &aReads[i].sRequest.sTransaction, &nHwErrors) != ADI_I2C_SUCCESS) ||
+               (aSensors[i].nReads != nBefore + 1u) || !Check(aReads[i].aData, aSensors[i]))
+            {
+                nMismatch++;
+            }
+        }
+        Work(nWork);
+    }
+
+    const double fBlocking        = (adi_i2c_bus_SimTime() - nStart) / 1e3 / nLoops;
+    const double fBlockingChanges = (double)(adi_i2c_bus_GetAddressChanges() - nChanges) / nLoops;
+
+    /* Queued reads, the work while the bus runs */
+    nChanges = adi_i2c_bus_GetAddressChanges();
+    nStart   = adi_i2c_bus_SimTime();
+
+    for(uint32_t nLoop = 0u; nLoop < nLoops; nLoop++)
+    {
+        for(uint32_t i = 0u; i < nSensors; i++)
+        {
+            if(adi_i2c_bus_Submit(&aReads[i].sRequest) != ADI_I2C_SUCCESS)
+            {
+                nMismatch++;
+            }
+        }
+
+        /* The simulated bus advances with the clock, as the driver does from its interrupt */
+        for(uint32_t nDone = 0u; nDone < nWork; nDone += nSlice)
+        {
+            Work(((nWork - nDone) < nSlice) ? (nWork - nDone) : nSlice);
+            adi_i2c_bus_Process();
+        }
+
+        while(!adi_i2c_bus_IsIdle())
+        {
+            adi_i2c_bus_Process();
+        }
+
+        for(uint32_t i = 0u; i < nSensors; i++)
+        {
+            if((aReads[i].nDone != nLoop + 1u) || !Check(aReads[i].aData, aSensors[i]))
+            {
+                nMismatch++;
+            }
+        }
+    }
+
+    const double fQueued        = (adi_i2c_bus_SimTime() - nStart) / 1e3 / nLoops;
+    const double fQueuedChanges = (double)(adi_i2c_bus_GetAddressChanges() - nChanges) / nLoops;
+
+    std::printf("%u sensors, %u us of other work in %u us slices, %u loops:\n", nSensors, nWork, nSlice, nLoops);
+    std::printf("  bus time  %8.1f us per loop by the model\n", fModel * nSensors);
+    std::printf("  blocking  %8.1f us per loop, %6.1f us more than the work, %.1f address changes\n",
+                fBlocking, fBlocking - nWork, fBlockingChanges);
+    std::printf("  queued    %8.1f us per loop, %6.1f us more than the work, %.1f address changes\n",
+                fQueued, fQueued - nWork, fQueuedChanges);
+
+    /* A sensor that is not on the bus */
+    {
+        Read     sMissing;
+        uint32_t nHwErrors = 0u;
+
+        Setup(sMissing, 0x4Cu);
+        if((adi_i2c_bus_ReadWrite(0x4Cu, &sMissing.sRequest.sTransaction, &nHwErrors) != ADI_I2C_HW_ERROR_DETECTED) ||
+           (nHwErrors != ADI_I2C_HW_ERROR_NACK_ADDR))
+        {
+            nMismatch++;
+        }
+    }
+
+    (void) adi_i2c_bus_Close();
+
+    std::printf("%s, %u mismatches\n", (nMismatch == 0u) ? "PASS" : "FAIL", nMismatch);
+
+    return (nMismatch == 0u) ? 0 : 1;
+}
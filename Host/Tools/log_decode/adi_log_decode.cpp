@@ -0,0 +1,386 @@
+/*!
+ *****************************************************************************
+  @file adi_log_decode.cpp
+
+  @brief Decoder for deferred log records.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+/*
+ * Rebuilds the text of ADI_LOG_DEFERRED() records. The format strings are
+ * read from the adi_log_fmt section of the application ELF file, %s arguments
+ * are resolved against any other allocated section of the same file.
+ *
+ *   adi_log_decode app.dxe [capture.bin|-]
+ *   adi_log_decode --dump app.dxe
+ *
+ * Bytes that are not part of a valid record are copied to the output
+ * unchanged, so text printed with adi_log_Printf() may be mixed in.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+namespace {
+
+const uint8_t  kRecordSync     = 0xA5u;     /* ADI_LOG_RECORD_SYNC        */
+const size_t   kRecordHeader   = 4u;        /* ADI_LOG_RECORD_HEADER_SIZE */
+const uint32_t kMaxArgs        = 8u;        /* ADI_LOG_MAX_DEFERRED_ARGS  */
+const char    *kFormatSection  = "adi_log_fmt";
+
+struct Section
+{
+    std::string          name;
+    uint64_t             addr;
+    std::vector<uint8_t> data;
+};
+
+template <typename T>
+T ReadLE(const uint8_t *p)
+{
+    T v = 0;
+    for(size_t i = 0; i < sizeof(T); i++) {
+        v |= static_cast<T>(p[i]) << (8u * i);
+    }
+    return v;
+}
+
+/* Loads the allocated PROGBITS sections of a little-endian ELF32/ELF64 file */
+bool LoadElf(const char *pPath, std::vector<Section> &sections)
+{
+    std::ifstream file(pPath, std::ios::binary);
+    std::vector<uint8_t> img((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if((img.size() < 52u) || (memcmp(img.data(), "\x7F" "ELF", 4u) != 0) || (img[5] != 1u)) {
+        return false;
+    }
+
+    const bool     b64      = (img[4] == 2u);
+    const uint64_t nShOff   = b64 ? ReadLE<uint64_t>(&img[0x28]) : ReadLE<uint32_t>(&img[0x20]);
+    const uint16_t nShSize  = ReadLE<uint16_t>(&img[b64 ? 0x3A : 0x2E]);
+    const uint16_t nShNum   = ReadLE<uint16_t>(&img[b64 ? 0x3C : 0x30]);
+    const uint16_t nShStr   = ReadLE<uint16_t>(&img[b64 ? 0x3E : 0x32]);
+
+    if((nShOff + static_cast<uint64_t>(nShSize) * nShNum) > img.size() || (nShStr >= nShNum)) {
+        return false;
+    }
+
+    struct Header { uint32_t name, type; uint64_t flags, addr, offset, size; };
+    std::vector<Header> headers(nShNum);
+    for(uint16_t i = 0; i < nShNum; i++) {
+        const uint8_t *p = &img[nShOff + static_cast<uint64_t>(i) * nShSize];
+        Header &h = headers[i];
+        h.name = ReadLE<uint32_t>(p);
+        h.type = ReadLE<uint32_t>(p + 4);
+        if(b64) {
+            h.flags  = ReadLE<uint64_t>(p + 0x08);
+            h.addr   = ReadLE<uint64_t>(p + 0x10);
+            h.offset = ReadLE<uint64_t>(p + 0x18);
+            h.size   = ReadLE<uint64_t>(p + 0x20);
+        } else {
+            h.flags  = ReadLE<uint32_t>(p + 0x08);
+            h.addr   = ReadLE<uint32_t>(p + 0x0C);
+            h.offset = ReadLE<uint32_t>(p + 0x10);
+            h.size   = ReadLE<uint32_t>(p + 0x14);
+        }
+    }
+
+    const Header &strtab = headers[nShStr];
+    for(const Header &h : headers) {
+        const uint32_t kProgBits = 1u;
+        const uint64_t kAlloc    = 2u;
+        if((h.type != kProgBits) || ((h.flags & kAlloc) == 0u) || ((h.offset + h.size) > img.size())) {
+            continue;
+        }
+        Section s;
+        const char *pName = reinterpret_cast<const char *>(&img[strtab.offset + h.name]);
+        s.name.assign(pName, strnlen(pName, img.size() - (strtab.offset + h.name)));
+        s.addr = h.addr;
+        s.data.assign(img.begin() + h.offset, img.begin() + h.offset + h.size);
+        sections.push_back(s);
+    }
+    return true;
+}
+
+class Decoder
+{
+public:
+    Decoder(const std::vector<Section> &sections) : m_sections(sections), m_pFormats(nullptr)
+    {
+        for(const Section &s : m_sections) {
+            if(s.name == kFormatSection) {
+                m_pFormats = &s;
+            }
+        }
+    }
+
+    bool HasFormats() const { return (m_pFormats != nullptr) && !m_pFormats->data.empty(); }
+
+    /* Prints every format string with its record ID */
+    void Dump(FILE *pOut) const
+    {
+        const std::vector<uint8_t> &d = m_pFormats->data;
+        for(size_t nId = 0; nId < d.size(); ) {
+            const char *pFmt = reinterpret_cast<const char *>(&d[nId]);
+            size_t nLen = strnlen(pFmt, d.size() - nId);
+            if(nLen == 0u) {
+                nId++;
+                continue;
+            }
+            fprintf(pOut, "%5zu: \"", nId);
+            for(size_t i = 0; i < nLen; i++) {
+                const char c = pFmt[i];
+                if(c == '\n')      { fputs("\\n", pOut); }
+                else if(c == '\r') { fputs("\\r", pOut); }
+                else if(c == '\t') { fputs("\\t", pOut); }
+                else               { fputc(c, pOut); }
+            }
+            fputs("\"\n", pOut);
+            nId += nLen + 1u;
+        }
+    }
+
+    /* Decodes as much of the buffer as possible, returns the bytes consumed */
+    size_t Feed(const uint8_t *pData, size_t nSize, std::string &out) const
+    {
+        size_t i = 0;
+        while(i < nSize) {
+            if(pData[i] != kRecordSync) {
+                out.push_back(static_cast<char>(pData[i++]));
+                continue;
+            }
+            if((nSize - i) < kRecordHeader) {
+                break;
+            }
+            const uint32_t nArgs = pData[i + 1];
+            const uint32_t nId   = ReadLE<uint16_t>(&pData[i + 2]);
+            if(!IsFormatStart(nId) || (nArgs > kMaxArgs)) {
+                out.push_back(static_cast<char>(pData[i++]));
+                continue;
+            }
+            const size_t nRecord = kRecordHeader + (nArgs * 4u);
+            if((nSize - i) < nRecord) {
+                break;
+            }
+            uint32_t aArgs[kMaxArgs];
+            for(uint32_t n = 0; n < nArgs; n++) {
+                aArgs[n] = ReadLE<uint32_t>(&pData[i + kRecordHeader + (n * 4u)]);
+            }
+            Format(reinterpret_cast<const char *>(&m_pFormats->data[nId]), aArgs, nArgs, out);
+            i += nRecord;
+        }
+        return i;
+    }
+
+private:
+    bool IsFormatStart(uint32_t nId) const
+    {
+        const std::vector<uint8_t> &d = m_pFormats->data;
+        return (nId < d.size()) && ((nId == 0u) || (d[nId - 1u] == 0u));
+    }
+
+    /* Returns the NUL terminated string at a target address, if it is in the image */
+    bool LookupString(uint32_t nAddr, std::string &str) const
+    {
+        for(const Section &s : m_sections) {
+            if((nAddr >= s.addr) && (nAddr < (s.addr + s.data.size()))) {
+                const char *p = reinterpret_cast<const char *>(&s.data[nAddr - s.addr]);
+                str.assign(p, strnlen(p, s.data.size() - (nAddr - s.addr)));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Format(const char *pFmt, const uint32_t *pArgs, uint32_t nArgs, std::string &out) const
+    {
+        uint32_t nArg = 0;
+        char aText[512];
+
+        auto nextArg = [&]() -> uint32_t { return (nArg < nArgs) ? pArgs[nArg++] : 0u; };
+
+        while(*pFmt != '\0') {
+            if(*pFmt != '%') {
+                out.push_back(*pFmt++);
+                continue;
+            }
+            if(pFmt[1] == '%') {
+                out.push_back('%');
+                pFmt += 2;
+                continue;
+            }
+
+            /* Rebuild the conversion without length modifiers, all arguments are 32-bit */
+            std::string spec("%");
+            const char *p = pFmt + 1;
+            while((*p != '\0') && (strchr("-+ #0", *p) != nullptr)) { spec.push_back(*p++); }
+            if(*p == '*') { spec += std::to_string(static_cast<int32_t>(nextArg())); p++; }
+            while((*p >= '0') && (*p <= '9')) { spec.push_back(*p++); }
+            if(*p == '.') {
+                spec.push_back(*p++);
+                if(*p == '*') { spec += std::to_string(static_cast<int32_t>(nextArg())); p++; }
+                while((*p >= '0') && (*p <= '9')) { spec.push_back(*p++); }
+            }
+            while((*p != '\0') && (strchr("hlLqjzt", *p) != nullptr)) { p++; }
+            if(*p == '\0') {
+                break;
+            }
+
+            const char conv = *p++;
+            spec.push_back(conv);
+            const uint32_t nValue = nextArg();
+
+            switch(conv) {
+            case 'd': case 'i':
+                snprintf(aText, sizeof(aText), spec.c_str(), static_cast<int32_t>(nValue));
+                break;
+            case 'u': case 'x': case 'X': case 'o': case 'c':
+                snprintf(aText, sizeof(aText), spec.c_str(), nValue);
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+                float fValue;
+                memcpy(&fValue, &nValue, sizeof(fValue));
+                snprintf(aText, sizeof(aText), spec.c_str(), static_cast<double>(fValue));
+                break;
+            }
+            case 's': {
+                std::string str;
+                if(!LookupString(nValue, str)) {
+                    snprintf(aText, sizeof(aText), "<0x%08X>", nValue);
+                    str = aText;
+                }
+                snprintf(aText, sizeof(aText), spec.c_str(), str.c_str());
+                break;
+            }
+            case 'p':
+                snprintf(aText, sizeof(aText), "0x%08X", nValue);
+                break;
+            default:
+                snprintf(aText, sizeof(aText), "<%%%c?>", conv);
+                break;
+            }
+            out += aText;
+            pFmt = p;
+        }
+    }
+
+    const std::vector<Section> &m_sections;
+    const Section              *m_pFormats;
+};
+
+void Usage(void)
+{
+    fprintf(stderr, "usage: adi_log_decode <app.elf> [capture.bin|-]\n"
+                    "       adi_log_decode --dump <app.elf>\n");
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    bool bDump = false;
+    int  nArg  = 1;
+
+    if((argc > 1) && (strcmp(argv[1], "--dump") == 0)) {
+        bDump = true;
+        nArg++;
+    }
+    if(nArg >= argc) {
+        Usage();
+        return 2;
+    }
+
+    std::vector<Section> sections;
+    if(!LoadElf(argv[nArg], sections)) {
+        fprintf(stderr, "adi_log_decode: %s is not a little-endian ELF file\n", argv[nArg]);
+        return 1;
+    }
+
+    Decoder decoder(sections);
+    if(!decoder.HasFormats()) {
+        fprintf(stderr, "adi_log_decode: %s has no %s section\n", argv[nArg], kFormatSection);
+        return 1;
+    }
+    if(bDump) {
+        decoder.Dump(stdout);
+        return 0;
+    }
+
+    FILE *pIn = stdin;
+    if(((nArg + 1) < argc) && (strcmp(argv[nArg + 1], "-") != 0)) {
+        if((pIn = fopen(argv[nArg + 1], "rb")) == nullptr) {
+            perror(argv[nArg + 1]);
+            return 1;
+        }
+    }
+
+    /* Read in chunks so a live serial port can be piped in */
+    std::vector<uint8_t> pending;
+    std::string          text;
+    uint8_t              aChunk[4096];
+
+    ssize_t              nRead;
+
+    while((nRead = read(fileno(pIn), aChunk, sizeof(aChunk))) > 0) {
+        pending.insert(pending.end(), aChunk, aChunk + static_cast<size_t>(nRead));
+        const size_t nUsed = decoder.Feed(pending.data(), pending.size(), text);
+        pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(nUsed));
+        fwrite(text.data(), 1u, text.size(), stdout);
+        fflush(stdout);
+        text.clear();
+    }
+
+    /* A truncated record at the end of the capture is shown as raw bytes */
+    fwrite(pending.data(), 1u, pending.size(), stdout);
+
+    if(pIn != stdin) {
+        fclose(pIn);
+    }
+    return 0;
+}
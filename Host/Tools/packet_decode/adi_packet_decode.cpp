@@ -0,0 +1,439 @@
+/*!
+ *****************************************************************************
+  @file adi_packet_decode.cpp
+
+  @brief Decodes and summarizes captured packet streams.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+/*
+ * Decodes files of back to back 20-byte packets, as written by adi_stream_rx
+ * or by a BLE capture, and prints per sensor statistics. Files are decoded in
+ * parallel, one file per worker thread.
+ *
+ *   adi_packet_decode [-j threads] [-c csv_dir] [-u] [-q] <file>...
+ *
+ *   -j  number of worker threads (default: number of CPUs)
+ *   -c  also write every sample to <csv_dir>/<file>.csv
+ *   -u  convert accelerometer counts to mg
+ *   -q  only print the totals
+ */
+
+#include <adi_packet_decoder.h>
+#include <base_sensor/adi_sensor_convert.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace adi_sensor_swpack;
+
+namespace {
+
+/* Packets decoded per call, bounds the size of the sample buffer */
+const size_t kChunkPackets = 65536u;
+
+struct FieldStats
+{
+    uint64_t nCount;
+    uint8_t  nKey;
+    double   fMin;
+    double   fMax;
+    double   fSum;
+    uint32_t nFirstTime;
+    uint32_t nLastTime;
+};
+
+/* Statistics of one sensor ID and type, one entry per payload field */
+struct SensorStats
+{
+    FieldStats aField[ADI_PACKET_MAX_DATA_TYPES];
+};
+
+struct FileResult
+{
+    std::string                      path;
+    bool                             bOk;
+    uint64_t                         nBytes;
+    uint64_t                         nTrailing;
+    ADI_PACKET_STATS                 sStats;
+    std::map<uint16_t, SensorStats>  sensors;   /* key: (id << 8) | type */
+};
+
+/* Gather buffers of the accelerometer fields of a chunk, one per range */
+struct UnitScratch
+{
+    std::vector<size_t>  index[3];
+    std::vector<int16_t> raw[3];
+    std::vector<float>   value;
+};
+
+/*
+ * Replaces the raw accelerometer counts of a chunk by mg. The counts of each range are
+ * gathered into one array so the conversion runs as a single vectorizable kernel.
+ */
+void ConvertUnits(std::vector<ADI_PACKET_SAMPLE> &samples, UnitScratch &scratch)
+{
+    for(uint32_t r = 0u; r < 3u; r++) {
+        scratch.index[r].clear();
+        scratch.raw[r].clear();
+    }
+
+    for(size_t i = 0u; i < samples.size(); i++) {
+        const ADI_PACKET_SAMPLE &s = samples[i];
+        uint32_t                 r;
+
+        switch(s.nSensorType) {
+        case ADI_ACCELEROMETER_2G_TYPE: r = 0u; break;
+        case ADI_ACCELEROMETER_4G_TYPE: r = 1u; break;
+        case ADI_ACCELEROMETER_8G_TYPE: r = 2u; break;
+        default: continue;
+        }
+        if(s.nKey == ADI_SHORT_TYPE) {
+            scratch.index[r].push_back(i);
+            scratch.raw[r].push_back(static_cast<int16_t>(s.uValue.nInteger));
+        }
+    }
+
+    for(uint32_t r = 0u; r < 3u; r++) {
+        const uint32_t nCount = static_cast<uint32_t>(scratch.raw[r].size());
+
+        scratch.value.resize(nCount);
+        switch(r) {
+        case 0u: AxlConvert<0u>::toMilliG(scratch.raw[r].data(), scratch.value.data(), nCount); break;
+        case 1u: AxlConvert<1u>::toMilliG(scratch.raw[r].data(), scratch.value.data(), nCount); break;
+        default: AxlConvert<2u>::toMilliG(scratch.raw[r].data(), scratch.value.data(), nCount); break;
+        }
+        for(uint32_t i = 0u; i < nCount; i++) {
+            ADI_PACKET_SAMPLE &s = samples[scratch.index[r][i]];
+            s.nKey         = ADI_FLOAT_TYPE;
+            s.uValue.fReal = scratch.value[i];
+        }
+    }
+}
+
+inline double SampleValue(const ADI_PACKET_SAMPLE &s)
+{
+    return ((s.nKey == ADI_FLOAT_TYPE) || (s.nKey == ADI_DOUBLE_TYPE)) ? s.uValue.fReal
+                                                                       : static_cast<double>(s.uValue.nInteger);
+}
+
+void Accumulate(FieldStats &f, uint8_t nKey, double fValue, uint32_t nTime)
+{
+    if(f.nCount == 0u) {
+        f.nKey       = nKey;
+        f.fMin       = fValue;
+        f.fMax       = fValue;
+        f.nFirstTime = nTime;
+    }
+    f.nCount++;
+    f.fMin      = std::min(f.fMin, fValue);
+    f.fMax      = std::max(f.fMax, fValue);
+    f.fSum     += fValue;
+    f.nLastTime = nTime;
+}
+
+void Merge(FieldStats &dst, const FieldStats &src)
+{
+    if(src.nCount == 0u) {
+        return;
+    }
+    if(dst.nCount == 0u) {
+        dst = src;
+        return;
+    }
+    dst.nCount   += src.nCount;
+    dst.fMin      = std::min(dst.fMin, src.fMin);
+    dst.fMax      = std::max(dst.fMax, src.fMax);
+    dst.fSum     += src.fSum;
+    dst.nLastTime = src.nLastTime;
+}
+
+void WriteCsv(FILE *pCsv, const std::vector<ADI_PACKET_SAMPLE> &samples)
+{
+    for(const ADI_PACKET_SAMPLE &s : samples) {
+        if((s.nKey == ADI_FLOAT_TYPE) || (s.nKey == ADI_DOUBLE_TYPE)) {
+            fprintf(pCsv, "%u,%u,%u,%u,%.9g\n", s.nTimestamp, s.nSensorId, s.nSensorType, s.nField, s.uValue.fReal);
+        } else {
+            fprintf(pCsv, "%u,%u,%u,%u,%" PRId64 "\n", s.nTimestamp, s.nSensorId, s.nSensorType, s.nField, s.uValue.nInteger);
+        }
+    }
+}
+
+void DecodeFile(FileResult &result, const char *pCsvDir, bool bUnits)
+{
+    PacketDecoder                  decoder;
+    std::vector<ADI_PACKET_SAMPLE> samples;
+    UnitScratch                    scratch;
+    FILE                          *pCsv = nullptr;
+    struct stat                    st;
+
+    result.bOk = false;
+
+    const int fd = open(result.path.c_str(), O_RDONLY);
+    if(fd < 0) {
+        perror(result.path.c_str());
+        return;
+    }
+    if(fstat(fd, &st) != 0) {
+        perror(result.path.c_str());
+        close(fd);
+        return;
+    }
+
+    result.nBytes = static_cast<uint64_t>(st.st_size);
+    const uint8_t *pData = nullptr;
+    if(result.nBytes > 0u) {
+        void *pMap = mmap(nullptr, result.nBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(pMap == MAP_FAILED) {
+            perror(result.path.c_str());
+            close(fd);
+            return;
+        }
+        madvise(pMap, result.nBytes, MADV_SEQUENTIAL);
+        pData = static_cast<const uint8_t *>(pMap);
+    }
+    close(fd);
+
+    if(pCsvDir != nullptr) {
+        const size_t      nSlash = result.path.find_last_of('/');
+        const std::string name   = std::string(pCsvDir) + "/" +
+                                   ((nSlash == std::string::npos) ? result.path : result.path.substr(nSlash + 1u)) + ".csv";
+        if((pCsv = fopen(name.c_str(), "w")) == nullptr) {
+            perror(name.c_str());
+        } else {
+            setvbuf(pCsv, nullptr, _IOFBF, 1u << 20);
+            fputs("timestamp,id,type,field,value\n", pCsv);
+        }
+    }
+
+    samples.reserve(kChunkPackets * 3u);
+
+    SensorStats *pLast    = nullptr;
+    uint16_t     nLastKey = 0xFFFFu;
+    size_t       nOffset  = 0u;
+
+    while((result.nBytes - nOffset) >= ADI_PACKET_WIRE_SIZE) {
+        const size_t nChunk = std::min<size_t>(result.nBytes - nOffset, kChunkPackets * ADI_PACKET_WIRE_SIZE);
+
+        samples.clear();
+        nOffset += decoder.decode(&pData[nOffset], nChunk, samples);
+        if(bUnits) {
+            ConvertUnits(samples, scratch);
+        }
+
+        for(const ADI_PACKET_SAMPLE &s : samples) {
+            const uint16_t nKey = static_cast<uint16_t>((s.nSensorId << 8) | s.nSensorType);
+            if(nKey != nLastKey) {
+                pLast    = &result.sensors[nKey];
+                nLastKey = nKey;
+            }
+            Accumulate(pLast->aField[s.nField], s.nKey, SampleValue(s), s.nTimestamp);
+        }
+        if(pCsv != nullptr) {
+            WriteCsv(pCsv, samples);
+        }
+    }
+
+    if(pCsv != nullptr) {
+        fclose(pCsv);
+    }
+    if(pData != nullptr) {
+        munmap(const_cast<uint8_t *>(pData), result.nBytes);
+    }
+
+    result.nTrailing = result.nBytes - nOffset;
+    result.sStats    = decoder.getStats();
+    result.bOk       = true;
+}
+
+const char *KeyName(uint8_t nKey)
+{
+    static const char *const names[] = { "byte", "short", "int", "long", "float", "double", "char" };
+    return (nKey < (sizeof(names) / sizeof(names[0]))) ? names[nKey] : "?";
+}
+
+void PrintSensors(const std::map<uint16_t, SensorStats> &sensors)
+{
+    printf("  %3s %4s %5s %-6s %12s %14s %14s %14s %10s %10s\n",
+           "id", "type", "field", "key", "count", "min", "max", "mean", "first", "last");
+    for(const auto &entry : sensors) {
+        for(uint32_t i = 0u; i < ADI_PACKET_MAX_DATA_TYPES; i++) {
+            const FieldStats &f = entry.second.aField[i];
+            if(f.nCount == 0u) {
+                continue;
+            }
+            printf("  %3u 0x%02X %5u %-6s %12" PRIu64 " %14.6g %14.6g %14.6g %10u %10u\n",
+                   entry.first >> 8, entry.first & 0xFFu, i, KeyName(f.nKey), f.nCount,
+                   f.fMin, f.fMax, f.fSum / static_cast<double>(f.nCount), f.nFirstTime, f.nLastTime);
+        }
+    }
+}
+
+void PrintStats(const ADI_PACKET_STATS &s, uint64_t nTrailing)
+{
+    printf("  packets %" PRIu64 ", data %" PRIu64 ", registrations %" PRIu64 ", strings %" PRIu64
+           ", samples %" PRIu64 "\n", s.nPackets, s.nDataPackets, s.nRegistrations, s.nStrings, s.nSamples);
+    if((s.nUnregistered | s.nBadRegistrations | s.nTypeMismatches | nTrailing) != 0u) {
+        printf("  unregistered %" PRIu64 ", bad registrations %" PRIu64 ", type mismatches %" PRIu64
+               ", trailing bytes %" PRIu64 "\n", s.nUnregistered, s.nBadRegistrations, s.nTypeMismatches, nTrailing);
+    }
+}
+
+void Usage(void)
+{
+    fprintf(stderr, "usage: adi_packet_decode [-j threads] [-c csv_dir] [-u] [-q] <file>...\n"
+                    "  -j  number of worker threads (default: number of CPUs)\n"
+                    "  -c  also write every sample to <csv_dir>/<file>.csv\n"
+                    "  -u  convert accelerometer counts to mg\n"
+                    "  -q  only print the totals\n");
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned    nThreads = std::max(1u, std::thread::hardware_concurrency());
+    const char *pCsvDir  = nullptr;
+    bool        bQuiet   = false;
+    bool        bUnits   = false;
+    int         opt;
+
+    while((opt = getopt(argc, argv, "j:c:uq")) != -1) {
+        switch(opt) {
+        case 'j': nThreads = static_cast<unsigned>(std::max(1l, strtol(optarg, nullptr, 10))); break;
+        case 'c': pCsvDir  = optarg; break;
+        case 'u': bUnits   = true; break;
+        case 'q': bQuiet   = true; break;
+        default:  Usage(); return 2;
+        }
+    }
+    if(optind >= argc) {
+        Usage();
+        return 2;
+    }
+
+    std::vector<FileResult> results(static_cast<size_t>(argc - optind));
+    for(size_t i = 0u; i < results.size(); i++) {
+        results[i].path = argv[optind + static_cast<int>(i)];
+    }
+
+    /* Files are handed out one at a time, a large file does not hold up the others */
+    std::atomic<size_t>      nNext(0u);
+    std::vector<std::thread> workers;
+    const auto               tStart = std::chrono::steady_clock::now();
+
+    nThreads = std::min<unsigned>(nThreads, static_cast<unsigned>(results.size()));
+    for(unsigned t = 0u; t < nThreads; t++) {
+        workers.emplace_back([&]() {
+            size_t i;
+            while((i = nNext.fetch_add(1u)) < results.size()) {
+                DecodeFile(results[i], pCsvDir, bUnits);
+            }
+        });
+    }
+    for(std::thread &worker : workers) {
+        worker.join();
+    }
+
+    const double fSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+
+    std::map<uint16_t, SensorStats> total;
+    ADI_PACKET_STATS                sTotal = {};
+    uint64_t                        nBytes = 0u;
+    uint64_t                        nTrailing = 0u;
+    int                             nStatus = 0;
+
+    for(const FileResult &r : results) {
+        if(!r.bOk) {
+            nStatus = 1;
+            continue;
+        }
+        if(!bQuiet) {
+            printf("%s\n", r.path.c_str());
+            PrintStats(r.sStats, r.nTrailing);
+            PrintSensors(r.sensors);
+        }
+        for(const auto &entry : r.sensors) {
+            SensorStats &dst = total[entry.first];
+            for(uint32_t i = 0u; i < ADI_PACKET_MAX_DATA_TYPES; i++) {
+                Merge(dst.aField[i], entry.second.aField[i]);
+            }
+        }
+        sTotal.nPackets          += r.sStats.nPackets;
+        sTotal.nDataPackets      += r.sStats.nDataPackets;
+        sTotal.nRegistrations    += r.sStats.nRegistrations;
+        sTotal.nStrings          += r.sStats.nStrings;
+        sTotal.nSamples          += r.sStats.nSamples;
+        sTotal.nUnregistered     += r.sStats.nUnregistered;
+        sTotal.nBadRegistrations += r.sStats.nBadRegistrations;
+        sTotal.nTypeMismatches   += r.sStats.nTypeMismatches;
+        nBytes                   += r.nBytes;
+        nTrailing                += r.nTrailing;
+    }
+
+    if(results.size() > 1u || bQuiet) {
+        printf("total (%zu files)\n", results.size());
+        PrintStats(sTotal, nTrailing);
+        PrintSensors(total);
+    }
+
+    fprintf(stderr, "%" PRIu64 " packets, %.1f MB in %.3f s (%.2f Mpackets/s, %u threads)\n",
+            sTotal.nPackets, static_cast<double>(nBytes) / 1e6, fSeconds,
+            (fSeconds > 0.0) ? (static_cast<double>(sTotal.nPackets) / fSeconds / 1e6) : 0.0, nThreads);
+    return nStatus;
+}
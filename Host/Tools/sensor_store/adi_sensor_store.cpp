@@ -0,0 +1,266 @@
+/*!
+ *****************************************************************************
+  @file adi_sensor_store.cpp
+
+  @brief Builds and queries columnar sensor stores.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+/*
+ *   adi_sensor_store build <store> <capture>...
+ *   adi_sensor_store info  <store>
+ *   adi_sensor_store scan  <store> <id> <type> <field> [start [end]] [-p]
+ *
+ * build decodes packet captures (see adi_packet_decode), in the order given,
+ * into a new store. info lists the series of a store. scan reads the samples
+ * of one series within a time range and prints their statistics, or every
+ * sample with -p.
+ */
+
+#include <adi_packet_decoder.h>
+#include <adi_sensor_store.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace adi_sensor_swpack;
+
+namespace {
+
+int Build(const char *pStore, char **ppFiles, int nFiles)
+{
+    StoreWriter                    writer;
+    PacketDecoder                  decoder;
+    std::vector<ADI_PACKET_SAMPLE> samples;
+    std::vector<uint8_t>           buffer(ADI_PACKET_WIRE_SIZE * 65536u);
+
+    if(!writer.open(pStore)) {
+        perror(pStore);
+        return 1;
+    }
+
+    for(int f = 0; f < nFiles; f++) {
+        FILE *pFile = fopen(ppFiles[f], "rb");
+        if(pFile == nullptr) {
+            perror(ppFiles[f]);
+            writer.close();
+            return 1;
+        }
+
+        /* Registrations do not carry over, every capture starts on the defaults */
+        decoder.reset(true);
+
+        size_t nHave = 0u;
+        size_t nRead;
+        while((nRead = fread(&buffer[nHave], 1u, buffer.size() - nHave, pFile)) > 0u) {
+            nHave += nRead;
+            samples.clear();
+            const size_t nUsed = decoder.decode(buffer.data(), nHave, samples);
+            memmove(buffer.data(), &buffer[nUsed], nHave - nUsed);
+            nHave -= nUsed;
+            if(!writer.append(samples.data(), samples.size())) {
+                fprintf(stderr, "adi_sensor_store: write error on %s\n", pStore);
+                fclose(pFile);
+                writer.close();
+                return 1;
+            }
+        }
+        fclose(pFile);
+
+        const ADI_PACKET_STATS &s = decoder.getStats();
+        fprintf(stderr, "%s: %" PRIu64 " packets, %" PRIu64 " samples, %zu trailing bytes\n",
+                ppFiles[f], s.nPackets, s.nSamples, nHave);
+    }
+
+    if(!writer.close()) {
+        fprintf(stderr, "adi_sensor_store: write error on %s\n", pStore);
+        return 1;
+    }
+    return 0;
+}
+
+int Info(const StoreReader &reader)
+{
+    printf("%6s %3s %4s %5s %4s %12s %8s %20s %20s\n", "series", "id", "type", "field", "key", "samples", "blocks", "first", "last");
+    for(uint32_t i = 0u; i < reader.getNumSeries(); i++) {
+        const ADI_STORE_SERIES &s = reader.getSeries(i);
+        const uint64_t nFirst = (s.nNumBlocks > 0u) ? reader.getBlock(i, 0u).nFirstTime : 0u;
+        const uint64_t nLast  = (s.nNumBlocks > 0u) ? reader.getBlock(i, s.nNumBlocks - 1u).nLastTime : 0u;
+
+        printf("%6u %3u 0x%02X %5u %4u %12" PRIu64 " %8u %20" PRIu64 " %20" PRIu64 "\n",
+               i, s.nSensorId, s.nSensorType, s.nField, s.nKey, s.nNumSamples, s.nNumBlocks, nFirst, nLast);
+    }
+    return 0;
+}
+
+struct ScanResult
+{
+    uint64_t nCount;
+    uint64_t nBytes;
+    double   fMin;
+    double   fMax;
+    double   fSum;
+};
+
+template <typename T>
+void ScanColumns(const ADI_STORE_COLUMNS &c, uint64_t nStart, uint64_t nEnd, bool bPrint, ScanResult &r)
+{
+    const T *pValues = static_cast<const T *>(c.pValues);
+
+    /* Only the first and last block of a range are partial, trim them by search */
+    const uint64_t *pBegin = std::lower_bound(c.pTime, c.pTime + c.nNumSamples, nStart);
+    const uint64_t *pEnd   = std::upper_bound(pBegin, c.pTime + c.nNumSamples, nEnd);
+
+    for(const uint64_t *p = pBegin; p < pEnd; p++) {
+        const double fValue = static_cast<double>(pValues[p - c.pTime]);
+        if(bPrint) {
+            printf("%" PRIu64 ",%.9g\n", *p, fValue);
+        }
+        r.fMin  = std::min(r.fMin, fValue);
+        r.fMax  = std::max(r.fMax, fValue);
+        r.fSum += fValue;
+    }
+    r.nCount += static_cast<uint64_t>(pEnd - pBegin);
+    r.nBytes += static_cast<uint64_t>(pEnd - pBegin) * (sizeof(uint64_t) + sizeof(T));
+}
+
+int Scan(const StoreReader &reader, int argc, char **argv)
+{
+    bool     bPrint = false;
+    uint64_t aArg[5] = { 0u, 0u, 0u, 0u, std::numeric_limits<uint64_t>::max() };
+    int      nArgs = 0;
+
+    for(int i = 0; i < argc; i++) {
+        if(strcmp(argv[i], "-p") == 0) {
+            bPrint = true;
+        } else if(nArgs < 5) {
+            aArg[nArgs++] = strtoull(argv[i], nullptr, 0);
+        }
+    }
+    if(nArgs < 3) {
+        fprintf(stderr, "adi_sensor_store: scan needs <id> <type> <field>\n");
+        return 2;
+    }
+
+    const int32_t nSeries = reader.findSeries(static_cast<uint8_t>(aArg[0]), static_cast<uint8_t>(aArg[1]), static_cast<uint8_t>(aArg[2]));
+    if(nSeries < 0) {
+        fprintf(stderr, "adi_sensor_store: no such series\n");
+        return 1;
+    }
+
+    const ADI_STORE_SERIES &s = reader.getSeries(static_cast<uint32_t>(nSeries));
+    ScanResult              r = { 0u, 0u, std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(), 0.0 };
+    uint32_t                nFirst;
+    const auto              tStart = std::chrono::steady_clock::now();
+    const uint32_t          nBlocks = reader.findBlocks(static_cast<uint32_t>(nSeries), aArg[3], aArg[4], nFirst);
+
+    for(uint32_t b = nFirst; b < (nFirst + nBlocks); b++) {
+        const ADI_STORE_COLUMNS c = reader.getColumns(static_cast<uint32_t>(nSeries), b);
+        switch(s.nKey) {
+        case ADI_BYTE_TYPE:
+        case ADI_CHAR_TYPE:   ScanColumns<int8_t>(c, aArg[3], aArg[4], bPrint, r);  break;
+        case ADI_SHORT_TYPE:  ScanColumns<int16_t>(c, aArg[3], aArg[4], bPrint, r); break;
+        case ADI_INT_TYPE:    ScanColumns<int32_t>(c, aArg[3], aArg[4], bPrint, r); break;
+        case ADI_LONG_TYPE:   ScanColumns<int64_t>(c, aArg[3], aArg[4], bPrint, r); break;
+        case ADI_FLOAT_TYPE:  ScanColumns<float>(c, aArg[3], aArg[4], bPrint, r);   break;
+        default:              ScanColumns<double>(c, aArg[3], aArg[4], bPrint, r);  break;
+        }
+    }
+
+    const double fSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+
+    if(r.nCount == 0u) {
+        printf("no samples in range\n");
+    } else {
+        printf("samples %" PRIu64 ", min %.9g, max %.9g, mean %.9g\n", r.nCount, r.fMin, r.fMax, r.fSum / static_cast<double>(r.nCount));
+    }
+    fprintf(stderr, "%u blocks, %.1f MB in %.3f s (%.0f MB/s)\n", nBlocks, static_cast<double>(r.nBytes) / 1e6, fSeconds,
+            (fSeconds > 0.0) ? (static_cast<double>(r.nBytes) / fSeconds / 1e6) : 0.0);
+    return 0;
+}
+
+void Usage(void)
+{
+    fprintf(stderr, "usage: adi_sensor_store build <store> <capture>...\n"
+                    "       adi_sensor_store info  <store>\n"
+                    "       adi_sensor_store scan  <store> <id> <type> <field> [start [end]] [-p]\n");
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc < 3) {
+        Usage();
+        return 2;
+    }
+
+    if(strcmp(argv[1], "build") == 0) {
+        if(argc < 4) {
+            Usage();
+            return 2;
+        }
+        return Build(argv[2], &argv[3], argc - 3);
+    }
+
+    StoreReader reader;
+    if(!reader.open(argv[2])) {
+        fprintf(stderr, "adi_sensor_store: %s is not a valid store\n", argv[2]);
+        return 1;
+    }
+
+    if(strcmp(argv[1], "info") == 0) {
+        return Info(reader);
+    }
+    if(strcmp(argv[1], "scan") == 0) {
+        return Scan(reader, argc - 3, &argv[3]);
+    }
+    Usage();
+    return 2;
+}
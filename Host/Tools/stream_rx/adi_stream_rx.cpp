@@ -0,0 +1,306 @@
+/*!
+ *****************************************************************************
+  @file adi_stream_rx.cpp
+
+  @brief Linux receiver for the framed packet stream.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+/*
+ * Receives the frames produced by adi_stream_Send() from a serial port, a
+ * capture file or stdin, checks them and writes the bare packets out back to
+ * back, which is the format read by the packet decoder.
+ *
+ *   adi_stream_rx [-b baud] [-o packets.bin] [-t] [-q] <tty|file|->
+ *
+ *   -b  baud rate when the input is a serial port (default 115200)
+ *   -o  write the packets to a file
+ *   -t  print one line per packet on stdout
+ *   -q  do not print the statistics on exit
+ */
+
+/* The firmware headers are shared with the target, select their host variant */
+#ifndef ADI_LOG_HOST
+#define ADI_LOG_HOST
+#endif
+#include <common/adi_stream.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace {
+
+volatile sig_atomic_t gbStop = 0;
+
+struct Stats
+{
+    uint64_t nFrames;
+    uint64_t nBytes;
+    uint64_t nCobsErrors;
+    uint64_t nCrcErrors;
+    uint64_t nShortFrames;
+    uint64_t nLostFrames;
+};
+
+void OnSignal(int)
+{
+    gbStop = 1;
+}
+
+speed_t BaudToSpeed(long nBaud)
+{
+    switch(nBaud) {
+    case 9600:    return B9600;
+    case 19200:   return B19200;
+    case 38400:   return B38400;
+    case 57600:   return B57600;
+    case 115200:  return B115200;
+    case 230400:  return B230400;
+    case 460800:  return B460800;
+    case 921600:  return B921600;
+    case 1000000: return B1000000;
+    default:      return 0;
+    }
+}
+
+/* Puts a serial port in raw 8N1 mode, does nothing for other files */
+bool ConfigurePort(int fd, long nBaud)
+{
+    struct termios tio;
+
+    if(!isatty(fd)) {
+        return true;
+    }
+    if(tcgetattr(fd, &tio) != 0) {
+        perror("tcgetattr");
+        return false;
+    }
+
+    const speed_t speed = BaudToSpeed(nBaud);
+    if(speed == 0) {
+        fprintf(stderr, "adi_stream_rx: unsupported baud rate %ld\n", nBaud);
+        return false;
+    }
+
+    cfmakeraw(&tio);
+    tio.c_cflag |= (CLOCAL | CREAD);
+    tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+    tio.c_cc[VMIN]  = 1;
+    tio.c_cc[VTIME] = 0;
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+
+    if(tcsetattr(fd, TCSANOW, &tio) != 0) {
+        perror("tcsetattr");
+        return false;
+    }
+    tcflush(fd, TCIFLUSH);
+    return true;
+}
+
+void PrintPacket(const uint8_t *pPacket, size_t nSize)
+{
+    const bool bData = (pPacket[0] & 0x80u) != 0u;
+
+    printf("%s id=%3u type=0x%02X", bData ? "DATA" : "REG ", pPacket[0] & 0x7Fu, pPacket[1]);
+    if(bData && (nSize >= 6u)) {
+        const uint32_t nTime = pPacket[2] | (pPacket[3] << 8) | (pPacket[4] << 16) | (static_cast<uint32_t>(pPacket[5]) << 24);
+        printf(" t=%10u", nTime);
+        for(size_t i = 6u; i < nSize; i++) {
+            printf(" %02X", pPacket[i]);
+        }
+    } else {
+        for(size_t i = 2u; i < nSize; i++) {
+            printf(" %02X", pPacket[i]);
+        }
+    }
+    putchar('\n');
+}
+
+void Usage(void)
+{
+    fprintf(stderr, "usage: adi_stream_rx [-b baud] [-o packets.bin] [-t] [-q] <tty|file|->\n");
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    long        nBaud   = 115200;
+    const char *pOut    = nullptr;
+    bool        bText   = false;
+    bool        bQuiet  = false;
+    int         opt;
+
+    while((opt = getopt(argc, argv, "b:o:tq")) != -1) {
+        switch(opt) {
+        case 'b': nBaud  = strtol(optarg, nullptr, 10); break;
+        case 'o': pOut   = optarg; break;
+        case 't': bText  = true; break;
+        case 'q': bQuiet = true; break;
+        default:  Usage(); return 2;
+        }
+    }
+    if(optind != (argc - 1)) {
+        Usage();
+        return 2;
+    }
+
+    int fd = STDIN_FILENO;
+    if(strcmp(argv[optind], "-") != 0) {
+        if((fd = open(argv[optind], O_RDONLY | O_NOCTTY)) < 0) {
+            perror(argv[optind]);
+            return 1;
+        }
+    }
+    if(!ConfigurePort(fd, nBaud)) {
+        return 1;
+    }
+
+    FILE *pFile = nullptr;
+    if((pOut != nullptr) && ((pFile = fopen(pOut, "wb")) == nullptr)) {
+        perror(pOut);
+        return 1;
+    }
+
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+
+    Stats                sStats = {};
+    std::vector<uint8_t> frame;
+    uint8_t              aDecoded[ADI_STREAM_MAX_FRAME_SIZE];
+    uint8_t              aChunk[4096];
+    bool                 bSynced   = true;
+    bool                 bHaveSeq  = false;
+    uint8_t              nNextSeq  = 0u;
+    ssize_t              nRead;
+
+    while(!gbStop && ((nRead = read(fd, aChunk, sizeof(aChunk))) != 0)) {
+        if(nRead < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            perror("read");
+            break;
+        }
+
+        for(ssize_t i = 0; i < nRead; i++) {
+            const uint8_t nByte = aChunk[i];
+
+            if(nByte != ADI_STREAM_DELIMITER) {
+                /* Frames longer than the largest valid frame are garbage, wait for the next delimiter */
+                if(frame.size() < ADI_STREAM_MAX_FRAME_SIZE) {
+                    frame.push_back(nByte);
+                } else {
+                    bSynced = false;
+                }
+                continue;
+            }
+
+            /* An overlong run ends here, a partial first frame is caught by the CRC */
+            if(!bSynced || frame.empty()) {
+                bSynced = true;
+                frame.clear();
+                continue;
+            }
+
+            const int32_t nSize = adi_stream_CobsDecode(frame.data(), static_cast<uint32_t>(frame.size()), aDecoded);
+            frame.clear();
+
+            if(nSize < 0) {
+                sStats.nCobsErrors++;
+                continue;
+            }
+            if(nSize <= static_cast<int32_t>(ADI_STREAM_FRAME_OVERHEAD)) {
+                sStats.nShortFrames++;
+                continue;
+            }
+            const uint32_t nRaw = static_cast<uint32_t>(nSize);
+            const uint16_t nCrc = adi_stream_Crc16(0xFFFFu, aDecoded, nRaw - 2u);
+            if((aDecoded[nRaw - 2u] != (nCrc & 0xFFu)) || (aDecoded[nRaw - 1u] != (nCrc >> 8))) {
+                sStats.nCrcErrors++;
+                continue;
+            }
+
+            const uint8_t nSeq = aDecoded[0];
+            if(bHaveSeq) {
+                sStats.nLostFrames += static_cast<uint8_t>(nSeq - nNextSeq);
+            }
+            bHaveSeq = true;
+            nNextSeq = static_cast<uint8_t>(nSeq + 1u);
+
+            const uint8_t *pPacket = &aDecoded[1];
+            const size_t   nPacket = nRaw - ADI_STREAM_FRAME_OVERHEAD;
+
+            sStats.nFrames++;
+            sStats.nBytes += nPacket;
+
+            if(pFile != nullptr) {
+                fwrite(pPacket, 1u, nPacket, pFile);
+            }
+            if(bText) {
+                PrintPacket(pPacket, nPacket);
+            }
+        }
+    }
+
+    if(pFile != nullptr) {
+        fclose(pFile);
+    }
+    if(!bQuiet) {
+        fprintf(stderr, "frames %llu, packet bytes %llu, lost %llu, crc errors %llu, cobs errors %llu, short %llu\n",
+                static_cast<unsigned long long>(sStats.nFrames), static_cast<unsigned long long>(sStats.nBytes),
+                static_cast<unsigned long long>(sStats.nLostFrames), static_cast<unsigned long long>(sStats.nCrcErrors),
+                static_cast<unsigned long long>(sStats.nCobsErrors), static_cast<unsigned long long>(sStats.nShortFrames));
+    }
+    return 0;
+}
@@ -0,0 +1,263 @@
+/*!
+ *****************************************************************************
+  @file adi_tsc_bench.cpp
+
+  @brief Measures the time series codec on captured packet streams.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+/*
+ * Compresses the data packets of a capture (see adi_packet_decode) with the
+ * codec of Source/common/adi_ts_codec.c, one stream per sensor ID and type,
+ * decodes the blocks again and checks that every sample comes back. Prints
+ * the compression ratio against the 20-byte packets and the decoder speed.
+ *
+ *   adi_tsc_bench [-s block_size] [-o blocks.bin] <capture>
+ *
+ *   -s  block size in bytes, as on the node (default 256)
+ *   -o  write the blocks, each preceded by its size (LE16)
+ */
+
+#include <adi_packet_decoder.h>
+#include <common/adi_ts_codec.h>
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace adi_sensor_swpack;
+
+namespace {
+
+struct Stream
+{
+    ADI_TSC_ENCODER                   sEncoder;
+    std::vector<uint8_t>              block;
+    std::vector<std::vector<uint8_t>> blocks;
+    std::vector<uint32_t>             time;
+    std::vector<uint8_t>              payload;
+    uint8_t                           aKey[ADI_TSC_MAX_FIELDS];
+    uint32_t                          nNumFields;
+    uint32_t                          nPayloadSize;
+    uint64_t                          nPackets;
+    uint64_t                          nBytes;
+};
+
+void CloseBlock(Stream &s)
+{
+    const uint32_t nSize = adi_tsc_GetSize(&s.sEncoder);
+
+    s.blocks.emplace_back(s.block.begin(), s.block.begin() + nSize);
+    s.nBytes += nSize;
+    adi_tsc_EncoderInit(&s.sEncoder, s.block.data(), static_cast<uint32_t>(s.block.size()), s.aKey, s.nNumFields);
+}
+
+void Usage(void)
+{
+    fprintf(stderr, "usage: adi_tsc_bench [-s block_size] [-o blocks.bin] <capture>\n");
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t    nBlockSize = 256u;
+    const char *pOut       = nullptr;
+    int         opt;
+
+    while((opt = getopt(argc, argv, "s:o:")) != -1) {
+        switch(opt) {
+        case 's': nBlockSize = static_cast<uint32_t>(strtoul(optarg, nullptr, 0)); break;
+        case 'o': pOut       = optarg; break;
+        default:  Usage(); return 2;
+        }
+    }
+    if((optind != (argc - 1)) || (nBlockSize < 64u) || (nBlockSize > 0xFFFFu)) {
+        Usage();
+        return 2;
+    }
+
+    FILE *pFile = fopen(argv[optind], "rb");
+    if(pFile == nullptr) {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    PacketDecoder                      decoder;
+    std::vector<ADI_PACKET_SAMPLE>     samples;
+    std::map<uint16_t, Stream>         streams;
+    uint8_t                            aPacket[ADI_PACKET_WIRE_SIZE];
+    uint64_t                           nSkipped = 0u;
+
+    /* Encode, keeping the originals to check against */
+    while(fread(aPacket, 1u, sizeof(aPacket), pFile) == sizeof(aPacket)) {
+        samples.clear();
+        decoder.decode(aPacket, sizeof(aPacket), samples);
+        if(((aPacket[0] & 0x80u) == 0u) || samples.empty()) {
+            continue;
+        }
+
+        const uint16_t nId = static_cast<uint16_t>(((aPacket[0] & 0x7Fu) << 8) | aPacket[1]);
+        const ADI_PACKET_SCHEMA *pSchema = decoder.findSchema(aPacket[0] & 0x7Fu, aPacket[1]);
+        auto it = streams.find(nId);
+
+        if(it == streams.end()) {
+            Stream &s = streams[nId];
+            s.nNumFields   = pSchema->nNumFields;
+            s.nPayloadSize = 0u;
+            s.nPackets     = 0u;
+            s.nBytes       = 0u;
+            if(s.nNumFields <= ADI_TSC_MAX_FIELDS) {
+                memcpy(s.aKey, pSchema->aKey, s.nNumFields);
+                for(uint32_t i = 0u; i < s.nNumFields; i++) {
+                    s.nPayloadSize += PacketDecoder::getKeySize(s.aKey[i]);
+                }
+            }
+            s.block.resize(nBlockSize);
+            if((s.nNumFields > ADI_TSC_MAX_FIELDS) ||
+               (adi_tsc_EncoderInit(&s.sEncoder, s.block.data(), nBlockSize, s.aKey, s.nNumFields) != ADI_TSC_SUCCESS)) {
+                s.nNumFields = 0u;
+            }
+            it = streams.find(nId);
+        }
+
+        Stream &s = it->second;
+        if(s.nNumFields == 0u) {
+            nSkipped++;
+            continue;
+        }
+
+        const uint8_t *pPayload = &aPacket[ADI_PACKET_PAYLOAD_OFFSET];
+        const uint32_t nTime    = samples[0].nTimestamp;
+
+        if(adi_tsc_Encode(&s.sEncoder, nTime, pPayload) == ADI_TSC_FULL) {
+            CloseBlock(s);
+            adi_tsc_Encode(&s.sEncoder, nTime, pPayload);
+        }
+        s.time.push_back(nTime);
+        s.payload.insert(s.payload.end(), pPayload, pPayload + s.nPayloadSize);
+        s.nPackets++;
+    }
+    fclose(pFile);
+
+    FILE *pBlocks = nullptr;
+    if((pOut != nullptr) && ((pBlocks = fopen(pOut, "wb")) == nullptr)) {
+        perror(pOut);
+        return 1;
+    }
+
+    int      nStatus   = 0;
+    uint64_t nPackets  = 0u;
+    uint64_t nBytes    = 0u;
+    double   fSeconds  = 0.0;
+
+    printf("%3s %4s %6s %12s %12s %8s\n", "id", "type", "fields", "packets", "bytes", "ratio");
+    for(auto &entry : streams) {
+        Stream &s = entry.second;
+        if(s.nNumFields == 0u) {
+            continue;
+        }
+        if(adi_tsc_GetSize(&s.sEncoder) > ADI_TSC_HEADER_SIZE(s.nNumFields)) {
+            CloseBlock(s);
+        }
+
+        /* Decode every block and compare */
+        uint8_t  aPayload[ADI_PACKET_PAYLOAD_SIZE];
+        uint32_t nTime;
+        size_t   nIndex = 0u;
+        bool     bOk    = true;
+        const auto tStart = std::chrono::steady_clock::now();
+
+        for(const std::vector<uint8_t> &block : s.blocks) {
+            ADI_TSC_DECODER sDecoder;
+            ADI_TSC_RESULT  eResult = adi_tsc_DecoderInit(&sDecoder, block.data(), static_cast<uint32_t>(block.size()));
+
+            while((eResult == ADI_TSC_SUCCESS) &&
+                  ((eResult = adi_tsc_Decode(&sDecoder, &nTime, aPayload)) == ADI_TSC_SUCCESS)) {
+                if((nIndex >= s.time.size()) || (nTime != s.time[nIndex]) ||
+                   (memcmp(aPayload, &s.payload[nIndex * s.nPayloadSize], s.nPayloadSize) != 0)) {
+                    bOk = false;
+                }
+                nIndex++;
+            }
+            if(eResult != ADI_TSC_END) {
+                bOk = false;
+            }
+        }
+        fSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+
+        if(!bOk || (nIndex != s.time.size())) {
+            fprintf(stderr, "adi_tsc_bench: stream %u/0x%02X does not decode back\n", entry.first >> 8, entry.first & 0xFFu);
+            nStatus = 1;
+        }
+
+        if(pBlocks != nullptr) {
+            for(const std::vector<uint8_t> &block : s.blocks) {
+                const uint8_t aSize[2] = { static_cast<uint8_t>(block.size()), static_cast<uint8_t>(block.size() >> 8) };
+                fwrite(aSize, 1u, sizeof(aSize), pBlocks);
+                fwrite(block.data(), 1u, block.size(), pBlocks);
+            }
+        }
+
+        printf("%3u 0x%02X %6u %12" PRIu64 " %12" PRIu64 " %8.2f\n", entry.first >> 8, entry.first & 0xFFu, s.nNumFields,
+               s.nPackets, s.nBytes, (s.nBytes > 0u) ? (static_cast<double>(s.nPackets * ADI_PACKET_WIRE_SIZE) / static_cast<double>(s.nBytes)) : 0.0);
+        nPackets += s.nPackets;
+        nBytes   += s.nBytes;
+    }
+
+    if(pBlocks != nullptr) {
+        fclose(pBlocks);
+    }
+    if(nSkipped != 0u) {
+        printf("%" PRIu64 " packets skipped, more than %u fields or 64-bit keys\n", nSkipped, ADI_TSC_MAX_FIELDS);
+    }
+    fprintf(stderr, "%" PRIu64 " packets -> %" PRIu64 " bytes in %u-byte blocks, decoded at %.2f Msamples/s\n",
+            nPackets, nBytes, nBlockSize, (fSeconds > 0.0) ? (static_cast<double>(nPackets) / fSeconds / 1e6) : 0.0);
+    return nStatus;
+}
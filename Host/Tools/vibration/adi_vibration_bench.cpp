@@ -0,0 +1,341 @@
+/*!
+ *****************************************************************************
+  @file adi_vibration_bench.cpp
+
+  @brief Host reference for the fixed-point vibration analysis.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+/*
+ * Runs the fixed-point FFT (Source/common/adi_fft.c) and the vibration
+ * analysis (Source/axl/adi_vibration.cpp) built for the host, and compares
+ * them with a double precision implementation of the same steps on
+ * synthetic accelerometer windows: tones at random frequencies and
+ * amplitudes plus noise, with a gravity offset.
+ *
+ *   adi_vibration_bench [-n points] [-r rate] [-t trials] [-s seed]
+ *
+ *   -n  points per window, power of two from 16 to 256 (default 256)
+ *   -r  sample rate in 0.1 Hz (default 4000, the 400 Hz ODR)
+ *   -t  number of random windows (default 1000)
+ *   -s  random seed (default 1)
+ *
+ * Prints the FFT signal to error ratio per size, the operation counts that
+ * set the cost on the ADuCM3029, and the error of the peak frequency, peak
+ * amplitude and band RMS against the reference.
+ */
+
+#include <axl/adi_vibration.h>
+#include <common/adi_fft.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace adi_sensor_swpack;
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+/* Reference DFT of a real signal, bins 0 to N/2 */
+void Dft(const std::vector<double> &x, std::vector<double> &re, std::vector<double> &im)
+{
+    const size_t n = x.size();
+
+    re.assign((n / 2) + 1, 0.0);
+    im.assign((n / 2) + 1, 0.0);
+    for(size_t k = 0; k <= n / 2; k++)
+    {
+        for(size_t i = 0; i < n; i++)
+        {
+            re[k] += x[i] * std::cos(2.0 * kPi * k * i / n);
+            im[k] -= x[i] * std::sin(2.0 * kPi * k * i / n);
+        }
+    }
+}
+
+/* Same steps as VibrationAnalyzer::AnalyzeAxis() in double precision */
+void Reference(const int16_t *pSamples, uint32_t nPoints, uint32_t nRate, const uint16_t *pEdges,
+               double &fPeakFreq, double &fPeakAmp, double *pBandRms)
+{
+    std::vector<double> x(nPoints), re, im, mag;
+    double              fMean = 0.0;
+
+    for(uint32_t i = 0; i < nPoints; i++)
+    {
+        fMean += pSamples[i];
+    }
+    fMean /= nPoints;
+    for(uint32_t i = 0; i < nPoints; i++)
+    {
+        const double w = std::sin(kPi * i / nPoints);
+        x[i] = (pSamples[i] - fMean) * w * w;
+    }
+    Dft(x, re, im);
+
+    mag.resize(re.size());
+    for(size_t k = 0; k < re.size(); k++)
+    {
+        mag[k] = std::sqrt((re[k] * re[k]) + (im[k] * im[k])) / nPoints;
+    }
+
+    for(uint32_t b = 0; b < ADI_VIBRATION_NUM_BANDS; b++)
+    {
+        double fEnergy = 0.0;
+
+        for(uint32_t k = 1; k <= nPoints / 2; k++)
+        {
+            const uint32_t nFreq = (k * nRate) / nPoints;
+
+            if((nFreq >= pEdges[b]) && (nFreq < pEdges[b + 1]))
+            {
+                fEnergy += mag[k] * mag[k];
+            }
+        }
+        pBandRms[b] = std::sqrt(fEnergy * 16.0 / 3.0);
+    }
+
+    uint32_t nPeak = 1;
+    for(uint32_t k = 2; k < nPoints / 2; k++)
+    {
+        if(mag[k] > mag[nPeak])
+        {
+            nPeak = k;
+        }
+    }
+    const double fCurve  = (2.0 * mag[nPeak]) - mag[nPeak - 1] - mag[nPeak + 1];
+    const double fOffset = (fCurve > 0.0) ? (0.5 * (mag[nPeak + 1] - mag[nPeak - 1]) / fCurve) : 0.0;
+
+    fPeakFreq = (nPeak + fOffset) * nRate / nPoints;
+    fPeakAmp  = 4.0 * mag[nPeak];
+}
+
+/* Signal to error ratio of adi_fft_Real() against the DFT, in dB */
+double FftSnr(uint32_t nPoints, std::mt19937 &rng)
+{
+    std::uniform_int_distribution<int> noise(-16384, 16384);
+    std::vector<int16_t>               data(nPoints);
+    std::vector<double>                x(nPoints), re, im;
+    double                             fSignal = 0.0, fError = 0.0;
+
+    for(uint32_t i = 0; i < nPoints; i++)
+    {
+        data[i] = (int16_t) noise(rng);
+        x[i]    = data[i];
+    }
+    adi_fft_Real(data.data(), nPoints);
+    Dft(x, re, im);
+
+    for(uint32_t k = 0; k <= nPoints / 2; k++)
+    {
+        double fRe = re[k] / nPoints, fIm = im[k] / nPoints, fGotRe, fGotIm;
+
+        if(k == 0)                { fGotRe = data[0];      fGotIm = 0.0; }
+        else if(k == nPoints / 2) { fGotRe = data[1];      fGotIm = 0.0; }
+        else                      { fGotRe = data[2 * k];  fGotIm = data[(2 * k) + 1]; }
+
+        fSignal += (fRe * fRe) + (fIm * fIm);
+        fError  += ((fGotRe - fRe) * (fGotRe - fRe)) + ((fGotIm - fIm) * (fGotIm - fIm));
+    }
+    return 10.0 * std::log10(fSignal / fError);
+}
+
+void Usage()
+{
+    std::fprintf(stderr, "usage: adi_vibration_bench [-n points] [-r rate] [-t trials] [-s seed]\n");
+    std::exit(2);
+}
+
+} /* namespace */
+
+int main(int argc, char *argv[])
+{
+    uint32_t nPoints = 256u, nRate = 4000u, nTrials = 1000u, nSeed = 1u;
+    int      opt;
+
+    while((opt = getopt(argc, argv, "n:r:t:s:")) != -1)
+    {
+        switch(opt)
+        {
+            case 'n': nPoints = (uint32_t) std::strtoul(optarg, nullptr, 0); break;
+            case 'r': nRate   = (uint32_t) std::strtoul(optarg, nullptr, 0); break;
+            case 't': nTrials = (uint32_t) std::strtoul(optarg, nullptr, 0); break;
+            case 's': nSeed   = (uint32_t) std::strtoul(optarg, nullptr, 0); break;
+            default:  Usage();
+        }
+    }
+
+    VibrationAnalyzer analyzer;
+    if((nTrials == 0u) || !analyzer.setup(nPoints, nRate))
+    {
+        Usage();
+    }
+
+    std::mt19937 rng(nSeed);
+
+    /* FFT accuracy, and the work that sets the cycle count on the target */
+    std::printf("FFT         SNR      butterflies  multiplies  host ns\n");
+    for(uint32_t n = ADI_FFT_MIN_POINTS; n <= ADI_FFT_MAX_POINTS; n *= 2u)
+    {
+        const uint32_t nHalf  = n / 2u;
+        uint32_t       nLog   = 0u;
+        double         fSnr   = 0.0;
+
+        while((1u << nLog) < nHalf)
+        {
+            nLog++;
+        }
+
+        for(int i = 0; i < 8; i++)
+        {
+            fSnr += FftSnr(n, rng) / 8.0;
+        }
+
+        /* Radix-2 butterflies of the half size transform plus the split stage,
+         * 4 multiplies each, and 2 per sample for the window */
+        const uint32_t nButterflies = ((nHalf / 2u) * nLog) + (nHalf / 2u);
+        const uint32_t nMultiplies  = (4u * nButterflies) + (2u * n);
+
+        std::vector<int16_t> data(n, 0);
+        const int            nRuns = 20000;
+        auto                 start = std::chrono::steady_clock::now();
+        for(int r = 0; r < nRuns; r++)
+        {
+            data[r % n] = (int16_t) r;
+            adi_fft_Window(data.data(), n);
+            adi_fft_Real(data.data(), n);
+        }
+        const double fNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / nRuns;
+
+        std::printf("%4u  %6.1f dB  %11u  %10u  %7.0f\n", n, fSnr, nButterflies, nMultiplies, fNs);
+    }
+
+    /* Analysis against the double precision reference */
+    const uint16_t aEdges[ADI_VIBRATION_NUM_BANDS + 1u] = {
+        0u, (uint16_t)(nRate / 16u), (uint16_t)(nRate / 8u), (uint16_t)(nRate / 4u), 0xFFFFu
+    };
+    std::uniform_real_distribution<double> freq(0.05, 0.45), amp(20.0, 1500.0), phase(0.0, 2.0 * kPi);
+    std::normal_distribution<double>       noise(0.0, 4.0);
+    double fFreqErr = 0.0, fFreqMax = 0.0, fAmpErr = 0.0, fBandErr = 0.0, fBandMax = 0.0, fBandAbs = 0.0;
+    uint32_t nBands = 0u, nStrongBands = 0u;
+
+    analyzer.setBands(aEdges);
+
+    for(uint32_t t = 0; t < nTrials; t++)
+    {
+        /* Main tone and a weaker harmonic on every axis, 1 g offset on Z */
+        double  fTone[ADI_VIBRATION_NUM_AXES], fAmp[ADI_VIBRATION_NUM_AXES], fPhase[ADI_VIBRATION_NUM_AXES];
+        int16_t aWindow[ADI_VIBRATION_NUM_AXES][ADI_VIBRATION_MAX_POINTS];
+        ADI_VIBRATION_AXIS aResult[ADI_VIBRATION_NUM_AXES];
+
+        for(uint32_t a = 0; a < ADI_VIBRATION_NUM_AXES; a++)
+        {
+            fTone[a]  = freq(rng);
+            fAmp[a]   = amp(rng);
+            fPhase[a] = phase(rng);
+        }
+
+        for(uint32_t i = 0; i < nPoints; i++)
+        {
+            int16_t aXYZ[ADI_VIBRATION_NUM_AXES];
+
+            for(uint32_t a = 0; a < ADI_VIBRATION_NUM_AXES; a++)
+            {
+                const double v = ((a == 2u) ? 1000.0 : 0.0) +
+                                 (fAmp[a] * std::sin((2.0 * kPi * fTone[a] * i) + fPhase[a])) +
+                                 (0.2 * fAmp[a] * std::sin((4.0 * kPi * fTone[a] * i) + fPhase[a])) + noise(rng);
+                aXYZ[a]       = (int16_t) std::lround(v);
+                aWindow[a][i] = aXYZ[a];
+            }
+            analyzer.add(aXYZ);
+        }
+        analyzer.analyze(aResult);
+
+        for(uint32_t a = 0; a < ADI_VIBRATION_NUM_AXES; a++)
+        {
+            double fRefFreq, fRefAmp, aRefRms[ADI_VIBRATION_NUM_BANDS];
+
+            Reference(aWindow[a], nPoints, nRate, aEdges, fRefFreq, fRefAmp, aRefRms);
+
+            const double fDf = std::fabs(aResult[a].nPeakFreq - fRefFreq);
+            fFreqErr += fDf;
+            fFreqMax  = (fDf > fFreqMax) ? fDf : fFreqMax;
+            fAmpErr  += std::fabs(aResult[a].nPeakAmp - fRefAmp) / fRefAmp;
+
+            for(uint32_t b = 0; b < ADI_VIBRATION_NUM_BANDS; b++)
+            {
+                const double fDb = std::fabs(aResult[a].aBandRms[b] - aRefRms[b]);
+
+                fBandAbs += fDb;
+                nBands++;
+
+                /* The FFT keeps about 58 dB below the largest sample and the
+                 * result is in whole counts, so weak bands are only compared
+                 * in counts */
+                if((aRefRms[b] >= (fAmp[a] / 20.0)) && (aRefRms[b] >= 20.0))
+                {
+                    fBandErr += fDb / aRefRms[b];
+                    fBandMax  = ((fDb / aRefRms[b]) > fBandMax) ? (fDb / aRefRms[b]) : fBandMax;
+                    nStrongBands++;
+                }
+            }
+        }
+    }
+
+    const uint32_t nAxes = nTrials * ADI_VIBRATION_NUM_AXES;
+    std::printf("\n%u windows of %u points at %.1f Hz, against the double precision reference:\n",
+                nTrials, nPoints, nRate / 10.0);
+    std::printf("  peak frequency  mean error %.2f Hz, max %.2f Hz (bin width %.2f Hz)\n",
+                fFreqErr / nAxes / 10.0, fFreqMax / 10.0, nRate / 10.0 / nPoints);
+    std::printf("  peak amplitude  mean error %.2f %%\n", 100.0 * fAmpErr / nAxes);
+    std::printf("  band RMS        mean error %.2f counts over all bands\n", fBandAbs / nBands);
+    std::printf("                  mean error %.2f %%, max %.2f %% over bands above 20 counts and 1/20 of the tone\n",
+                (nStrongBands != 0u) ? (100.0 * fBandErr / nStrongBands) : 0.0, 100.0 * fBandMax);
+    return 0;
+}
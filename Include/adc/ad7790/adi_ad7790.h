@@ -52,6 +52,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <adc/adi_adc.h>
+#include <base_sensor/adi_sensor_task.h>
 #include <drivers/spi/adi_spi.h>
 
 
@@ -95,11 +96,8 @@ POSSIBILITY OF SUCH DAMAGE.
 /*! Bit mask of the data ready bit in the STATUS register. */
 #define AD7790_STATUS_NOT_RDY_BITM (0x80u)
 
-/*! Max number of status reads before timing out when reading data. */
-#define AD7790_MAX_STATUS_READS    (1000u)
-
-/*! Small delay between status reads when reading data. */
-#define AD7790_STATUS_DELAY_LOOPS  (1024u)
+/*! Conversion periods of the configured filter to wait for data ready before timing out. */
+#define AD7790_TIMEOUT_CONVERSIONS (4u)
 
 
 /*! @} */
@@ -114,7 +112,7 @@ namespace adi_sensor_swpack
       * @brief 16-bit sigma-delta analog-to-digital converter.
       *
       */
-    class AD7790: public ADC
+    class AD7790: public ADC, public SensorTask
     {
 
         public:
@@ -165,7 +163,9 @@ namespace adi_sensor_swpack
                 /*!< Write to mode register did not work in init */
                 MODE_READ_WRITE_MISMATCH,
                 /*!< Write to filter register did not work in init */
-                FILTER_READ_WRITE_MISMATCH
+                FILTER_READ_WRITE_MISMATCH,
+                /*!< Another operation is still running */
+                TASK_BUSY
             };
 
             /*!
@@ -225,6 +225,25 @@ namespace adi_sensor_swpack
              */
             SENSOR_RESULT getVoltage(float * pData);
 
+            /*!
+             * @brief  Start reading data without waiting for the conversion.
+             *
+             * @param  [out] pData : The data from the ADC (allocated by caller).
+             *
+             * @return SENSOR_RESULT
+             *
+             * @details Each poll() reads the status register once. The data is read
+             *          by the poll() that sees the data ready bit. The read times out
+             *          after #AD7790_TIMEOUT_CONVERSIONS conversion periods.
+             *
+             * @note   pData only contains valid data if poll() returns SENSOR_ERROR_NONE.
+             *
+             */
+            SENSOR_RESULT beginRead(uint16_t * pData);
+
+            /* Inherited from SensorTask */
+            virtual SENSOR_RESULT poll();
+
         private:
 
             /*!
@@ -235,10 +254,22 @@ namespace adi_sensor_swpack
              */
             SENSOR_RESULT applyStaticConfig(void);
 
+            /*!
+             * @brief  Read the status register once for the running read.
+             *
+             * @param  [out] pResult : Result of the read when it is done.
+             *
+             * @return true when data is ready, the read failed or the read timed out.
+             *
+             */
+            bool IsTaskReady(SENSOR_RESULT * pResult);
+
             /*! SPI configuration structure, moved off of stack */
             ADI_SPI_TRANSCEIVER m_adc_spi_config;
             /*! Pointer to SPI handle passed from constructor */
             ADI_SPI_HANDLE    * m_adc_spi_phandle;
+            /*! Destination of the running read */
+            uint16_t          * m_pTaskData;
     };
 
 }
@@ -62,6 +62,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <adc/adi_adc.h>
 #include <base_sensor/adi_sensor_errors.h>
 #include <base_sensor/adi_sensor.h>
+#include <base_sensor/adi_sensor_task.h>
 #include <drivers/spi/adi_spi.h>
 
 /********** Bit positions within registers (AD7798_REG_COMM) **********/
@@ -167,8 +168,10 @@ POSSIBILITY OF SUCH DAMAGE.
 #define AD7798_FORMAT_DATA(byte1, byte2)    ((byte2 | (byte1 << 0x08u)))
 /*!< The maximum register size of the ADC in bytes. For the AD7798 this value is 2 bytes.             */
 #define AD7798_MAX_REG_SIZE                 (2u)
-/*!< The maximum timeout in cycles for an ADC transaction to wait on the RDY signal to go low.        */
-#define AD7798_TRANSACTION_TIMEOUT          (20000000u)
+/*!< Conversion periods of the filter rate an ADC transaction may wait on the RDY signal to go low.  */
+#define AD7798_TIMEOUT_CONVERSIONS          (4u)
+/*!< Conversion periods of a zero-scale or full-scale calibration.                                    */
+#define AD7798_CALIBRATION_CONVERSIONS      (2u)
 /*!< AD7798 reference voltage.                                                                        */
 #define AD7798_REFERENCE_VOLTAGE            (3150.0)
 /*!< 2^ADC Resolution = 2^16 as the AD7798 is a 16-bit ADC.                                           */
@@ -186,7 +189,7 @@ namespace adi_sensor_swpack
      **/
 #pragma pack(push)
 #pragma pack(4)
-    class AD7798 : public ADC
+    class AD7798 : public ADC, public SensorTask
     {
         public:
             /*!
@@ -202,6 +205,7 @@ namespace adi_sensor_swpack
             {
                 ERROR_CODE_ID_MISMATCH = 0u, /*!< ID register does not match the expected value.  */
                 ERROR_CODE_RDY_TIMEOUT = 1u, /*!< Timed out waiting for a conversion to complete. */
+                ERROR_CODE_TASK_BUSY   = 2u, /*!< Another operation is still running.             */
             } ERROR_CODES;
 
             /*!
@@ -484,6 +488,33 @@ namespace adi_sensor_swpack
              */
             SENSOR_RESULT   setReference(AD7798::REF_DET reference);
 
+            /*!
+             * @brief  Start a calibration without waiting for it.
+             *
+             * @param  [in] mode : One of the OPERATING_MODE_CAL_ modes.
+             *
+             * @return SENSOR_RESULT. This value can be set using #SET_SENSOR_ERROR(type, error).
+             *
+             * @details The calibration runs from poll(), which writes the mode, waits for the
+             *          calibration time of the filter rate and then reads the status register once
+             *          per call until the RDY bit is cleared.
+             *
+             */
+            SENSOR_RESULT   beginCalibration(AD7798::OPERATING_MODE mode);
+
+            /*!
+             * @brief  Start reading the next conversion without waiting for it.
+             *
+             * @param  [out] data : Filled when poll() returns SENSOR_ERROR_NONE (allocated by caller).
+             *
+             * @return SENSOR_RESULT. This value can be set using #SET_SENSOR_ERROR(type, error).
+             *
+             */
+            SENSOR_RESULT   beginRead(uint16_t * data);
+
+            /* Inherited from SensorTask */
+            virtual SENSOR_RESULT poll();
+
             /*!
              * @brief  Get the gain select bits of the configuration register.
              *
@@ -515,6 +546,22 @@ namespace adi_sensor_swpack
              */
             SENSOR_RESULT applyStaticConfig(void);
 
+            /*!
+             * @brief  Read the status register once for the running operation.
+             *
+             * @param  [out] pResult : Result of the operation when it is done.
+             *
+             * @return true when the RDY bit is cleared, the read failed or the operation timed out.
+             *
+             */
+            bool IsTaskReady(SENSOR_RESULT * pResult);
+
+            /*!
+             * @brief  Conversion period of the current filter rate, us.
+             *
+             */
+            uint32_t GetConversionUs(void) const;
+
 
             /*!< SPI memory buffer.              */
             uint8_t             m_spi_memory[ADI_SPI_MEMORY_SIZE];
@@ -528,6 +575,12 @@ namespace adi_sensor_swpack
             uint8_t             m_rxBuffer[2];
             /*!< Current gain select bits.       */
             AD7798::GAIN       m_gain;
+            /*!< Current filter update rate.     */
+            AD7798::FILTER_RATE m_filter;
+            /*!< Calibration mode of the running operation.     */
+            AD7798::OPERATING_MODE m_eTaskMode;
+            /*!< Destination of the running read, NULL for a calibration. */
+            uint16_t          * m_pTaskData;
     };
 #pragma pack(pop)
 }
@@ -77,6 +77,8 @@ namespace adi_sensor_swpack
                 AXL_ERROR_INVALID_DEVID,      /*!< Invalid device ID       */
                 AXL_ERROR_INVALID_DEVID_MST,  /*!< Invalid mems device ID  */
                 AXL_ERROR_INVALID_PARTID,     /*!< Invalid part ID         */
+                AXL_ERROR_TASK_BUSY,          /*!< Operation still running */
+                AXL_ERROR_DATAREADY_TIMEOUT,  /*!< No sample became ready  */
             } AXL_ERROR_CODES;
 
             /*!
@@ -198,11 +200,14 @@ namespace adi_sensor_swpack
              * @param   range  : Specifies the accelerometer range. Range is enumerated via
              *          AXL_RANGE.
              *
+             * @return   SENSOR_RESULT  In case of success SENSOR_ERROR_NONE is returned. Upon
+             *           failure applications must use GET_SENSOR_ERROR_TYPE() and
+             *           GET_DRIVER_ERROR_CODE() to determine the error.
+             *
+             * @details  Like setOutputDataRate(), the range is stored before start() and
+             *           programmed right away once started.
              */
-            void setRange(const AXL_RANGE range)
-            {
-                m_range = range;
-            }
+            virtual SENSOR_RESULT  setRange(const AXL_RANGE range) = 0;
 
             /*!
              * @brief    Get accelerometer range.
@@ -216,6 +221,31 @@ namespace adi_sensor_swpack
                 return m_range;
             }
 
+            /*!
+             * @brief    Set the output data rate of the accelerometer.
+             *
+             * @param [in] odr : Output data rate, enumerated via AXL_ODR.
+             *
+             * @return   SENSOR_RESULT  In case of success SENSOR_ERROR_NONE is returned. Upon
+             *           failure applications must use GET_SENSOR_ERROR_TYPE() and
+             *           GET_DRIVER_ERROR_CODE() to determine the error.
+             *
+             * @details  Before start() the rate is only stored and used by start(). Once
+             *           started the accelerometer is reprogrammed right away, so
+             *           applications can follow the activity of the signal.
+             */
+            virtual SENSOR_RESULT  setOutputDataRate(const AXL_ODR odr) = 0;
+
+            /*!
+             * @brief    Get accelerometer output data rate.
+             *
+             * @return   Output data rate value.
+             */
+            AXL_ODR getOutputDataRate(void)
+            {
+                return m_odr;
+            }
+
 
             /*!
               * @brief    Reads accelerometer register value.
@@ -311,6 +341,7 @@ namespace adi_sensor_swpack
             uint32_t      m_y_axis;  /*!< y axis */
             uint32_t      m_z_axis;  /*!< z axis */
             AXL_RANGE     m_range;   /*!< accelerometer range */
+            AXL_ODR       m_odr;     /*!< accelerometer output data rate */
 
     };
 }
@@ -0,0 +1,189 @@
+/*!
+ *****************************************************************************
+  @file adi_orientation.h
+
+  @brief Fixed-point pitch, roll and tilt of accelerometer frames.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#ifndef ADI_ORIENTATION_H
+#define ADI_ORIENTATION_H
+
+#include <stdint.h>
+#include <base_sensor/adi_sensor_packet.h>
+
+namespace adi_sensor_swpack
+{
+    /*!
+     *  @struct ADI_ORIENTATION
+     *
+     *  @brief  Orientation of one frame, all angles in 0.01 degree.
+     */
+    typedef struct
+    {
+        int16_t     nPitch;     /*!< Rotation about Y, -9000 to 9000, X down is positive    */
+        int16_t     nRoll;      /*!< Rotation about X, -18000 to 18000, 0 with Z up         */
+        uint16_t    nTilt;      /*!< Angle between Z and the vertical, 0 to 18000           */
+    } ADI_ORIENTATION;
+
+    /*!
+     * @enum ADI_ORIENTATION_EVENT
+     *
+     * @brief Events returned by OrientationEngine::update(), one bit each.
+     */
+    typedef enum
+    {
+        ADI_ORIENTATION_EVENT_NONE        = 0x00u,  /*!< Nothing to report                                  */
+        ADI_ORIENTATION_EVENT_CHANGED     = 0x01u,  /*!< Pitch or roll moved by the deadband since the last */
+        ADI_ORIENTATION_EVENT_TILT_ALARM  = 0x02u,  /*!< Tilt rose above the trip angle                     */
+        ADI_ORIENTATION_EVENT_TILT_CLEAR  = 0x04u,  /*!< Tilt fell back below the clear angle               */
+    } ADI_ORIENTATION_EVENT;
+
+    /**
+     * @class OrientationEngine
+     *
+     * @brief Turns raw X/Y/Z frames into pitch, roll, tilt and tilt alarms.
+     *
+     * @details The angles come from an integer CORDIC in vectoring mode, so
+     *          no floating point library is linked in. They only depend on the
+     *          ratio of the axes, which makes the raw counts of any range
+     *          usable without scaling.
+     *
+     *          update() takes a batch of frames, e.g. the content of the
+     *          accelerometer FIFO, and evaluates the mean of the batch: one
+     *          CORDIC run per batch, with the noise of the mean. The events
+     *          let the application send changes instead of every reading.
+     */
+    class OrientationEngine
+    {
+        public:
+            OrientationEngine();
+
+            /*!
+             * @brief   Sets the change that raises #ADI_ORIENTATION_EVENT_CHANGED.
+             *
+             * @param [in] nDeadband : Pitch or roll change in 0.01 degree, 0 reports
+             *                         every batch.
+             */
+            void setDeadband(uint16_t nDeadband);
+
+            /*!
+             * @brief   Sets the tilt alarm.
+             *
+             * @param [in] nTrip  : Tilt above which the alarm is raised, 0.01 degree.
+             *                      18000 disables the alarm.
+             * @param [in] nClear : Tilt below which the alarm clears, at most nTrip.
+             */
+            void setTiltAlarm(uint16_t nTrip, uint16_t nClear);
+
+            /*!
+             * @brief   Evaluates a batch of frames.
+             *
+             * @param [in] pFrames : nFrames X, Y, Z triplets in counts.
+             * @param [in] nFrames : Number of frames, at least 1.
+             *
+             * @return  The #ADI_ORIENTATION_EVENT bits raised by the batch.
+             */
+            uint32_t update(const int16_t *pFrames, uint32_t nFrames);
+
+            /*!
+             * @brief   Returns the orientation of the last batch.
+             */
+            const ADI_ORIENTATION &getOrientation(void) const
+            {
+                return m_sCurrent;
+            }
+
+            /*!
+             * @brief   Returns true while the tilt alarm is raised.
+             */
+            bool isTilted(void) const
+            {
+                return m_bTilted;
+            }
+
+            /*!
+             * @brief   Computes the orientation of each frame.
+             *
+             * @param [in]  pFrames : nFrames X, Y, Z triplets in counts.
+             * @param [in]  nFrames : Number of frames.
+             * @param [out] pResult : nFrames orientations.
+             */
+            static void convert(const int16_t *pFrames, uint32_t nFrames, ADI_ORIENTATION *pResult);
+
+            /*!
+             * @brief   Fills a registration packet for #ADI_ORIENTATION_TYPE packets.
+             *
+             * @param [in]  nSensorId     : ID of the accelerometer.
+             * @param [out] pRegistration : Packet to fill.
+             */
+            static void fillRegistration(uint8_t nSensorId, ADI_REGISTRATION_PACKET *pRegistration);
+
+            /*!
+             * @brief   Fills an #ADI_ORIENTATION_TYPE data packet with the last batch.
+             *
+             * @param [in]  nSensorId  : ID of the accelerometer.
+             * @param [in]  nEvents    : Events returned by update().
+             * @param [in]  nTimestamp : Timestamp of the batch.
+             * @param [out] pPacket    : Packet to fill.
+             */
+            void fillPacket(uint8_t nSensorId, uint32_t nEvents, uint32_t nTimestamp,
+                            ADI_DATA_PACKET *pPacket) const;
+
+        private:
+
+            /*! Orientation of one frame given as 32-bit axes */
+            static void Compute(int32_t nX, int32_t nY, int32_t nZ, ADI_ORIENTATION *pResult);
+
+            uint16_t        m_nDeadband;
+            uint16_t        m_nTrip;
+            uint16_t        m_nClear;
+            bool            m_bTilted;
+            bool            m_bReported;
+            ADI_ORIENTATION m_sCurrent;
+            ADI_ORIENTATION m_sReported;
+    };
+}
+
+#endif /* ADI_ORIENTATION_H */
@@ -0,0 +1,172 @@
+/*!
+ *****************************************************************************
+  @file adi_vibration.h
+
+  @brief Vibration spectrum analysis of accelerometer windows.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#ifndef ADI_VIBRATION_H
+#define ADI_VIBRATION_H
+
+#include <stdint.h>
+#include <base_sensor/adi_sensor_packet.h>
+
+namespace adi_sensor_swpack
+{
+    /*! Largest window, the buffers are sized for it */
+#define ADI_VIBRATION_MAX_POINTS    (256u)
+
+    /*! Number of frequency bands reported per axis */
+#define ADI_VIBRATION_NUM_BANDS     (4u)
+
+    /*! Number of accelerometer axes */
+#define ADI_VIBRATION_NUM_AXES      (3u)
+
+    /*!
+     *  @struct ADI_VIBRATION_AXIS
+     *
+     *  @brief  Spectrum summary of one axis. Accelerations are in raw
+     *          accelerometer counts, frequencies in 0.1 Hz.
+     */
+    typedef struct
+    {
+        uint16_t    nPeakFreq;                          /*!< Frequency of the strongest component  */
+        uint16_t    nPeakAmp;                           /*!< Amplitude of the strongest component  */
+        uint16_t    aBandRms[ADI_VIBRATION_NUM_BANDS];  /*!< RMS acceleration of each band         */
+    } ADI_VIBRATION_AXIS;
+
+    /**
+     * @class VibrationAnalyzer
+     *
+     * @brief Band energies and peak frequency of X/Y/Z windows.
+     *
+     * @details The application feeds getXYZ() readings with add(). When a
+     *          window is full, analyze() processes each axis:
+     *            - removes the mean and scales the samples to +/-16384,
+     *            - applies a Hann window and a Q15 real FFT (adi_fft.h),
+     *            - reports the RMS of each band from the bin powers, and the
+     *              strongest bin above DC refined by parabolic interpolation.
+     *
+     *          Everything runs in integer arithmetic in the buffers of the
+     *          object: 1.5 KB of samples and 0.5 KB of bin powers for 256
+     *          points. The peak amplitude is read at the peak bin, so a tone
+     *          between two bins reads up to 1.4 dB low.
+     */
+    class VibrationAnalyzer
+    {
+        public:
+            VibrationAnalyzer();
+
+            /*!
+             * @brief   Sets the window length and the sample rate.
+             *
+             * @param [in] nPoints     : Samples per window, a power of two from 16 to
+             *                           #ADI_VIBRATION_MAX_POINTS.
+             * @param [in] nSampleRate : Output data rate of the accelerometer, 0.1 Hz.
+             *
+             * @return  false if nPoints is not supported. The window restarts.
+             */
+            bool setup(uint32_t nPoints, uint32_t nSampleRate);
+
+            /*!
+             * @brief   Sets the band edges.
+             *
+             * @param [in] pEdges : #ADI_VIBRATION_NUM_BANDS + 1 increasing frequencies,
+             *                      0.1 Hz. Band i covers pEdges[i] up to, not including,
+             *                      pEdges[i + 1].
+             */
+            void setBands(const uint16_t *pEdges);
+
+            /*!
+             * @brief   Adds one reading.
+             *
+             * @param [in] pXYZ : X, Y and Z counts, as returned by getXYZ().
+             *
+             * @return  true if the window is full and analyze() must be called.
+             */
+            bool add(const int16_t *pXYZ);
+
+            /*!
+             * @brief   Analyzes the full window and starts the next one.
+             *
+             * @param [out] pResult : #ADI_VIBRATION_NUM_AXES results.
+             */
+            void analyze(ADI_VIBRATION_AXIS *pResult);
+
+            /*!
+             * @brief   Fills a registration packet for #ADI_VIBRATION_TYPE packets.
+             *
+             * @param [in]  nSensorId     : ID of the accelerometer.
+             * @param [out] pRegistration : Packet to fill.
+             */
+            static void fillRegistration(uint8_t nSensorId, ADI_REGISTRATION_PACKET *pRegistration);
+
+            /*!
+             * @brief   Fills an #ADI_VIBRATION_TYPE data packet.
+             *
+             * @param [in]  nSensorId  : ID of the accelerometer.
+             * @param [in]  nAxis      : Axis of the result.
+             * @param [in]  nTimestamp : Timestamp of the end of the window.
+             * @param [in]  pResult    : Result of the axis.
+             * @param [out] pPacket    : Packet to fill.
+             */
+            static void fillPacket(uint8_t nSensorId, uint8_t nAxis, uint32_t nTimestamp,
+                                   const ADI_VIBRATION_AXIS *pResult, ADI_DATA_PACKET *pPacket);
+
+        private:
+
+            /*! Analyzes one axis, the samples are overwritten by the spectrum */
+            void AnalyzeAxis(int16_t *pSamples, ADI_VIBRATION_AXIS *pResult);
+
+            uint32_t    m_nPoints;
+            uint32_t    m_nSampleRate;
+            uint32_t    m_nCount;
+            uint16_t    m_aEdge[ADI_VIBRATION_NUM_BANDS + 1u];
+            int16_t     m_aSamples[ADI_VIBRATION_NUM_AXES][ADI_VIBRATION_MAX_POINTS];
+            uint32_t    m_aPower[(ADI_VIBRATION_MAX_POINTS / 2u) + 1u];
+    };
+}
+
+#endif /* ADI_VIBRATION_H */
@@ -51,7 +51,10 @@ POSSIBILITY OF SUCH DAMAGE.
 #define ADI_ADXL362_H
 
 #include <axl/adi_accelerometer.h>
+#include <base_sensor/adi_sensor_task.h>
 #include <drivers/spi/adi_spi.h>
+#include <drivers/gpio/adi_gpio.h>
+#include <common/adi_timesync.h>
 
 /*! @addtogroup adxl362_macros ADXL362 Macros
  *  @ingroup sensor_macros
@@ -75,6 +78,8 @@ namespace adi_sensor_swpack
 #define ADXL362_PCTL_AUTOSLEEP    (4u)
     /*! Power control register wakeup */
 #define ADXL362_PCTL_WAKEUP       (8u)
+    /*! Power control register noise mode bit position */
+#define ADXL362_PCTL_NOISE_BITPOS (4u)
 
     /*! Filter control register standby */
 #define ADXL362_FCTL_STDBY        (0u)
@@ -82,6 +87,8 @@ namespace adi_sensor_swpack
 #define ADXL362_FCTL_RANGE_BITPOS (6u)
     /*! Filter control register output data rate bit position */
 #define ADXL362_FCTL_ODR_BITPOS   (0u)
+    /*! Filter control register half bandwidth, anti-aliasing at ODR/4 instead of ODR/2 */
+#define ADXL362_FCTL_HALF_BW      (0x10u)
 
     /*! ADXL362 SPI command code write register */
 #define ADXL362_CMD_WRITE_REG     (0x0A)
@@ -90,8 +97,30 @@ namespace adi_sensor_swpack
     /*! ADXL362 SPI command code read FIFO */
 #define ADXL362_CMD_READ_FIFO     (0x0D)
 
-    /*! Check for data ready - iteration count */
-#define ADXL362_DATAREADY_ITERCOUNT (0xA)
+    /*! FIFO size in 16-bit entries */
+#define ADXL362_FIFO_ENTRIES_MAX  (512u)
+    /*! FIFO control register, bit 8 of the watermark */
+#define ADXL362_FIFO_CTL_AH       (0x08u)
+
+    /*! Temperature register value at ADXL362_TEMP_REFERENCE, typical */
+#define ADXL362_TEMP_BIAS         (350)
+    /*! Temperature of ADXL362_TEMP_BIAS, m degree C */
+#define ADXL362_TEMP_REFERENCE    (25000)
+    /*! Temperature scale, m degree C per LSB, typical */
+#define ADXL362_TEMP_SCALE        (65)
+
+    /*! Sample period at AXL_ODR_12_5, us, each faster rate halves it */
+#define ADXL362_ODR_12_5_PERIOD_US  (80000u)
+
+    /*! Check for data ready - sample periods before the wait times out */
+#define ADXL362_DATAREADY_PERIODS   (3u)
+
+    /*! INTMAP bit, the interrupt follows the data ready status */
+#define ADXL362_INT_DATA_READY      (0x01u)
+    /*! INTMAP bit, the interrupt follows the FIFO watermark status */
+#define ADXL362_INT_FIFO_WATERMARK  (0x04u)
+    /*! INTMAP bit, the interrupt pin is active low */
+#define ADXL362_INT_LOW             (0x80u)
 
     /*! @} */
 
@@ -103,7 +132,7 @@ namespace adi_sensor_swpack
      **/
 #pragma pack(push)
 #pragma pack(4)
-    class ADXL362 : public Accelerometer
+    class ADXL362 : public Accelerometer, public SensorTask
     {
         public:
 
@@ -119,7 +148,12 @@ namespace adi_sensor_swpack
                 REG_DEVID             = 0x00,  /*!< ADXL362 device ID                     */
                 REG_DEVID_MST         = 0x01,  /*!< ADXL362 Analog Devices MEMS ID        */
                 REG_PARTID            = 0x02,  /*!< ADXL362 Part ID                       */
+                REG_XDATA             = 0x08,  /*!< X-axis acceleration, 8 MSBs           */
+                REG_YDATA             = 0x09,  /*!< Y-axis acceleration, 8 MSBs           */
+                REG_ZDATA             = 0x0A,  /*!< Z-axis acceleration, 8 MSBs           */
                 REG_STATUS            = 0x0B,  /*!< Status register                       */
+                REG_FIFO_ENTRIES_L    = 0x0C,  /*!< Valid FIFO entries, low byte          */
+                REG_FIFO_ENTRIES_H    = 0x0D,  /*!< Valid FIFO entries, high byte         */
                 REG_XDATA_L           = 0x0E,  /*!< X-axis acceleration low byte          */
                 REG_XDATA_H           = 0x0F,  /*!< X-axis acceleration high byte         */
                 REG_YDATA_L           = 0x10,  /*!< Y-axis acceleration low byte          */
@@ -137,6 +171,8 @@ namespace adi_sensor_swpack
                 REG_TIME_INACT_L      = 0x25,  /*!< Inactivity time register low          */
                 REG_TIME_INACT_H      = 0x26,  /*!< Inactivity time register high         */
                 REG_ACT_INACT_CTL     = 0x27,  /*!< Activity/Inactivity control register  */
+                REG_FIFO_CONTROL      = 0x28,  /*!< FIFO control register                 */
+                REG_FIFO_SAMPLES      = 0x29,  /*!< FIFO watermark, 8 LSBs                */
                 REG_INTMAP1           = 0x2A,  /*!< Interrupt-1 map register              */
                 REG_INTMAP2           = 0x2B,  /*!< Interrupt-2 map register              */
                 REG_FILTER_CTL        = 0x2C,  /*!< Filter control register               */
@@ -156,6 +192,33 @@ namespace adi_sensor_swpack
                 NOISE_MODE_ULOW   = 0x2,      /*!< Noise mode ultra low                   */
             } NOISE_MODE;
 
+            /*!
+             *  @enum   FIFO_MODE
+             *
+             *  @brief  ADXL362 FIFO modes
+             *
+             */
+            typedef enum
+            {
+                FIFO_DISABLED     = 0x0,      /*!< FIFO off                               */
+                FIFO_OLDEST_SAVED = 0x1,      /*!< Stops storing when full                */
+                FIFO_STREAM       = 0x2,      /*!< Overwrites the oldest entries          */
+                FIFO_TRIGGERED    = 0x3,      /*!< Keeps the samples around a trigger     */
+            } FIFO_MODE;
+
+            /*!
+             *  @struct ADXL362_CONFIG
+             *
+             *  @brief  Measurement settings that configure() programs together.
+             */
+            typedef struct
+            {
+                AXL_RANGE   eRange;             /*!< Measurement range                        */
+                AXL_ODR     eOdr;               /*!< Output data rate                         */
+                NOISE_MODE  eNoiseMode;         /*!< Noise mode, trades current for noise     */
+                bool        bHalfBandwidth;     /*!< Anti-aliasing filter at ODR/4 not ODR/2  */
+            } ADXL362_CONFIG;
+
             ADXL362();
             virtual ~ADXL362();
             virtual SENSOR_RESULT open();
@@ -166,6 +229,187 @@ namespace adi_sensor_swpack
             virtual SENSOR_RESULT getY(uint8_t *pBuffer, const uint32_t sizeInBytes);
             virtual SENSOR_RESULT getZ(uint8_t *pBuffer, const uint32_t sizeInBytes);
             virtual SENSOR_RESULT getXYZ(uint8_t *pBuffer, const uint32_t sizeInBytes);
+            virtual SENSOR_RESULT setOutputDataRate(const AXL_ODR odr);
+            virtual SENSOR_RESULT setRange(const AXL_RANGE range);
+
+            /*!
+             * @brief  Reads X, Y and Z at 8-bit resolution.
+             *
+             * @param  [out] pBuffer     : X, Y and Z as int8_t.
+             * @param  [in]  sizeInBytes : Size of pBuffer, at least 3.
+             *
+             * @return SENSOR_RESULT
+             *
+             * @details Reads the 8 most significant bits of the axes, 16 mg per count
+             *          in the 2g range, with one 3-byte burst after the data ready
+             *          check, half the bytes of getXYZ().
+             */
+            SENSOR_RESULT getXYZ8(uint8_t *pBuffer, const uint32_t sizeInBytes);
+
+            /*!
+             * @brief  Reads X, Y, Z and the temperature of the same sample.
+             *
+             * @param  [out] pBuffer     : X, Y, Z and temperature as int16_t.
+             * @param  [in]  sizeInBytes : Size of pBuffer, at least 8.
+             *
+             * @return SENSOR_RESULT
+             *
+             * @details One 8-byte burst from XDATA_L to TEMP_H. The offset drift set
+             *          by setDriftCompensation() is removed from the axes using the
+             *          temperature of the burst; the temperature is the raw register
+             *          value, see temperatureToMilliCelsius().
+             */
+            SENSOR_RESULT getXYZT(uint8_t *pBuffer, const uint32_t sizeInBytes);
+
+            /*!
+             * @brief  Sets the offset drift of the axes over temperature.
+             *
+             * @param  [in] pSlope     : X, Y and Z drift in 1/256 count per degree C.
+             * @param  [in] nReference : Temperature without offset error, m degree C.
+             *
+             * @details The defaults come from adi_adxl362_cfg.h.
+             */
+            void setDriftCompensation(const int16_t *pSlope, const int32_t nReference);
+
+            /*!
+             * @brief  Converts a temperature register value to m degree C.
+             *
+             * @details Uses the typical bias and scale of the data sheet. The error of
+             *          an uncalibrated part is a few degrees, the slope is accurate
+             *          enough for drift compensation.
+             */
+            static int32_t temperatureToMilliCelsius(const int16_t nRaw);
+
+            /*!
+             * @brief  Sets the noise mode.
+             *
+             * @param  [in] eNoiseMode : Normal, low noise or ultralow noise.
+             *
+             * @return SENSOR_RESULT
+             *
+             * @details Lower noise costs supply current, see the ADXL362 data sheet.
+             *          Programmed right away when measuring, like setOutputDataRate().
+             */
+            SENSOR_RESULT setNoiseMode(const NOISE_MODE eNoiseMode);
+
+            /*!
+             * @brief  Selects the bandwidth of the anti-aliasing filter.
+             *
+             * @param  [in] bHalfBandwidth : true for ODR/4, false for ODR/2.
+             *
+             * @return SENSOR_RESULT
+             */
+            SENSOR_RESULT setHalfBandwidth(const bool bHalfBandwidth);
+
+            /*!
+             * @brief  Changes range, output data rate, noise mode and bandwidth at once.
+             *
+             * @param  [in] sConfig : New settings.
+             *
+             * @return SENSOR_RESULT
+             *
+             * @details When measuring, the filter and power control registers are
+             *          written in a single SPI transaction and the measurement keeps
+             *          running. Nothing is written when the settings do not change.
+             */
+            SENSOR_RESULT configure(const ADXL362_CONFIG &sConfig);
+
+            /*!
+             * @brief  Returns the current settings.
+             */
+            void getConfig(ADXL362_CONFIG *pConfig);
+
+            /*!
+             * @brief  Sets the FIFO mode.
+             *
+             * @param  [in] eMode      : FIFO mode.
+             * @param  [in] nWatermark : Entries that set the watermark status, up
+             *                           to #ADXL362_FIFO_ENTRIES_MAX - 1.
+             *
+             * @return SENSOR_RESULT
+             *
+             * @details Every sample takes three entries, X, Y and Z.
+             */
+            SENSOR_RESULT setFifoMode(const FIFO_MODE eMode, const uint32_t nWatermark);
+
+            /*!
+             * @brief  Reads the number of valid FIFO entries.
+             *
+             * @param  [out] pEntries : Entries, up to #ADXL362_FIFO_ENTRIES_MAX.
+             *
+             * @return SENSOR_RESULT
+             */
+            SENSOR_RESULT getFifoEntries(uint32_t *pEntries);
+
+            /*!
+             * @brief  Drains FIFO entries in one burst.
+             *
+             * @param  [out] pBuffer     : Entries as uint16_t, the axis in bits 15:14
+             *                             and the sign extended sample below.
+             * @param  [in]  sizeInBytes : 2 bytes per entry, at most the entries
+             *                             reported by getFifoEntries().
+             *
+             * @return SENSOR_RESULT
+             *
+             * @details Bursts of ADI_SPI_DMA_CFG_THRESHOLD bytes or more are moved
+             *          with DMA, see adi_spi_dma.h. A half-word aligned pBuffer is
+             *          filled directly, other buffers go through a static copy.
+             */
+            SENSOR_RESULT readFifo(uint8_t *pBuffer, const uint32_t sizeInBytes);
+
+            /*!
+             * @brief  Enables the INT1 interrupt and stamps its edges.
+             *
+             * @param  [in] nMap       : ADXL362_INT_DATA_READY or
+             *                           ADXL362_INT_FIFO_WATERMARK.
+             * @param  [in] pfCallback : Called from the GPIO interrupt after the
+             *                           edge was stamped, or NULL.
+             * @param  [in] pCBParam   : Passed to pfCallback.
+             *
+             * @return SENSOR_RESULT
+             *
+             * @details The time of each edge is taken first thing in the
+             *          interrupt, getEdgeTime() returns it, so a sample carries
+             *          the time it was converted rather than the time it was
+             *          read. The GPIO is set in adi_adxl362_cfg.h.
+             */
+            SENSOR_RESULT enableInterrupt(const uint8_t nMap, ADI_CALLBACK const pfCallback, void *const pCBParam);
+
+            /*!
+             * @brief  Disables the INT1 interrupt.
+             *
+             * @return SENSOR_RESULT
+             */
+            SENSOR_RESULT disableInterrupt();
+
+            /*!
+             * @brief  Time of the last INT1 edge.
+             *
+             * @param  [out] pTime : adi_time_GetUs64() time of the edge.
+             *
+             * @return Edges so far, 0 when pTime is not valid yet.
+             */
+            uint32_t getEdgeTime(uint64_t *pTime)
+            {
+                return adi_tsync_GetEdge(&m_sEdge, pTime);
+            }
+
+            /*!
+             * @brief  Starts reading the next sample of the three axes.
+             *
+             * @param  [out] pBuffer     : Filled like getXYZ() when poll() returns SENSOR_ERROR_NONE.
+             * @param  [in]  sizeInBytes : At least 6 bytes.
+             *
+             * @return SENSOR_RESULT
+             *
+             * @details Each poll() reads the status register once, unlike getXYZ()
+             *          the axes are only read once the data ready bit is set. The read
+             *          times out after ADXL362_DATAREADY_PERIODS sample periods.
+             */
+            SENSOR_RESULT beginReadXYZ(uint8_t *pBuffer, const uint32_t sizeInBytes);
+
+            /* Inherited from SensorTask */
+            virtual SENSOR_RESULT poll();
             virtual SENSOR_RESULT readRegister(const uint32_t regAddr, uint8_t *pBuffer, uint32_t sizeInBytes);
             virtual SENSOR_RESULT writeRegister(const uint8_t regAddr, const uint32_t regValue, uint32_t sizeInBytes);
 
@@ -194,18 +438,61 @@ namespace adi_sensor_swpack
             /*!
              * @brief  Checks for the data
              *
-             * @param  iterCount : Iteration counter for graceful return
+             * @return true when a sample is ready
+             *
+             * @details Polls the status register, with an adi_time_Sleep() between
+             *          reads, for up to ADXL362_DATAREADY_PERIODS sample periods.
+             *          Returns at once in standby, when no sample will come.
+             */
+            bool           CheckDataReady();
+
+            /*!
+             * @brief  Sample period of the current output data rate, us
+             */
+            uint32_t       GetSamplePeriodUs() const;
+
+            /*!
+             * @brief  GPIO callback of INT1
+             */
+            static void    EdgeCallback(void *pCBParam, uint32_t Event, void *pArg);
+
+            /*!
+             * @brief  Writes the filter and power control registers
              *
              * @return SENSOR_RESULT
              *
-             * @details polls the accelerometer for data for specified number of times
+             * @details Programs the current range, output data rate, bandwidth, noise
+             *          mode and measurement state in one transaction, unless the
+             *          registers already hold these values.
              */
-            bool           CheckDataReady(const uint32_t iterCount);
+            SENSOR_RESULT  WriteControl();
 
             /*! SPI driver memory */
             uint8_t        m_spi_memory[ADI_SPI_MEMORY_SIZE];
             /*! SPI driver handle */
             ADI_SPI_HANDLE m_spi_handle;
+            /*! True while the accelerometer is in measurement mode */
+            bool           m_bMeasuring;
+            /*! True for the ODR/4 anti-aliasing filter */
+            bool           m_bHalfBandwidth;
+            /*! Noise mode */
+            NOISE_MODE     m_eNoiseMode;
+            /*! Last values written to FILTER_CTL and POWER_CTL, 0xFFFF when unknown */
+            uint16_t       m_nControl;
+            /*! Offset drift of each axis, 1/256 count per degree C */
+            int16_t        m_aDrift[3];
+            /*! Temperature without offset error, m degree C */
+            int32_t        m_nDriftReference;
+            /*! Destination of the running read */
+            uint8_t       *m_pTaskBuffer;
+            /*! Time of the last INT1 edge */
+            ADI_TSYNC_EDGE m_sEdge;
+            /*! Application INT1 callback */
+            ADI_CALLBACK   m_pfEdgeCallback;
+            /*! Parameter of m_pfEdgeCallback */
+            void          *m_pEdgeCBParam;
+            /*! GPIO driver memory */
+            uint8_t        m_gpio_memory[ADI_GPIO_MEMORY_SIZE];
     };
 #pragma pack(pop)
 }
@@ -0,0 +1,100 @@
+/*!
+ *****************************************************************************
+  @file adi_adxl362_temp.h
+
+  @brief ADXL362 temperature sensor interface.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#ifndef ADI_ADXL362_TEMP_H
+#define ADI_ADXL362_TEMP_H
+
+#include <temp/adi_temperature.h>
+#include <axl/adxl362/adi_adxl362.h>
+
+namespace adi_sensor_swpack
+{
+    /**
+     * @class ADXL362Temperature
+     *
+     * @brief Temperature interface to the sensor inside the ADXL362.
+     *
+     * @details The accelerometer object owns the SPI bus and the power mode, so
+     *          open(), start(), stop() and close() do nothing here; the ADXL362
+     *          must be open and measuring. Applications that already read the
+     *          axes with ADXL362::getXYZT() get the temperature from that burst.
+     **/
+    class ADXL362Temperature : public Temperature
+    {
+        public:
+            /*!
+             * @brief  Constructor.
+             *
+             * @param  [in] pAccelerometer : Opened ADXL362 that measures the temperature.
+             */
+            ADXL362Temperature(ADXL362 *pAccelerometer);
+
+            /*!< Pure virtual functions must be implemented by the derived class */
+            virtual SENSOR_RESULT open();
+            virtual SENSOR_RESULT start();
+            virtual SENSOR_RESULT stop();
+            virtual SENSOR_RESULT close();
+
+            /*! Returns the raw 12-bit register value as int16_t, sizeInBytes must be at least 2 */
+            virtual SENSOR_RESULT getTemperature(uint8_t *pTemperature, const uint32_t sizeInBytes);
+            virtual SENSOR_RESULT getTemperatureInFahrenheit(float *pTemperatureFahrenheit);
+
+            virtual SENSOR_RESULT getTemperatureInCelsius(float *pTemperatureCelsius);
+
+        private:
+            /*!
+             * @brief   Reads the temperature in m degree C.
+             */
+            SENSOR_RESULT ReadMilliCelsius(int32_t *pMilliCelsius);
+
+            ADXL362       *m_pAccelerometer;
+    };
+}
+
+#endif /* ADI_ADXL362_TEMP_H */
@@ -0,0 +1,155 @@
+/*!
+ *****************************************************************************
+  @file adi_adaptive_sampler.h
+
+  @brief Variance driven adaptive sample rate.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#ifndef ADI_ADAPTIVE_SAMPLER_H
+#define ADI_ADAPTIVE_SAMPLER_H
+
+#include <stdint.h>
+
+namespace adi_sensor_swpack
+{
+    /*! Maximum number of channels tracked by the sampler, e.g. X/Y/Z or R/G/B */
+#define ADI_SAMPLER_MAX_CHANNELS    (3u)
+
+    /**
+     * @class AdaptiveSampler
+     *
+     * @brief Chooses the sample period from the activity of the signal.
+     *
+     * @details The sampler keeps an exponentially weighted mean and variance
+     *          of every channel. The period is the maximum period divided by
+     *          a power of two, 2^step, and never below the minimum period:
+     *            - when the variance of any channel rises above the active
+     *              threshold the sampler jumps to the fastest step,
+     *            - when the variance of every channel stays below the quiet
+     *              threshold for the hold count, it backs off by one step.
+     *
+     *          The jump up keeps the start of an event, the slow back off
+     *          keeps the sampler from toggling on a signal near a threshold.
+     *          The application reprograms any hardware rate from getStep(),
+     *          each step doubles the rate. The default sampler never leaves
+     *          step 0.
+     */
+    class AdaptiveSampler
+    {
+        public:
+            AdaptiveSampler();
+
+            /*!
+             * @brief   Sets the bounds of the sample period.
+             *
+             * @param [in] nMinPeriod : Fastest period allowed.
+             * @param [in] nMaxPeriod : Period used while the signal is quiet.
+             *
+             * @details The number of steps is the number of times nMaxPeriod
+             *          can be halved without going below nMinPeriod. The
+             *          sampler restarts at step 0.
+             */
+            void setPeriod(uint32_t nMinPeriod, uint32_t nMaxPeriod);
+
+            /*!
+             * @brief   Sets the variance thresholds, in the units of the reading squared.
+             *
+             * @param [in] fActive : Variance above which the signal is active.
+             * @param [in] fQuiet  : Variance below which the signal is quiet.
+             *                       Must not be above fActive.
+             */
+            void setThreshold(float fActive, float fQuiet);
+
+            /*!
+             * @brief   Sets how the variance is tracked.
+             *
+             * @param [in] fWeight : Weight of a new reading, between 0 and 1.
+             *                       Higher values follow the signal faster.
+             * @param [in] nHold   : Number of quiet readings before the sampler
+             *                       backs off by one step.
+             */
+            void setTracking(float fWeight, uint32_t nHold);
+
+            /*!
+             * @brief   Feeds a reading to the sampler.
+             *
+             * @param [in] pValues     : Channel values.
+             * @param [in] nNumValues  : Number of channels, at most #ADI_SAMPLER_MAX_CHANNELS.
+             *
+             * @return  true if the step changed, and with it the period.
+             */
+            bool update(const float *pValues, uint32_t nNumValues);
+
+            /*!
+             * @brief   Returns the current sample period.
+             */
+            uint32_t getPeriod() const { return (m_nMaxPeriod >> m_nStep); }
+
+            /*!
+             * @brief   Returns the current step, 0 for the slowest rate.
+             */
+            uint32_t getStep() const { return m_nStep; }
+
+            /*!
+             * @brief   Returns the variance tracked for a channel.
+             */
+            float getVariance(uint32_t nChannel) const { return m_fVariance[nChannel]; }
+
+        private:
+            float    m_fActive;
+            float    m_fQuiet;
+            float    m_fWeight;
+            uint32_t m_nHold;
+            uint32_t m_nMaxPeriod;
+            uint32_t m_nMaxStep;
+            uint32_t m_nStep;
+            uint32_t m_nQuietCount;
+            bool     m_bPrimed;
+            float    m_fMean[ADI_SAMPLER_MAX_CHANNELS];
+            float    m_fVariance[ADI_SAMPLER_MAX_CHANNELS];
+    };
+}
+
+#endif /* ADI_ADAPTIVE_SAMPLER_H */
@@ -0,0 +1,146 @@
+/*!
+ *****************************************************************************
+  @file adi_report_policy.h
+
+  @brief Report-by-exception policy for sensor readings.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#ifndef ADI_REPORT_POLICY_H
+#define ADI_REPORT_POLICY_H
+
+#include <stdint.h>
+
+namespace adi_sensor_swpack
+{
+    /*! Maximum number of channels of one reading, e.g. X/Y/Z or R/G/B */
+#define ADI_REPORT_MAX_CHANNELS     (3u)
+
+    /**
+     * @class ReportPolicy
+     *
+     * @brief Decides which sensor readings are worth sending.
+     *
+     * @details An application keeps one ReportPolicy per sensor and asks it
+     *          before each packet is sent. A reading is reported when:
+     *            - it is the first reading, or force() was called,
+     *            - any channel moved from the last reported value by at least
+     *              the deadband, the larger of the absolute deadband and the
+     *              relative deadband times the last reported value,
+     *            - or the heartbeat interval has elapsed since the last report,
+     *          and at least the minimum interval has elapsed since the last
+     *          report. A change held back by the minimum interval is still
+     *          reported later because it is measured against the last
+     *          reported value.
+     *
+     *          Intervals are in the units of the timestamps passed to
+     *          shouldReport(), normally GET_TIME(). The timestamps must come
+     *          from a running clock, started with INIT_TIME(): with a stopped
+     *          clock the heartbeat never fires and a quiet sensor is never
+     *          reported again. The default policy reports every reading.
+     */
+    class ReportPolicy
+    {
+        public:
+            ReportPolicy();
+
+            /*!
+             * @brief   Sets the deadband.
+             *
+             * @param [in] fAbsolute : Smallest change reported, in the units of the reading.
+             * @param [in] fRelative : Smallest change reported, as a fraction of the last
+             *                         reported value (0.05 for 5%).
+             */
+            void setDeadband(float fAbsolute, float fRelative);
+
+            /*!
+             * @brief   Sets the report intervals.
+             *
+             * @param [in] nMinInterval : No two reports closer than this, 0 for no limit.
+             * @param [in] nHeartbeat   : Report at least this often, 0 for no heartbeat.
+             */
+            void setInterval(uint32_t nMinInterval, uint32_t nHeartbeat);
+
+            /*!
+             * @brief   Reports the next reading regardless of the deadband and
+             *          minimum interval, e.g. after a new connection.
+             */
+            void force() { m_bForce = true; }
+
+            /*!
+             * @brief   Checks a reading against the policy.
+             *
+             * @param [in] nTime       : Timestamp of the reading.
+             * @param [in] pValues     : Channel values.
+             * @param [in] nNumValues  : Number of channels, at most #ADI_REPORT_MAX_CHANNELS.
+             *
+             * @return  true if the reading is to be sent. The reading then becomes
+             *          the reference for the next decisions.
+             */
+            bool shouldReport(uint32_t nTime, const float *pValues, uint32_t nNumValues);
+
+            /*!
+             * @brief   Returns the number of readings reported.
+             */
+            uint32_t getReported() const { return m_nReported; }
+
+            /*!
+             * @brief   Returns the number of readings held back.
+             */
+            uint32_t getSuppressed() const { return m_nSuppressed; }
+
+        private:
+            float    m_fAbsolute;
+            float    m_fRelative;
+            uint32_t m_nMinInterval;
+            uint32_t m_nHeartbeat;
+            uint32_t m_nLastTime;
+            float    m_fLast[ADI_REPORT_MAX_CHANNELS];
+            bool     m_bForce;
+            uint32_t m_nReported;
+            uint32_t m_nSuppressed;
+    };
+}
+
+#endif /* ADI_REPORT_POLICY_H */
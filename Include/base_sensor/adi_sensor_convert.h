@@ -0,0 +1,247 @@
+/*!
+ *****************************************************************************
+  @file adi_sensor_convert.h
+
+  @brief Batch conversion of raw sensor samples to engineering units.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#ifndef ADI_SENSOR_CONVERT_H
+#define ADI_SENSOR_CONVERT_H
+
+#include <stdint.h>
+
+/*! @addtogroup adi_sensor_convert Sensor Unit Conversion
+ *  @ingroup common
+ *  @brief Array conversion kernels with the scale factors fixed at compile time.
+ *  @details Each class is specialized on the sensor setting that sets its scale,
+ *           given as the value of the driver enum so this header stays free of
+ *           driver includes and builds on the host too:
+ *             - AxlConvert      : #Accelerometer::AXL_RANGE value, counts to mg.
+ *             - Ad7798Convert   : #AD7798::GAIN and #AD7798::CODING_MODE values,
+ *                                 codes to uV.
+ *             - LuxConvert      : mlux per code of a CN0397 channel, codes to mlux.
+ *             - Adt7420Convert  : ADT7420 resolution in bits, register values to
+ *                                 m degree C.
+ *
+ *           Every class has an integer kernel for the target, with rounding and
+ *           64-bit intermediates where needed, and a float kernel for the host
+ *           decoder. The float kernels are a single multiply-add per element with
+ *           no branches, which compilers vectorize.
+ *  @{
+ */
+
+namespace adi_sensor_swpack
+{
+    /**
+     * @class AxlConvert
+     *
+     * @brief ADXL362 counts to mg.
+     *
+     * @details The ADXL362 resolution is 1, 2 and 4 mg per count in the
+     *          2g, 4g and 8g range.
+     */
+    template <uint32_t nRange>
+    class AxlConvert
+    {
+        public:
+            /*! Resolution in mg per count */
+            static const int32_t kMilliGPerCount = (int32_t)(1u << nRange);
+            /*! Resolution of the 8-bit registers, see ADXL362::getXYZ8() */
+            static const int32_t kMilliGPerCount8 = kMilliGPerCount << 4;
+
+            /*! Target kernel, exact */
+            static void toMilliG(const int16_t *pRaw, int32_t *pOut, uint32_t nCount)
+            {
+                for(uint32_t i = 0u; i < nCount; i++)
+                {
+                    pOut[i] = (int32_t) pRaw[i] * kMilliGPerCount;
+                }
+            }
+
+            /*! Host kernel */
+            static void toMilliG(const int16_t * __restrict pRaw, float * __restrict pOut, uint32_t nCount)
+            {
+                for(uint32_t i = 0u; i < nCount; i++)
+                {
+                    pOut[i] = (float) pRaw[i] * (float) kMilliGPerCount;
+                }
+            }
+
+            /*! Target kernel for 8-bit samples, exact */
+            static void toMilliG(const int8_t *pRaw, int32_t *pOut, uint32_t nCount)
+            {
+                for(uint32_t i = 0u; i < nCount; i++)
+                {
+                    pOut[i] = (int32_t) pRaw[i] * kMilliGPerCount8;
+                }
+            }
+
+            /*! Host kernel for 8-bit samples */
+            static void toMilliG(const int8_t * __restrict pRaw, float * __restrict pOut, uint32_t nCount)
+            {
+                for(uint32_t i = 0u; i < nCount; i++)
+                {
+                    pOut[i] = (float) pRaw[i] * (float) kMilliGPerCount8;
+                }
+            }
+    };
+
+    /**
+     * @class Ad7798Convert
+     *
+     * @brief AD7798 codes to uV at the ADC input.
+     *
+     * @details Unipolar coding gives 0 V at code 0 and Vref / gain at full
+     *          scale; bipolar coding is offset binary around code 0x8000.
+     *          nRefMilliVolt defaults to AD7798_REFERENCE_VOLTAGE.
+     */
+    template <uint32_t nGain, uint32_t nCoding, uint32_t nRefMilliVolt = 3150u>
+    class Ad7798Convert
+    {
+        public:
+            /*! Code of 0 V */
+            static const int32_t  kZeroCode = (nCoding == 0u) ? 0x8000 : 0;
+            /*! Weight of one code is kRefMicroVolt >> kShift */
+            static const int64_t  kRefMicroVolt = (int64_t) nRefMilliVolt * 1000;
+            static const uint32_t kShift = ((nCoding == 0u) ? 15u : 16u) + nGain;
+
+            /*! Target kernel, rounded to the nearest uV */
+            static void toMicroVolt(const uint16_t *pRaw, int32_t *pOut, uint32_t nCount)
+            {
+                for(uint32_t i = 0u; i < nCount; i++)
+                {
+                    int64_t nProduct = ((int64_t) pRaw[i] - kZeroCode) * kRefMicroVolt;
+                    pOut[i] = (int32_t)((nProduct + ((int64_t) 1 << (kShift - 1u))) >> kShift);
+                }
+            }
+
+            /*! Host kernel */
+            static void toMicroVolt(const uint16_t * __restrict pRaw, float * __restrict pOut, uint32_t nCount)
+            {
+                const float fScale = (float) kRefMicroVolt / (float)((uint64_t) 1 << kShift);
+
+                for(uint32_t i = 0u; i < nCount; i++)
+                {
+                    pOut[i] = (float)((int32_t) pRaw[i] - kZeroCode) * fScale;
+                }
+            }
+    };
+
+    /**
+     * @class LuxConvert
+     *
+     * @brief CN0397 codes to mlux.
+     *
+     * @details The constants of the channels are LIGHT_INTENSITY_CONSTANT_RED,
+     *          _GREEN and _BLUE in mlux, see the typedefs below.
+     */
+    template <uint32_t nMilliLuxPerCode>
+    class LuxConvert
+    {
+        public:
+            /*! Target kernel, exact */
+            static void toMilliLux(const uint16_t *pRaw, int32_t *pOut, uint32_t nCount)
+            {
+                for(uint32_t i = 0u; i < nCount; i++)
+                {
+                    pOut[i] = (int32_t)((uint32_t) pRaw[i] * nMilliLuxPerCode);
+                }
+            }
+
+            /*! Host kernel */
+            static void toMilliLux(const uint16_t * __restrict pRaw, float * __restrict pOut, uint32_t nCount)
+            {
+                for(uint32_t i = 0u; i < nCount; i++)
+                {
+                    pOut[i] = (float) pRaw[i] * (float) nMilliLuxPerCode;
+                }
+            }
+    };
+
+    typedef LuxConvert<2122u> Cn0397RedConvert;     /*!< Red photodiode channel   */
+    typedef LuxConvert<2124u> Cn0397GreenConvert;   /*!< Green photodiode channel */
+    typedef LuxConvert<2113u> Cn0397BlueConvert;    /*!< Blue photodiode channel  */
+
+    /**
+     * @class Adt7420Convert
+     *
+     * @brief ADT7420 temperature register values to m degree C.
+     *
+     * @details The input is the 16-bit temperature register, MSB first as read,
+     *          assembled into a uint16_t. It is two's complement with 1/128 degree
+     *          per LSB; in 13-bit mode the three status bits at the bottom are
+     *          masked off, which leaves 1/16 degree steps. nBits is 13 or 16.
+     */
+    template <uint32_t nBits>
+    class Adt7420Convert
+    {
+        public:
+            /*! Temperature bits of the register */
+            static const uint16_t kMask = (nBits == 16u) ? 0xFFFFu : 0xFFF8u;
+
+            /*! Target kernel, rounded to the nearest m degree */
+            static void toMilliCelsius(const uint16_t *pRaw, int32_t *pOut, uint32_t nCount)
+            {
+                for(uint32_t i = 0u; i < nCount; i++)
+                {
+                    /* 1000 / 128 = 125 / 16 */
+                    pOut[i] = (((int32_t)(int16_t)(pRaw[i] & kMask) * 125) + 8) >> 4;
+                }
+            }
+
+            /*! Host kernel */
+            static void toMilliCelsius(const uint16_t * __restrict pRaw, float * __restrict pOut, uint32_t nCount)
+            {
+                for(uint32_t i = 0u; i < nCount; i++)
+                {
+                    pOut[i] = (float)(int16_t)(pRaw[i] & kMask) * 7.8125f;
+                }
+            }
+    };
+}
+
+/*! @} */
+
+#endif /* ADI_SENSOR_CONVERT_H */
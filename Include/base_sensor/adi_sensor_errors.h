@@ -123,6 +123,14 @@ namespace adi_sensor_swpack
 
     /*! Printf wrapper to easily change the print behavior */
 #define PRINTF(x) printf x
+#elif defined(ADI_LOG_DEFERRED_MODE)
+#define ASSERT(x)
+
+    /*! Deferred records are cheap enough to keep sensor errors in release builds */
+#define PRINT_SENSOR_ERROR(result) ADI_LOG_DEFERRED("Sensor Error = %X\tDriver Error = %X\r\n", (int) GET_SENSOR_ERROR_TYPE(result), (int) GET_DRIVER_ERROR_CODE(result))
+
+    /*! Format string and arguments are sent as a binary record, see Host/Tools/log_decode */
+#define PRINTF(x) ADI_LOG_DEFERRED x
 #else
 #define ASSERT(x)
 #define PRINT_SENSOR_ERROR(result)
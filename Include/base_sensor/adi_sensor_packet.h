@@ -119,6 +119,10 @@ typedef enum
     ADI_TEMPERATURE_TYPE          = 0x03u, /*!< Temperature sensor type */
     ADI_VISIBLELIGHT_TYPE         = 0x04u, /*!< Visible light sensor type */
     ADI_PRINTSTRING_TYPE          = 0x05u, /*!< Print string sensor type */
+    ADI_STATISTICS_TYPE           = 0x06u, /*!< Window statistics of another sensor, see #ADI_STATISTICS_DATA */
+    ADI_VIBRATION_TYPE            = 0x07u, /*!< Vibration spectrum summary of an accelerometer axis, see #ADI_VIBRATION_DATA */
+    ADI_ORIENTATION_TYPE          = 0x08u, /*!< Pitch, roll and tilt of an accelerometer, see #ADI_ORIENTATION_DATA */
+    ADI_ACCELEROMETER_8BIT_TYPE   = 0x09u, /*!< Up to four 8-bit accelerometer samples, see #ADI_ACCELEROMETER_8BIT_DATA */
     ADI_ACCELEROMETER_4G_TYPE     = 0x0Bu, /*!< Accelerometer (4G) type */
     ADI_ACCELEROMETER_8G_TYPE     = 0x0Cu, /*!< Accelerometer (8G) type */
 } ADI_SENSOR_TYPE;
@@ -178,6 +182,25 @@ typedef struct
 } ADI_ACCELEROMETER_DATA;
 #pragma pack(pop)
 
+/*!
+ *  @struct ADI_ACCELEROMETER_8BIT_DATA
+ *
+ *  @brief  Data structure for the #ADI_ACCELEROMETER_8BIT_TYPE. The timestamp
+ *          of the packet is that of the newest sample, the samples are one
+ *          output data rate period apart.
+ *
+ */
+#pragma pack(push)
+#pragma pack(1)
+typedef struct
+{
+    uint8_t           nRange;            /*!< AXL_RANGE, a count is 16 mg at 2g, 32 mg at 4g, 64 mg at 8g */
+    uint8_t           nCount;            /*!< Number of valid samples, 1 to 4                           */
+    int8_t            aSample[4][3];     /*!< X, Y and Z of each sample, oldest first                   */
+
+} ADI_ACCELEROMETER_8BIT_DATA;
+#pragma pack(pop)
+
 /*!
  *  @struct ADI_VISUAL_LIGHT_DATA
  *
@@ -195,6 +218,67 @@ typedef struct
 } ADI_VISUAL_LIGHT_DATA;
 #pragma pack(pop)
 
+/*!
+ *  @struct ADI_STATISTICS_DATA
+ *
+ *  @brief  Data structure for the #ADI_STATISTICS_TYPE data type. One packet
+ *          summarizes one window of one channel; the header carries the ID of
+ *          the sensor the samples came from.
+ *
+ */
+#pragma pack(push)
+#pragma pack(1)
+typedef struct
+{
+    uint8_t         nChannel;         /*!< Channel of the sensor, e.g. 0 to 2 for X, Y and Z     */
+    uint8_t         aCount[2];        /*!< Number of samples in the window                       */
+    uint8_t         aMin[2];          /*!< Smallest sample                                       */
+    uint8_t         aMax[2];          /*!< Largest sample                                        */
+    uint8_t         aMean[4];         /*!< Mean, signed with 8 fraction bits                     */
+    uint8_t         aStdDev[2];       /*!< Sample standard deviation, 4 fraction bits, saturated */
+    uint8_t         nReserved;        /*!< Unused, sent as 0                                     */
+
+} ADI_STATISTICS_DATA;
+#pragma pack(pop)
+
+/*!
+ *  @struct ADI_VIBRATION_DATA
+ *
+ *  @brief  Data structure for the #ADI_VIBRATION_TYPE data type. One packet
+ *          summarizes the spectrum of one window of one accelerometer axis.
+ *
+ */
+#pragma pack(push)
+#pragma pack(1)
+typedef struct
+{
+    uint8_t         nAxis;            /*!< 0 to 2 for X, Y and Z                          */
+    uint8_t         aPeakFreq[2];     /*!< Frequency of the strongest component, 0.1 Hz   */
+    uint8_t         aPeakAmp[2];      /*!< Amplitude of the strongest component, counts   */
+    uint8_t         aBandRms[4][2];   /*!< RMS acceleration of each band, counts          */
+    uint8_t         nReserved;        /*!< Unused, sent as 0                              */
+
+} ADI_VIBRATION_DATA;
+#pragma pack(pop)
+
+/*!
+ *  @struct ADI_ORIENTATION_DATA
+ *
+ *  @brief  Data structure for the #ADI_ORIENTATION_TYPE data type.
+ *
+ */
+#pragma pack(push)
+#pragma pack(1)
+typedef struct
+{
+    uint8_t         aPitch[2];        /*!< Pitch, signed, 0.01 degree                     */
+    uint8_t         aRoll[2];         /*!< Roll, signed, 0.01 degree                      */
+    uint8_t         aTilt[2];         /*!< Angle of Z from the vertical, 0.01 degree      */
+    uint8_t         nEvents;          /*!< ADI_ORIENTATION_EVENT bits of this packet      */
+
+} ADI_ORIENTATION_DATA;
+#pragma pack(pop)
+
 /*!
  *  @struct ADI_DATA_PACKET
  *
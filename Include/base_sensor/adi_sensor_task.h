@@ -0,0 +1,283 @@
+/*!
+ *****************************************************************************
+  @file adi_sensor_task.h
+
+  @brief Resumable sensor operations and their scheduler.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#ifndef ADI_SENSOR_TASK_H
+#define ADI_SENSOR_TASK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <drivers/general/adi_drivers_general.h>
+#include <base_sensor/adi_sensor_errors.h>
+#include <common/adi_time.h>
+
+namespace adi_sensor_swpack
+{
+    /*! Returned by SensorTask::poll() while the operation is not done, no error type uses it */
+#define SENSOR_TASK_PENDING         (0xFF000000ul)
+
+    /*! Number of tasks a SensorScheduler holds */
+#define SENSOR_SCHEDULER_MAX_TASKS  (8u)
+
+    /*
+     * Local continuations for SensorTask::poll(). The body of poll() sits
+     * between SENSOR_TASK_BEGIN() and SENSOR_TASK_END(); each wait saves the
+     * source line and returns, and the next poll() jumps back to it through
+     * the switch. Local variables are not kept across a wait, so the state of
+     * an operation lives in members. The body must not use switch statements,
+     * and two waits must not share a line.
+     */
+
+    /*! Starts the body of poll() */
+#define SENSOR_TASK_BEGIN()          switch(m_nTaskLine) { case 0u:
+
+    /*! Returns SENSOR_TASK_PENDING from poll() until cond is true */
+#define SENSOR_TASK_WAIT_UNTIL(cond) do { m_nTaskLine = __LINE__; case __LINE__: \
+                                          if(!(cond)) { return(SENSOR_TASK_PENDING); } } while(0)
+
+    /*! Returns SENSOR_TASK_PENDING from poll() until the time reaches wake, see adi_time_Deadline() */
+#define SENSOR_TASK_SLEEP_UNTIL(wake) do { m_nTaskWake = (wake); m_nTaskLine = __LINE__; case __LINE__: \
+                                           if(!adi_time_IsExpired(m_nTaskWake)) { return(SENSOR_TASK_PENDING); } } while(0)
+
+    /*! Returns SENSOR_TASK_PENDING once so other tasks can run */
+#define SENSOR_TASK_YIELD()          do { m_nTaskLine = __LINE__; return(SENSOR_TASK_PENDING); \
+                                          case __LINE__: ; } while(0)
+
+    /*! Finishes the operation with result */
+#define SENSOR_TASK_EXIT(result)     do { m_nTaskLine = 0u; m_bTaskBusy = false; return(result); } while(0)
+
+    /*! Ends the body of poll() and finishes the operation with result */
+#define SENSOR_TASK_END(result)      default: break; } SENSOR_TASK_EXIT(result)
+
+    /**
+     * @class SensorTask
+     *
+     * @brief Operation of a sensor that runs in steps instead of blocking.
+     *
+     * @details A driver starts an operation with one of its begin functions,
+     *          which only records what to do. Each poll() then does one short
+     *          step, e.g. a single status read, and returns
+     *          #SENSOR_TASK_PENDING until the operation is done, then its
+     *          SENSOR_RESULT. One operation runs at a time per sensor. A
+     *          SensorScheduler, or the main loop directly, polls several
+     *          sensors in turn so their conversions overlap.
+     *
+     *          Timeouts are deadlines on the adi_time clock, set by the begin
+     *          function from the conversion time of the part.
+     */
+    class SensorTask
+    {
+        public:
+            SensorTask() : m_nTaskLine(0u), m_nTaskDeadline(0u), m_nTaskWake(0u), m_bTaskBusy(false) {}
+
+            /*!
+             * @brief   Runs the next step of the current operation.
+             *
+             * @return  #SENSOR_TASK_PENDING, or the SENSOR_RESULT of the
+             *          operation once it is done. SENSOR_ERROR_NONE when idle.
+             */
+            virtual SENSOR_RESULT poll() = 0;
+
+            /*!
+             * @brief   Returns true from a begin function until poll() returns a result.
+             */
+            bool isBusy() const
+            {
+                return m_bTaskBusy;
+            }
+
+            /*!
+             * @brief   Drops the current operation.
+             *
+             * @details The part may still be converting or calibrating.
+             */
+            void cancel()
+            {
+                m_nTaskLine = 0u;
+                m_bTaskBusy = false;
+            }
+
+        protected:
+
+            /*!
+             * @brief   Starts a new operation, false if one is running.
+             *
+             * @param [in] nTimeoutUs : Time the operation may take, us.
+             */
+            bool BeginTask(uint32_t nTimeoutUs)
+            {
+                if(m_bTaskBusy) {
+                    return false;
+                }
+
+                m_nTaskLine     = 0u;
+                m_nTaskDeadline = adi_time_Deadline(nTimeoutUs);
+                m_nTaskWake     = adi_time_GetUs();
+                m_bTaskBusy     = true;
+
+                return true;
+            }
+
+            /*!
+             * @brief   True once the operation ran out of time.
+             */
+            bool IsTaskExpired() const
+            {
+                return adi_time_IsExpired(m_nTaskDeadline);
+            }
+
+            /*!
+             * @brief   Polls the current operation until it is done.
+             *
+             * @details Lets the blocking functions of a driver share the code of
+             *          its operations. Between polls the core sleeps until the
+             *          wake time of SENSOR_TASK_SLEEP_UNTIL(), or for
+             *          adi_time_Sleep() while a status bit is polled.
+             */
+            SENSOR_RESULT WaitTask()
+            {
+                SENSOR_RESULT eResult;
+
+                while((eResult = poll()) == SENSOR_TASK_PENDING) {
+                    if(adi_time_IsExpired(m_nTaskWake)) {
+                        adi_time_Sleep();
+                    }
+                    else {
+                        adi_time_SleepUntil(m_nTaskWake);
+                    }
+                }
+
+                return eResult;
+            }
+
+            uint32_t m_nTaskLine;     /*!< Line to resume poll() at, 0 at the start */
+            uint32_t m_nTaskDeadline; /*!< Time the operation times out, us         */
+            uint32_t m_nTaskWake;     /*!< Time poll() has something to do again    */
+            bool     m_bTaskBusy;     /*!< An operation is running                   */
+    };
+
+    /**
+     * @class SensorScheduler
+     *
+     * @brief Polls the running operations of several sensors.
+     *
+     * @details Call tick() from the main loop. Every busy task gets one poll()
+     *          per tick, in the order they were added, and the callback of a
+     *          task runs with Event set to the SENSOR_RESULT and pArg to the
+     *          task when its operation is done.
+     */
+    class SensorScheduler
+    {
+        public:
+            SensorScheduler() : m_nTasks(0u) {}
+
+            /*!
+             * @brief   Adds a task.
+             *
+             * @param [in] pTask      : Sensor to poll.
+             * @param [in] pfCallback : Called when an operation of the task is done, or NULL.
+             * @param [in] pCBParam   : Passed to pfCallback.
+             *
+             * @return  false when #SENSOR_SCHEDULER_MAX_TASKS are already added.
+             */
+            bool add(SensorTask *pTask, ADI_CALLBACK pfCallback, void *pCBParam)
+            {
+                if(m_nTasks == SENSOR_SCHEDULER_MAX_TASKS) {
+                    return false;
+                }
+
+                m_aEntries[m_nTasks].pTask      = pTask;
+                m_aEntries[m_nTasks].pfCallback = pfCallback;
+                m_aEntries[m_nTasks].pCBParam   = pCBParam;
+                m_nTasks++;
+
+                return true;
+            }
+
+            /*!
+             * @brief   Polls every busy task once.
+             *
+             * @return  Number of tasks still busy.
+             */
+            uint32_t tick()
+            {
+                SENSOR_RESULT eResult;
+                uint32_t      nBusy = 0u;
+
+                for(uint32_t i = 0u; i < m_nTasks; i++) {
+                    SensorTask *pTask = m_aEntries[i].pTask;
+
+                    if(pTask->isBusy()) {
+                        if((eResult = pTask->poll()) == SENSOR_TASK_PENDING) {
+                            nBusy++;
+                        }
+                        else if(m_aEntries[i].pfCallback != NULL) {
+                            m_aEntries[i].pfCallback(m_aEntries[i].pCBParam, eResult, pTask);
+                        }
+                    }
+                }
+
+                return nBusy;
+            }
+
+        private:
+
+            /*! Task and its callback */
+            typedef struct
+            {
+                SensorTask     *pTask;
+                ADI_CALLBACK    pfCallback;
+                void           *pCBParam;
+            } SENSOR_SCHEDULER_ENTRY;
+
+            SENSOR_SCHEDULER_ENTRY  m_aEntries[SENSOR_SCHEDULER_MAX_TASKS];
+            uint32_t                m_nTasks;
+    };
+}
+
+#endif /* ADI_SENSOR_TASK_H */
@@ -0,0 +1,220 @@
+/*!
+ *****************************************************************************
+  @file adi_uplink_scheduler.h
+
+  @brief Priority scheduler for the packets of several sensors sharing one radio link.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#ifndef ADI_UPLINK_SCHEDULER_H
+#define ADI_UPLINK_SCHEDULER_H
+
+#include <stdint.h>
+#include <base_sensor/adi_sensor_packet.h>
+
+namespace adi_sensor_swpack
+{
+    /*! Number of sensor queues */
+#define ADI_UPLINK_MAX_QUEUES       (4u)
+    /*! Packets held by each sensor queue */
+#define ADI_UPLINK_QUEUE_DEPTH      (8u)
+    /*! Alarm packets held, shared by all queues */
+#define ADI_UPLINK_ALARM_DEPTH      (4u)
+
+    /*!
+     * @brief Statistics of one queue, see UplinkScheduler::getStats().
+     */
+    typedef struct
+    {
+        uint32_t nSent;             /*!< Packets sent, alarms included                  */
+        uint32_t nAlarms;           /*!< Alarm packets sent                             */
+        uint32_t nDropped;          /*!< Sensor packets lost to a full queue            */
+        uint32_t nAlarmsRefused;    /*!< Alarm pushes refused by a full alarm queue     */
+        uint32_t nLatencyMean;      /*!< Mean time from push to pop of the sent packets */
+        uint32_t nLatencyMax;       /*!< Longest time from push to pop                  */
+    } ADI_UPLINK_STATS;
+
+    /**
+     * @class UplinkScheduler
+     *
+     * @brief Orders the packets of several sensors onto one radio link.
+     *
+     * @details Each sensor pushes its ADI_DATA_PACKETs into its own queue. The
+     *          application drains the scheduler whenever the link can take a
+     *          packet: peek() picks the next packet, and pop() removes it once
+     *          adi_radio_DE_SendData accepted it. A packet the radio refused stays
+     *          at the head of its queue for the next attempt.
+     *
+     *          The next packet is chosen as follows:
+     *            - alarm packets first, oldest first, regardless of rate limits,
+     *            - then the head of the highest priority queue that has a token,
+     *              the oldest head between queues of the same priority.
+     *
+     *          Each queue has a token bucket of burst packets, refilled at its
+     *          rate, so a fast sensor cannot starve the link. A full queue drops
+     *          its oldest packet, the newest reading being the one worth sending.
+     *
+     *          Times are in ms, normally GET_TIME(). The default queue has
+     *          priority 0, the highest, and no rate limit.
+     */
+    class UplinkScheduler
+    {
+        public:
+            UplinkScheduler();
+
+            /*!
+             * @brief   Configures a queue.
+             *
+             * @param [in] nQueue    : Queue, less than #ADI_UPLINK_MAX_QUEUES.
+             * @param [in] nPriority : 0 is served first.
+             * @param [in] nRate     : Packets per second, 0 for no limit.
+             * @param [in] nBurst    : Packets that may be sent back to back after the
+             *                         queue was idle, at least 1.
+             */
+            void setQueue(uint32_t nQueue, uint8_t nPriority, uint32_t nRate, uint32_t nBurst);
+
+            /*!
+             * @brief   Queues a packet.
+             *
+             * @param [in] nQueue  : Queue of the sensor.
+             * @param [in] pPacket : Packet, copied.
+             * @param [in] nTime   : Current time.
+             * @param [in] bAlarm  : Send ahead of all other packets and past the rate limit.
+             *
+             * @return  false if the queue number is invalid or the alarm queue is full.
+             *          A refused alarm is not queued, the caller pushes it again
+             *          once packets were sent. A full sensor queue makes room by
+             *          dropping its oldest packet.
+             */
+            bool push(uint32_t nQueue, const ADI_DATA_PACKET *pPacket, uint32_t nTime, bool bAlarm = false);
+
+            /*!
+             * @brief   Returns the next packet to send, NULL if none is due.
+             *
+             * @param [in] nTime : Current time, used to refill the token buckets.
+             */
+            const ADI_DATA_PACKET *peek(uint32_t nTime);
+
+            /*!
+             * @brief   Removes the packet returned by the last peek(), once it was sent.
+             *
+             * @param [in] nTime : Current time, the latency is measured to it.
+             */
+            void pop(uint32_t nTime);
+
+            /*!
+             * @brief   Returns the number of packets waiting, alarms included.
+             */
+            uint32_t getPending() const;
+
+            /*!
+             * @brief   Returns the statistics of a queue.
+             *
+             * @param [in]  nQueue : Queue.
+             * @param [out] pStats : Statistics since the last resetStats().
+             */
+            void getStats(uint32_t nQueue, ADI_UPLINK_STATS *pStats) const;
+
+            /*!
+             * @brief   Clears the statistics of all queues.
+             */
+            void resetStats();
+
+            /*!
+             * @brief   Drops all waiting packets, e.g. when the central disconnects.
+             *          The dropped packets are not counted.
+             */
+            void clear();
+
+        private:
+            /* A queued packet and the time it was pushed */
+            typedef struct
+            {
+                ADI_DATA_PACKET sPacket;
+                uint32_t        nTime;
+                uint8_t         nQueue;
+            } SLOT;
+
+            /* A ring of slots */
+            typedef struct
+            {
+                SLOT    *pSlots;
+                uint8_t  nSize;
+                uint8_t  nHead;
+                uint8_t  nCount;
+            } RING;
+
+            /* A sensor queue, its token bucket and its statistics */
+            typedef struct
+            {
+                SLOT     aSlots[ADI_UPLINK_QUEUE_DEPTH];
+                RING     sRing;
+                uint8_t  nPriority;
+                uint32_t nRate;
+                uint32_t nBurst;
+                uint32_t nTokens;
+                uint32_t nLastRefill;
+                uint32_t nSent;
+                uint32_t nAlarms;
+                uint32_t nDropped;
+                uint32_t nAlarmsRefused;
+                uint32_t nLatencyMax;
+                uint64_t nLatencySum;
+            } QUEUE;
+
+            static SLOT *Head(RING *pRing);
+            static SLOT *Append(RING *pRing);
+            static void  Remove(RING *pRing);
+
+            void Refill(QUEUE *pQueue, uint32_t nTime);
+
+            QUEUE    m_aQueue[ADI_UPLINK_MAX_QUEUES];
+            SLOT     m_aAlarmSlots[ADI_UPLINK_ALARM_DEPTH];
+            RING     m_sAlarm;
+            /* Source of the packet returned by peek(), a queue, ALARM or NONE */
+            uint32_t m_nSelected;
+    };
+}
+
+#endif /* ADI_UPLINK_SCHEDULER_H */
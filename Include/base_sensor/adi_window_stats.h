@@ -0,0 +1,178 @@
+/*!
+ *****************************************************************************
+  @file adi_window_stats.h
+
+  @brief Streaming window statistics of sensor readings.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#ifndef ADI_WINDOW_STATS_H
+#define ADI_WINDOW_STATS_H
+
+#include <stdint.h>
+#include <base_sensor/adi_sensor_packet.h>
+
+namespace adi_sensor_swpack
+{
+    /*! Fraction bits of the mean and variance in #ADI_STATS_RESULT */
+#define ADI_STATS_FRAC_BITS         (8u)
+
+    /*! Largest window, the count is sent as 16 bits */
+#define ADI_STATS_MAX_WINDOW        (65535u)
+
+    /*!
+     *  @struct ADI_STATS_RESULT
+     *
+     *  @brief  Statistics of one complete window.
+     */
+    typedef struct
+    {
+        uint32_t    nCount;         /*!< Number of samples                                      */
+        int16_t     nMin;           /*!< Smallest sample                                        */
+        int16_t     nMax;           /*!< Largest sample                                         */
+        int32_t     nMean;          /*!< Mean, #ADI_STATS_FRAC_BITS fraction bits               */
+        uint64_t    nVariance;      /*!< Sample variance, #ADI_STATS_FRAC_BITS fraction bits    */
+        uint32_t    nStdDev;        /*!< Standard deviation, #ADI_STATS_FRAC_BITS fraction bits */
+    } ADI_STATS_RESULT;
+
+    /**
+     * @class WindowStats
+     *
+     * @brief Min, max, mean and variance of one channel over fixed size windows.
+     *
+     * @details Samples are 16 bit integers: raw sensor codes, or readings the
+     *          application scaled into 16 bits (e.g. centidegrees). The mean
+     *          and sum of squared deviations are updated with Welford's
+     *          algorithm in fixed point, with #ADI_STATS_FRAC_BITS fraction
+     *          bits for the mean. add() uses one integer division and no
+     *          floating point, so it takes the same time for every sample and
+     *          can be called from a data-ready interrupt.
+     *
+     *          When a window is full its totals are latched and the next
+     *          window starts with the next sample. getResult(), called from
+     *          the main loop, collects the latched window and does the
+     *          division and square root. A window that is not collected before
+     *          the next one completes is replaced and counted in getOverruns().
+     */
+    class WindowStats
+    {
+        public:
+            WindowStats();
+
+            /*!
+             * @brief   Sets the window size and starts a new window.
+             *
+             * @param [in] nSamples : Samples per window, 2 to #ADI_STATS_MAX_WINDOW.
+             *
+             * @details Must not be called while add() can run.
+             */
+            void setWindow(uint32_t nSamples);
+
+            /*!
+             * @brief   Adds a sample to the current window.
+             *
+             * @param [in] nSample : Sample value.
+             *
+             * @return  true if the sample completed a window.
+             */
+            bool add(int16_t nSample);
+
+            /*!
+             * @brief   Collects the last complete window.
+             *
+             * @param [out] pResult : Statistics of the window.
+             *
+             * @return  true if a window was waiting, false if pResult was not written.
+             */
+            bool getResult(ADI_STATS_RESULT *pResult);
+
+            /*!
+             * @brief   Returns the number of windows replaced before they were collected.
+             */
+            uint32_t getOverruns() const { return m_nOverruns; }
+
+            /*!
+             * @brief   Fills a registration packet for #ADI_STATISTICS_TYPE packets.
+             *
+             * @param [in]  nSensorId     : ID of the sensor the statistics belong to.
+             * @param [out] pRegistration : Packet to fill.
+             */
+            static void fillRegistration(uint8_t nSensorId, ADI_REGISTRATION_PACKET *pRegistration);
+
+            /*!
+             * @brief   Fills an #ADI_STATISTICS_TYPE data packet.
+             *
+             * @param [in]  nSensorId  : ID of the sensor the statistics belong to.
+             * @param [in]  nChannel   : Channel of the sensor.
+             * @param [in]  nTimestamp : Timestamp of the end of the window.
+             * @param [in]  pResult    : Statistics from getResult().
+             * @param [out] pPacket    : Packet to fill.
+             */
+            static void fillPacket(uint8_t nSensorId, uint8_t nChannel, uint32_t nTimestamp,
+                                   const ADI_STATS_RESULT *pResult, ADI_DATA_PACKET *pPacket);
+
+        private:
+
+            /*! Totals of a window, as left by add() */
+            typedef struct
+            {
+                uint32_t    nCount;
+                int16_t     nMin;
+                int16_t     nMax;
+                int32_t     nMean;
+                int64_t     nM2;
+            } ADI_STATS_TOTALS;
+
+            /*! Starts a new window */
+            void Restart();
+
+            uint32_t            m_nWindow;
+            ADI_STATS_TOTALS    m_sCurrent;
+            ADI_STATS_TOTALS    m_sLatched;
+            volatile bool       m_bLatched;
+            volatile uint32_t   m_nOverruns;
+    };
+}
+
+#endif /* ADI_WINDOW_STATS_H */
@@ -56,6 +56,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdarg.h>
 #include <drivers/uart/adi_uart.h>
 #include <drivers/general/adi_drivers_general.h>
+#include <common/adi_log.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -0,0 +1,142 @@
+/*!
+ *****************************************************************************
+ * @file    adi_fft.h
+ * @brief   Fixed-point real FFT
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#ifndef ADI_FFT_H
+#define ADI_FFT_H
+
+#include <stdint.h>
+
+/*! @addtogroup common_fft Fixed-Point FFT
+ *  @ingroup common
+ *  @brief Q15 real FFT for spectral analysis on the ADuCM3029.
+ *
+ *  @details Samples are 16-bit fixed point. A real transform of N points runs
+ *           as a complex radix-2 transform of N/2 points followed by a split
+ *           stage, in place, with 16-bit twiddles from a 257 entry quarter
+ *           wave table in flash. Every stage halves its outputs, so the
+ *           result is the DFT divided by N and cannot overflow as long as the
+ *           input stays within +/-23170 (the analysis code keeps it within
+ *           +/-16384). The price is about log2(N) / 2 bits of noise.
+ *
+ *           The spectrum is packed in the input buffer:
+ *
+ *           | X[0] | X[N/2] | Re X[1] | Im X[1] | ... | Re X[N/2-1] | Im X[N/2-1] |
+ *
+ *           X[0] and X[N/2] are real for a real input.
+ *  @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Largest transform, limited by the twiddle table */
+#define ADI_FFT_MAX_POINTS          (512u)
+
+/*! Smallest transform */
+#define ADI_FFT_MIN_POINTS          (16u)
+
+/*!
+ * @enum ADI_FFT_RESULT
+ *
+ * @brief FFT return codes.
+ */
+typedef enum
+{
+    ADI_FFT_SUCCESS = 0,        /*!< Transform done                                         */
+    ADI_FFT_INVALID             /*!< Number of points not a power of two in range          */
+} ADI_FFT_RESULT;
+
+/*!
+ * @brief       Applies a Hann window in place.
+ *
+ * @param [in,out] pData   : Samples.
+ * @param [in]     nPoints : Number of samples, a power of two from #ADI_FFT_MIN_POINTS
+ *                           to #ADI_FFT_MAX_POINTS.
+ *
+ * @return      #ADI_FFT_SUCCESS or #ADI_FFT_INVALID.
+ */
+ADI_FFT_RESULT adi_fft_Window(int16_t *pData, uint32_t nPoints);
+
+/*!
+ * @brief       Real FFT in place.
+ *
+ * @param [in,out] pData   : nPoints samples in, the packed spectrum divided by nPoints out.
+ * @param [in]     nPoints : Number of samples, a power of two from #ADI_FFT_MIN_POINTS
+ *                           to #ADI_FFT_MAX_POINTS.
+ *
+ * @return      #ADI_FFT_SUCCESS or #ADI_FFT_INVALID.
+ */
+ADI_FFT_RESULT adi_fft_Real(int16_t *pData, uint32_t nPoints);
+
+/*!
+ * @brief       Squared magnitude of each bin of a packed spectrum.
+ *
+ * @param [in]  pSpectrum : Output of adi_fft_Real().
+ * @param [in]  nPoints   : Number of points of the transform.
+ * @param [out] pPower    : nPoints / 2 + 1 bins, DC to Nyquist.
+ *
+ * @return      #ADI_FFT_SUCCESS or #ADI_FFT_INVALID.
+ */
+ADI_FFT_RESULT adi_fft_Power(const int16_t *pSpectrum, uint32_t nPoints, uint32_t *pPower);
+
+/*!
+ * @brief       Integer square root.
+ *
+ * @param [in]  nValue : Value.
+ *
+ * @return      floor(sqrt(nValue)).
+ */
+uint32_t adi_fft_Sqrt(uint64_t nValue);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*! @} */
+
+#endif /* ADI_FFT_H */
@@ -0,0 +1,190 @@
+/*!
+ *****************************************************************************
+ * @file    adi_i2c_bus.h
+ * @brief   Shared I2C bus for several sensors
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#ifndef ADI_I2C_BUS_H
+#define ADI_I2C_BUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef ADI_I2C_BUS_HOST
+#include <drivers/i2c/adi_i2c.h>
+#endif
+
+/*! @addtogroup common_i2c_bus Shared I2C Bus
+ *  @ingroup common
+ *  @brief One I2C driver handle shared by every sensor on the bus, with a
+ *         queue of non-blocking transfers.
+ *
+ *  @details The I2C driver is opened by the first adi_i2c_bus_Open() and
+ *           closed by the last adi_i2c_bus_Close(), so several sensor objects
+ *           can live on the same bus. Every transfer names its slave address;
+ *           the address is only reprogrammed when it differs from the one of
+ *           the previous transfer, so a sensor that is read several times in
+ *           a row costs a single address change.
+ *
+ *           adi_i2c_bus_Submit() queues a request and returns at once. The
+ *           driver moves the bytes from its interrupt while the application
+ *           does other work, and adi_i2c_bus_Process(), called from the main
+ *           loop, completes the active request, calls its callback and starts
+ *           the next one. Callbacks therefore run in the main loop, never in
+ *           an interrupt. The request memory belongs to the caller and must
+ *           stay valid until the request is done. adi_i2c_bus_ReadWrite() is
+ *           the blocking form: it queues behind the pending requests and
+ *           processes the queue until its own transfer is done.
+ *           adi_i2c_bus_WaitIdle() processes it until it is empty. Both
+ *           give each transfer its bit time plus ADI_I2C_BUS_CFG_TIMEOUT_US,
+ *           then reset the driver and fail the transfer, so a hung bus
+ *           cannot stop the main loop.
+ *
+ *           Only the main loop may submit requests or process the queue.
+ *
+ *           Building with ADI_I2C_BUS_HOST defined replaces the driver with a
+ *           simulated bus on the PC. Devices are register files attached with
+ *           adi_i2c_bus_SimAttach(), and every transfer takes the time its
+ *           bits need at the bit rate, so queueing and overlap can be measured.
+ *  @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Address cache value when no address is programmed */
+#define ADI_I2C_BUS_NO_ADDRESS       (0xFFFFu)
+
+#ifdef ADI_I2C_BUS_HOST
+/*! Result codes of the simulated driver, a subset of the ADuCM3029 driver */
+typedef enum
+{
+    ADI_I2C_SUCCESS           = 0,   /*!< Transfer done                          */
+    ADI_I2C_FAILURE           = 1,   /*!< Bus not open or request already queued */
+    ADI_I2C_HW_ERROR_DETECTED = 7,   /*!< See the hardware error bits            */
+} ADI_I2C_RESULT;
+
+/*! Hardware error bit of the simulated driver, no device at the address */
+#define ADI_I2C_HW_ERROR_NACK_ADDR   (0x01u)
+
+/*! Transfer of the simulated driver, same layout as the ADuCM3029 driver */
+typedef struct
+{
+    uint8_t  *pPrologue;      /*!< Bytes written first, the register address */
+    uint16_t  nPrologueSize;  /*!< Number of prologue bytes                  */
+    uint8_t  *pData;          /*!< Data read or written                      */
+    uint16_t  nDataSize;      /*!< Number of data bytes                      */
+    bool      bReadNotWrite;  /*!< Read pData from the device                */
+    bool      bRepeatStart;   /*!< Repeated start between prologue and data  */
+} ADI_I2C_TRANSACTION;
+#endif
+
+/*! Request states */
+typedef enum
+{
+    ADI_I2C_BUS_IDLE   = 0u,  /*!< Not queued, can be submitted    */
+    ADI_I2C_BUS_QUEUED = 1u,  /*!< Waiting for the bus             */
+    ADI_I2C_BUS_ACTIVE = 2u,  /*!< On the bus                      */
+    ADI_I2C_BUS_DONE   = 3u,  /*!< eResult and nHwErrors are valid */
+} ADI_I2C_BUS_STATE;
+
+struct ADI_I2C_BUS_REQUEST;
+
+/*! Completion callback, called from adi_i2c_bus_Process() */
+typedef void (*ADI_I2C_BUS_CALLBACK)(struct ADI_I2C_BUS_REQUEST *pRequest);
+
+/*! Queued transfer */
+typedef struct ADI_I2C_BUS_REQUEST
+{
+    uint16_t                     nAddress;      /*!< 7-bit slave address                  */
+    ADI_I2C_TRANSACTION          sTransaction;  /*!< Transfer                             */
+    ADI_I2C_BUS_CALLBACK         pfCallback;    /*!< Called when done, or NULL            */
+    void                        *pCBParam;      /*!< Free for the callback                */
+
+    volatile ADI_I2C_BUS_STATE   eState;        /*!< Set by the bus                       */
+    ADI_I2C_RESULT               eResult;       /*!< Driver result once done              */
+    uint32_t                     nHwErrors;     /*!< Hardware errors once done            */
+    struct ADI_I2C_BUS_REQUEST  *pNext;         /*!< Queue link, used by the bus          */
+} ADI_I2C_BUS_REQUEST;
+
+#ifdef ADI_I2C_BUS_HOST
+/*! Called by the simulated bus after a transfer with the device */
+typedef void (*ADI_I2C_BUS_SIM_HOOK)(void *pParam, uint8_t nRegister, bool bRead);
+
+/*! Simulated device, a register file with an auto-incrementing pointer */
+typedef struct
+{
+    uint16_t              nAddress;    /*!< 7-bit slave address                   */
+    uint8_t              *pRegisters;  /*!< Register file                         */
+    uint32_t              nSize;       /*!< Registers in the file                 */
+    ADI_I2C_BUS_SIM_HOOK  pfHook;      /*!< Device behaviour, or NULL             */
+    void                 *pParam;      /*!< Passed to pfHook                      */
+} ADI_I2C_BUS_SIM_DEVICE;
+#endif
+
+/********************************************************************************
+* API function prototypes
+*********************************************************************************/
+ADI_I2C_RESULT adi_i2c_bus_Open(uint32_t nBitRate);
+ADI_I2C_RESULT adi_i2c_bus_Close(void);
+ADI_I2C_RESULT adi_i2c_bus_Submit(ADI_I2C_BUS_REQUEST *pRequest);
+void           adi_i2c_bus_Process(void);
+bool           adi_i2c_bus_IsIdle(void);
+ADI_I2C_RESULT adi_i2c_bus_WaitIdle(void);
+ADI_I2C_RESULT adi_i2c_bus_ReadWrite(uint16_t nAddress, ADI_I2C_TRANSACTION *pTransaction, uint32_t *pHwErrors);
+uint32_t       adi_i2c_bus_GetAddressChanges(void);
+
+#ifdef ADI_I2C_BUS_HOST
+void           adi_i2c_bus_SimAttach(ADI_I2C_BUS_SIM_DEVICE *pDevice);
+uint64_t       adi_i2c_bus_SimTime(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+/*! @} */
+
+#endif /* ADI_I2C_BUS_H */
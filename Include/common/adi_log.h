@@ -0,0 +1,224 @@
+/*!
+ *****************************************************************************
+ * @file    adi_log.h
+ * @brief   Non-blocking UART logger
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#ifndef ADI_LOG_H
+#define ADI_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+#ifndef ADI_LOG_HOST
+#include <drivers/uart/adi_uart.h>
+#endif
+
+/*! @addtogroup common_log Logger
+ *  @ingroup common
+ *  @brief Asynchronous logger used by the release PRINTF path.
+ *
+ *  @details Messages are formatted (bounded by #ADI_LOG_CFG_MAX_LINE_SIZE)
+ *           into a single-producer/single-consumer ring buffer and the
+ *           caller returns immediately. The ring is drained by the UART
+ *           driver in the background, one contiguous chunk per DMA transfer,
+ *           and the transfer-complete callback queues the next chunk. When
+ *           the ring is full the whole message is dropped and counted rather
+ *           than blocking the sample loop.
+ *
+ *           Only one execution context may produce messages (the main loop).
+ *
+ *           Building with ADI_LOG_HOST defined replaces the UART with a stdio
+ *           stream that is drained synchronously by adi_log_Process(), which
+ *           allows the ring buffer to be exercised on a PC.
+ *
+ *           ADI_LOG_DEFERRED() skips formatting altogether. The format string
+ *           is placed in the adi_log_fmt section and only its offset in that
+ *           section plus the raw 32-bit arguments are queued, as a record of
+ *           the form:
+ *
+ *           | 0xA5 | nArgs | ID (LE16) | nArgs x argument (LE32) |
+ *
+ *           The ID limits the adi_log_fmt section to 64 KB of format strings.
+ *           Debug builds assert on a larger offset, release builds would send
+ *           the wrong string.
+ *
+ *           The host tool Host/Tools/log_decode reads the format strings back
+ *           out of the application ELF file and rebuilds the text. Any bytes
+ *           outside a record (e.g. from adi_log_Printf) are passed through.
+ *  @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! First byte of a deferred log record */
+#define ADI_LOG_RECORD_SYNC         (0xA5u)
+
+/*! Size of a deferred log record header */
+#define ADI_LOG_RECORD_HEADER_SIZE  (4u)
+
+/*! Maximum number of arguments for ADI_LOG_DEFERRED() */
+#define ADI_LOG_MAX_DEFERRED_ARGS   (8u)
+
+/*! Places a deferred format string in the string table section */
+#define ADI_LOG_FMT_ATTRIBUTE       __attribute__((section("adi_log_fmt"), used, aligned(1)))
+
+/*! Output port the logger drains to */
+#ifdef ADI_LOG_HOST
+typedef FILE *ADI_LOG_PORT;
+#else
+typedef ADI_UART_HANDLE ADI_LOG_PORT;
+#endif
+
+/*! Logger result codes */
+typedef enum
+{
+    ADI_LOG_SUCCESS   = 0u,    /*!< Message queued                                       */
+    ADI_LOG_TRUNCATED = 1u,    /*!< Message was longer than the line size and was cut     */
+    ADI_LOG_OVERFLOW  = 2u,    /*!< Not enough room in the ring, message dropped          */
+    ADI_LOG_PORT_ERROR = 3u,   /*!< The output port refused a transfer                    */
+} ADI_LOG_RESULT;
+
+/*! Logger statistics, see adi_log_GetStats() */
+typedef struct
+{
+    uint32_t nBytesQueued;      /*!< Bytes accepted into the ring                         */
+    uint32_t nBytesSent;        /*!< Bytes handed back by the output port                 */
+    uint32_t nDroppedMessages;  /*!< Messages discarded because the ring was full         */
+    uint32_t nDroppedBytes;     /*!< Bytes belonging to the discarded messages            */
+    uint32_t nTruncated;        /*!< Messages cut to #ADI_LOG_CFG_MAX_LINE_SIZE            */
+    uint32_t nPortErrors;       /*!< Transfers the output port refused                    */
+    uint32_t nHighWater;        /*!< Largest ring occupancy seen, in bytes                */
+} ADI_LOG_STATS;
+
+/********************************************************************************
+* API function prototypes
+*********************************************************************************/
+void           adi_log_Init(ADI_LOG_PORT hPort);
+ADI_LOG_RESULT adi_log_Printf(const char *format, ...);
+ADI_LOG_RESULT adi_log_VPrintf(const char *format, va_list args);
+ADI_LOG_RESULT adi_log_Write(const void *pData, uint32_t nSize);
+void           adi_log_Process(void);
+void           adi_log_Flush(void);
+uint32_t       adi_log_GetPending(void);
+void           adi_log_GetStats(ADI_LOG_STATS *pStats);
+void           adi_log_ClearStats(void);
+ADI_LOG_PORT   adi_log_GetPort(void);
+ADI_LOG_RESULT adi_log_Deferred(const char *pFormat, const uint32_t *pArgs, uint32_t nArgs);
+
+#ifdef __cplusplus
+}
+
+/*
+ * Conversion of a deferred log argument to its 32-bit wire form. Floating
+ * point values are sent as IEEE-754 single precision, pointers as addresses
+ * (the decoder resolves %s against the constant data of the ELF file).
+ */
+static inline uint32_t adi_log_Arg(int nValue)                { return((uint32_t) nValue); }
+static inline uint32_t adi_log_Arg(unsigned int nValue)       { return((uint32_t) nValue); }
+static inline uint32_t adi_log_Arg(long nValue)               { return((uint32_t) nValue); }
+static inline uint32_t adi_log_Arg(unsigned long nValue)      { return((uint32_t) nValue); }
+static inline uint32_t adi_log_Arg(long long nValue)          { return((uint32_t) nValue); }
+static inline uint32_t adi_log_Arg(unsigned long long nValue) { return((uint32_t) nValue); }
+static inline uint32_t adi_log_Arg(const void *pValue)        { return((uint32_t) (uintptr_t) pValue); }
+static inline uint32_t adi_log_Arg(double fValue)
+{
+    union { float f; uint32_t n; } uValue;
+    uValue.f = (float) fValue;
+    return(uValue.n);
+}
+#else
+static inline uint32_t adi_log_ArgInt(uint32_t nValue) { return(nValue); }
+static inline uint32_t adi_log_ArgFloat(double fValue)
+{
+    union { float f; uint32_t n; } uValue;
+    uValue.f = (float) fValue;
+    return(uValue.n);
+}
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define adi_log_Arg(x) _Generic((x), float: adi_log_ArgFloat, double: adi_log_ArgFloat, default: adi_log_ArgInt)(x)
+#else
+/* Without _Generic floating point arguments must be wrapped in adi_log_ArgFloat() */
+#define adi_log_Arg(x) ((uint32_t) (x))
+#endif
+#endif
+
+/* Argument counting and expansion helpers for ADI_LOG_DEFERRED() */
+#define ADI_LOG_FIRST_(f, ...)   f
+#define ADI_LOG_FIRST(...)       ADI_LOG_FIRST_(__VA_ARGS__, 0)
+#define ADI_LOG_SELECT_(f, a1, a2, a3, a4, a5, a6, a7, a8, NAME, ...) NAME
+#define ADI_LOG_NARGS(...)       ADI_LOG_SELECT_(__VA_ARGS__, 8u, 7u, 6u, 5u, 4u, 3u, 2u, 1u, 0u, 0)
+#define ADI_LOG_ARGS(...)        ADI_LOG_SELECT_(__VA_ARGS__, ADI_LOG_A8, ADI_LOG_A7, ADI_LOG_A6, ADI_LOG_A5, \
+                                                 ADI_LOG_A4, ADI_LOG_A3, ADI_LOG_A2, ADI_LOG_A1, ADI_LOG_A0, 0)(__VA_ARGS__)
+#define ADI_LOG_A0(f)
+#define ADI_LOG_A1(f, a)                      , adi_log_Arg(a)
+#define ADI_LOG_A2(f, a, b)                   ADI_LOG_A1(f, a) ADI_LOG_A1(f, b)
+#define ADI_LOG_A3(f, a, b, c)                ADI_LOG_A2(f, a, b) ADI_LOG_A1(f, c)
+#define ADI_LOG_A4(f, a, b, c, d)             ADI_LOG_A3(f, a, b, c) ADI_LOG_A1(f, d)
+#define ADI_LOG_A5(f, a, b, c, d, e)          ADI_LOG_A4(f, a, b, c, d) ADI_LOG_A1(f, e)
+#define ADI_LOG_A6(f, a, b, c, d, e, g)       ADI_LOG_A5(f, a, b, c, d, e) ADI_LOG_A1(f, g)
+#define ADI_LOG_A7(f, a, b, c, d, e, g, h)    ADI_LOG_A6(f, a, b, c, d, e, g) ADI_LOG_A1(f, h)
+#define ADI_LOG_A8(f, a, b, c, d, e, g, h, i) ADI_LOG_A7(f, a, b, c, d, e, g, h) ADI_LOG_A1(f, i)
+
+/*!
+ * @brief  Queue a deferred log record.
+ *
+ * @details Takes the same arguments as printf, the format must be a string
+ *          literal and there may be up to #ADI_LOG_MAX_DEFERRED_ARGS
+ *          arguments of at most 32 bits each.
+ */
+#define ADI_LOG_DEFERRED(...)                                                       \
+    do {                                                                            \
+        static const char ADI_LOG_FMT_ATTRIBUTE aLogFmt_[] = ADI_LOG_FIRST(__VA_ARGS__); \
+        const uint32_t aLogArgs_[] = { 0u ADI_LOG_ARGS(__VA_ARGS__) };              \
+        adi_log_Deferred(aLogFmt_, &aLogArgs_[1], ADI_LOG_NARGS(__VA_ARGS__));      \
+    } while(0)
+
+/*! @} */
+
+#endif /* ADI_LOG_H */
@@ -0,0 +1,97 @@
+/*!
+ *****************************************************************************
+ * @file    adi_spi_dma.h
+ * @brief   DMA for large SPI transfers
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+#ifndef ADI_SPI_DMA_H
+#define ADI_SPI_DMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <drivers/spi/adi_spi.h>
+
+/*! @addtogroup common_spi_dma SPI DMA Transfers
+ *  @ingroup common
+ *  @brief Moves large SPI transfers with DMA and keeps small ones on PIO.
+ *
+ *  @details adi_spi_dma_ReadWrite() takes the place of adi_spi_MasterReadWrite()
+ *           in the sensor drivers. A transfer with bDMA set may use DMA, and it
+ *           does when it moves at least ADI_SPI_DMA_CFG_THRESHOLD bytes. Below
+ *           that, setting up the channels costs more than the core spends on
+ *           the FIFO, so register accesses stay on PIO.
+ *
+ *           The DMA channels move half-words: the byte counts must be even and
+ *           the buffers half-word aligned. Buffers of the caller that are not
+ *           aligned are replaced by static, word aligned buffers of
+ *           ADI_SPI_DMA_CFG_BUFFER_SIZE bytes and copied. In read command mode
+ *           (bRD_CTL) the command is written to the FIFO by the driver and only
+ *           the received bytes use DMA. Transfers the DMA cannot move stay on
+ *           PIO, so the call never fails for that reason.
+ *
+ *           While the channels run the core waits in WFI and is woken by the
+ *           completion interrupt of the SPI DMA channel.
+ *
+ *           The static buffers are shared by all SPI devices; transfers must
+ *           not be made from interrupts.
+ *  @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************************************************************************
+* API function prototypes
+*********************************************************************************/
+ADI_SPI_RESULT adi_spi_dma_ReadWrite(ADI_SPI_HANDLE const hDevice, ADI_SPI_TRANSCEIVER *const pXfr);
+bool           adi_spi_dma_IsEligible(const ADI_SPI_TRANSCEIVER *const pXfr);
+uint32_t       adi_spi_dma_GetCount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*! @} */
+
+#endif /* ADI_SPI_DMA_H */
@@ -0,0 +1,106 @@
+/*!
+ *****************************************************************************
+ * @file    adi_stream.h
+ * @brief   Framed binary packet stream over the logger UART
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#ifndef ADI_STREAM_H
+#define ADI_STREAM_H
+
+#include <stdint.h>
+#include <common/adi_log.h>
+
+/*! @addtogroup common_stream Packet Stream
+ *  @ingroup common
+ *  @brief Binary framing of sensor packets for wired links.
+ *
+ *  @details Each packet (normally an ADI_DATA_PACKET or an
+ *           ADI_REGISTRATION_PACKET) is sent as one frame:
+ *
+ *           COBS( sequence | packet | CRC-16 (LE) ) | 0x00
+ *
+ *           The sequence number increments by one per frame so the receiver
+ *           can count frames lost to ring buffer overflows. The CRC is
+ *           CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF) over
+ *           the sequence number and the packet. COBS removes every zero byte
+ *           from the frame so 0x00 only ever marks the end of a frame and a
+ *           receiver can resynchronize after any corruption.
+ *
+ *           Frames are queued on the logger ring buffer, so sending never
+ *           blocks. The receiver is in Host/Tools/stream_rx.
+ *  @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Largest packet accepted by adi_stream_Send() */
+#define ADI_STREAM_MAX_PACKET_SIZE   (32u)
+
+/*! Frame bytes added around the packet: sequence and CRC */
+#define ADI_STREAM_FRAME_OVERHEAD    (3u)
+
+/*! Largest encoded frame, including the COBS code byte and the delimiter */
+#define ADI_STREAM_MAX_FRAME_SIZE    (ADI_STREAM_MAX_PACKET_SIZE + ADI_STREAM_FRAME_OVERHEAD + 2u)
+
+/*! Frame delimiter */
+#define ADI_STREAM_DELIMITER         (0x00u)
+
+/********************************************************************************
+* API function prototypes
+*********************************************************************************/
+void           adi_stream_Init(void);
+ADI_LOG_RESULT adi_stream_Send(const void *pPacket, uint32_t nSize);
+uint16_t       adi_stream_Crc16(uint16_t nCrc, const uint8_t *pData, uint32_t nSize);
+uint32_t       adi_stream_CobsEncode(const uint8_t *pSrc, uint32_t nSize, uint8_t *pDst);
+int32_t        adi_stream_CobsDecode(const uint8_t *pSrc, uint32_t nSize, uint8_t *pDst);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*! @} */
+
+#endif /* ADI_STREAM_H */
@@ -0,0 +1,105 @@
+/*!
+ *****************************************************************************
+ * @file    adi_time.h
+ * @brief   Monotonic time and deadline waits
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+#ifndef ADI_TIME_H
+#define ADI_TIME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*! @addtogroup common_time Monotonic Time
+ *  @ingroup common
+ *  @brief Microsecond time base, deadline waits and low-power sleep.
+ *
+ *  @details A general purpose timer counts the 26 MHz HFOSC divided by 256
+ *           and only interrupts when its 16-bit count wraps, every 645 ms.
+ *           The time does not depend on the HCLK and PCLK dividers, so
+ *           timeouts keep their length when adi_pwr_SetClockDivider()
+ *           changes them.
+ *
+ *           Times are 32-bit microsecond counts that wrap after about 71
+ *           minutes. Deadlines are compared by their signed difference, so
+ *           they work across the wrap for timeouts up to 35 minutes.
+ *           adi_time_GetUs64() returns the same time without the wrap, for
+ *           timestamps that must stay monotonic.
+ *
+ *           adi_time_SleepUntil() arms a second timer for the deadline and
+ *           puts the core in flexi mode, there is no periodic tick to wake
+ *           it. A GPIO or other callback that needs the main loop calls
+ *           adi_time_Wake() to end the sleep early. The time asleep is
+ *           counted, adi_time_GetDutyCycle() reports the share the core
+ *           was awake.
+ *
+ *           The timers are started by adi_time_Init(), or by the first call
+ *           that needs them.
+ *  @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************************************************************************
+* API function prototypes
+*********************************************************************************/
+bool     adi_time_Init(void);
+uint32_t adi_time_GetUs(void);
+uint64_t adi_time_GetUs64(void);
+uint32_t adi_time_Deadline(uint32_t nTimeoutUs);
+bool     adi_time_IsExpired(uint32_t nDeadline);
+void     adi_time_Sleep(void);
+bool     adi_time_SleepUntil(uint32_t nDeadline);
+bool     adi_time_DelayMs(uint32_t nMilliseconds);
+void     adi_time_Wake(void);
+uint32_t adi_time_GetDutyCycle(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*! @} */
+
+#endif /* ADI_TIME_H */
@@ -0,0 +1,153 @@
+/*!
+ *****************************************************************************
+ * @file    adi_timesync.h
+ * @brief   Sample timestamps and clock sync with the central
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+#ifndef ADI_TIMESYNC_H
+#define ADI_TIMESYNC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*! @addtogroup common_timesync Timestamp Service
+ *  @ingroup common
+ *  @brief 64-bit sample timestamps aligned with the clock of the central.
+ *
+ *  @details Times are microseconds of adi_time_GetUs64(), which do not wrap.
+ *
+ *           - #ADI_TSYNC_EDGE records the time of a data ready or FIFO
+ *             watermark edge from the GPIO callback, so a sample is stamped
+ *             when it was taken rather than when it was read or sent.
+ *           - #ADI_TSYNC_BATCH times every sample of a FIFO batch from the
+ *             edge of one of them and the sample period. The period starts
+ *             at the nominal output data rate and follows the rate measured
+ *             between edges, sensor oscillators are only accurate to a few
+ *             percent.
+ *           - #ADI_TSYNC_CLOCK estimates the offset and drift of the local
+ *             time to the central by a least squares fit over the last
+ *             sync points. A sync point pairs the local time of a
+ *             connection event with the central's time of the same event,
+ *             for example sent by the central in a data exchange packet.
+ *             Connection events happen at the same instant for both sides,
+ *             so the radio latency does not enter the estimate.
+ *
+ *           Converting the sample time with adi_tsync_ToCentral() lets
+ *           the samples of several nodes be merged on the central's clock.
+ *  @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Sync points in the clock fit, each costs 16 bytes of state */
+#define ADI_TSYNC_MAX_POINTS        (8u)
+
+/*!
+ * @struct ADI_TSYNC_EDGE
+ *
+ * @brief Time of the last edge of an interrupt line.
+ */
+typedef struct
+{
+    volatile uint64_t   nTime;          /*!< Time of the last edge, us   */
+    volatile uint32_t   nCount;         /*!< Edges stamped so far        */
+} ADI_TSYNC_EDGE;
+
+/*!
+ * @struct ADI_TSYNC_BATCH
+ *
+ * @brief Sample times of a FIFO batch.
+ */
+typedef struct
+{
+    uint64_t    nAnchorTime;            /*!< Time of the anchor sample, us                   */
+    uint32_t    nAnchor;                /*!< Index of the anchor sample in the batch         */
+    uint32_t    nSamples;               /*!< Samples in the batch                            */
+    uint32_t    nNominal;               /*!< Nominal sample period, 1/256 us                 */
+    uint32_t    nPeriod;                /*!< Measured sample period, 1/256 us                */
+    bool        bValid;                 /*!< A batch has been added                          */
+} ADI_TSYNC_BATCH;
+
+/*!
+ * @struct ADI_TSYNC_CLOCK
+ *
+ * @brief Offset and drift of the local time to the central.
+ */
+typedef struct
+{
+    uint64_t    aLocal[ADI_TSYNC_MAX_POINTS];   /*!< Local time of the sync points, us             */
+    int64_t     aOffset[ADI_TSYNC_MAX_POINTS];  /*!< Central minus local time of the points, us    */
+    uint32_t    nPoints;                        /*!< Valid points                                  */
+    uint32_t    nNext;                          /*!< Point replaced next                           */
+    uint32_t    nRejects;                       /*!< Consecutive points rejected as outliers       */
+    uint64_t    nReference;                     /*!< Local time the fit is centered on, us         */
+    int64_t     nOffset;                        /*!< Offset at nReference, us                      */
+    int32_t     nDrift;                         /*!< Rate of the central to the local time - 1, ppb */
+} ADI_TSYNC_CLOCK;
+
+/********************************************************************************
+* API function prototypes
+*********************************************************************************/
+void     adi_tsync_Stamp(ADI_TSYNC_EDGE *pEdge);
+void     adi_tsync_EdgeCallback(void *pCBParam, uint32_t Event, void *pArg);
+uint32_t adi_tsync_GetEdge(const ADI_TSYNC_EDGE *pEdge, uint64_t *pTime);
+
+void     adi_tsync_BatchInit(ADI_TSYNC_BATCH *pBatch, uint32_t nPeriodUs);
+void     adi_tsync_BatchAdd(ADI_TSYNC_BATCH *pBatch, uint64_t nEdgeTime, uint32_t nAnchor, uint32_t nSamples);
+uint64_t adi_tsync_BatchTime(const ADI_TSYNC_BATCH *pBatch, uint32_t nIndex);
+uint32_t adi_tsync_BatchPeriod(const ADI_TSYNC_BATCH *pBatch);
+
+void     adi_tsync_ClockInit(ADI_TSYNC_CLOCK *pClock);
+bool     adi_tsync_ClockAdd(ADI_TSYNC_CLOCK *pClock, uint64_t nLocal, uint64_t nCentral);
+bool     adi_tsync_IsSynced(const ADI_TSYNC_CLOCK *pClock);
+uint64_t adi_tsync_ToCentral(const ADI_TSYNC_CLOCK *pClock, uint64_t nLocal);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*! @} */
+
+#endif /* ADI_TIMESYNC_H */
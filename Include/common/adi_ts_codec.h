@@ -0,0 +1,173 @@
+/*!
+ *****************************************************************************
+ * @file    adi_ts_codec.h
+ * @brief   Time series compression for sensor payloads
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+#ifndef ADI_TS_CODEC_H
+#define ADI_TS_CODEC_H
+
+#include <stdint.h>
+
+/*! @addtogroup common_ts_codec Time Series Codec
+ *  @ingroup common
+ *  @brief Compression of timestamped sensor payloads.
+ *
+ *  @details Samples made of a 32-bit timestamp and the fields of an
+ *           ADI_DATA_PACKET payload are packed into a caller supplied block:
+ *
+ *           | count (LE16) | nNumFields | keys | bit stream |
+ *
+ *           The first sample is stored as is. For the following samples the
+ *           timestamp is stored as the change of the sample interval
+ *           (delta-of-delta), which takes one bit for a regular sample rate.
+ *           ADI_FLOAT_TYPE fields store the XOR with the previous value, which
+ *           takes one bit for an unchanged value and only the changed bits
+ *           otherwise. ADI_BYTE_TYPE, ADI_CHAR_TYPE, ADI_SHORT_TYPE and
+ *           ADI_INT_TYPE fields store the zigzag coded difference with the
+ *           previous value. 64-bit keys are not supported.
+ *
+ *           The encoder uses no memory besides its state and the block, and a
+ *           sample is either encoded completely or not at all, so a full
+ *           block is always valid. The same code decodes on the host.
+ *  @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Maximum number of fields per sample, each field costs 8 bytes of state */
+#define ADI_TSC_MAX_FIELDS          (4u)
+
+/*! Block header size for a number of fields */
+#define ADI_TSC_HEADER_SIZE(n)      (3u + (n))
+
+/*! Maximum number of samples in a block */
+#define ADI_TSC_MAX_SAMPLES         (0xFFFFu)
+
+/*!
+ * @enum ADI_TSC_RESULT
+ *
+ * @brief Codec return codes.
+ */
+typedef enum
+{
+    ADI_TSC_SUCCESS = 0,        /*!< Sample encoded or decoded                          */
+    ADI_TSC_FULL,               /*!< Sample does not fit, the block is unchanged        */
+    ADI_TSC_END,                /*!< All samples of the block have been decoded         */
+    ADI_TSC_INVALID             /*!< Unsupported key or field count, or corrupt block  */
+} ADI_TSC_RESULT;
+
+/*!
+ * @struct ADI_TSC_FIELD
+ *
+ * @brief Per field state.
+ */
+typedef struct
+{
+    uint32_t    nPrev;          /*!< Previous value, or bits of the previous float    */
+    uint8_t     nKey;           /*!< ADI_DATA_TYPE_KEY of the field                   */
+    uint8_t     nSize;          /*!< Size of the field in the payload                 */
+    uint8_t     nLeading;       /*!< Leading zeros of the last stored XOR window      */
+    uint8_t     nTrailing;      /*!< Trailing zeros of the window, 0xFF if none yet   */
+} ADI_TSC_FIELD;
+
+/*!
+ * @struct ADI_TSC_STATE
+ *
+ * @brief State shared by the encoder and the decoder.
+ */
+typedef struct
+{
+    uint32_t        nSize;                          /*!< Block size in bytes                   */
+    uint32_t        nBitPos;                        /*!< Bit position in the bit stream        */
+    uint32_t        nPrevTime;                      /*!< Previous timestamp                    */
+    int32_t         nPrevDelta;                     /*!< Previous timestamp difference         */
+    uint16_t        nCount;                         /*!< Samples encoded or decoded so far     */
+    uint16_t        nTotal;                         /*!< Decoder: samples in the block         */
+    uint8_t         nNumFields;                     /*!< Fields per sample                     */
+    uint8_t         nPayloadSize;                   /*!< Bytes per sample payload              */
+    ADI_TSC_FIELD   aField[ADI_TSC_MAX_FIELDS];     /*!< Field state                           */
+} ADI_TSC_STATE;
+
+/*!
+ * @struct ADI_TSC_ENCODER
+ *
+ * @brief Encoder instance.
+ */
+typedef struct
+{
+    uint8_t        *pBlock;     /*!< Block being written */
+    ADI_TSC_STATE   sState;     /*!< Codec state         */
+} ADI_TSC_ENCODER;
+
+/*!
+ * @struct ADI_TSC_DECODER
+ *
+ * @brief Decoder instance.
+ */
+typedef struct
+{
+    const uint8_t  *pBlock;     /*!< Block being read    */
+    ADI_TSC_STATE   sState;     /*!< Codec state         */
+} ADI_TSC_DECODER;
+
+/********************************************************************************
+* API function prototypes
+*********************************************************************************/
+ADI_TSC_RESULT adi_tsc_EncoderInit(ADI_TSC_ENCODER *pEncoder, uint8_t *pBlock, uint32_t nSize,
+                                   const uint8_t *pKeys, uint32_t nNumFields);
+ADI_TSC_RESULT adi_tsc_Encode(ADI_TSC_ENCODER *pEncoder, uint32_t nTimestamp, const void *pPayload);
+uint32_t       adi_tsc_GetSize(const ADI_TSC_ENCODER *pEncoder);
+ADI_TSC_RESULT adi_tsc_DecoderInit(ADI_TSC_DECODER *pDecoder, const uint8_t *pBlock, uint32_t nSize);
+ADI_TSC_RESULT adi_tsc_Decode(ADI_TSC_DECODER *pDecoder, uint32_t *pTimestamp, void *pPayload);
+
+#ifdef __cplusplus
+}
+#endif
+
+/*! @} */
+
+#endif /* ADI_TS_CODEC_H */
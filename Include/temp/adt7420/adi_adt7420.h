@@ -52,6 +52,32 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include <temp/adi_temperature.h>
 #include <drivers/i2c/adi_i2c.h>
+#include <drivers/gpio/adi_gpio.h>
+#include <common/adi_i2c_bus.h>
+
+    /*! I2C address with A1 and A0 low, the pins add 0 to 3 */
+#define ADT7420_ADDRESS_BASE              (0x48u)
+    /*! I2C address with A1 and A0 high */
+#define ADT7420_ADDRESS_MAX               (0x4Bu)
+    /*! Configuration register, resolution bit */
+#define ADT7420_CONFIG_RESOLUTION_BITPOS  (7u)
+    /*! Configuration register, operation mode field */
+#define ADT7420_CONFIG_MODE_BITPOS        (5u)
+#define ADT7420_CONFIG_MODE_MASK          (0x60u)
+    /*! Configuration register, fault queue field */
+#define ADT7420_CONFIG_FAULT_QUEUE_MASK   (0x03u)
+    /*! Status register, low when a new conversion result is ready */
+#define ADT7420_STATUS_RDY                (0x80u)
+    /*! Status register, limit flags */
+#define ADT7420_STATUS_ALARM_MASK         (0x70u)
+    /*! Largest T_HYST value, degree C */
+#define ADT7420_HYSTERESIS_MAX            (15u)
+    /*! Conversion time in continuous and one-shot mode, ms, maximum */
+#define ADT7420_CONVERSION_TIME           (240u)
+    /*! Conversion time in 1 SPS mode, ms, typical */
+#define ADT7420_1SPS_CONVERSION_TIME      (60u)
+    /*! Longest wait for a conversion before RDY times out, ms */
+#define ADT7420_READY_TIMEOUT             (ADT7420_CONVERSION_TIME + (ADT7420_CONVERSION_TIME / 4u))
 
 namespace adi_sensor_swpack
 {
@@ -64,6 +90,81 @@ namespace adi_sensor_swpack
     class ADT7420 : public Temperature
     {
         public:
+            /*!
+             *  @enum    ERROR_CODES
+             *
+             *  @brief   ADT7420 error codes.
+             *
+             *  @details Packed into the SENSOR_RESULT as a SENSOR_ERROR_TEMP.
+             */
+            typedef enum
+            {
+                ERROR_CODE_RDY_TIMEOUT = 0u, /*!< Timed out waiting for a conversion to complete. */
+                ERROR_CODE_READ_BUSY   = 1u, /*!< readTemperatureAsync() is still pending.        */
+            } ERROR_CODES;
+
+            /*!
+             *  @enum   ADT7420_REGS
+             *
+             *  @brief  ADT7420 registers used by the class
+             */
+            typedef enum {
+                REG_TEMP_MSB = 0x00,  /*!< Temperature value, most significant byte */
+                REG_TEMP_LSB = 0x01,  /*!< Temperature value, least significant byte */
+                REG_STATUS   = 0x02,  /*!< Status                                   */
+                REG_CONFIG   = 0x03,  /*!< Configuration                            */
+                REG_T_HIGH   = 0x04,  /*!< High limit, MSB first                    */
+                REG_T_LOW    = 0x06,  /*!< Low limit, MSB first                     */
+                REG_T_CRIT   = 0x08,  /*!< Critical limit, MSB first                */
+                REG_T_HYST   = 0x0A,  /*!< Hysteresis of all limits, 1 degree C/LSB */
+                REG_ID       = 0x0B   /*!< Manufacturer ID                          */
+            } ADT7420_REGS;
+
+            /*!
+             *  @enum   ALARM
+             *
+             *  @brief  Limit flags returned by getAlarmStatus()
+             */
+            typedef enum {
+                ALARM_LOW      = 0x10,  /*!< Below T_LOW                    */
+                ALARM_HIGH     = 0x20,  /*!< Above T_HIGH                   */
+                ALARM_CRITICAL = 0x40   /*!< Above T_CRIT                   */
+            } ALARM;
+
+            /*!
+             *  @enum   RESOLUTION
+             *
+             *  @brief  Temperature resolution
+             */
+            typedef enum {
+                RESOLUTION_13BIT = 0,  /*!< 0.0625 degree C per LSB */
+                RESOLUTION_16BIT = 1   /*!< 0.0078 degree C per LSB */
+            } RESOLUTION;
+
+            /*!
+             *  @enum   OPERATION_MODE
+             *
+             *  @brief  Conversion modes
+             */
+            typedef enum {
+                MODE_CONTINUOUS = 0,  /*!< Back to back conversions, 240 ms each          */
+                MODE_ONE_SHOT   = 1,  /*!< One conversion per reading, shut down between  */
+                MODE_1SPS       = 2,  /*!< One 60 ms conversion per second                */
+                MODE_SHUTDOWN   = 3   /*!< No conversions, the last result can be read    */
+            } OPERATION_MODE;
+
+            /*!
+             * @brief  Constructor.
+             *
+             * @param  [in] nAddress : I2C address set by the A1 and A0 pins, from
+             *                         #ADT7420_ADDRESS_BASE to #ADT7420_ADDRESS_MAX.
+             *
+             * @details Up to four ADT7420 objects share the I2C driver, see
+             *          adi_i2c_bus.h. setSlaveAddress() can change the address
+             *          before open().
+             */
+            ADT7420(const uint8_t nAddress = ADT7420_ADDRESS_BASE);
+
             /*!< Pure virtual functions must be implemented by the derived class */
             virtual SENSOR_RESULT open();
             virtual SENSOR_RESULT start();
@@ -75,10 +176,198 @@ namespace adi_sensor_swpack
 
             virtual SENSOR_RESULT getTemperatureInCelsius(float *pTemperatureCelsius);
 
+            /*!
+             * @brief   Sets the temperature resolution.
+             *
+             * @param   [in] eResolution : 13 or 16 bits.
+             *
+             * @return  SENSOR_RESULT
+             *
+             * @details The conversion of getTemperatureInCelsius() and
+             *          getTemperatureInFahrenheit() follows the resolution. The
+             *          first result at the new resolution is ready after one
+             *          conversion time.
+             */
+            SENSOR_RESULT setResolution(const RESOLUTION eResolution);
+
+            /*!
+             * @brief   Returns the temperature resolution.
+             */
+            RESOLUTION getResolution()
+            {
+                return m_eResolution;
+            }
+
+            /*!
+             * @brief   Sets the conversion mode used while the sensor is started.
+             *
+             * @param   [in] eMode : Operation mode.
+             *
+             * @return  SENSOR_RESULT
+             *
+             * @details Written to the part right away when it is started. In one-shot
+             *          mode every reading starts a conversion and waits up to
+             *          #ADT7420_CONVERSION_TIME for it, and the part shuts down again
+             *          on its own, which suits long sample periods. Use
+             *          startConversion() and isConversionReady() to do other work
+             *          during the conversion instead.
+             */
+            SENSOR_RESULT setOperationMode(const OPERATION_MODE eMode);
+
+            /*!
+             * @brief   Returns the conversion mode used while the sensor is started.
+             */
+            OPERATION_MODE getOperationMode()
+            {
+                return m_eMode;
+            }
+
+            /*!
+             * @brief   Starts a one-shot conversion.
+             *
+             * @return  SENSOR_RESULT
+             *
+             * @details Only has an effect in one-shot mode. The next reading waits
+             *          for this conversion instead of starting another one.
+             */
+            SENSOR_RESULT startConversion();
+
+            /*!
+             * @brief   Checks if a new conversion result is ready.
+             *
+             * @param   [out] pbReady : true when the temperature registers hold a
+             *                          result that has not been read yet.
+             *
+             * @return  SENSOR_RESULT
+             */
+            SENSOR_RESULT isConversionReady(bool *pbReady);
+
+            /*!
+             * @brief   Returns the conversion time of the current mode in ms.
+             *
+             * @details 0 in shutdown mode, no conversion is made.
+             */
+            uint32_t getConversionTime();
+
+            /*!
+             * @brief   Programs the alarm limits.
+             *
+             * @param   [in] nLow        : T_LOW, m degree C.
+             * @param   [in] nHigh       : T_HIGH, m degree C.
+             * @param   [in] nCritical   : T_CRIT, m degree C.
+             * @param   [in] nHysteresis : Degree C a reading must move back inside a
+             *                             limit before the alarm clears, up to
+             *                             #ADT7420_HYSTERESIS_MAX.
+             *
+             * @return  SENSOR_RESULT
+             *
+             * @details The limits are rounded to 1/128 degree C. The part compares
+             *          each conversion, so alarms need the continuous or the 1 SPS
+             *          mode; 1 SPS draws the least.
+             */
+            SENSOR_RESULT setAlarmLimits(const int32_t nLow, const int32_t nHigh, const int32_t nCritical,
+                                         const uint32_t nHysteresis);
+
+            /*!
+             * @brief   Enables the INT pin interrupt.
+             *
+             * @param   [in] pfCallback : Called from the GPIO interrupt when the
+             *                            temperature leaves or returns inside the
+             *                            limits, or NULL to only poll isAlarmPending().
+             * @param   [in] pCBParam   : Passed to pfCallback.
+             *
+             * @return  SENSOR_RESULT
+             *
+             * @details The INT pin runs in interrupt mode: it is asserted once per
+             *          crossing and released by the next register read, so the
+             *          application only wakes on excursions. The GPIO is set in
+             *          adi_adt7420_cfg.h. Call getAlarmStatus() after each interrupt.
+             */
+            SENSOR_RESULT enableAlarm(ADI_CALLBACK const pfCallback, void *const pCBParam);
+
+            /*!
+             * @brief   Disables the INT pin interrupt.
+             *
+             * @return  SENSOR_RESULT
+             */
+            SENSOR_RESULT disableAlarm();
+
+            /*!
+             * @brief   Returns true when the INT pin fired since the last getAlarmStatus().
+             */
+            bool isAlarmPending()
+            {
+                return m_bAlarm;
+            }
+
+            /*!
+             * @brief   Reads the limit flags.
+             *
+             * @param   [out] pStatus : #ALARM flags of the last conversion, 0 when
+             *                          the temperature is back inside the limits.
+             *
+             * @return  SENSOR_RESULT
+             *
+             * @details Releases the INT pin and clears isAlarmPending().
+             */
+            SENSOR_RESULT getAlarmStatus(uint8_t *pStatus);
+
+            /*!
+             * @brief   Reads several sensors on the bus.
+             *
+             * @param   [in]  ppSensors     : Started sensors.
+             * @param   [in]  nSensors      : Number of sensors.
+             * @param   [out] pMilliCelsius : One temperature per sensor, m degree C.
+             *
+             * @return  SENSOR_RESULT of the first sensor that failed, the
+             *          temperatures from there on are not written.
+             *
+             * @details Sensors in one-shot mode are all triggered before the first
+             *          one is read, so their conversions overlap and the batch
+             *          takes one conversion time instead of one per sensor. The
+             *          sensors are then read in turn.
+             */
+            static SENSOR_RESULT readTemperatures(ADT7420 *const *ppSensors, const uint32_t nSensors,
+                                                  int32_t *pMilliCelsius);
+
+            /*!
+             * @brief   Reads the temperature without waiting for the bus.
+             *
+             * @param   [in] pfCallback : Called with Event set to the SENSOR_RESULT
+             *                            of the read and pArg pointing to the
+             *                            int32_t temperature in m degree C.
+             * @param   [in] pCBParam   : Passed to pfCallback.
+             *
+             * @return  SENSOR_RESULT, ERROR_CODE_READ_BUSY while the previous read
+             *          is pending.
+             *
+             * @details The read is queued on the shared bus, see adi_i2c_bus.h, and
+             *          the driver moves the bytes while the application does other
+             *          work. pfCallback runs from adi_i2c_bus_Process() in the main
+             *          loop. In one-shot mode call startConversion() at least
+             *          getConversionTime() earlier. A read made before that first
+             *          polls RDY on the bus until the conversion is done, or fails
+             *          with ERROR_CODE_RDY_TIMEOUT after #ADT7420_READY_TIMEOUT.
+             */
+            SENSOR_RESULT readTemperatureAsync(ADI_CALLBACK const pfCallback, void *const pCBParam);
+
+            /*!
+             * @brief   Returns true while readTemperatureAsync() is pending.
+             */
+            bool isReadPending()
+            {
+                return((m_sRequest.eState == ADI_I2C_BUS_QUEUED) || (m_sRequest.eState == ADI_I2C_BUS_ACTIVE));
+            }
+
         private:
 
             /*!
-              * @brief   Initialize I2C.
+             * @brief   Completion of readTemperatureAsync().
+             */
+            static void ReadCallback(ADI_I2C_BUS_REQUEST *pRequest);
+
+            /*!
+              * @brief   Opens the shared I2C bus.
               *
               * @details This method is used to initialize I2C.
               */
@@ -94,9 +383,67 @@ namespace adi_sensor_swpack
                           */
             SENSOR_RESULT ReadTemperature(uint8_t *pTemperature, const uint32_t sizeInBytes);
 
-            uint8_t        m_slave_addr;
-            ADI_I2C_HANDLE m_i2c_handle;
-            uint8_t        m_I2C_memory[ADI_I2C_MEMORY_SIZE];
+            /*!
+             * @brief   Reads sizeInBytes registers starting at nReg.
+             */
+            SENSOR_RESULT ReadRegister(const uint8_t nReg, uint8_t *pData, const uint32_t sizeInBytes);
+
+            /*!
+             * @brief   Writes sizeInBytes registers starting at nReg.
+             */
+            SENSOR_RESULT WriteRegister(const uint8_t nReg, const uint8_t *pData, const uint32_t sizeInBytes);
+
+            /*!
+             * @brief   Writes a limit register pair.
+             */
+            SENSOR_RESULT WriteLimit(const uint8_t nReg, const int32_t nMilliCelsius);
+
+            /*!
+             * @brief   GPIO callback of the INT pin.
+             */
+            static void AlarmCallback(void *pCBParam, uint32_t Event, void *pArg);
+
+            /*!
+             * @brief   Writes the configuration register with the given mode.
+             */
+            SENSOR_RESULT WriteConfig(const OPERATION_MODE eMode);
+
+            /*!
+             * @brief   Polls the status register until a conversion result is ready.
+             *
+             * @details Sleeps with adi_time_Sleep() between status reads and gives
+             *          up after nTimeoutMs.
+             */
+            SENSOR_RESULT WaitReady(const uint32_t nTimeoutMs);
+
+            /*!
+             * @brief   Queues a register read for readTemperatureAsync().
+             */
+            SENSOR_RESULT SubmitRead(const uint8_t nReg, const uint16_t nSize);
+
+            /*!
+             * @brief   Converts a temperature register value at the current resolution.
+             */
+            int32_t ToMilliCelsius(const uint8_t *pBuffer);
+
+            RESOLUTION     m_eResolution;       /*!< Temperature resolution                  */
+            OPERATION_MODE m_eMode;             /*!< Conversion mode while started           */
+            bool           m_bStarted;          /*!< The part is in m_eMode, not shut down   */
+            bool           m_bPending;          /*!< A one-shot conversion was started       */
+            uint32_t       m_nConversionEnd;    /*!< adi_time deadline of the conversion     */
+            uint32_t       m_nReadyDeadline;    /*!< adi_time deadline to give up on RDY     */
+            uint8_t        m_nConfig;           /*!< Other configuration register bits       */
+            volatile bool  m_bAlarm;            /*!< INT fired, set from the interrupt       */
+            ADI_CALLBACK   m_pfAlarmCallback;   /*!< Application alarm callback              */
+            void          *m_pAlarmCBParam;     /*!< Parameter of m_pfAlarmCallback          */
+            uint8_t        m_gpio_memory[ADI_GPIO_MEMORY_SIZE];
+
+            ADI_I2C_BUS_REQUEST m_sRequest;             /*!< Bus request of readTemperatureAsync() */
+            uint8_t             m_nRequestReg;          /*!< Register address of m_sRequest        */
+            uint8_t             m_aRequestData[2];      /*!< Temperature registers read            */
+            int32_t             m_nRequestMilliCelsius; /*!< Converted result, m degree C          */
+            ADI_CALLBACK        m_pfReadCallback;       /*!< Application read callback             */
+            void               *m_pReadCBParam;         /*!< Parameter of m_pfReadCallback         */
     };
 }
 
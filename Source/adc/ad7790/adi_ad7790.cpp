@@ -48,11 +48,21 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "adi_ad7790_cfg.h"
 #include <adc/ad7790/adi_ad7790.h>
 #include <base_sensor/adi_sensor_errors.h>
+#include <common/adi_spi_dma.h>
 
 
 namespace adi_sensor_swpack {
 
 
+    /* Conversion period of each filter word rate with the clock undivided, us */
+    static const uint32_t aWordRateUs[8] = {
+        8333u, 10000u, 30030u, 50000u, 60241u, 59880u, 75188u, 105263u
+    };
+
+/* Conversion period of the static configuration, a divided clock slows the filter by the same factor */
+#define AD7790_CONVERSION_US    (aWordRateUs[AD7790_CFG_FILTER_WORD_RATE] << AD7790_CFG_FILTER_CLOCK_DIV)
+
+
     /*********************************************************************************
                                        PUBLIC FUNCTIONS
     *********************************************************************************/
@@ -65,7 +75,10 @@ namespace adi_sensor_swpack {
         // Some members of SPI transceiver struct are constant and can be configured once in order to save cycles
         m_adc_spi_config.nTxIncrement = 1u;
         m_adc_spi_config.nRxIncrement = 1u;
-        m_adc_spi_config.bDMA         = false;
+        // DMA is only used for transfers above ADI_SPI_DMA_CFG_THRESHOLD
+        m_adc_spi_config.bDMA         = true;
+
+        m_pTaskData = NULL;
     }
 
 
@@ -121,7 +134,7 @@ namespace adi_sensor_swpack {
         m_adc_spi_config.pTransmitter     = aTransmitBytes;
         m_adc_spi_config.pReceiver        = NULL;
 
-        eSpiResult = adi_spi_MasterReadWrite(*m_adc_spi_phandle, &m_adc_spi_config);
+        eSpiResult = adi_spi_dma_ReadWrite(*m_adc_spi_phandle, &m_adc_spi_config);
 
         if(eSpiResult == ADI_SPI_SUCCESS) {
             return (SENSOR_ERROR_NONE);
@@ -150,7 +163,7 @@ namespace adi_sensor_swpack {
         m_adc_spi_config.pTransmitter     = &nTransmitByte;
         m_adc_spi_config.pReceiver        = &nReceivedByte;
 
-        eSpiResult = adi_spi_MasterReadWrite(*m_adc_spi_phandle, &m_adc_spi_config);
+        eSpiResult = adi_spi_dma_ReadWrite(*m_adc_spi_phandle, &m_adc_spi_config);
 
         if(eSpiResult == ADI_SPI_SUCCESS) {
             *regValue = nReceivedByte;
@@ -178,7 +191,7 @@ namespace adi_sensor_swpack {
         m_adc_spi_config.pTransmitter     = aTransmitBytes;
         m_adc_spi_config.pReceiver        = NULL;
 
-        eSpiResult = adi_spi_MasterReadWrite(*m_adc_spi_phandle, &m_adc_spi_config);
+        eSpiResult = adi_spi_dma_ReadWrite(*m_adc_spi_phandle, &m_adc_spi_config);
 
         if(eSpiResult == ADI_SPI_SUCCESS) {
             return (SENSOR_ERROR_NONE);
@@ -192,37 +205,68 @@ namespace adi_sensor_swpack {
 
     SENSOR_RESULT AD7790::getData(uint16_t * pData)
     {
-        ADI_SPI_RESULT eSpiResult;
-        SENSOR_RESULT  eAdcResult;
-        uint32_t       nCounter          = 0u;
-        uint8_t        nTransmitByte     = AD7790::READ_DATA;
-        uint8_t        aReceiveBytes[2u] = {0x00u, 0x00u};
-        uint8_t        nStatus;
+        SENSOR_RESULT eAdcResult;
+
+        if((eAdcResult = this->beginRead(pData)) == SENSOR_ERROR_NONE) {
+            eAdcResult = this->WaitTask();
+        }
+
+        return (eAdcResult);
+    }
+
+
+    SENSOR_RESULT AD7790::getVoltage(float * pData)
+    {
+        SENSOR_RESULT eResult;
+        uint32_t      nAdcMid = (1u << (AD7790_WIDTH_BITS - 1u));
+        uint16_t      nAdcData;
 
-        ASSERT(m_adc_spi_phandle != NULL);
-        ASSERT(*m_adc_spi_phandle != NULL);
         ASSERT(pData != NULL);
 
-        do {
-            eAdcResult = this->readRegister(AD7790::READ_STATUS, 1u, &nStatus);
+        eResult = this->getData(&nAdcData);
 
-            if(eAdcResult != SENSOR_ERROR_NONE) {
-                return (eAdcResult);
-            }
+        if(eResult == SENSOR_ERROR_NONE) {
+            *pData = (((((float) nAdcData) / ((float) nAdcMid)) - 1.0F) * ((float) AD7790_REFERENCE_VOLTAGE)) / ((float) AD7790_GAIN);
+        }
 
-            nCounter++;
+        return (eResult);
+    }
 
-            if(nCounter == AD7790_MAX_STATUS_READS) {
-                break;
-            }
 
-            for(volatile uint16_t i = 0u; i < AD7790_STATUS_DELAY_LOOPS; i++);
+    SENSOR_RESULT AD7790::beginRead(uint16_t * pData)
+    {
+        ASSERT(pData != NULL);
+
+        if(!this->BeginTask(AD7790_CONVERSION_US * AD7790_TIMEOUT_CONVERSIONS)) {
+            return (SET_SENSOR_ERROR(SENSOR_ERROR_ADC, AD7790::TASK_BUSY));
+        }
+
+        m_pTaskData = pData;
+
+        return (SENSOR_ERROR_NONE);
+    }
+
+
+    SENSOR_RESULT AD7790::poll()
+    {
+        ADI_SPI_RESULT eSpiResult;
+        SENSOR_RESULT  eAdcResult        = SENSOR_ERROR_NONE;
+        uint8_t        nTransmitByte     = AD7790::READ_DATA;
+        uint8_t        aReceiveBytes[2u] = {0x00u, 0x00u};
+
+        ASSERT(m_adc_spi_phandle != NULL);
+        ASSERT(*m_adc_spi_phandle != NULL);
 
+        if(!m_bTaskBusy) {
+            return (SENSOR_ERROR_NONE);
         }
-        while((nStatus & AD7790_STATUS_NOT_RDY_BITM) == AD7790_STATUS_NOT_RDY_BITM);
 
-        if(nCounter == AD7790_MAX_STATUS_READS) {
-            return (SET_SENSOR_ERROR(SENSOR_ERROR_ADC, AD7790::DATA_READ_STATUS_TIMEOUT));
+        SENSOR_TASK_BEGIN();
+
+        SENSOR_TASK_WAIT_UNTIL(this->IsTaskReady(&eAdcResult));
+
+        if(eAdcResult != SENSOR_ERROR_NONE) {
+            SENSOR_TASK_EXIT(eAdcResult);
         }
 
         m_adc_spi_config.TransmitterBytes = 1u;
@@ -231,40 +275,44 @@ namespace adi_sensor_swpack {
         m_adc_spi_config.pTransmitter     = &nTransmitByte;
         m_adc_spi_config.pReceiver        = aReceiveBytes;
 
-        eSpiResult = adi_spi_MasterReadWrite(*m_adc_spi_phandle, &m_adc_spi_config);
+        eSpiResult = adi_spi_dma_ReadWrite(*m_adc_spi_phandle, &m_adc_spi_config);
 
         if(eSpiResult == ADI_SPI_SUCCESS) {
-            *pData = ((aReceiveBytes[0u] << 8u) | aReceiveBytes[1u]);
-            return (SENSOR_ERROR_NONE);
+            *m_pTaskData = ((aReceiveBytes[0u] << 8u) | aReceiveBytes[1u]);
         }
         else {
             // TODO: Check and log hardware errors if they occur
-            return (SET_SENSOR_ERROR(SENSOR_ERROR_SPI, eSpiResult));
+            eAdcResult = SET_SENSOR_ERROR(SENSOR_ERROR_SPI, eSpiResult);
         }
+
+        SENSOR_TASK_END(eAdcResult);
     }
 
 
-    SENSOR_RESULT AD7790::getVoltage(float * pData)
-    {
-        SENSOR_RESULT eResult;
-        uint32_t      nAdcMid = (1u << (AD7790_WIDTH_BITS - 1u));
-        uint16_t      nAdcData;
+    /*********************************************************************************
+                                       PRIVATE FUNCTIONS
+    *********************************************************************************/
 
-        ASSERT(pData != NULL);
 
-        eResult = this->getData(&nAdcData);
+    bool AD7790::IsTaskReady(SENSOR_RESULT * pResult)
+    {
+        uint8_t nStatus;
 
-        if(eResult == SENSOR_ERROR_NONE) {
-            *pData = (((((float) nAdcData) / ((float) nAdcMid)) - 1.0F) * ((float) AD7790_REFERENCE_VOLTAGE)) / ((float) AD7790_GAIN);
+        if((*pResult = this->readRegister(AD7790::READ_STATUS, 1u, &nStatus)) != SENSOR_ERROR_NONE) {
+            return (true);
         }
 
-        return (eResult);
-    }
+        if((nStatus & AD7790_STATUS_NOT_RDY_BITM) != AD7790_STATUS_NOT_RDY_BITM) {
+            return (true);
+        }
 
+        if(this->IsTaskExpired()) {
+            *pResult = SET_SENSOR_ERROR(SENSOR_ERROR_ADC, AD7790::DATA_READ_STATUS_TIMEOUT);
+            return (true);
+        }
 
-    /*********************************************************************************
-                                       PRIVATE FUNCTIONS
-    *********************************************************************************/
+        return (false);
+    }
 
 
     SENSOR_RESULT AD7790::applyStaticConfig(void)
@@ -46,15 +46,28 @@ POSSIBILITY OF SUCH DAMAGE.
 *****************************************************************************/
 
 #include <adc/ad7798/adi_ad7798.h>
+#include <common/adi_spi_dma.h>
+#include <common/adi_time.h>
 #include "adi_ad7798_cfg.h"
 
 namespace adi_sensor_swpack {
+
+    /* Conversion period of each FILTER_RATE, us, 0 is reserved */
+    static const uint32_t aConversionUs[16] = {
+        2128u,   2128u,   4132u,   8130u,   16129u,  20000u,  25641u,  30120u,
+        51020u,  59880u,  59880u,  80000u,  100000u, 120048u, 160000u, 239808u
+    };
+
     AD7798::AD7798()
     {
         /* Initialize SPI transceive structure static members  */
         m_transceive.nTxIncrement = 1u;
         m_transceive.nRxIncrement = 1u;
         m_transceive.bDMA         = AD7798_SPI_DMA_CFG ;
+
+        m_filter    = (AD7798::FILTER_RATE) AD7798_FILTER_RATE_CFG;
+        m_eTaskMode = AD7798::OPERATING_MODE_CAL_SYS_ZERO;
+        m_pTaskData = NULL;
     }
 
     SENSOR_RESULT AD7798::init()
@@ -99,7 +112,7 @@ namespace adi_sensor_swpack {
         m_transceive.pTransmitter     = m_txBuffer;
         m_transceive.pReceiver        = NULL;
 
-        if((eSpiResult = adi_spi_MasterReadWrite(m_spi_handle, &m_transceive)) != ADI_SPI_SUCCESS) {
+        if((eSpiResult = adi_spi_dma_ReadWrite(m_spi_handle, &m_transceive)) != ADI_SPI_SUCCESS) {
             if(eSpiResult == ADI_SPI_HW_ERROR_OCCURRED) {
                 //TODO: Set hardware error
             }
@@ -126,7 +139,7 @@ namespace adi_sensor_swpack {
         m_transceive.pTransmitter     = &m_txBuffer[0];
         m_transceive.pReceiver        = &regValue[0];
 
-        if((eSpiResult = adi_spi_MasterReadWrite(m_spi_handle, &m_transceive)) != ADI_SPI_SUCCESS) {
+        if((eSpiResult = adi_spi_dma_ReadWrite(m_spi_handle, &m_transceive)) != ADI_SPI_SUCCESS) {
             if(eSpiResult == ADI_SPI_HW_ERROR_OCCURRED) {
                 //TODO: Set hardware error
             }
@@ -156,7 +169,7 @@ namespace adi_sensor_swpack {
         m_transceive.bRD_CTL          = false;
 
 
-        if((eSpiResult = adi_spi_MasterReadWrite(m_spi_handle, &m_transceive)) != ADI_SPI_SUCCESS) {
+        if((eSpiResult = adi_spi_dma_ReadWrite(m_spi_handle, &m_transceive)) != ADI_SPI_SUCCESS) {
             if(eSpiResult == ADI_SPI_HW_ERROR_OCCURRED) {
                 //TODO: Set hardware error
             }
@@ -334,7 +347,9 @@ namespace adi_sensor_swpack {
             nRegVal = AD7798_FORMAT_DATA(m_rxBuffer[0], m_rxBuffer[1]) & ~AD7798_MODE_RATE(0xFu);
             nRegVal |= AD7798_MODE_RATE(rate);
 
-            eSensorResult = this->writeRegister(AD7798::REGISTER_MODE, 2u, nRegVal);
+            if((eSensorResult = this->writeRegister(AD7798::REGISTER_MODE, 2u, nRegVal)) == SENSOR_ERROR_NONE) {
+                m_filter = rate;
+            }
         }
 
         return (eSensorResult);
@@ -364,25 +379,9 @@ namespace adi_sensor_swpack {
     SENSOR_RESULT AD7798::fullScaleSystemCalibration()
     {
         SENSOR_RESULT eSensorResult;
-        uint32_t   nTicks = 0;
-
-        /* Set the operating mode to full system calibration to begin the calibration */
-        if((eSensorResult = setOperatingMode(AD7798::OPERATING_MODE_CAL_SYS_FULL)) == SENSOR_ERROR_NONE) {
-            /* Poll the status register for ready signal to go low. The ready bit will be cleared once the calibration is complete. */
-            do {
-                if((eSensorResult = this->readRegister(AD7798::REGISTER_COMM_STAT, 1u, &m_rxBuffer[0])) != SENSOR_ERROR_NONE) {
-                    return(eSensorResult);
-                }
-
-                /* Check for timeout */
-                if(nTicks == AD7798_TRANSACTION_TIMEOUT) {
-                    return(SET_SENSOR_ERROR(SENSOR_ERROR_ADC, AD7798::ERROR_CODE_RDY_TIMEOUT));
-                }
 
-                nTicks++;
-
-            }
-            while(((m_rxBuffer[0] & AD7798_STAT_RDY) == AD7798_STAT_RDY));
+        if((eSensorResult = beginCalibration(AD7798::OPERATING_MODE_CAL_SYS_FULL)) == SENSOR_ERROR_NONE) {
+            eSensorResult = WaitTask();
         }
 
         return (eSensorResult);
@@ -392,25 +391,9 @@ namespace adi_sensor_swpack {
     SENSOR_RESULT AD7798::zeroScaleSystemCalibration()
     {
         SENSOR_RESULT eSensorResult;
-        uint32_t   nTicks = 0;
-
-        /* Set the operating mode to zero system calibration to begin the calibration */
-        if((eSensorResult = setOperatingMode(AD7798::OPERATING_MODE_CAL_SYS_ZERO)) == SENSOR_ERROR_NONE) {
-            /* Poll the status register for ready signal to go low. The ready bit will be cleared once the calibration is complete. */
-            do {
-                if((eSensorResult = this->readRegister(AD7798::REGISTER_COMM_STAT, 1u, &m_rxBuffer[0])) != SENSOR_ERROR_NONE) {
-                    return(eSensorResult);
-                }
-
-                /* Check for timeout */
-                if(nTicks == AD7798_TRANSACTION_TIMEOUT) {
-                    return(SET_SENSOR_ERROR(SENSOR_ERROR_ADC, AD7798::ERROR_CODE_RDY_TIMEOUT));
-                }
-
-                nTicks++;
 
-            }
-            while(((m_rxBuffer[0] & AD7798_STAT_RDY) == AD7798_STAT_RDY));
+        if((eSensorResult = beginCalibration(AD7798::OPERATING_MODE_CAL_SYS_ZERO)) == SENSOR_ERROR_NONE) {
+            eSensorResult = WaitTask();
         }
 
         return (eSensorResult);
@@ -419,30 +402,103 @@ namespace adi_sensor_swpack {
     SENSOR_RESULT AD7798::getData(uint16_t * data)
     {
         SENSOR_RESULT eSensorResult;
-        uint32_t   nTicks = 0;
 
-        /* Poll the status register for ready signal to go low. The ready bit will be cleared once the conversion is complete. */
-        do {
-            if((eSensorResult = this->readRegister(AD7798::REGISTER_COMM_STAT, 1u, &m_rxBuffer[0])) != SENSOR_ERROR_NONE) {
-                return(eSensorResult);
+        if((eSensorResult = beginRead(data)) == SENSOR_ERROR_NONE) {
+            eSensorResult = WaitTask();
+        }
+
+        return (eSensorResult);
+    }
+
+
+    SENSOR_RESULT AD7798::beginCalibration(AD7798::OPERATING_MODE mode)
+    {
+        ASSERT(mode >= AD7798::OPERATING_MODE_CAL_INT_ZERO);
+
+        if(!BeginTask(GetConversionUs() * AD7798_TIMEOUT_CONVERSIONS)) {
+            return(SET_SENSOR_ERROR(SENSOR_ERROR_ADC, AD7798::ERROR_CODE_TASK_BUSY));
+        }
+
+        m_eTaskMode = mode;
+        m_pTaskData = NULL;
+
+        return(SENSOR_ERROR_NONE);
+    }
+
+
+    SENSOR_RESULT AD7798::beginRead(uint16_t * data)
+    {
+        ASSERT(data != NULL);
+
+        if(!BeginTask(GetConversionUs() * AD7798_TIMEOUT_CONVERSIONS)) {
+            return(SET_SENSOR_ERROR(SENSOR_ERROR_ADC, AD7798::ERROR_CODE_TASK_BUSY));
+        }
+
+        m_pTaskData = data;
+
+        return(SENSOR_ERROR_NONE);
+    }
+
+
+    SENSOR_RESULT AD7798::poll()
+    {
+        SENSOR_RESULT eSensorResult = SENSOR_ERROR_NONE;
+
+        if(!m_bTaskBusy) {
+            return(SENSOR_ERROR_NONE);
+        }
+
+        SENSOR_TASK_BEGIN();
+
+        /* A calibration begins when its mode is written, a read waits for the running conversion */
+        if(m_pTaskData == NULL) {
+            if((eSensorResult = setOperatingMode(m_eTaskMode)) != SENSOR_ERROR_NONE) {
+                SENSOR_TASK_EXIT(eSensorResult);
             }
+        }
+
+        /* Sleep through the calibration, the status is only polled once it should be done */
+        if(m_pTaskData == NULL) {
+            SENSOR_TASK_SLEEP_UNTIL(adi_time_Deadline(GetConversionUs() * AD7798_CALIBRATION_CONVERSIONS));
+        }
+
+        /* The ready bit will be cleared once the calibration or conversion is complete */
+        SENSOR_TASK_WAIT_UNTIL(IsTaskReady(&eSensorResult));
 
-            /* Check for timeout */
-            if(nTicks == AD7798_TRANSACTION_TIMEOUT) {
-                return(SET_SENSOR_ERROR(SENSOR_ERROR_ADC, AD7798::ERROR_CODE_RDY_TIMEOUT));
+        /* Read the Data register */
+        if((eSensorResult == SENSOR_ERROR_NONE) && (m_pTaskData != NULL)) {
+            if((eSensorResult = this->readRegister(AD7798::REGISTER_DATA, 2u, &m_rxBuffer[0])) == SENSOR_ERROR_NONE) {
+                *m_pTaskData = (uint16_t) AD7798_FORMAT_DATA(m_rxBuffer[0], m_rxBuffer[1]);
             }
+        }
+
+        SENSOR_TASK_END(eSensorResult);
+    }
 
-            nTicks++;
 
+    bool AD7798::IsTaskReady(SENSOR_RESULT * pResult)
+    {
+        if((*pResult = this->readRegister(AD7798::REGISTER_COMM_STAT, 1u, &m_rxBuffer[0])) != SENSOR_ERROR_NONE) {
+            return(true);
         }
-        while(((m_rxBuffer[0] & AD7798_STAT_RDY) == AD7798_STAT_RDY));
 
-        /* Read the Data register */
-        if((eSensorResult = this->readRegister(AD7798::REGISTER_DATA, 2u, &m_rxBuffer[0])) == SENSOR_ERROR_NONE) {
-            *data = (uint16_t) AD7798_FORMAT_DATA(m_rxBuffer[0], m_rxBuffer[1]);
+        if((m_rxBuffer[0] & AD7798_STAT_RDY) != AD7798_STAT_RDY) {
+            return(true);
         }
 
-        return (eSensorResult);
+        /* Check for timeout */
+        if(IsTaskExpired()) {
+            *pResult = SET_SENSOR_ERROR(SENSOR_ERROR_ADC, AD7798::ERROR_CODE_RDY_TIMEOUT);
+            return(true);
+        }
+
+        return(false);
+    }
+
+
+    uint32_t AD7798::GetConversionUs(void) const
+    {
+        return(aConversionUs[m_filter & 0x0Fu]);
     }
 }
 
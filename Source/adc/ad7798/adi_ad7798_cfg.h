@@ -91,12 +91,12 @@ POSSIBILITY OF SUCH DAMAGE.
 /*!
  * @breif Configure DMA use.
  *
- * @details  When initializing the SPI, this flag will either enable or disable
- *           DMA use for all the transactions.
- *            true  : use DMA
+ * @details  Allows the transactions to use DMA, see common/adi_spi_dma.h.
+ *            true  : use DMA for transfers of ADI_SPI_DMA_CFG_THRESHOLD bytes
+ *                    or more, PIO for the register accesses below it
  *            false : use PIO
  */
-#define AD7798_SPI_DMA_CFG        (false)
+#define AD7798_SPI_DMA_CFG        (true)
 
 /****************** ADC Configuration ******************/
 /*!
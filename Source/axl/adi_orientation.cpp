@@ -0,0 +1,288 @@
+/*!
+ *****************************************************************************
+  @file adi_orientation.cpp
+
+  @brief Fixed-point pitch, roll and tilt of accelerometer frames.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+#include <string.h>
+#include <axl/adi_orientation.h>
+
+namespace adi_sensor_swpack {
+
+    namespace
+    {
+        /* Angles are carried in 2^-16 degree until the result */
+        const int32_t kDegree = 65536;
+
+        /* atan(2^-i) in 2^-16 degree */
+        const int32_t kAtan[] =
+        {
+            2949120, 1740967, 919879, 466945, 234379, 117304, 58666, 29335,
+            14668,   7334,    3667,   1833,   917,    458,    229,    115
+        };
+
+        const uint32_t kIterations = sizeof(kAtan) / sizeof(kAtan[0]);
+
+        /* 1 / CORDIC gain of kIterations steps, Q16 */
+        const int64_t kInverseGain = 39797;
+
+        /* The axes are scaled below this before the CORDIC, which grows them by up to 2.9 */
+        const int32_t kInputLimit = (1 << 28);
+
+        /*
+         * Vectoring mode CORDIC: returns atan2(nY, nX) in 2^-16 degree, -180 to 180,
+         * and sqrt(nX^2 + nY^2) in pMagnitude.
+         */
+        int32_t Vector(int32_t nX, int32_t nY, int32_t *pMagnitude)
+        {
+            int32_t nAngle = 0;
+            int32_t nNextX;
+
+            /* No direction, e.g. roll with the X axis vertical: report 0 like atan2() */
+            if((nX == 0) && (nY == 0))
+            {
+                *pMagnitude = 0;
+                return 0;
+            }
+
+            /* Rotate by 180 degree into the right half plane the iterations cover */
+            if(nX < 0)
+            {
+                nAngle = (nY >= 0) ? (180 * kDegree) : (-180 * kDegree);
+                nX = -nX;
+                nY = -nY;
+            }
+
+            for(uint32_t i = 0u; i < kIterations; i++)
+            {
+                if(nY > 0)
+                {
+                    nNextX  = nX + (nY >> i);
+                    nY      = nY - (nX >> i);
+                    nAngle += kAtan[i];
+                }
+                else
+                {
+                    nNextX  = nX - (nY >> i);
+                    nY      = nY + (nX >> i);
+                    nAngle -= kAtan[i];
+                }
+                nX = nNextX;
+            }
+
+            *pMagnitude = (int32_t)(((int64_t) nX * kInverseGain) >> 16);
+            return nAngle;
+        }
+
+        /* 2^-16 degree to 0.01 degree, rounded */
+        int16_t ToCentidegree(int32_t nAngle)
+        {
+            return (int16_t)((nAngle * 100 + (kDegree / 2)) >> 16);
+        }
+
+        int32_t Abs(int32_t nValue)
+        {
+            return (nValue < 0) ? -nValue : nValue;
+        }
+
+        void Store16(uint8_t *pDest, uint16_t nValue)
+        {
+            pDest[0] = (uint8_t) nValue;
+            pDest[1] = (uint8_t)(nValue >> 8);
+        }
+    }
+
+    OrientationEngine::OrientationEngine() :
+        m_nDeadband(0u),
+        m_nTrip(18000u),
+        m_nClear(18000u),
+        m_bTilted(false),
+        m_bReported(false)
+    {
+        memset(&m_sCurrent, 0, sizeof(m_sCurrent));
+        memset(&m_sReported, 0, sizeof(m_sReported));
+    }
+
+    void OrientationEngine::setDeadband(uint16_t nDeadband)
+    {
+        m_nDeadband = nDeadband;
+    }
+
+    void OrientationEngine::setTiltAlarm(uint16_t nTrip, uint16_t nClear)
+    {
+        m_nTrip  = nTrip;
+        m_nClear = (nClear > nTrip) ? nTrip : nClear;
+    }
+
+    uint32_t OrientationEngine::update(const int16_t *pFrames, uint32_t nFrames)
+    {
+        int32_t  aSum[3] = {0, 0, 0};
+        int32_t  nPitch, nRoll;
+        uint32_t nEvents = ADI_ORIENTATION_EVENT_NONE;
+
+        /* The angles only depend on the direction, so the sum stands in for the mean */
+        for(uint32_t nFrame = 0u; nFrame < nFrames; nFrame++)
+        {
+            aSum[0] += pFrames[0];
+            aSum[1] += pFrames[1];
+            aSum[2] += pFrames[2];
+            pFrames += 3;
+        }
+
+        Compute(aSum[0], aSum[1], aSum[2], &m_sCurrent);
+
+        nPitch = (int32_t) m_sCurrent.nPitch - m_sReported.nPitch;
+        nRoll  = (int32_t) m_sCurrent.nRoll - m_sReported.nRoll;
+
+        /* Roll wraps around at +/-180 degree */
+        if(nRoll > 18000)
+        {
+            nRoll -= 36000;
+        }
+        else if(nRoll < -18000)
+        {
+            nRoll += 36000;
+        }
+
+        if(!m_bReported || (Abs(nPitch) >= (int32_t) m_nDeadband) || (Abs(nRoll) >= (int32_t) m_nDeadband))
+        {
+            m_sReported = m_sCurrent;
+            m_bReported = true;
+            nEvents    |= ADI_ORIENTATION_EVENT_CHANGED;
+        }
+
+        if(!m_bTilted && (m_sCurrent.nTilt > m_nTrip))
+        {
+            m_bTilted = true;
+            nEvents  |= ADI_ORIENTATION_EVENT_TILT_ALARM;
+        }
+        else if(m_bTilted && (m_sCurrent.nTilt < m_nClear))
+        {
+            m_bTilted = false;
+            nEvents  |= ADI_ORIENTATION_EVENT_TILT_CLEAR;
+        }
+
+        return nEvents;
+    }
+
+    void OrientationEngine::convert(const int16_t *pFrames, uint32_t nFrames, ADI_ORIENTATION *pResult)
+    {
+        for(uint32_t nFrame = 0u; nFrame < nFrames; nFrame++)
+        {
+            Compute(pFrames[0], pFrames[1], pFrames[2], &pResult[nFrame]);
+            pFrames += 3;
+        }
+    }
+
+    void OrientationEngine::Compute(int32_t nX, int32_t nY, int32_t nZ, ADI_ORIENTATION *pResult)
+    {
+        int32_t nMax = Abs(nX);
+        int32_t nRadius;
+
+        if(Abs(nY) > nMax)
+        {
+            nMax = Abs(nY);
+        }
+        if(Abs(nZ) > nMax)
+        {
+            nMax = Abs(nZ);
+        }
+
+        /* Bring the largest axis to 2^27..2^28 for the resolution of the CORDIC */
+        if(nMax != 0)
+        {
+            while(nMax >= kInputLimit)
+            {
+                nX >>= 1;
+                nY >>= 1;
+                nZ >>= 1;
+                nMax >>= 1;
+            }
+            while(nMax < (kInputLimit / 2))
+            {
+                nX *= 2;
+                nY *= 2;
+                nZ *= 2;
+                nMax *= 2;
+            }
+        }
+
+        pResult->nRoll  = ToCentidegree(Vector(nZ, nY, &nRadius));
+        pResult->nPitch = ToCentidegree(Vector(nRadius, -nX, &nRadius));
+
+        Vector(nX, nY, &nRadius);
+        pResult->nTilt  = (uint16_t) ToCentidegree(Vector(nZ, nRadius, &nRadius));
+    }
+
+    void OrientationEngine::fillRegistration(uint8_t nSensorId, ADI_REGISTRATION_PACKET *pRegistration)
+    {
+        memset(pRegistration, 0, sizeof(ADI_REGISTRATION_PACKET));
+
+        pRegistration->nPacketHeader   = ADI_SET_HEADER(ADI_REGISTRATION_PACKET_TYPE, nSensorId);
+        pRegistration->eSensorType     = ADI_ORIENTATION_TYPE;
+        pRegistration->nNumDataTypes   = 4u;
+        pRegistration->aDataTypeKey[0] = ADI_SHORT_TYPE;
+        pRegistration->aDataTypeKey[1] = ADI_SHORT_TYPE;
+        pRegistration->aDataTypeKey[2] = ADI_SHORT_TYPE;
+        pRegistration->aDataTypeKey[3] = ADI_BYTE_TYPE;
+    }
+
+    void OrientationEngine::fillPacket(uint8_t nSensorId, uint32_t nEvents, uint32_t nTimestamp,
+                                       ADI_DATA_PACKET *pPacket) const
+    {
+        ADI_ORIENTATION_DATA sData;
+
+        Store16(sData.aPitch, (uint16_t) m_sCurrent.nPitch);
+        Store16(sData.aRoll, (uint16_t) m_sCurrent.nRoll);
+        Store16(sData.aTilt, m_sCurrent.nTilt);
+        sData.nEvents = (uint8_t) nEvents;
+
+        pPacket->nPacketHeader = ADI_SET_HEADER(ADI_DATA_PACKET_TYPE, nSensorId);
+        pPacket->eSensorType   = ADI_ORIENTATION_TYPE;
+        memcpy(pPacket->aTimestamp, &nTimestamp, 4u);
+        memset(pPacket->aPayload, 0, sizeof(pPacket->aPayload));
+        memcpy(pPacket->aPayload, &sData, sizeof(sData));
+    }
+}
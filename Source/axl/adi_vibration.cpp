@@ -0,0 +1,271 @@
+/*!
+ *****************************************************************************
+  @file adi_vibration.cpp
+
+  @brief Vibration spectrum analysis of accelerometer windows.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+#include <string.h>
+#include <axl/adi_vibration.h>
+#include <common/adi_fft.h>
+
+namespace adi_sensor_swpack {
+
+    namespace
+    {
+        /* Largest sample after scaling, keeps the FFT clear of overflow */
+        const int32_t kFullScale = 16384;
+
+        /* Undoes the input scaling with rounding, saturated to 16 bits */
+        uint16_t Unscale(uint32_t nValue, int32_t nShift)
+        {
+            if(nShift > 0)
+            {
+                nValue = (nValue + (1u << (nShift - 1))) >> nShift;
+            }
+            else if(nShift < 0)
+            {
+                nValue = (nValue > (0xFFFFu >> -nShift)) ? 0xFFFFu : (nValue << -nShift);
+            }
+            return (nValue > 0xFFFFu) ? 0xFFFFu : (uint16_t) nValue;
+        }
+
+        void Store16(uint8_t *pDest, uint16_t nValue)
+        {
+            pDest[0] = (uint8_t) nValue;
+            pDest[1] = (uint8_t)(nValue >> 8);
+        }
+    }
+
+    VibrationAnalyzer::VibrationAnalyzer() :
+        m_nPoints(ADI_VIBRATION_MAX_POINTS),
+        m_nSampleRate(1000u),
+        m_nCount(0u)
+    {
+        /* Four equal bands up to the Nyquist frequency */
+        for(uint32_t i = 0u; i <= ADI_VIBRATION_NUM_BANDS; i++)
+        {
+            m_aEdge[i] = (uint16_t)((i * m_nSampleRate) / (2u * ADI_VIBRATION_NUM_BANDS));
+        }
+        m_aEdge[ADI_VIBRATION_NUM_BANDS] = 0xFFFFu;
+    }
+
+    bool VibrationAnalyzer::setup(uint32_t nPoints, uint32_t nSampleRate)
+    {
+        if((nPoints < ADI_FFT_MIN_POINTS) || (nPoints > ADI_VIBRATION_MAX_POINTS) ||
+           ((nPoints & (nPoints - 1u)) != 0u) || (nSampleRate == 0u))
+        {
+            return false;
+        }
+
+        m_nPoints     = nPoints;
+        m_nSampleRate = nSampleRate;
+        m_nCount      = 0u;
+        return true;
+    }
+
+    void VibrationAnalyzer::setBands(const uint16_t *pEdges)
+    {
+        memcpy(m_aEdge, pEdges, sizeof(m_aEdge));
+    }
+
+    bool VibrationAnalyzer::add(const int16_t *pXYZ)
+    {
+        if(m_nCount < m_nPoints)
+        {
+            for(uint32_t nAxis = 0u; nAxis < ADI_VIBRATION_NUM_AXES; nAxis++)
+            {
+                m_aSamples[nAxis][m_nCount] = pXYZ[nAxis];
+            }
+            m_nCount++;
+        }
+
+        return (m_nCount == m_nPoints);
+    }
+
+    void VibrationAnalyzer::analyze(ADI_VIBRATION_AXIS *pResult)
+    {
+        for(uint32_t nAxis = 0u; nAxis < ADI_VIBRATION_NUM_AXES; nAxis++)
+        {
+            AnalyzeAxis(m_aSamples[nAxis], &pResult[nAxis]);
+        }
+        m_nCount = 0u;
+    }
+
+    void VibrationAnalyzer::AnalyzeAxis(int16_t *pSamples, ADI_VIBRATION_AXIS *pResult)
+    {
+        const uint32_t nHalf = m_nPoints / 2u;
+        int32_t        nSum  = 0;
+        int32_t        nMean;
+        int32_t        nMax  = 0;
+        int32_t        nShift = 0;
+        uint32_t       nPeak = 1u;
+        uint32_t       i;
+
+        /* Remove the mean (gravity and offset), then use the full Q15 range */
+        for(i = 0u; i < m_nPoints; i++)
+        {
+            nSum += pSamples[i];
+        }
+        nMean = nSum / (int32_t) m_nPoints;
+
+        for(i = 0u; i < m_nPoints; i++)
+        {
+            const int32_t nValue = pSamples[i] - nMean;
+            const int32_t nAbs   = (nValue < 0) ? -nValue : nValue;
+
+            if(nAbs > nMax)
+            {
+                nMax = nAbs;
+            }
+        }
+        while((nMax > 0) && ((nMax << (nShift + 1)) <= kFullScale) && (nShift < 14))
+        {
+            nShift++;
+        }
+        while((nMax >> -nShift) > kFullScale)
+        {
+            nShift--;
+        }
+        for(i = 0u; i < m_nPoints; i++)
+        {
+            const int32_t nValue = pSamples[i] - nMean;
+
+            pSamples[i] = (int16_t)((nShift >= 0) ? (nValue * (1 << nShift)) : (nValue >> -nShift));
+        }
+
+        adi_fft_Window(pSamples, m_nPoints);
+        adi_fft_Real(pSamples, m_nPoints);
+        adi_fft_Power(pSamples, m_nPoints, m_aPower);
+
+        /* Band RMS by Parseval: one sided bins count twice, and the Hann window
+         * keeps 3/8 of the power, so RMS^2 = 16/3 * sum of the bin powers */
+        for(uint32_t nBand = 0u; nBand < ADI_VIBRATION_NUM_BANDS; nBand++)
+        {
+            uint64_t nEnergy = 0u;
+            uint32_t nRms;
+
+            for(i = 1u; i <= nHalf; i++)
+            {
+                const uint32_t nFreq = (i * m_nSampleRate) / m_nPoints;
+
+                if((nFreq >= m_aEdge[nBand]) && (nFreq < m_aEdge[nBand + 1u]))
+                {
+                    nEnergy += m_aPower[i];
+                }
+            }
+            nRms = adi_fft_Sqrt((nEnergy * 16u) / 3u);
+            pResult->aBandRms[nBand] = Unscale(nRms, nShift);
+        }
+
+        /* Strongest bin between DC and Nyquist */
+        for(i = 2u; i < nHalf; i++)
+        {
+            if(m_aPower[i] > m_aPower[nPeak])
+            {
+                nPeak = i;
+            }
+        }
+
+        {
+            /* Parabola through the magnitudes of the peak and its neighbours,
+             * offset of the vertex in 1/256 of a bin, within +/-128 */
+            const int32_t nLeft   = (int32_t) adi_fft_Sqrt(m_aPower[nPeak - 1u]);
+            const int32_t nCenter = (int32_t) adi_fft_Sqrt(m_aPower[nPeak]);
+            const int32_t nRight  = (int32_t) adi_fft_Sqrt(m_aPower[nPeak + 1u]);
+            const int32_t nCurve  = (2 * nCenter) - nLeft - nRight;
+            int32_t       nOffset = 0;
+            uint32_t      nAmp;
+
+            if(nCurve > 0)
+            {
+                nOffset = ((nRight - nLeft) * 128) / nCurve;
+            }
+
+            pResult->nPeakFreq = Unscale((uint32_t)((((int32_t) nPeak * 256) + nOffset) * (int64_t) m_nSampleRate /
+                                                    ((int64_t) m_nPoints * 256)), 0);
+
+            /* A tone of amplitude A gives A/2 in its one sided bin, times the
+             * Hann coherent gain of 1/2 */
+            nAmp = 4u * (uint32_t) nCenter;
+            pResult->nPeakAmp = Unscale(nAmp, nShift);
+        }
+    }
+
+    void VibrationAnalyzer::fillRegistration(uint8_t nSensorId, ADI_REGISTRATION_PACKET *pRegistration)
+    {
+        memset(pRegistration, 0, sizeof(ADI_REGISTRATION_PACKET));
+
+        pRegistration->nPacketHeader   = ADI_SET_HEADER(ADI_REGISTRATION_PACKET_TYPE, nSensorId);
+        pRegistration->eSensorType     = ADI_VIBRATION_TYPE;
+        pRegistration->nNumDataTypes   = 8u;
+        pRegistration->aDataTypeKey[0] = ADI_BYTE_TYPE;
+        for(uint32_t i = 1u; i < 7u; i++)
+        {
+            pRegistration->aDataTypeKey[i] = ADI_SHORT_TYPE;
+        }
+        pRegistration->aDataTypeKey[7] = ADI_BYTE_TYPE;
+    }
+
+    void VibrationAnalyzer::fillPacket(uint8_t nSensorId, uint8_t nAxis, uint32_t nTimestamp,
+                                       const ADI_VIBRATION_AXIS *pResult, ADI_DATA_PACKET *pPacket)
+    {
+        ADI_VIBRATION_DATA sData;
+
+        sData.nAxis     = nAxis;
+        sData.nReserved = 0u;
+        Store16(sData.aPeakFreq, pResult->nPeakFreq);
+        Store16(sData.aPeakAmp, pResult->nPeakAmp);
+        for(uint32_t nBand = 0u; nBand < ADI_VIBRATION_NUM_BANDS; nBand++)
+        {
+            Store16(sData.aBandRms[nBand], pResult->aBandRms[nBand]);
+        }
+
+        pPacket->nPacketHeader = ADI_SET_HEADER(ADI_DATA_PACKET_TYPE, nSensorId);
+        pPacket->eSensorType   = ADI_VIBRATION_TYPE;
+        memcpy(pPacket->aTimestamp, &nTimestamp, 4u);
+        memset(pPacket->aPayload, 0, sizeof(pPacket->aPayload));
+        memcpy(pPacket->aPayload, &sData, sizeof(sData));
+    }
+}
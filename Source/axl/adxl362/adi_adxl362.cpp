@@ -55,8 +55,11 @@ POSSIBILITY OF SUCH DAMAGE.
  *  @details  ADXL362 accelerometer interface class. This class implements the
  *            accelerometer functions for the ADXL362 accelerometer.
  */
+#include <string.h>
 #include <axl/adxl362/adi_adxl362.h>
 #include <base_sensor/adi_sensor_errors.h>
+#include <common/adi_spi_dma.h>
+#include <common/adi_time.h>
 #include "adi_adxl362_cfg.h"
 
 namespace adi_sensor_swpack {
@@ -66,7 +69,24 @@ namespace adi_sensor_swpack {
      */
     ADXL362::ADXL362()
     {
-        m_range = ADI_CFG_ADXL362_RANGE;
+        m_range          = ADI_CFG_ADXL362_RANGE;
+        m_odr            = ADI_CFG_ADXL362_RATE;
+        m_eNoiseMode     = ADI_CFG_ADXL362_NOISE;
+        m_bHalfBandwidth = (ADI_CFG_ADXL362_HALF_BW != 0u);
+        m_bMeasuring     = false;
+        m_nControl       = 0xFFFFu;
+
+        m_aDrift[0]       = ADI_CFG_ADXL362_DRIFT_X;
+        m_aDrift[1]       = ADI_CFG_ADXL362_DRIFT_Y;
+        m_aDrift[2]       = ADI_CFG_ADXL362_DRIFT_Z;
+        m_nDriftReference = ADI_CFG_ADXL362_DRIFT_REFERENCE;
+
+        m_pTaskBuffer     = NULL;
+
+        m_sEdge.nTime     = 0u;
+        m_sEdge.nCount    = 0u;
+        m_pfEdgeCallback  = NULL;
+        m_pEdgeCBParam    = NULL;
     }
 
     /**
@@ -82,6 +102,9 @@ namespace adi_sensor_swpack {
     {
         SENSOR_RESULT eResult;
 
+        /* The control registers are unknown until written */
+        m_nControl = 0xFFFFu;
+
         /* Initialize SPI */
         if((eResult = this->InitSPI()) == SENSOR_ERROR_NONE) {
             if((eResult = this->InitAccelerometer()) == SENSOR_ERROR_NONE) {
@@ -97,33 +120,210 @@ namespace adi_sensor_swpack {
      * Starts ADXL362 accelerometer by starting measurement
      */
     SENSOR_RESULT   ADXL362::start()
+    {
+        /* Turn on the measurement mode with the stored settings */
+        m_bMeasuring = true;
+
+        return(WriteControl());
+    }
+
+    /**
+     * Stops accelerometer by moving it to standby mode.
+     */
+    SENSOR_RESULT   ADXL362::stop()
+    {
+        m_bMeasuring = false;
+
+        /* put accelerometer in standby mode */
+        return(WriteControl());
+    }
+
+    /**
+     * Sets the output data rate, reprogramming the accelerometer if it is measuring.
+     */
+    SENSOR_RESULT   ADXL362::setOutputDataRate(const AXL_ODR odr)
+    {
+        m_odr = odr;
+
+        return (m_bMeasuring ? WriteControl() : SENSOR_ERROR_NONE);
+    }
+
+    /**
+     * Sets the range, reprogramming the accelerometer if it is measuring.
+     */
+    SENSOR_RESULT   ADXL362::setRange(const AXL_RANGE range)
+    {
+        m_range = range;
+
+        return (m_bMeasuring ? WriteControl() : SENSOR_ERROR_NONE);
+    }
+
+    /**
+     * Sets the noise mode, reprogramming the accelerometer if it is measuring.
+     */
+    SENSOR_RESULT   ADXL362::setNoiseMode(const NOISE_MODE eNoiseMode)
+    {
+        m_eNoiseMode = eNoiseMode;
+
+        return (m_bMeasuring ? WriteControl() : SENSOR_ERROR_NONE);
+    }
+
+    /**
+     * Selects the anti-aliasing filter bandwidth, reprogramming the accelerometer if it is measuring.
+     */
+    SENSOR_RESULT   ADXL362::setHalfBandwidth(const bool bHalfBandwidth)
+    {
+        m_bHalfBandwidth = bHalfBandwidth;
+
+        return (m_bMeasuring ? WriteControl() : SENSOR_ERROR_NONE);
+    }
+
+    /**
+     * Changes all measurement settings with at most one register transaction.
+     */
+    SENSOR_RESULT   ADXL362::configure(const ADXL362_CONFIG &sConfig)
+    {
+        m_range          = sConfig.eRange;
+        m_odr            = sConfig.eOdr;
+        m_eNoiseMode     = sConfig.eNoiseMode;
+        m_bHalfBandwidth = sConfig.bHalfBandwidth;
+
+        return (m_bMeasuring ? WriteControl() : SENSOR_ERROR_NONE);
+    }
+
+    /**
+     * Returns the current measurement settings.
+     */
+    void ADXL362::getConfig(ADXL362_CONFIG *pConfig)
+    {
+        ASSERT(pConfig != NULL);
+
+        pConfig->eRange         = m_range;
+        pConfig->eOdr           = m_odr;
+        pConfig->eNoiseMode     = m_eNoiseMode;
+        pConfig->bHalfBandwidth = m_bHalfBandwidth;
+    }
+
+    /**
+     * Programs FIFO_CONTROL and FIFO_SAMPLES in one transaction
+     */
+    SENSOR_RESULT ADXL362::setFifoMode(const FIFO_MODE eMode, const uint32_t nWatermark)
+    {
+        uint32_t nControl = (uint32_t) eMode;
+
+        ASSERT(nWatermark < ADXL362_FIFO_ENTRIES_MAX);
+
+        if(nWatermark > 0xFFu) {
+            nControl |= ADXL362_FIFO_CTL_AH;
+        }
+
+        return(writeRegister(REG_FIFO_CONTROL, nControl | ((nWatermark & 0xFFu) << 8u), 2u));
+    }
+
+    /**
+     * Reads FIFO_ENTRIES_L and FIFO_ENTRIES_H
+     */
+    SENSOR_RESULT ADXL362::getFifoEntries(uint32_t *pEntries)
     {
         SENSOR_RESULT eResult;
+        uint8_t       aEntries[2];
 
-        /* Turn on the measurement mode */
-        if((eResult = writeRegister(REG_POWER_CTL, ADXL362_PCTL_MEASURE, 1u)) == SENSOR_ERROR_NONE) {
-            uint8_t filterReg = ((m_range  << ADXL362_FCTL_RANGE_BITPOS) |
-                                 (ADI_CFG_ADXL362_RATE   << ADXL362_FCTL_ODR_BITPOS));
+        ASSERT(pEntries != NULL);
 
-            /* ODR 100Hz Range - 2G */
-            if((eResult = writeRegister(REG_FILTER_CTL, filterReg, 1u)) == SENSOR_ERROR_NONE) {
-                return(SENSOR_ERROR_NONE);
-            }
+        if((eResult = readRegister(REG_FIFO_ENTRIES_L, aEntries, 2u)) == SENSOR_ERROR_NONE) {
+            *pEntries = ((uint32_t)(aEntries[1] & 0x03u) << 8u) | aEntries[0];
         }
 
-        return (eResult);
+        return(eResult);
     }
 
     /**
-     * Stops accelerometer by moving it to standby mode.
+     * Reads FIFO entries, with DMA for long bursts
      */
-    SENSOR_RESULT   ADXL362::stop()
+    SENSOR_RESULT ADXL362::readFifo(uint8_t *pBuffer, const uint32_t sizeInBytes)
     {
-        /* put accelerometer in standby mode */
-        return(writeRegister(REG_POWER_CTL, ADXL362_PCTL_STDBY, 1u));
+        ADI_SPI_TRANSCEIVER sTransceive;
+        ADI_SPI_RESULT      eSpiResult;
+        uint8_t             nCommand = ADXL362_CMD_READ_FIFO;
+
+        ASSERT(pBuffer != NULL);
+        ASSERT((sizeInBytes != 0u) && ((sizeInBytes & 1u) == 0u));
+        ASSERT(sizeInBytes <= (2u * ADXL362_FIFO_ENTRIES_MAX));
+
+        sTransceive.TransmitterBytes = 1u;
+        sTransceive.ReceiverBytes    = (uint16_t) sizeInBytes;
+        sTransceive.nTxIncrement     = 1u;
+        sTransceive.nRxIncrement     = 1u;
+        sTransceive.bRD_CTL          = true;
+        sTransceive.bDMA             = true;
+        sTransceive.pTransmitter     = &nCommand;
+        sTransceive.pReceiver        = pBuffer;
+
+        eSpiResult = adi_spi_dma_ReadWrite(m_spi_handle, &sTransceive);
+
+        if(eSpiResult == ADI_SPI_SUCCESS) {
+            return (SENSOR_ERROR_NONE);
+        }
+
+        return (SET_SENSOR_ERROR(SENSOR_ERROR_SPI, eSpiResult));
     }
 
 
+    /*
+     * Maps a status bit to INT1 and hooks INT1 to a GPIO group interrupt
+     */
+    SENSOR_RESULT ADXL362::enableInterrupt(const uint8_t nMap, ADI_CALLBACK const pfCallback, void *const pCBParam)
+    {
+        ADI_GPIO_RESULT eGpioResult;
+        SENSOR_RESULT   eResult;
+
+        m_pfEdgeCallback = pfCallback;
+        m_pEdgeCBParam   = pCBParam;
+
+        eGpioResult = adi_gpio_Init(m_gpio_memory, ADI_GPIO_MEMORY_SIZE);
+
+        if(eGpioResult == ADI_GPIO_SUCCESS) {
+            if((eGpioResult = adi_gpio_InputEnable(ADI_CFG_ADXL362_INT1_PORT, ADI_CFG_ADXL362_INT1_PIN, true)) == ADI_GPIO_SUCCESS) {
+                if((eGpioResult = adi_gpio_RegisterCallback(ADI_CFG_ADXL362_INT1_IRQ, EdgeCallback, this)) == ADI_GPIO_SUCCESS) {
+                    /* INT1 is mapped active low, the interrupt comes on the falling edge */
+                    eGpioResult = adi_gpio_SetGroupInterruptPolarity(ADI_CFG_ADXL362_INT1_PORT, ADI_CFG_ADXL362_INT1_PIN);
+                }
+            }
+        }
+
+        if(eGpioResult != ADI_GPIO_SUCCESS) {
+            return(SET_SENSOR_ERROR(SENSOR_ERROR_GPIO, eGpioResult));
+        }
+
+        if((eResult = writeRegister(REG_INTMAP1, nMap | ADXL362_INT_LOW, 1u)) == SENSOR_ERROR_NONE) {
+            eGpioResult = adi_gpio_SetGroupInterruptPins(ADI_CFG_ADXL362_INT1_PORT, ADI_CFG_ADXL362_INT1_IRQ, ADI_CFG_ADXL362_INT1_PIN);
+
+            if(eGpioResult != ADI_GPIO_SUCCESS) {
+                eResult = SET_SENSOR_ERROR(SENSOR_ERROR_GPIO, eGpioResult);
+            }
+        }
+
+        return(eResult);
+    }
+
+    /*
+     * Unhooks INT1 and clears its map
+     */
+    SENSOR_RESULT ADXL362::disableInterrupt()
+    {
+        ADI_GPIO_RESULT eGpioResult;
+
+        eGpioResult = adi_gpio_SetGroupInterruptPins(ADI_CFG_ADXL362_INT1_PORT, ADI_CFG_ADXL362_INT1_IRQ, 0u);
+
+        m_pfEdgeCallback = NULL;
+
+        if(eGpioResult != ADI_GPIO_SUCCESS) {
+            return(SET_SENSOR_ERROR(SENSOR_ERROR_GPIO, eGpioResult));
+        }
+
+        return(writeRegister(REG_INTMAP1, 0u, 1u));
+    }
+
     /**
      * Close accelerometer by closing the underlying peripheral.
      */
@@ -150,7 +350,7 @@ namespace adi_sensor_swpack {
 
         ASSERT(sizeInBytes >= 2u);
 
-        CheckDataReady(ADXL362_DATAREADY_ITERCOUNT);
+        CheckDataReady();
 
         if((eResult = readRegister(REG_XDATA_L, (uint8_t*)&pBuffer[0], 1u)) == SENSOR_ERROR_NONE) {
             if((eResult = readRegister(REG_XDATA_H, (uint8_t*)&pBuffer[1], 1u)) == SENSOR_ERROR_NONE) {
@@ -170,7 +370,7 @@ namespace adi_sensor_swpack {
 
         ASSERT(sizeInBytes >= 2u);
 
-        CheckDataReady(ADXL362_DATAREADY_ITERCOUNT);
+        CheckDataReady();
 
         if((eResult = readRegister(REG_YDATA_L, (uint8_t*)&pBuffer[0], 1u)) == SENSOR_ERROR_NONE) {
             if((eResult = readRegister(REG_YDATA_H, (uint8_t*)&pBuffer[1], 1u)) == SENSOR_ERROR_NONE) {
@@ -190,10 +390,10 @@ namespace adi_sensor_swpack {
 
         ASSERT(sizeInBytes >= 2u);
 
-        CheckDataReady(ADXL362_DATAREADY_ITERCOUNT);
+        CheckDataReady();
 
-        if((eResult = readRegister(REG_ZDATA_L, (uint8_t*)&pBuffer[0], sizeInBytes)) == SENSOR_ERROR_NONE) {
-            if((eResult = readRegister(REG_ZDATA_H, (uint8_t*)&pBuffer[1], sizeInBytes)) == SENSOR_ERROR_NONE) {
+        if((eResult = readRegister(REG_ZDATA_L, (uint8_t*)&pBuffer[0], 1u)) == SENSOR_ERROR_NONE) {
+            if((eResult = readRegister(REG_ZDATA_H, (uint8_t*)&pBuffer[1], 1u)) == SENSOR_ERROR_NONE) {
                 return(SENSOR_ERROR_NONE);
             }
         }
@@ -206,22 +406,122 @@ namespace adi_sensor_swpack {
      */
     SENSOR_RESULT ADXL362::getXYZ(uint8_t *pBuffer, const uint32_t sizeInBytes)
     {
-        SENSOR_RESULT eResult;
+        ASSERT(pBuffer != NULL);
+        ASSERT(sizeInBytes >= 6u);
+
+        CheckDataReady();
+
+        /* One burst keeps the three axes of the same sample together */
+        return(readRegister(REG_XDATA_L, pBuffer, 6u));
+    }
 
+    /**
+     *  Start reading all three axes of the next sample
+     */
+    SENSOR_RESULT ADXL362::beginReadXYZ(uint8_t *pBuffer, const uint32_t sizeInBytes)
+    {
         ASSERT(pBuffer != NULL);
         ASSERT(sizeInBytes >= 6u);
 
-        if((eResult = this->getX((uint8_t*)&pBuffer[0], sizeInBytes)) == SENSOR_ERROR_NONE) {
-            if((eResult = this->getY((uint8_t*)&pBuffer[2], sizeInBytes)) == SENSOR_ERROR_NONE) {
-                if((eResult = this->getZ((uint8_t*)&pBuffer[4], sizeInBytes)) == SENSOR_ERROR_NONE) {
-                    return SENSOR_ERROR_NONE;
-                }
+        if(!BeginTask(GetSamplePeriodUs() * ADXL362_DATAREADY_PERIODS)) {
+            return (SET_SENSOR_ERROR(SENSOR_ERROR_AXL, AXL_ERROR_TASK_BUSY));
+        }
+
+        m_pTaskBuffer = pBuffer;
+
+        return (SENSOR_ERROR_NONE);
+    }
+
+    /**
+     *  Runs the next step of beginReadXYZ()
+     */
+    SENSOR_RESULT ADXL362::poll()
+    {
+        SENSOR_RESULT eResult = SENSOR_ERROR_NONE;
+        uint8_t       nStatus = 0x00u;
+
+        if(!m_bTaskBusy) {
+            return (SENSOR_ERROR_NONE);
+        }
+
+        SENSOR_TASK_BEGIN();
+
+        /* Read status register, bottom bit represents data ready */
+        SENSOR_TASK_WAIT_UNTIL(((eResult = readRegister(REG_STATUS, &nStatus, 1u)) != SENSOR_ERROR_NONE) ||
+                               ((nStatus & 0x01u) == 0x01u) ||
+                               IsTaskExpired());
+
+        if((eResult == SENSOR_ERROR_NONE) && ((nStatus & 0x01u) != 0x01u)) {
+            eResult = SET_SENSOR_ERROR(SENSOR_ERROR_AXL, AXL_ERROR_DATAREADY_TIMEOUT);
+        }
+
+        if(eResult == SENSOR_ERROR_NONE) {
+            eResult = readRegister(REG_XDATA_L, m_pTaskBuffer, 6u);
+        }
+
+        SENSOR_TASK_END(eResult);
+    }
+
+    /**
+     *  Get all three axes and the temperature of the same sample
+     */
+    SENSOR_RESULT ADXL362::getXYZT(uint8_t *pBuffer, const uint32_t sizeInBytes)
+    {
+        SENSOR_RESULT eResult;
+        int16_t       aSample[4];
+        int32_t       nDelta;
+
+        ASSERT(pBuffer != NULL);
+        ASSERT(sizeInBytes >= 8u);
+
+        CheckDataReady();
+
+        if((eResult = readRegister(REG_XDATA_L, (uint8_t*)aSample, 8u)) == SENSOR_ERROR_NONE) {
+            /* Offset drift relative to the calibration temperature, m degree C times 1/256 count per degree */
+            nDelta = temperatureToMilliCelsius(aSample[3]) - m_nDriftReference;
+            for(uint32_t nAxis = 0u; nAxis < 3u; nAxis++) {
+                aSample[nAxis] -= (int16_t)(((int64_t) m_aDrift[nAxis] * nDelta) / (256 * 1000));
             }
+            memcpy(pBuffer, aSample, sizeof(aSample));
         }
 
         return(eResult);
     }
 
+    /**
+     *  Sets the offset drift of the axes
+     */
+    void ADXL362::setDriftCompensation(const int16_t *pSlope, const int32_t nReference)
+    {
+        ASSERT(pSlope != NULL);
+
+        m_aDrift[0]       = pSlope[0];
+        m_aDrift[1]       = pSlope[1];
+        m_aDrift[2]       = pSlope[2];
+        m_nDriftReference = nReference;
+    }
+
+    /**
+     *  Converts a temperature register value
+     */
+    int32_t ADXL362::temperatureToMilliCelsius(const int16_t nRaw)
+    {
+        return (ADXL362_TEMP_REFERENCE + ((int32_t) nRaw - ADXL362_TEMP_BIAS) * ADXL362_TEMP_SCALE);
+    }
+
+    /**
+     *  Get the 8 most significant bits of all three axes in one burst
+     */
+    SENSOR_RESULT ADXL362::getXYZ8(uint8_t *pBuffer, const uint32_t sizeInBytes)
+    {
+        ASSERT(pBuffer != NULL);
+        ASSERT(sizeInBytes >= 3u);
+
+        CheckDataReady();
+
+        return (readRegister(REG_XDATA, pBuffer, 3u));
+    }
+
     /**
      * Read accelerometer value to a register
      */
@@ -229,24 +529,24 @@ namespace adi_sensor_swpack {
     {
         ADI_SPI_TRANSCEIVER sTransceive;
         ADI_SPI_RESULT      eSpiResult;
-        uint8_t             aTxBuffer[2u] = {0x0Bu, (uint8_t)regAddr};
-        uint8_t             aRxBuffer[1u] = {0x00u};
+        uint8_t             aTxBuffer[2u] = {ADXL362_CMD_READ_REG, (uint8_t)regAddr};
 
         ASSERT(pBuffer != NULL);
+        ASSERT(sizeInBytes >= 1u);
 
+        /* The address auto-increments, sizeInBytes consecutive registers are read */
         sTransceive.TransmitterBytes = 2u;
-        sTransceive.ReceiverBytes    = 1u;
+        sTransceive.ReceiverBytes    = sizeInBytes;
         sTransceive.nTxIncrement     = 1u;
         sTransceive.nRxIncrement     = 1u;
         sTransceive.bRD_CTL          = true;
-        sTransceive.bDMA             = false;
+        sTransceive.bDMA             = true;
         sTransceive.pTransmitter     = aTxBuffer;
-        sTransceive.pReceiver        = aRxBuffer;
+        sTransceive.pReceiver        = pBuffer;
 
-        eSpiResult = adi_spi_MasterReadWrite(m_spi_handle, &sTransceive);
+        eSpiResult = adi_spi_dma_ReadWrite(m_spi_handle, &sTransceive);
 
         if(eSpiResult == ADI_SPI_SUCCESS) {
-            *pBuffer   = aRxBuffer[0u];
             return (SENSOR_ERROR_NONE);
         }
 
@@ -261,19 +561,26 @@ namespace adi_sensor_swpack {
     {
         ADI_SPI_TRANSCEIVER sTransceive;
         ADI_SPI_RESULT      eSpiResult;
-        uint8_t             aTxBuffer[3u] = {0x0Au, regAddr, (uint8_t)(regValue & 0xFF)};
-        uint8_t             aRxBuffer[3u] = {0x00u, 0x00u, 0x00u};
+        uint8_t             aTxBuffer[6u] = {ADXL362_CMD_WRITE_REG, regAddr};
+        uint8_t             aRxBuffer[6u];
+
+        /* Up to four consecutive registers, regValue least significant byte first */
+        ASSERT((sizeInBytes >= 1u) && (sizeInBytes <= 4u));
 
-        sTransceive.TransmitterBytes = 3u;
-        sTransceive.ReceiverBytes    = 3u;
+        for(uint32_t i = 0u; i < sizeInBytes; i++) {
+            aTxBuffer[2u + i] = (uint8_t)(regValue >> (8u * i));
+        }
+
+        sTransceive.TransmitterBytes = 2u + sizeInBytes;
+        sTransceive.ReceiverBytes    = 2u + sizeInBytes;
         sTransceive.nTxIncrement     = 1u;
         sTransceive.nRxIncrement     = 1u;
         sTransceive.bRD_CTL          = false;
-        sTransceive.bDMA             = false;
+        sTransceive.bDMA             = true;
         sTransceive.pTransmitter     = aTxBuffer;
         sTransceive.pReceiver        = aRxBuffer;
 
-        eSpiResult = adi_spi_MasterReadWrite(m_spi_handle, &sTransceive);
+        eSpiResult = adi_spi_dma_ReadWrite(m_spi_handle, &sTransceive);
 
         if(eSpiResult == ADI_SPI_SUCCESS) {
             return  SENSOR_ERROR_NONE;
@@ -342,23 +649,78 @@ namespace adi_sensor_swpack {
 
 
 
-    bool ADXL362::CheckDataReady(const uint32_t iterCount)
+    /**
+     * Writes the filter and power control registers in one transaction.
+     */
+    SENSOR_RESULT ADXL362::WriteControl()
+    {
+        SENSOR_RESULT eResult;
+        uint8_t filterReg = (uint8_t)((m_range << ADXL362_FCTL_RANGE_BITPOS) |
+                                      (m_odr   << ADXL362_FCTL_ODR_BITPOS) |
+                                      (m_bHalfBandwidth ? ADXL362_FCTL_HALF_BW : 0u));
+        uint8_t powerReg  = (uint8_t)((m_eNoiseMode << ADXL362_PCTL_NOISE_BITPOS) |
+                                      (m_bMeasuring ? ADXL362_PCTL_MEASURE : ADXL362_PCTL_STDBY));
+        uint16_t nControl = (uint16_t)(filterReg | (powerReg << 8u));
+
+        /* Adaptive rate logic may ask for the current settings again, skip the bus then */
+        if(nControl == m_nControl) {
+            return SENSOR_ERROR_NONE;
+        }
+
+        /* POWER_CTL follows FILTER_CTL, the burst writes both */
+        if((eResult = writeRegister(REG_FILTER_CTL, nControl, 2u)) == SENSOR_ERROR_NONE) {
+            m_nControl = nControl;
+        }
+        else {
+            m_nControl = 0xFFFFu;
+        }
+
+        return (eResult);
+    }
+
+    bool ADXL362::CheckDataReady()
     {
-        uint8_t nValue = 0x00u;
-        uint8_t nCount = 0x00u;
+        uint8_t  nValue    = 0x00u;
+        uint32_t nDeadline = adi_time_Deadline(GetSamplePeriodUs() * ADXL362_DATAREADY_PERIODS);
+
+        if(!m_bMeasuring) {
+            return false;
+        }
 
         /* Ensure there is valid data to be read */
-        do {
+        for(;;) {
             /* Read status register, bottom bit represents data ready */
             readRegister(REG_STATUS, &nValue, 1);
-            nCount++;
+
+            if((nValue & 0x01u) == 0x01u) {
+                return true;
+            }
+
+            if(adi_time_IsExpired(nDeadline)) {
+                return false;
+            }
+
+            adi_time_Sleep();
         }
-        while(((nValue & 0x01u) != 0x01u) && (nCount < iterCount));
+    }
 
-        if(nCount == iterCount)
-            return false;
+    uint32_t ADXL362::GetSamplePeriodUs() const
+    {
+        return (ADXL362_ODR_12_5_PERIOD_US >> m_odr);
+    }
 
-        return true;
+    /**
+     * @brief  INT1 interrupt, the edge is stamped before anything else runs
+     */
+    void ADXL362::EdgeCallback(void *pCBParam, uint32_t Event, void *pArg)
+    {
+        ADXL362 *pSensor = (ADXL362*) pCBParam;
+
+        adi_tsync_Stamp(&pSensor->m_sEdge);
+
+        if(pSensor->m_pfEdgeCallback != NULL) {
+            pSensor->m_pfEdgeCallback(pSensor->m_pEdgeCBParam, Event, pArg);
+        }
     }
 
 }
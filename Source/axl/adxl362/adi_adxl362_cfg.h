@@ -55,7 +55,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #ifndef ADI_ADXL362_CFG_H
 #define ADI_ADXL362_CFG_H
 
-#include <axl/adi_accelerometer.h>
+#include <axl/adxl362/adi_adxl362.h>
 
 /*!< ADXL362 shield is expected to be connected to SPI 1*/
 #define ADI_CFG_SPI_DEV       (1u)
@@ -72,8 +72,31 @@ POSSIBILITY OF SUCH DAMAGE.
 /*!< ADXL362 range is 2G */
 #define ADI_CFG_ADXL362_RANGE (adi_sensor_swpack::Accelerometer::AXL_RANGE_2g)
 
-/*!< ADXL362 output data rate 100Hz */
+/*!< ADXL362 output data rate 100Hz, until changed with setOutputDataRate() */
 #define ADI_CFG_ADXL362_RATE  (adi_sensor_swpack::Accelerometer::AXL_ODR_100)
 
+/*!< ADXL362 noise mode, until changed with setNoiseMode() */
+#define ADI_CFG_ADXL362_NOISE (adi_sensor_swpack::ADXL362::NOISE_MODE_NORMAL)
+
+/*!< ADXL362 anti-aliasing filter at ODR/2 (0u) or ODR/4 (1u), until changed with setHalfBandwidth() */
+#define ADI_CFG_ADXL362_HALF_BW (0u)
+
+/*!< Offset drift of each axis removed by getXYZT(), 1/256 count per degree C. Measure it on the
+     board; 0 leaves the readings as they are. */
+#define ADI_CFG_ADXL362_DRIFT_X (0)
+#define ADI_CFG_ADXL362_DRIFT_Y (0)
+#define ADI_CFG_ADXL362_DRIFT_Z (0)
+
+/*!< Temperature of the offset calibration, m degree C */
+#define ADI_CFG_ADXL362_DRIFT_REFERENCE (25000)
+
+/*!< GPIO port and pin wired to the ADXL362 INT1 output, see ADXL362::enableInterrupt(). INT1 is
+     driven push-pull and mapped active low. */
+#define ADI_CFG_ADXL362_INT1_PORT (ADI_GPIO_PORT1)
+#define ADI_CFG_ADXL362_INT1_PIN  (ADI_GPIO_PIN_1)
+
+/*!< GPIO group interrupt used for INT1 */
+#define ADI_CFG_ADXL362_INT1_IRQ  (ADI_GPIO_INTA_IRQ)
+
 #endif  /* ADI_ADXL362_CFG_H */
 /* @} */
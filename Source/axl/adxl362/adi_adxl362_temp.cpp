@@ -0,0 +1,157 @@
+/*!
+ *****************************************************************************
+  @file adi_adxl362_temp.cpp
+
+  @brief ADXL362 temperature sensor implementation.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+#include <axl/adxl362/adi_adxl362_temp.h>
+#include <base_sensor/adi_sensor_errors.h>
+
+namespace adi_sensor_swpack {
+
+    /*
+     * Constructor
+     */
+    ADXL362Temperature::ADXL362Temperature(ADXL362 *pAccelerometer)
+    {
+        ASSERT(pAccelerometer != NULL);
+
+        m_pAccelerometer = pAccelerometer;
+        m_slave_addr     = 0u;
+        setType(ADI_TEMPERATURE_TYPE);
+    }
+
+    /*
+     * The ADXL362 is opened by its own object
+     */
+    SENSOR_RESULT ADXL362Temperature::open()
+    {
+        return(SENSOR_ERROR_NONE);
+    }
+
+    /*
+     * Measures while the ADXL362 measures
+     */
+    SENSOR_RESULT ADXL362Temperature::start()
+    {
+        return(SENSOR_ERROR_NONE);
+    }
+
+    /*
+     * Stopping would stop the accelerometer as well
+     */
+    SENSOR_RESULT ADXL362Temperature::stop()
+    {
+        return(SENSOR_ERROR_NONE);
+    }
+
+    /*
+     * The ADXL362 is closed by its own object
+     */
+    SENSOR_RESULT ADXL362Temperature::close()
+    {
+        return(SENSOR_ERROR_NONE);
+    }
+
+    /*
+     * Reads the temperature register
+     */
+    SENSOR_RESULT ADXL362Temperature::getTemperature(uint8_t *pTemperature, const uint32_t sizeInBytes)
+    {
+        ASSERT(pTemperature != NULL);
+        ASSERT(sizeInBytes >= 2u);
+
+        return(m_pAccelerometer->readRegister(ADXL362::REG_TEMP_L, pTemperature, 2u));
+    }
+
+    /*
+     * Temperature in degree Celsius
+     */
+    SENSOR_RESULT ADXL362Temperature::getTemperatureInCelsius(float *pTemperature)
+    {
+        int32_t       nMilliCelsius;
+        SENSOR_RESULT eResult;
+
+        ASSERT(pTemperature != NULL);
+
+        if((eResult = ReadMilliCelsius(&nMilliCelsius)) == SENSOR_ERROR_NONE) {
+            *pTemperature = nMilliCelsius / 1000.0F;
+        }
+
+        return(eResult);
+    }
+
+    /*
+     * Temperature in degree Fahrenheit
+     */
+    SENSOR_RESULT ADXL362Temperature::getTemperatureInFahrenheit(float *pTemperature)
+    {
+        int32_t       nMilliCelsius;
+        SENSOR_RESULT eResult;
+
+        ASSERT(pTemperature != NULL);
+
+        if((eResult = ReadMilliCelsius(&nMilliCelsius)) == SENSOR_ERROR_NONE) {
+            *pTemperature = (9.0F / 5.0F) * (nMilliCelsius / 1000.0F) + 32.0F;
+        }
+
+        return(eResult);
+    }
+
+    /*
+     * Reads and converts the temperature register
+     */
+    SENSOR_RESULT ADXL362Temperature::ReadMilliCelsius(int32_t *pMilliCelsius)
+    {
+        int16_t       nRaw;
+        SENSOR_RESULT eResult;
+
+        if((eResult = getTemperature((uint8_t*)&nRaw, sizeof(nRaw))) == SENSOR_ERROR_NONE) {
+            *pMilliCelsius = ADXL362::temperatureToMilliCelsius(nRaw);
+        }
+
+        return(eResult);
+    }
+}
@@ -0,0 +1,155 @@
+/*!
+ *****************************************************************************
+  @file adi_adaptive_sampler.cpp
+
+  @brief Variance driven adaptive sample rate.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+#include <base_sensor/adi_adaptive_sampler.h>
+
+namespace adi_sensor_swpack {
+
+    AdaptiveSampler::AdaptiveSampler() :
+        m_fActive(0.0f),
+        m_fQuiet(0.0f),
+        m_fWeight(0.125f),
+        m_nHold(1u),
+        m_nMaxPeriod(0u),
+        m_nMaxStep(0u),
+        m_nStep(0u),
+        m_nQuietCount(0u),
+        m_bPrimed(false)
+    {
+        for(uint32_t i = 0u; i < ADI_SAMPLER_MAX_CHANNELS; i++)
+        {
+            m_fMean[i]     = 0.0f;
+            m_fVariance[i] = 0.0f;
+        }
+    }
+
+    void AdaptiveSampler::setPeriod(uint32_t nMinPeriod, uint32_t nMaxPeriod)
+    {
+        m_nMaxPeriod = nMaxPeriod;
+        m_nMaxStep   = 0u;
+
+        while(((nMaxPeriod >> (m_nMaxStep + 1u)) >= nMinPeriod) && ((nMaxPeriod >> (m_nMaxStep + 1u)) != 0u))
+        {
+            m_nMaxStep++;
+        }
+
+        m_nStep       = 0u;
+        m_nQuietCount = 0u;
+    }
+
+    void AdaptiveSampler::setThreshold(float fActive, float fQuiet)
+    {
+        m_fActive = fActive;
+        m_fQuiet  = fQuiet;
+    }
+
+    void AdaptiveSampler::setTracking(float fWeight, uint32_t nHold)
+    {
+        m_fWeight = fWeight;
+        m_nHold   = (nHold != 0u) ? nHold : 1u;
+    }
+
+    /*
+     * Updates the running variance of every channel and moves the step
+     */
+    bool AdaptiveSampler::update(const float *pValues, uint32_t nNumValues)
+    {
+        const uint32_t nLastStep = m_nStep;
+        float          fMax      = 0.0f;
+
+        if(nNumValues > ADI_SAMPLER_MAX_CHANNELS)
+        {
+            nNumValues = ADI_SAMPLER_MAX_CHANNELS;
+        }
+
+        /* The first reading only sets the means, it has no spread yet */
+        if(!m_bPrimed)
+        {
+            for(uint32_t i = 0u; i < nNumValues; i++)
+            {
+                m_fMean[i] = pValues[i];
+            }
+            m_bPrimed = true;
+            return false;
+        }
+
+        for(uint32_t i = 0u; i < nNumValues; i++)
+        {
+            /* Exponentially weighted variance, West's incremental form */
+            const float fDelta = pValues[i] - m_fMean[i];
+
+            m_fMean[i]    += m_fWeight * fDelta;
+            m_fVariance[i] = (1.0f - m_fWeight) * (m_fVariance[i] + (m_fWeight * fDelta * fDelta));
+
+            if(m_fVariance[i] > fMax)
+            {
+                fMax = m_fVariance[i];
+            }
+        }
+
+        if(fMax > m_fActive)
+        {
+            m_nStep       = m_nMaxStep;
+            m_nQuietCount = 0u;
+        }
+        else if(fMax < m_fQuiet)
+        {
+            if((m_nStep > 0u) && (++m_nQuietCount >= m_nHold))
+            {
+                m_nStep--;
+                m_nQuietCount = 0u;
+            }
+        }
+        else
+        {
+            m_nQuietCount = 0u;
+        }
+
+        return (m_nStep != nLastStep);
+    }
+}
@@ -0,0 +1,125 @@
+/*!
+ *****************************************************************************
+  @file adi_report_policy.cpp
+
+  @brief Report-by-exception policy for sensor readings.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+#include <math.h>
+#include <base_sensor/adi_report_policy.h>
+
+namespace adi_sensor_swpack {
+
+    ReportPolicy::ReportPolicy() :
+        m_fAbsolute(0.0f),
+        m_fRelative(0.0f),
+        m_nMinInterval(0u),
+        m_nHeartbeat(0u),
+        m_nLastTime(0u),
+        m_bForce(true),
+        m_nReported(0u),
+        m_nSuppressed(0u)
+    {
+        for(uint32_t i = 0u; i < ADI_REPORT_MAX_CHANNELS; i++)
+        {
+            m_fLast[i] = 0.0f;
+        }
+    }
+
+    void ReportPolicy::setDeadband(float fAbsolute, float fRelative)
+    {
+        m_fAbsolute = fAbsolute;
+        m_fRelative = fRelative;
+    }
+
+    void ReportPolicy::setInterval(uint32_t nMinInterval, uint32_t nHeartbeat)
+    {
+        m_nMinInterval = nMinInterval;
+        m_nHeartbeat   = nHeartbeat;
+    }
+
+    /*
+     * Checks a reading against the deadband and the intervals
+     */
+    bool ReportPolicy::shouldReport(uint32_t nTime, const float *pValues, uint32_t nNumValues)
+    {
+        /* Unsigned difference, correct across a timestamp wrap */
+        const uint32_t nElapsed = nTime - m_nLastTime;
+        bool           bReport  = m_bForce;
+
+        if(nNumValues > ADI_REPORT_MAX_CHANNELS)
+        {
+            nNumValues = ADI_REPORT_MAX_CHANNELS;
+        }
+
+        if(!bReport && (nElapsed >= m_nMinInterval))
+        {
+            bReport = (m_nHeartbeat != 0u) && (nElapsed >= m_nHeartbeat);
+
+            for(uint32_t i = 0u; !bReport && (i < nNumValues); i++)
+            {
+                const float fRelative  = m_fRelative * fabsf(m_fLast[i]);
+                const float fThreshold = (fRelative > m_fAbsolute) ? fRelative : m_fAbsolute;
+
+                /* Written as a negation so a NaN reading, or a NaN reference, is reported */
+                bReport = !(fabsf(pValues[i] - m_fLast[i]) < fThreshold);
+            }
+        }
+
+        if(!bReport)
+        {
+            m_nSuppressed++;
+            return false;
+        }
+
+        for(uint32_t i = 0u; i < nNumValues; i++)
+        {
+            m_fLast[i] = pValues[i];
+        }
+        m_nLastTime = nTime;
+        m_bForce    = false;
+        m_nReported++;
+        return true;
+    }
+}
@@ -0,0 +1,319 @@
+/*!
+ *****************************************************************************
+  @file adi_uplink_scheduler.cpp
+
+  @brief Priority scheduler for the packets of several sensors sharing one radio link.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+#include <string.h>
+#include <base_sensor/adi_uplink_scheduler.h>
+
+/* Token bucket levels are kept in thousandths of a packet, so ms times a rate in packets per second */
+#define UPLINK_TOKEN            (1000u)
+
+/* Values of m_nSelected besides a queue number */
+#define UPLINK_SELECTED_ALARM   (ADI_UPLINK_MAX_QUEUES)
+#define UPLINK_SELECTED_NONE    (ADI_UPLINK_MAX_QUEUES + 1u)
+
+namespace adi_sensor_swpack {
+
+    UplinkScheduler::UplinkScheduler() :
+        m_nSelected(UPLINK_SELECTED_NONE)
+    {
+        memset(m_aQueue, 0, sizeof(m_aQueue));
+
+        for(uint32_t i = 0u; i < ADI_UPLINK_MAX_QUEUES; i++)
+        {
+            m_aQueue[i].sRing.pSlots = m_aQueue[i].aSlots;
+            m_aQueue[i].sRing.nSize  = ADI_UPLINK_QUEUE_DEPTH;
+            setQueue(i, 0u, 0u, 1u);
+        }
+
+        m_sAlarm.pSlots = m_aAlarmSlots;
+        m_sAlarm.nSize  = ADI_UPLINK_ALARM_DEPTH;
+        m_sAlarm.nHead  = 0u;
+        m_sAlarm.nCount = 0u;
+    }
+
+    void UplinkScheduler::setQueue(uint32_t nQueue, uint8_t nPriority, uint32_t nRate, uint32_t nBurst)
+    {
+        if(nQueue >= ADI_UPLINK_MAX_QUEUES)
+        {
+            return;
+        }
+
+        QUEUE *pQueue = &m_aQueue[nQueue];
+
+        pQueue->nPriority = nPriority;
+        pQueue->nRate     = nRate;
+        pQueue->nBurst    = ((nBurst != 0u) ? nBurst : 1u) * UPLINK_TOKEN;
+        /* Start full, the first packets of a queue go out at once */
+        pQueue->nTokens   = pQueue->nBurst;
+        pQueue->nLastRefill = 0u;
+    }
+
+    bool UplinkScheduler::push(uint32_t nQueue, const ADI_DATA_PACKET *pPacket, uint32_t nTime, bool bAlarm)
+    {
+        if(nQueue >= ADI_UPLINK_MAX_QUEUES)
+        {
+            return false;
+        }
+
+        QUEUE *pQueue = &m_aQueue[nQueue];
+        RING  *pRing  = bAlarm ? &m_sAlarm : &pQueue->sRing;
+
+        if(pRing->nCount == pRing->nSize)
+        {
+            /* Alarms are never dropped once queued, the new one is refused */
+            if(bAlarm)
+            {
+                pQueue->nAlarmsRefused++;
+                return false;
+            }
+
+            Remove(pRing);
+            pQueue->nDropped++;
+
+            /* The packet peek() returned may be the one just dropped */
+            if(m_nSelected == nQueue)
+            {
+                m_nSelected = UPLINK_SELECTED_NONE;
+            }
+        }
+
+        SLOT *pSlot = Append(pRing);
+        memcpy(&pSlot->sPacket, pPacket, sizeof(ADI_DATA_PACKET));
+        pSlot->nTime  = nTime;
+        pSlot->nQueue = (uint8_t) nQueue;
+        return true;
+    }
+
+    /*
+     * Alarms first, then the highest priority queue with a token
+     */
+    const ADI_DATA_PACKET *UplinkScheduler::peek(uint32_t nTime)
+    {
+        m_nSelected = UPLINK_SELECTED_NONE;
+
+        if(m_sAlarm.nCount != 0u)
+        {
+            m_nSelected = UPLINK_SELECTED_ALARM;
+            return &Head(&m_sAlarm)->sPacket;
+        }
+
+        SLOT *pBest = NULL;
+
+        for(uint32_t i = 0u; i < ADI_UPLINK_MAX_QUEUES; i++)
+        {
+            QUEUE *pQueue = &m_aQueue[i];
+
+            if(pQueue->sRing.nCount == 0u)
+            {
+                continue;
+            }
+
+            Refill(pQueue, nTime);
+            if((pQueue->nRate != 0u) && (pQueue->nTokens < UPLINK_TOKEN))
+            {
+                continue;
+            }
+
+            SLOT *pSlot = Head(&pQueue->sRing);
+
+            if(pBest != NULL)
+            {
+                const uint8_t nBest = m_aQueue[m_nSelected].nPriority;
+
+                if(pQueue->nPriority > nBest)
+                {
+                    continue;
+                }
+                /* Same priority, the older head goes first. Signed so a time wrap orders correctly */
+                if((pQueue->nPriority == nBest) && ((int32_t)(pSlot->nTime - pBest->nTime) >= 0))
+                {
+                    continue;
+                }
+            }
+
+            pBest       = pSlot;
+            m_nSelected = i;
+        }
+
+        return (pBest != NULL) ? &pBest->sPacket : NULL;
+    }
+
+    void UplinkScheduler::pop(uint32_t nTime)
+    {
+        RING  *pRing;
+        QUEUE *pQueue;
+        bool   bAlarm = (m_nSelected == UPLINK_SELECTED_ALARM);
+
+        if(bAlarm)
+        {
+            pRing = &m_sAlarm;
+        }
+        else if(m_nSelected < ADI_UPLINK_MAX_QUEUES)
+        {
+            pRing = &m_aQueue[m_nSelected].sRing;
+        }
+        else
+        {
+            return;
+        }
+
+        const SLOT     *pSlot    = Head(pRing);
+        const uint32_t  nLatency = nTime - pSlot->nTime;
+
+        pQueue = &m_aQueue[pSlot->nQueue];
+        Remove(pRing);
+        m_nSelected = UPLINK_SELECTED_NONE;
+
+        if(bAlarm)
+        {
+            pQueue->nAlarms++;
+        }
+        else if(pQueue->nRate != 0u)
+        {
+            pQueue->nTokens -= UPLINK_TOKEN;
+        }
+
+        pQueue->nSent++;
+        pQueue->nLatencySum += nLatency;
+        if(nLatency > pQueue->nLatencyMax)
+        {
+            pQueue->nLatencyMax = nLatency;
+        }
+    }
+
+    uint32_t UplinkScheduler::getPending() const
+    {
+        uint32_t nPending = m_sAlarm.nCount;
+
+        for(uint32_t i = 0u; i < ADI_UPLINK_MAX_QUEUES; i++)
+        {
+            nPending += m_aQueue[i].sRing.nCount;
+        }
+        return nPending;
+    }
+
+    void UplinkScheduler::getStats(uint32_t nQueue, ADI_UPLINK_STATS *pStats) const
+    {
+        memset(pStats, 0, sizeof(ADI_UPLINK_STATS));
+
+        if(nQueue >= ADI_UPLINK_MAX_QUEUES)
+        {
+            return;
+        }
+
+        const QUEUE *pQueue = &m_aQueue[nQueue];
+
+        pStats->nSent          = pQueue->nSent;
+        pStats->nAlarms        = pQueue->nAlarms;
+        pStats->nDropped       = pQueue->nDropped;
+        pStats->nAlarmsRefused = pQueue->nAlarmsRefused;
+        pStats->nLatencyMax    = pQueue->nLatencyMax;
+        if(pQueue->nSent != 0u)
+        {
+            pStats->nLatencyMean = (uint32_t)(pQueue->nLatencySum / pQueue->nSent);
+        }
+    }
+
+    void UplinkScheduler::resetStats()
+    {
+        for(uint32_t i = 0u; i < ADI_UPLINK_MAX_QUEUES; i++)
+        {
+            m_aQueue[i].nSent          = 0u;
+            m_aQueue[i].nAlarms        = 0u;
+            m_aQueue[i].nDropped       = 0u;
+            m_aQueue[i].nAlarmsRefused = 0u;
+            m_aQueue[i].nLatencyMax    = 0u;
+            m_aQueue[i].nLatencySum    = 0u;
+        }
+    }
+
+    void UplinkScheduler::clear()
+    {
+        for(uint32_t i = 0u; i < ADI_UPLINK_MAX_QUEUES; i++)
+        {
+            m_aQueue[i].sRing.nHead  = 0u;
+            m_aQueue[i].sRing.nCount = 0u;
+            m_aQueue[i].nTokens      = m_aQueue[i].nBurst;
+        }
+        m_sAlarm.nHead  = 0u;
+        m_sAlarm.nCount = 0u;
+        m_nSelected     = UPLINK_SELECTED_NONE;
+    }
+
+    /*
+     * Adds the tokens earned since the last refill, up to the burst
+     */
+    void UplinkScheduler::Refill(QUEUE *pQueue, uint32_t nTime)
+    {
+        /* Unsigned difference, correct across a timestamp wrap */
+        const uint32_t nElapsed = nTime - pQueue->nLastRefill;
+        const uint64_t nTokens  = (uint64_t) pQueue->nTokens + (uint64_t) nElapsed * pQueue->nRate;
+
+        pQueue->nTokens     = (nTokens > pQueue->nBurst) ? pQueue->nBurst : (uint32_t) nTokens;
+        pQueue->nLastRefill = nTime;
+    }
+
+    UplinkScheduler::SLOT *UplinkScheduler::Head(RING *pRing)
+    {
+        return &pRing->pSlots[pRing->nHead];
+    }
+
+    UplinkScheduler::SLOT *UplinkScheduler::Append(RING *pRing)
+    {
+        SLOT *pSlot = &pRing->pSlots[(pRing->nHead + pRing->nCount) % pRing->nSize];
+
+        pRing->nCount++;
+        return pSlot;
+    }
+
+    void UplinkScheduler::Remove(RING *pRing)
+    {
+        pRing->nHead = (uint8_t)((pRing->nHead + 1u) % pRing->nSize);
+        pRing->nCount--;
+    }
+}
@@ -0,0 +1,231 @@
+/*!
+ *****************************************************************************
+  @file adi_window_stats.cpp
+
+  @brief Streaming window statistics of sensor readings.
+
+  @details
+ -----------------------------------------------------------------------------
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-
+INFRINGEMENT, TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF
+CLAIMS OF INTELLECTUAL PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+#include <string.h>
+#include <drivers/general/adi_drivers_general.h>
+#include <base_sensor/adi_window_stats.h>
+
+namespace adi_sensor_swpack {
+
+    namespace
+    {
+        /* Integer square root, one result bit per iteration */
+        uint32_t SquareRoot(uint64_t nValue)
+        {
+            uint64_t nRoot = 0u;
+            uint64_t nBit  = 1ull << 62;
+
+            while(nBit > nValue)
+            {
+                nBit >>= 2;
+            }
+
+            while(nBit != 0u)
+            {
+                if(nValue >= (nRoot + nBit))
+                {
+                    nValue -= nRoot + nBit;
+                    nRoot   = (nRoot >> 1) + nBit;
+                }
+                else
+                {
+                    nRoot >>= 1;
+                }
+                nBit >>= 2;
+            }
+
+            return (uint32_t) nRoot;
+        }
+
+        void Store16(uint8_t *pDest, uint32_t nValue)
+        {
+            pDest[0] = (uint8_t) nValue;
+            pDest[1] = (uint8_t)(nValue >> 8);
+        }
+    }
+
+    WindowStats::WindowStats() :
+        m_nWindow(ADI_STATS_MAX_WINDOW),
+        m_bLatched(false),
+        m_nOverruns(0u)
+    {
+        memset(&m_sLatched, 0, sizeof(m_sLatched));
+        Restart();
+    }
+
+    void WindowStats::setWindow(uint32_t nSamples)
+    {
+        if(nSamples < 2u)
+        {
+            nSamples = 2u;
+        }
+        else if(nSamples > ADI_STATS_MAX_WINDOW)
+        {
+            nSamples = ADI_STATS_MAX_WINDOW;
+        }
+
+        m_nWindow  = nSamples;
+        m_bLatched = false;
+        Restart();
+    }
+
+    void WindowStats::Restart()
+    {
+        m_sCurrent.nCount = 0u;
+        m_sCurrent.nMin   = INT16_MAX;
+        m_sCurrent.nMax   = INT16_MIN;
+        m_sCurrent.nMean  = 0;
+        m_sCurrent.nM2    = 0;
+    }
+
+    /*
+     * Welford update in fixed point. With ADI_STATS_FRAC_BITS fraction bits a
+     * deviation fits in 25 bits and a product in 49; the sum of squares of a
+     * full window is at most 2^16 * 2^30 * 2^16 = 2^62.
+     */
+    bool WindowStats::add(int16_t nSample)
+    {
+        const int32_t nValue = (int32_t) nSample * (1 << ADI_STATS_FRAC_BITS);
+        const int32_t nDelta = nValue - m_sCurrent.nMean;
+
+        m_sCurrent.nCount++;
+        m_sCurrent.nMean += nDelta / (int32_t) m_sCurrent.nCount;
+        m_sCurrent.nM2   += (int64_t) nDelta * (nValue - m_sCurrent.nMean);
+
+        if(nSample < m_sCurrent.nMin)
+        {
+            m_sCurrent.nMin = nSample;
+        }
+        if(nSample > m_sCurrent.nMax)
+        {
+            m_sCurrent.nMax = nSample;
+        }
+
+        if(m_sCurrent.nCount < m_nWindow)
+        {
+            return false;
+        }
+
+        if(m_bLatched)
+        {
+            m_nOverruns++;
+        }
+        m_sLatched = m_sCurrent;
+        m_bLatched = true;
+        Restart();
+        return true;
+    }
+
+    bool WindowStats::getResult(ADI_STATS_RESULT *pResult)
+    {
+        ADI_STATS_TOTALS sTotals;
+        uint64_t         nVariance;
+
+        ADI_INT_STATUS_ALLOC();
+
+        /* add() may latch the next window from an interrupt while this one is copied */
+        ADI_ENTER_CRITICAL_REGION();
+        if(!m_bLatched)
+        {
+            ADI_EXIT_CRITICAL_REGION();
+            return false;
+        }
+        sTotals    = m_sLatched;
+        m_bLatched = false;
+        ADI_EXIT_CRITICAL_REGION();
+
+        /* The sum of squares has twice the fraction bits of the mean */
+        nVariance = (sTotals.nM2 > 0) ? ((uint64_t) sTotals.nM2 / (sTotals.nCount - 1u)) : 0u;
+
+        pResult->nCount    = sTotals.nCount;
+        pResult->nMin      = sTotals.nMin;
+        pResult->nMax      = sTotals.nMax;
+        pResult->nMean     = sTotals.nMean;
+        pResult->nVariance = nVariance >> ADI_STATS_FRAC_BITS;
+        pResult->nStdDev   = SquareRoot(nVariance);
+        return true;
+    }
+
+    void WindowStats::fillRegistration(uint8_t nSensorId, ADI_REGISTRATION_PACKET *pRegistration)
+    {
+        memset(pRegistration, 0, sizeof(ADI_REGISTRATION_PACKET));
+
+        pRegistration->nPacketHeader   = ADI_SET_HEADER(ADI_REGISTRATION_PACKET_TYPE, nSensorId);
+        pRegistration->eSensorType     = ADI_STATISTICS_TYPE;
+        pRegistration->nNumDataTypes   = 7u;
+        pRegistration->aDataTypeKey[0] = ADI_BYTE_TYPE;
+        pRegistration->aDataTypeKey[1] = ADI_SHORT_TYPE;
+        pRegistration->aDataTypeKey[2] = ADI_SHORT_TYPE;
+        pRegistration->aDataTypeKey[3] = ADI_SHORT_TYPE;
+        pRegistration->aDataTypeKey[4] = ADI_INT_TYPE;
+        pRegistration->aDataTypeKey[5] = ADI_SHORT_TYPE;
+        pRegistration->aDataTypeKey[6] = ADI_BYTE_TYPE;
+    }
+
+    void WindowStats::fillPacket(uint8_t nSensorId, uint8_t nChannel, uint32_t nTimestamp,
+                                 const ADI_STATS_RESULT *pResult, ADI_DATA_PACKET *pPacket)
+    {
+        ADI_STATISTICS_DATA sData;
+        uint32_t            nStdDev = pResult->nStdDev >> (ADI_STATS_FRAC_BITS - 4u);
+
+        sData.nChannel  = nChannel;
+        sData.nReserved = 0u;
+        Store16(sData.aCount, pResult->nCount);
+        Store16(sData.aMin, (uint16_t) pResult->nMin);
+        Store16(sData.aMax, (uint16_t) pResult->nMax);
+        Store16(&sData.aMean[0], (uint32_t) pResult->nMean);
+        Store16(&sData.aMean[2], (uint32_t) pResult->nMean >> 16);
+        Store16(sData.aStdDev, (nStdDev > 0xFFFFu) ? 0xFFFFu : nStdDev);
+
+        pPacket->nPacketHeader = ADI_SET_HEADER(ADI_DATA_PACKET_TYPE, nSensorId);
+        pPacket->eSensorType   = ADI_STATISTICS_TYPE;
+        memcpy(pPacket->aTimestamp, &nTimestamp, 4u);
+        memset(pPacket->aPayload, 0, sizeof(pPacket->aPayload));
+        memcpy(pPacket->aPayload, &sData, sizeof(sData));
+    }
+}
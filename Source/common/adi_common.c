@@ -50,7 +50,6 @@ static ADI_UART_HANDLE hDevOutput ADI_ALIGNED_ATTRIBUTE(4);
 
 ADI_ALIGNED_PRAGMA(4)
 uint8_t OutDeviceMem[ADI_UART_UNIDIR_MEMORY_SIZE] ADI_ALIGNED_ATTRIBUTE(4);
-char InfoBuffer[150];
 
 #define UART0_TX_PORTP0_MUX (1u<<20)
 #define UART0_RX_PORTP0_MUX (1u<<22)
@@ -69,6 +68,9 @@ void common_Init(void)
 
     /* Open the UART device, data transfer is bidirectional with NORMAL mode by default */
     adi_uart_Open(0u, ADI_UART_DIR_TRANSMIT, OutDeviceMem, sizeof OutDeviceMem, &hDevOutput);
+
+    /* Hand the UART to the logger, it owns the transmit callback from now on */
+    adi_log_Init(hDevOutput);
 }
 
 /*!
@@ -77,14 +79,15 @@ void common_Init(void)
  * @param  [in] format : Format for string to print.
  * @param  [in] ...    : Arguments passed in to string.
  *
+ * @details The message is queued on the asynchronous logger and sent in the
+ *          background, the call does not wait for the UART.
  */
 void common_Perf(const char *format, ...)
 {
     va_list args;
     va_start(args, format);
 
-    /* Ignore return codes since there's nothing we can do if it fails */
-    vsprintf(InfoBuffer, format, args);
-    adi_uart_Write(hDevOutput, InfoBuffer, strlen(InfoBuffer), 0u, 0u);
+    /* Ignore return codes, drops are accounted for by the logger */
+    adi_log_VPrintf(format, args);
     va_end(args);
 }
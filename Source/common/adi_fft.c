@@ -0,0 +1,285 @@
+/*!
+ *****************************************************************************
+ * @file    adi_fft.c
+ * @brief   Fixed-point real FFT
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+#include <common/adi_fft.h>
+
+/* Entries of the quarter wave table, one quadrant of a 1024 point circle */
+#define FFT_QUARTER     (256u)
+
+/* sin(2 * pi * i / 1024) in Q15 for i = 0 to 256 */
+static const int16_t aSineTable[FFT_QUARTER + 1u] = {
+         0,    201,    402,    603,    804,   1005,   1206,   1407,   1608,   1809,   2009,   2210,
+      2411,   2611,   2811,   3012,   3212,   3412,   3612,   3812,   4011,   4211,   4410,   4609,
+      4808,   5007,   5205,   5404,   5602,   5800,   5998,   6195,   6393,   6590,   6787,   6983,
+      7180,   7376,   7571,   7767,   7962,   8157,   8351,   8546,   8740,   8933,   9127,   9319,
+      9512,   9704,   9896,  10088,  10279,  10469,  10660,  10850,  11039,  11228,  11417,  11605,
+     11793,  11980,  12167,  12354,  12540,  12725,  12910,  13095,  13279,  13463,  13646,  13828,
+     14010,  14192,  14373,  14553,  14733,  14912,  15091,  15269,  15447,  15624,  15800,  15976,
+     16151,  16326,  16500,  16673,  16846,  17018,  17190,  17361,  17531,  17700,  17869,  18037,
+     18205,  18372,  18538,  18703,  18868,  19032,  19195,  19358,  19520,  19681,  19841,  20001,
+     20160,  20318,  20475,  20632,  20788,  20943,  21097,  21251,  21403,  21555,  21706,  21856,
+     22006,  22154,  22302,  22449,  22595,  22740,  22884,  23028,  23170,  23312,  23453,  23593,
+     23732,  23870,  24008,  24144,  24279,  24414,  24548,  24680,  24812,  24943,  25073,  25202,
+     25330,  25457,  25583,  25708,  25833,  25956,  26078,  26199,  26320,  26439,  26557,  26674,
+     26791,  26906,  27020,  27133,  27246,  27357,  27467,  27576,  27684,  27791,  27897,  28002,
+     28106,  28209,  28311,  28411,  28511,  28610,  28707,  28803,  28899,  28993,  29086,  29178,
+     29269,  29359,  29448,  29535,  29622,  29707,  29792,  29875,  29957,  30038,  30118,  30196,
+     30274,  30350,  30425,  30499,  30572,  30644,  30715,  30784,  30853,  30920,  30986,  31050,
+     31114,  31177,  31238,  31298,  31357,  31415,  31471,  31527,  31581,  31634,  31686,  31737,
+     31786,  31834,  31881,  31927,  31972,  32015,  32058,  32099,  32138,  32177,  32214,  32251,
+     32286,  32319,  32352,  32383,  32413,  32442,  32470,  32496,  32522,  32546,  32568,  32590,
+     32610,  32629,  32647,  32664,  32679,  32693,  32706,  32718,  32729,  32738,  32746,  32753,
+     32758,  32762,  32766,  32767,  32767
+};
+
+
+/* cos and sin of 2 * pi * nIndex / 1024 in Q15 */
+static void Twiddle(uint32_t nIndex, int32_t *pCos, int32_t *pSin)
+{
+    const uint32_t nRem = nIndex & (FFT_QUARTER - 1u);
+
+    switch((nIndex >> 8) & 3u) {
+        case 0u:
+            *pSin =  aSineTable[nRem];
+            *pCos =  aSineTable[FFT_QUARTER - nRem];
+            break;
+        case 1u:
+            *pSin =  aSineTable[FFT_QUARTER - nRem];
+            *pCos = -aSineTable[nRem];
+            break;
+        case 2u:
+            *pSin = -aSineTable[nRem];
+            *pCos = -aSineTable[FFT_QUARTER - nRem];
+            break;
+        default:
+            *pSin = -aSineTable[FFT_QUARTER - nRem];
+            *pCos =  aSineTable[nRem];
+            break;
+    }
+}
+
+/* log2 of nPoints, 0 if it is not a supported size */
+static uint32_t Log2Points(uint32_t nPoints)
+{
+    uint32_t nLog = 0u;
+
+    if((nPoints < ADI_FFT_MIN_POINTS) || (nPoints > ADI_FFT_MAX_POINTS) || ((nPoints & (nPoints - 1u)) != 0u)) {
+        return(0u);
+    }
+
+    while((1u << nLog) < nPoints) {
+        nLog++;
+    }
+    return(nLog);
+}
+
+/* Complex radix-2 decimation in time FFT of nPoints interleaved values, each
+ * stage scaled by 1/2 with rounding */
+static void ComplexFFT(int16_t *pData, uint32_t nPoints, uint32_t nLog)
+{
+    uint32_t i, j, nSize;
+
+    /* Bit reversed order */
+    for(i = 0u; i < nPoints; i++) {
+        uint32_t nRev = 0u;
+        uint32_t nBit;
+
+        for(nBit = 0u; nBit < nLog; nBit++) {
+            nRev |= ((i >> nBit) & 1u) << (nLog - 1u - nBit);
+        }
+        if(nRev > i) {
+            int16_t nRe = pData[2u * i];
+            int16_t nIm = pData[(2u * i) + 1u];
+
+            pData[2u * i]           = pData[2u * nRev];
+            pData[(2u * i) + 1u]    = pData[(2u * nRev) + 1u];
+            pData[2u * nRev]        = nRe;
+            pData[(2u * nRev) + 1u] = nIm;
+        }
+    }
+
+    for(nSize = 2u; nSize <= nPoints; nSize <<= 1) {
+        const uint32_t nHalf = nSize >> 1;
+        const uint32_t nStep = (4u * FFT_QUARTER) / nSize;
+
+        for(j = 0u; j < nHalf; j++) {
+            int32_t nCos, nSin;
+
+            Twiddle(j * nStep, &nCos, &nSin);
+
+            for(i = j; i < nPoints; i += nSize) {
+                int16_t *pA = &pData[2u * i];
+                int16_t *pB = &pData[2u * (i + nHalf)];
+
+                /* t = b * (cos - j sin) */
+                const int32_t nTr = ((nCos * pB[0]) + (nSin * pB[1]) + 0x4000) >> 15;
+                const int32_t nTi = ((nCos * pB[1]) - (nSin * pB[0]) + 0x4000) >> 15;
+
+                pB[0] = (int16_t)((pA[0] - nTr + 1) >> 1);
+                pB[1] = (int16_t)((pA[1] - nTi + 1) >> 1);
+                pA[0] = (int16_t)((pA[0] + nTr + 1) >> 1);
+                pA[1] = (int16_t)((pA[1] + nTi + 1) >> 1);
+            }
+        }
+    }
+}
+
+ADI_FFT_RESULT adi_fft_Window(int16_t *pData, uint32_t nPoints)
+{
+    uint32_t i;
+
+    if(Log2Points(nPoints) == 0u) {
+        return(ADI_FFT_INVALID);
+    }
+
+    /* Hann: sin^2(pi * i / N), the table step is 1024 / 2N */
+    for(i = 0u; i < nPoints; i++) {
+        int32_t nCos, nSin, nWeight;
+
+        Twiddle((i * (2u * FFT_QUARTER)) / nPoints, &nCos, &nSin);
+        nWeight  = (nSin * nSin + 0x4000) >> 15;
+        pData[i] = (int16_t)((pData[i] * nWeight + 0x4000) >> 15);
+    }
+    return(ADI_FFT_SUCCESS);
+}
+
+/*
+ * The N real samples are taken as N/2 complex values z[n] = x[2n] + j x[2n+1].
+ * With Z the transform of z, M = N/2 and W = exp(-2 pi j k / N):
+ *
+ *     Xe[k] = (Z[k] + conj(Z[M-k])) / 2
+ *     Xo[k] = -j (Z[k] - conj(Z[M-k])) / 2
+ *     X[k]   = Xe[k] + W Xo[k]
+ *     X[M-k] = conj(Xe[k] - W Xo[k])
+ *
+ * The final halving brings the scale from 1/M to 1/N.
+ */
+ADI_FFT_RESULT adi_fft_Real(int16_t *pData, uint32_t nPoints)
+{
+    const uint32_t nLog  = Log2Points(nPoints);
+    const uint32_t nHalf = nPoints >> 1;
+    const uint32_t nStep = (4u * FFT_QUARTER) / nPoints;
+    uint32_t       k;
+    int32_t        nRe, nIm;
+
+    if(nLog == 0u) {
+        return(ADI_FFT_INVALID);
+    }
+
+    ComplexFFT(pData, nHalf, nLog - 1u);
+
+    /* DC and Nyquist are both real, packed in the first pair */
+    nRe = pData[0];
+    nIm = pData[1];
+    pData[0] = (int16_t)((nRe + nIm + 1) >> 1);
+    pData[1] = (int16_t)((nRe - nIm + 1) >> 1);
+
+    for(k = 1u; k <= (nHalf >> 1); k++) {
+        int16_t       *pK  = &pData[2u * k];
+        int16_t       *pMk = &pData[2u * (nHalf - k)];
+        const int32_t nEr  = (pK[0] + pMk[0]) >> 1;
+        const int32_t nEi  = (pK[1] - pMk[1]) >> 1;
+        const int32_t nOr  = (pK[1] + pMk[1]) >> 1;
+        const int32_t nOi  = (pMk[0] - pK[0]) >> 1;
+        int32_t       nCos, nSin, nTr, nTi;
+
+        Twiddle(k * nStep, &nCos, &nSin);
+
+        /* W Xo with W = cos - j sin */
+        nTr = ((nCos * nOr) + (nSin * nOi) + 0x4000) >> 15;
+        nTi = ((nCos * nOi) - (nSin * nOr) + 0x4000) >> 15;
+
+        pK[0]  = (int16_t)((nEr + nTr + 1) >> 1);
+        pK[1]  = (int16_t)((nEi + nTi + 1) >> 1);
+        if(pMk != pK) {
+            pMk[0] = (int16_t)((nEr - nTr + 1) >> 1);
+            pMk[1] = (int16_t)((nTi - nEi + 1) >> 1);
+        }
+    }
+    return(ADI_FFT_SUCCESS);
+}
+
+ADI_FFT_RESULT adi_fft_Power(const int16_t *pSpectrum, uint32_t nPoints, uint32_t *pPower)
+{
+    const uint32_t nHalf = nPoints >> 1;
+    uint32_t       k;
+
+    if(Log2Points(nPoints) == 0u) {
+        return(ADI_FFT_INVALID);
+    }
+
+    pPower[0]     = (uint32_t)((int32_t) pSpectrum[0] * pSpectrum[0]);
+    pPower[nHalf] = (uint32_t)((int32_t) pSpectrum[1] * pSpectrum[1]);
+
+    for(k = 1u; k < nHalf; k++) {
+        const int32_t nRe = pSpectrum[2u * k];
+        const int32_t nIm = pSpectrum[(2u * k) + 1u];
+
+        pPower[k] = (uint32_t)(nRe * nRe) + (uint32_t)(nIm * nIm);
+    }
+    return(ADI_FFT_SUCCESS);
+}
+
+uint32_t adi_fft_Sqrt(uint64_t nValue)
+{
+    uint64_t nRoot = 0u;
+    uint64_t nBit  = 1ull << 62;
+
+    while(nBit > nValue) {
+        nBit >>= 2;
+    }
+
+    while(nBit != 0u) {
+        if(nValue >= (nRoot + nBit)) {
+            nValue -= nRoot + nBit;
+            nRoot   = (nRoot >> 1) + nBit;
+        }
+        else {
+            nRoot >>= 1;
+        }
+        nBit >>= 2;
+    }
+    return((uint32_t) nRoot);
+}
@@ -0,0 +1,614 @@
+/*!
+ *****************************************************************************
+ * @file    adi_i2c_bus.c
+ * @brief   Shared I2C bus for several sensors
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+#include <common/adi_i2c_bus.h>
+#include <stddef.h>
+#include "adi_i2c_bus_cfg.h"
+
+#ifdef ADI_I2C_BUS_HOST
+#include <string.h>
+#include <time.h>
+#else
+#include <common/adi_time.h>
+#endif
+
+/* Number of adi_i2c_bus_Open() calls without a matching close */
+static uint32_t             nBusUsers;
+
+/* Slave address programmed in the driver */
+static uint16_t             nBusAddress = ADI_I2C_BUS_NO_ADDRESS;
+
+/* Number of times the slave address was reprogrammed */
+static uint32_t             nBusAddressChanges;
+
+/* Queue of requests, the head is on the bus once started */
+static ADI_I2C_BUS_REQUEST *pBusHead;
+static ADI_I2C_BUS_REQUEST *pBusTail;
+
+/* Bit rate given to the first adi_i2c_bus_Open(), reapplied after a reset */
+static uint32_t             nBusBitRate;
+
+/* Transfers put on the bus, tells a waiter that the head is a new transfer */
+static uint32_t             nBusStarted;
+
+/*
+ * Bits a transfer takes on the bus: start, address and ACK per byte, a
+ * second address after a repeated start, stop
+ */
+static uint32_t TransferBits(const ADI_I2C_TRANSACTION *pTransaction)
+{
+    uint32_t nBytes = 1u + pTransaction->nPrologueSize + pTransaction->nDataSize;
+
+    if(pTransaction->bRepeatStart && (pTransaction->nPrologueSize != 0u)) {
+        nBytes++;
+    }
+
+    return((nBytes * 9u) + 2u);
+}
+
+#ifndef ADI_I2C_BUS_HOST
+/* Driver handle and memory, valid while nBusUsers is not 0 */
+static ADI_I2C_HANDLE       hI2cBus;
+static uint8_t              aI2cBusMemory[ADI_I2C_MEMORY_SIZE];
+
+/*
+ * The driver, the same calls are simulated in host builds
+ */
+static ADI_I2C_RESULT BusReset(void)
+{
+    ADI_I2C_RESULT eResult;
+
+    if((eResult = adi_i2c_Reset(hI2cBus)) == ADI_I2C_SUCCESS) {
+        eResult = adi_i2c_SetBitRate(hI2cBus, nBusBitRate);
+    }
+
+    return(eResult);
+}
+
+static ADI_I2C_RESULT BusOpen(void)
+{
+    ADI_I2C_RESULT eResult;
+
+    eResult = adi_i2c_Open(ADI_I2C_BUS_CFG_DEVICE_NUM, aI2cBusMemory, ADI_I2C_MEMORY_SIZE, &hI2cBus);
+
+    if(eResult == ADI_I2C_SUCCESS) {
+        if((eResult = BusReset()) != ADI_I2C_SUCCESS) {
+            (void) adi_i2c_Close(hI2cBus);
+        }
+    }
+
+    return(eResult);
+}
+
+static ADI_I2C_RESULT BusClose(void)
+{
+    return(adi_i2c_Close(hI2cBus));
+}
+
+static ADI_I2C_RESULT BusSetAddress(uint16_t nAddress)
+{
+    return(adi_i2c_SetSlaveAddress(hI2cBus, nAddress));
+}
+
+static ADI_I2C_RESULT BusSubmit(ADI_I2C_TRANSACTION *pTransaction)
+{
+    return(adi_i2c_SubmitBuffer(hI2cBus, pTransaction));
+}
+
+static bool BusIsDone(void)
+{
+    bool bDone = false;
+
+    (void) adi_i2c_IsBufferAvailable(hI2cBus, &bDone);
+
+    return(bDone);
+}
+
+static ADI_I2C_RESULT BusGetResult(uint32_t *pHwErrors)
+{
+    return(adi_i2c_GetBuffer(hI2cBus, pHwErrors));
+}
+
+static uint32_t BusDeadline(uint32_t nTimeoutUs)
+{
+    return(adi_time_Deadline(nTimeoutUs));
+}
+
+static bool BusIsExpired(uint32_t nDeadline)
+{
+    return(adi_time_IsExpired(nDeadline));
+}
+
+static void BusSleepUntil(uint32_t nDeadline)
+{
+    (void) adi_time_SleepUntil(nDeadline);
+}
+
+static void BusSleep(void)
+{
+    adi_time_Sleep();
+}
+#else
+/* Attached devices */
+static ADI_I2C_BUS_SIM_DEVICE *aSimDevices[ADI_I2C_BUS_CFG_SIM_DEVICES];
+static uint32_t                nSimDevices;
+
+/* The transfer on the bus and the time it ends, ns */
+static ADI_I2C_TRANSACTION    *pSimTransfer;
+static uint64_t                nSimEnd;
+
+static ADI_I2C_RESULT BusReset(void)
+{
+    pSimTransfer = NULL;
+
+    return(ADI_I2C_SUCCESS);
+}
+
+static ADI_I2C_RESULT BusOpen(void)
+{
+    pSimTransfer = NULL;
+
+    return((nBusBitRate != 0u) ? ADI_I2C_SUCCESS : ADI_I2C_FAILURE);
+}
+
+static ADI_I2C_RESULT BusClose(void)
+{
+    return(ADI_I2C_SUCCESS);
+}
+
+static ADI_I2C_RESULT BusSetAddress(uint16_t nAddress)
+{
+    (void) nAddress;
+
+    return(ADI_I2C_SUCCESS);
+}
+
+static ADI_I2C_RESULT BusSubmit(ADI_I2C_TRANSACTION *pTransaction)
+{
+    pSimTransfer = pTransaction;
+    nSimEnd      = adi_i2c_bus_SimTime() + (((uint64_t) TransferBits(pTransaction) * 1000000000u) / nBusBitRate);
+
+    return(ADI_I2C_SUCCESS);
+}
+
+static bool BusIsDone(void)
+{
+    return(adi_i2c_bus_SimTime() >= nSimEnd);
+}
+
+static ADI_I2C_RESULT BusGetResult(uint32_t *pHwErrors)
+{
+    ADI_I2C_TRANSACTION    *pTransfer = pSimTransfer;
+    ADI_I2C_BUS_SIM_DEVICE *pDevice   = NULL;
+    uint32_t                nReg      = 0u;
+    uint32_t                i;
+
+    while(!BusIsDone()) {
+        /* The driver blocks here too */
+    }
+
+    if(pTransfer == NULL) {
+        /* Reset while on the bus */
+        *pHwErrors = 0u;
+        return(ADI_I2C_FAILURE);
+    }
+
+    for(i = 0u; i < nSimDevices; i++) {
+        if(aSimDevices[i]->nAddress == nBusAddress) {
+            pDevice = aSimDevices[i];
+        }
+    }
+
+    *pHwErrors = 0u;
+    if(pDevice == NULL) {
+        *pHwErrors = ADI_I2C_HW_ERROR_NACK_ADDR;
+        return(ADI_I2C_HW_ERROR_DETECTED);
+    }
+
+    if(pTransfer->nPrologueSize != 0u) {
+        nReg = pTransfer->pPrologue[0];
+    }
+
+    for(i = 0u; i < pTransfer->nDataSize; i++) {
+        if(pTransfer->bReadNotWrite) {
+            pTransfer->pData[i] = pDevice->pRegisters[(nReg + i) % pDevice->nSize];
+        }
+        else {
+            pDevice->pRegisters[(nReg + i) % pDevice->nSize] = pTransfer->pData[i];
+        }
+    }
+
+    if(pDevice->pfHook != NULL) {
+        pDevice->pfHook(pDevice->pParam, (uint8_t) nReg, pTransfer->bReadNotWrite);
+    }
+
+    return(ADI_I2C_SUCCESS);
+}
+
+static uint32_t BusDeadline(uint32_t nTimeoutUs)
+{
+    return((uint32_t) (adi_i2c_bus_SimTime() / 1000u) + nTimeoutUs);
+}
+
+static bool BusIsExpired(uint32_t nDeadline)
+{
+    return((int32_t) (nDeadline - (uint32_t) (adi_i2c_bus_SimTime() / 1000u)) <= 0);
+}
+
+/* The host has no low-power mode to model, the waits poll */
+static void BusSleepUntil(uint32_t nDeadline)
+{
+    while(!BusIsExpired(nDeadline)) {
+    }
+}
+
+static void BusSleep(void)
+{
+}
+
+/*!
+ * @brief  Attach a simulated device to the bus.
+ *
+ * @param  [in] pDevice : Device, must stay valid.
+ */
+void adi_i2c_bus_SimAttach(ADI_I2C_BUS_SIM_DEVICE *pDevice)
+{
+    if(nSimDevices < ADI_I2C_BUS_CFG_SIM_DEVICES) {
+        aSimDevices[nSimDevices++] = pDevice;
+    }
+}
+
+/*!
+ * @brief  Monotonic time of the simulated bus, ns.
+ */
+uint64_t adi_i2c_bus_SimTime(void)
+{
+    struct timespec sNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &sNow);
+
+    return(((uint64_t) sNow.tv_sec * 1000000000u) + (uint64_t) sNow.tv_nsec);
+}
+#endif
+
+/*
+ * Puts the head of the queue on the bus, or completes it at once if the
+ * driver refuses it. Returns true when a transfer is running.
+ */
+static bool StartNext(void)
+{
+    ADI_I2C_BUS_REQUEST *pRequest;
+    ADI_I2C_RESULT       eResult;
+
+    while((pRequest = pBusHead) != NULL) {
+        eResult = ADI_I2C_SUCCESS;
+
+        if(pRequest->nAddress != nBusAddress) {
+            if((eResult = BusSetAddress(pRequest->nAddress)) == ADI_I2C_SUCCESS) {
+                nBusAddress = pRequest->nAddress;
+                nBusAddressChanges++;
+            }
+            else {
+                nBusAddress = ADI_I2C_BUS_NO_ADDRESS;
+            }
+        }
+
+        if(eResult == ADI_I2C_SUCCESS) {
+            if((eResult = BusSubmit(&pRequest->sTransaction)) == ADI_I2C_SUCCESS) {
+                pRequest->eState = ADI_I2C_BUS_ACTIVE;
+                nBusStarted++;
+                return(true);
+            }
+        }
+
+        /* Refused, complete it with the error and try the next one */
+        pBusHead = pRequest->pNext;
+        pRequest->eResult   = eResult;
+        pRequest->nHwErrors = 0u;
+        pRequest->eState    = ADI_I2C_BUS_DONE;
+        if(pRequest->pfCallback != NULL) {
+            pRequest->pfCallback(pRequest);
+        }
+    }
+
+    return(false);
+}
+
+/*
+ * Gives up on the transfer on the bus. The driver is reset, the request
+ * completes with ADI_I2C_FAILURE and the next one is started.
+ */
+static void AbortActive(void)
+{
+    ADI_I2C_BUS_REQUEST *pRequest = pBusHead;
+
+    (void) BusReset();
+    nBusAddress = ADI_I2C_BUS_NO_ADDRESS;
+
+    pBusHead            = pRequest->pNext;
+    pRequest->eResult   = ADI_I2C_FAILURE;
+    pRequest->nHwErrors = 0u;
+    pRequest->eState    = ADI_I2C_BUS_DONE;
+
+    if(!StartNext()) {
+        pBusTail = NULL;
+    }
+
+    if(pRequest->pfCallback != NULL) {
+        pRequest->pfCallback(pRequest);
+    }
+}
+
+/*
+ * Processes the queue until pRequest is done, or until the queue is empty
+ * when pRequest is NULL. Each transfer gets its bit time plus
+ * ADI_I2C_BUS_CFG_TIMEOUT_US, a transfer that takes longer is aborted.
+ * The core sleeps through the bit time of each transfer, and between the
+ * polls of a transfer that runs late.
+ * Returns ADI_I2C_FAILURE when a transfer was aborted on the way.
+ */
+static ADI_I2C_RESULT WaitFor(ADI_I2C_BUS_REQUEST *pRequest)
+{
+    ADI_I2C_RESULT eResult   = ADI_I2C_SUCCESS;
+    uint32_t       nActive   = nBusStarted - 1u;
+    uint32_t       nDeadline = 0u;
+    uint32_t       nBitsUs;
+
+    for(;;) {
+        adi_i2c_bus_Process();
+
+        if(pRequest != NULL) {
+            if(pRequest->eState == ADI_I2C_BUS_DONE) {
+                return(pRequest->eResult);
+            }
+        }
+        else if(adi_i2c_bus_IsIdle()) {
+            return(eResult);
+        }
+
+        if(nActive != nBusStarted) {
+            /* A new transfer is on the bus */
+            nActive   = nBusStarted;
+            nBitsUs   = ((TransferBits(&pBusHead->sTransaction) * 1000000u) + nBusBitRate - 1u) / nBusBitRate;
+            nDeadline = BusDeadline(nBitsUs + ADI_I2C_BUS_CFG_TIMEOUT_US);
+
+            /* The driver interrupt does not wake the core, the bit time is the modelled end */
+            BusSleepUntil(BusDeadline(nBitsUs));
+        }
+        else if(BusIsExpired(nDeadline)) {
+            AbortActive();
+            eResult = ADI_I2C_FAILURE;
+        }
+        else {
+            BusSleep();
+        }
+    }
+}
+
+
+/*!
+ * @brief  Open the bus.
+ *
+ * @param  [in] nBitRate : Bit rate, only applied by the first caller.
+ *
+ * @return ADI_I2C_RESULT of the driver.
+ *
+ * @details The first call opens and resets the driver, later calls only
+ *          count the users.
+ */
+ADI_I2C_RESULT adi_i2c_bus_Open(uint32_t nBitRate)
+{
+    ADI_I2C_RESULT eResult;
+
+    if(nBusUsers == 0u) {
+        nBusBitRate = nBitRate;
+
+        if((eResult = BusOpen()) != ADI_I2C_SUCCESS) {
+            return(eResult);
+        }
+
+        nBusAddress = ADI_I2C_BUS_NO_ADDRESS;
+        pBusHead    = NULL;
+        pBusTail    = NULL;
+    }
+
+    nBusUsers++;
+
+    return(ADI_I2C_SUCCESS);
+}
+
+/*!
+ * @brief  Release the bus.
+ *
+ * @return ADI_I2C_RESULT of the driver.
+ *
+ * @details The last user finishes the queued requests, see
+ *          adi_i2c_bus_WaitIdle(), and closes the driver.
+ */
+ADI_I2C_RESULT adi_i2c_bus_Close(void)
+{
+    if(nBusUsers == 0u) {
+        return(ADI_I2C_SUCCESS);
+    }
+
+    if(--nBusUsers == 0u) {
+        (void) WaitFor(NULL);
+        return(BusClose());
+    }
+
+    return(ADI_I2C_SUCCESS);
+}
+
+/*!
+ * @brief  Queue a transfer.
+ *
+ * @param  [in] pRequest : Request with nAddress, sTransaction, pfCallback and
+ *                         pCBParam set. Owned by the bus until it is done.
+ *
+ * @return ADI_I2C_FAILURE when the bus is not open or the request is still
+ *         queued, otherwise ADI_I2C_SUCCESS. Driver errors are reported in
+ *         the request.
+ *
+ * @details The transfer starts right away when the bus is free.
+ */
+ADI_I2C_RESULT adi_i2c_bus_Submit(ADI_I2C_BUS_REQUEST *pRequest)
+{
+    if((nBusUsers == 0u) || (pRequest->eState == ADI_I2C_BUS_QUEUED) || (pRequest->eState == ADI_I2C_BUS_ACTIVE)) {
+        return(ADI_I2C_FAILURE);
+    }
+
+    pRequest->eState    = ADI_I2C_BUS_QUEUED;
+    pRequest->eResult   = ADI_I2C_SUCCESS;
+    pRequest->nHwErrors = 0u;
+    pRequest->pNext     = NULL;
+
+    if(pBusHead == NULL) {
+        pBusHead = pRequest;
+        pBusTail = pRequest;
+        (void) StartNext();
+    }
+    else {
+        pBusTail->pNext = pRequest;
+        pBusTail        = pRequest;
+    }
+
+    return(ADI_I2C_SUCCESS);
+}
+
+/*!
+ * @brief  Complete finished transfers and start the next ones.
+ *
+ * @details Call from the main loop. Runs the callbacks of the completed
+ *          requests; a callback may submit again.
+ */
+void adi_i2c_bus_Process(void)
+{
+    ADI_I2C_BUS_REQUEST *pRequest;
+
+    while(((pRequest = pBusHead) != NULL) && BusIsDone()) {
+        pRequest->eResult = BusGetResult(&pRequest->nHwErrors);
+
+        pBusHead         = pRequest->pNext;
+        pRequest->eState = ADI_I2C_BUS_DONE;
+
+        /* Next transfer first, so the bus works while the callback runs */
+        if(!StartNext()) {
+            pBusTail = NULL;
+        }
+
+        if(pRequest->pfCallback != NULL) {
+            pRequest->pfCallback(pRequest);
+        }
+    }
+}
+
+/*!
+ * @brief  True when no request is queued or on the bus.
+ */
+bool adi_i2c_bus_IsIdle(void)
+{
+    return(pBusHead == NULL);
+}
+
+/*!
+ * @brief  Wait until no request is queued or on the bus.
+ *
+ * @return ADI_I2C_FAILURE when a transfer timed out, otherwise ADI_I2C_SUCCESS.
+ *         The result of each transfer is in its request.
+ *
+ * @details Processes the queue, including the callbacks, which may submit
+ *          again. The core sleeps in flexi mode while each transfer's bits
+ *          are sent, then in steps of adi_time_Sleep() if it runs late. A
+ *          transfer still on the bus ADI_I2C_BUS_CFG_TIMEOUT_US after its
+ *          bits should have been sent is aborted: the driver is reset and
+ *          the request completes with ADI_I2C_FAILURE.
+ */
+ADI_I2C_RESULT adi_i2c_bus_WaitIdle(void)
+{
+    return(WaitFor(NULL));
+}
+
+/*!
+ * @brief  Run a transfer with a slave and wait for it.
+ *
+ * @param  [in]  nAddress     : 7-bit slave address.
+ * @param  [in]  pTransaction : Transfer, see adi_i2c_ReadWrite().
+ * @param  [out] pHwErrors    : Hardware errors of the transfer.
+ *
+ * @return ADI_I2C_RESULT of the driver, ADI_I2C_FAILURE when the transfer
+ *         timed out.
+ *
+ * @details Queues behind the pending requests and processes the queue,
+ *          including their callbacks, until this transfer is done. The
+ *          timeout is the one of adi_i2c_bus_WaitIdle().
+ */
+ADI_I2C_RESULT adi_i2c_bus_ReadWrite(uint16_t nAddress, ADI_I2C_TRANSACTION *pTransaction, uint32_t *pHwErrors)
+{
+    ADI_I2C_BUS_REQUEST sRequest;
+    ADI_I2C_RESULT      eResult;
+
+    sRequest.nAddress     = nAddress;
+    sRequest.sTransaction = *pTransaction;
+    sRequest.pfCallback   = NULL;
+    sRequest.pCBParam     = NULL;
+    sRequest.eState       = ADI_I2C_BUS_IDLE;
+
+    if((eResult = adi_i2c_bus_Submit(&sRequest)) != ADI_I2C_SUCCESS) {
+        return(eResult);
+    }
+
+    eResult    = WaitFor(&sRequest);
+    *pHwErrors = sRequest.nHwErrors;
+
+    return(eResult);
+}
+
+/*!
+ * @brief  Number of slave address changes since start up.
+ */
+uint32_t adi_i2c_bus_GetAddressChanges(void)
+{
+    return(nBusAddressChanges);
+}
@@ -0,0 +1,84 @@
+/*!
+ *****************************************************************************
+ * @file    adi_i2c_bus_cfg.h
+ * @brief   Static configuration of the shared I2C bus
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+/*! @addtogroup common_i2c_bus_static_config Shared I2C Bus Static Configuration
+ *  @ingroup static_config
+ *  @brief Configurable macros for the shared I2C bus.
+ *  @{
+ */
+
+#ifndef ADI_I2C_BUS_CFG_H
+#define ADI_I2C_BUS_CFG_H
+
+/*!
+ * @brief I2C device number.
+ *
+ * @details The ADuCM3029 has one I2C master, device 0.
+ */
+#define ADI_I2C_BUS_CFG_DEVICE_NUM       (0u)
+
+/*!
+ * @brief Number of devices adi_i2c_bus_SimAttach() accepts in a host build.
+ */
+#define ADI_I2C_BUS_CFG_SIM_DEVICES      (8u)
+
+/*!
+ * @brief Time a transfer may take beyond its bits before it is aborted, us.
+ *
+ * @details Covers clock stretching by the slave and the interrupt latency
+ *          of the driver.
+ */
+#define ADI_I2C_BUS_CFG_TIMEOUT_US       (5000u)
+
+/****************** Macro Validation ******************/
+
+#if (ADI_I2C_BUS_CFG_TIMEOUT_US < 100u) || (ADI_I2C_BUS_CFG_TIMEOUT_US > 1000000u)
+#error "ADI_I2C_BUS_CFG_TIMEOUT_US must be between 100 and 1000000"
+#endif
+
+#endif /* ADI_I2C_BUS_CFG_H */
+/* @} */
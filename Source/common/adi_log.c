@@ -0,0 +1,395 @@
+/*!
+ *****************************************************************************
+ * @file    adi_log.c
+ * @brief   Non-blocking UART logger
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+#include <common/adi_log.h>
+#include <string.h>
+#ifdef ADI_DEBUG
+#include <assert.h>
+#endif
+#include "adi_log_cfg.h"
+
+/* Index mask, the head and tail indices are free running */
+#define ADI_LOG_MASK   (ADI_LOG_CFG_BUFFER_SIZE - 1u)
+
+#ifdef ADI_LOG_HOST
+#define ADI_ALIGNED_PRAGMA(num)
+#define ADI_ALIGNED_ATTRIBUTE(num) __attribute__((aligned(num)))
+#define ADI_LOG_BARRIER()          __sync_synchronize()
+#define ADI_LOG_LOCK(state)        ((state) = 0u)
+#define ADI_LOG_UNLOCK(state)      ((void)(state))
+#else
+#define ADI_LOG_BARRIER()          __DMB()
+#define ADI_LOG_LOCK(state)        do { (state) = __get_PRIMASK(); __disable_irq(); } while(0)
+#define ADI_LOG_UNLOCK(state)      __set_PRIMASK(state)
+#endif
+
+ADI_ALIGNED_PRAGMA(4)
+static uint8_t aLogRing[ADI_LOG_CFG_BUFFER_SIZE] ADI_ALIGNED_ATTRIBUTE(4);
+
+/* Formatting scratch, only touched by the producer */
+static char aLogLine[ADI_LOG_CFG_MAX_LINE_SIZE];
+
+/* Written by the producer only */
+static volatile uint32_t nLogHead;
+/* Written by the consumer (UART callback) only */
+static volatile uint32_t nLogTail;
+/* Bytes currently owned by the UART driver, 0 when the port is idle */
+static volatile uint32_t nLogInFlight;
+
+/* Start of the deferred format string table, provided by the linker when the section exists */
+extern const char __start_adi_log_fmt[] __attribute__((weak));
+
+static ADI_LOG_PORT  hLogPort;
+static ADI_LOG_STATS sLogStats;
+
+#ifndef ADI_LOG_HOST
+/*
+ * Hand the next contiguous chunk of the ring to the UART. Must only be called
+ * when no transfer is in flight, either from the transfer-complete callback or
+ * with interrupts disabled.
+ */
+static void StartTransfer(void)
+{
+    uint32_t nTail = nLogTail;
+    uint32_t nUsed = nLogHead - nTail;
+    uint32_t nOffset, nChunk;
+
+    if(nUsed != 0u) {
+        nOffset = nTail & ADI_LOG_MASK;
+        nChunk  = ADI_LOG_CFG_BUFFER_SIZE - nOffset;
+
+        if(nChunk > nUsed) {
+            nChunk = nUsed;
+        }
+        if(nChunk > ADI_LOG_CFG_MAX_TRANSFER_SIZE) {
+            nChunk = ADI_LOG_CFG_MAX_TRANSFER_SIZE;
+        }
+
+        nLogInFlight = nChunk;
+        if(adi_uart_SubmitTxBuffer(hLogPort, &aLogRing[nOffset], nChunk, (ADI_LOG_CFG_USE_DMA != 0u)) != ADI_UART_SUCCESS) {
+            /* Discard the chunk rather than stall the ring, the next message restarts the drain */
+            nLogInFlight = 0u;
+            nLogTail     = nTail + nChunk;
+            sLogStats.nPortErrors++;
+        }
+    }
+}
+
+/*
+ * UART transfer-complete callback, runs in interrupt context.
+ */
+static void LogCallback(void *pCBParam, uint32_t nEvent, void *pArg)
+{
+    (void) pCBParam;
+    (void) pArg;
+
+    if(nEvent == (uint32_t) ADI_UART_EVENT_TX_BUFFER_PROCESSED) {
+        sLogStats.nBytesSent += nLogInFlight;
+        nLogTail    += nLogInFlight;
+        nLogInFlight = 0u;
+        StartTransfer();
+    }
+}
+#endif
+
+/*
+ * Start draining if the port is idle.
+ */
+static void Kick(void)
+{
+#ifndef ADI_LOG_HOST
+    uint32_t nState;
+
+    ADI_LOG_LOCK(nState);
+    if(nLogInFlight == 0u) {
+        StartTransfer();
+    }
+    ADI_LOG_UNLOCK(nState);
+#endif
+}
+
+
+/*!
+ * @brief  Initialize the logger.
+ *
+ * @param  [in] hPort : Opened UART handle (stdio stream in a host build).
+ *
+ * @details The UART callback is taken over by the logger, so the handle must
+ *          not be used for anything else afterwards.
+ */
+void adi_log_Init(ADI_LOG_PORT hPort)
+{
+    nLogHead     = 0u;
+    nLogTail     = 0u;
+    nLogInFlight = 0u;
+    hLogPort     = hPort;
+    memset(&sLogStats, 0, sizeof(sLogStats));
+
+#ifndef ADI_LOG_HOST
+    adi_uart_RegisterCallback(hPort, LogCallback, NULL);
+#endif
+}
+
+/*!
+ * @brief  Queue raw bytes for output.
+ *
+ * @param  [in] pData : Bytes to queue.
+ * @param  [in] nSize : Number of bytes.
+ *
+ * @return ADI_LOG_RESULT
+ *         - #ADI_LOG_SUCCESS  : All bytes were queued.
+ *         - #ADI_LOG_OVERFLOW : Not enough room, nothing was queued.
+ *
+ * @details The bytes are queued all or nothing so a message is never split
+ *          by an overflow.
+ */
+ADI_LOG_RESULT adi_log_Write(const void *pData, uint32_t nSize)
+{
+    const uint8_t *pSrc = (const uint8_t *) pData;
+    uint32_t nHead = nLogHead;
+    uint32_t nUsed = nHead - nLogTail;
+    uint32_t nOffset, nFirst;
+
+    if(nSize > (ADI_LOG_CFG_BUFFER_SIZE - nUsed)) {
+        sLogStats.nDroppedMessages++;
+        sLogStats.nDroppedBytes += nSize;
+        return(ADI_LOG_OVERFLOW);
+    }
+
+    nOffset = nHead & ADI_LOG_MASK;
+    nFirst  = ADI_LOG_CFG_BUFFER_SIZE - nOffset;
+    if(nFirst > nSize) {
+        nFirst = nSize;
+    }
+    memcpy(&aLogRing[nOffset], pSrc, nFirst);
+    memcpy(&aLogRing[0], pSrc + nFirst, nSize - nFirst);
+
+    /* The data must be visible before the consumer sees the new head */
+    ADI_LOG_BARRIER();
+    nLogHead = nHead + nSize;
+
+    sLogStats.nBytesQueued += nSize;
+    if((nUsed + nSize) > sLogStats.nHighWater) {
+        sLogStats.nHighWater = nUsed + nSize;
+    }
+
+    Kick();
+    return(ADI_LOG_SUCCESS);
+}
+
+/*!
+ * @brief  Format a message and queue it.
+ *
+ * @param  [in] format : Format for string to print.
+ * @param  [in] args   : Arguments passed in to string.
+ *
+ * @return ADI_LOG_RESULT, see adi_log_Write(). #ADI_LOG_TRUNCATED is returned
+ *         when a truncated message was queued.
+ */
+ADI_LOG_RESULT adi_log_VPrintf(const char *format, va_list args)
+{
+    ADI_LOG_RESULT eResult;
+    int32_t nLength = (int32_t) vsnprintf(aLogLine, sizeof(aLogLine), format, args);
+    bool bTruncated = false;
+
+    if(nLength < 0) {
+        return(ADI_LOG_SUCCESS);
+    }
+    if(nLength >= (int32_t) sizeof(aLogLine)) {
+        nLength    = (int32_t) sizeof(aLogLine) - 1;
+        bTruncated = true;
+        sLogStats.nTruncated++;
+    }
+
+    if(((eResult = adi_log_Write(aLogLine, (uint32_t) nLength)) == ADI_LOG_SUCCESS) && bTruncated) {
+        eResult = ADI_LOG_TRUNCATED;
+    }
+    return(eResult);
+}
+
+/*!
+ * @brief  Format a message and queue it.
+ *
+ * @param  [in] format : Format for string to print.
+ * @param  [in] ...    : Arguments passed in to string.
+ *
+ * @return ADI_LOG_RESULT, see adi_log_VPrintf().
+ */
+ADI_LOG_RESULT adi_log_Printf(const char *format, ...)
+{
+    ADI_LOG_RESULT eResult;
+    va_list args;
+
+    va_start(args, format);
+    eResult = adi_log_VPrintf(format, args);
+    va_end(args);
+    return(eResult);
+}
+
+/*!
+ * @brief  Service the output port.
+ *
+ * @details On the target this only restarts a drain stopped by a port error,
+ *          the UART callback does the work. In a host build this writes
+ *          everything queued so far to the stdio stream.
+ */
+void adi_log_Process(void)
+{
+#ifdef ADI_LOG_HOST
+    uint32_t nUsed, nOffset, nChunk;
+
+    while((nUsed = nLogHead - nLogTail) != 0u) {
+        nOffset = nLogTail & ADI_LOG_MASK;
+        nChunk  = ADI_LOG_CFG_BUFFER_SIZE - nOffset;
+        if(nChunk > nUsed) {
+            nChunk = nUsed;
+        }
+        if(fwrite(&aLogRing[nOffset], 1u, nChunk, hLogPort) != nChunk) {
+            sLogStats.nPortErrors++;
+        }
+        sLogStats.nBytesSent += nChunk;
+        nLogTail += nChunk;
+    }
+    fflush(hLogPort);
+#else
+    Kick();
+#endif
+}
+
+/*!
+ * @brief  Wait until everything queued has been sent.
+ *
+ * @details Intended for use before a reset or a fatal trap, must not be
+ *          called with interrupts disabled.
+ */
+void adi_log_Flush(void)
+{
+    while(nLogHead != nLogTail) {
+        adi_log_Process();
+    }
+}
+
+/*!
+ * @brief  Number of bytes waiting to be sent.
+ */
+uint32_t adi_log_GetPending(void)
+{
+    return(nLogHead - nLogTail);
+}
+
+/*!
+ * @brief  Copy the logger statistics.
+ *
+ * @param  [out] pStats : Destination for the statistics.
+ */
+void adi_log_GetStats(ADI_LOG_STATS *pStats)
+{
+    *pStats = sLogStats;
+}
+
+/*!
+ * @brief  Reset the logger statistics.
+ */
+void adi_log_ClearStats(void)
+{
+    uint32_t nState;
+
+    ADI_LOG_LOCK(nState);
+    memset(&sLogStats, 0, sizeof(sLogStats));
+    ADI_LOG_UNLOCK(nState);
+}
+
+/*!
+ * @brief  Output port given to adi_log_Init().
+ *
+ * @details Lets other users of the same UART (e.g. the packet stream)
+ *          reconfigure it. Transfers are owned by the logger.
+ */
+ADI_LOG_PORT adi_log_GetPort(void)
+{
+    return(hLogPort);
+}
+
+/*!
+ * @brief  Queue a deferred log record.
+ *
+ * @param  [in] pFormat : Format string placed in the adi_log_fmt section.
+ * @param  [in] pArgs   : Arguments already converted with adi_log_Arg().
+ * @param  [in] nArgs   : Number of arguments.
+ *
+ * @return ADI_LOG_RESULT, see adi_log_Write().
+ *
+ * @details Normally called through ADI_LOG_DEFERRED(). The record is queued
+ *          as one unit so the decoder never sees a partial record.
+ */
+ADI_LOG_RESULT adi_log_Deferred(const char *pFormat, const uint32_t *pArgs, uint32_t nArgs)
+{
+    uint8_t  aRecord[ADI_LOG_RECORD_HEADER_SIZE + (ADI_LOG_MAX_DEFERRED_ARGS * 4u)];
+    uint32_t nId = (uint32_t) (pFormat - __start_adi_log_fmt);
+    uint32_t nArg;
+
+#ifdef ADI_DEBUG
+    /* The record carries a 16-bit ID, see the adi_log_fmt limit in adi_log.h */
+    assert(nId <= 0xFFFFu);
+#endif
+
+    if(nArgs > ADI_LOG_MAX_DEFERRED_ARGS) {
+        nArgs = ADI_LOG_MAX_DEFERRED_ARGS;
+    }
+
+    aRecord[0] = (uint8_t) ADI_LOG_RECORD_SYNC;
+    aRecord[1] = (uint8_t) nArgs;
+    aRecord[2] = (uint8_t) (nId & 0xFFu);
+    aRecord[3] = (uint8_t) ((nId >> 8u) & 0xFFu);
+
+    for(nArg = 0u; nArg < nArgs; nArg++) {
+        aRecord[ADI_LOG_RECORD_HEADER_SIZE + (nArg * 4u) + 0u] = (uint8_t) (pArgs[nArg]);
+        aRecord[ADI_LOG_RECORD_HEADER_SIZE + (nArg * 4u) + 1u] = (uint8_t) (pArgs[nArg] >> 8u);
+        aRecord[ADI_LOG_RECORD_HEADER_SIZE + (nArg * 4u) + 2u] = (uint8_t) (pArgs[nArg] >> 16u);
+        aRecord[ADI_LOG_RECORD_HEADER_SIZE + (nArg * 4u) + 3u] = (uint8_t) (pArgs[nArg] >> 24u);
+    }
+
+    return(adi_log_Write(aRecord, ADI_LOG_RECORD_HEADER_SIZE + (nArgs * 4u)));
+}
@@ -0,0 +1,104 @@
+/*!
+ *****************************************************************************
+ * @file    adi_log_cfg.h
+ * @brief   Static configuration of the asynchronous logger
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+/*! @addtogroup common_log_static_config Logger Static Configuration
+ *  @ingroup static_config
+ *  @brief Configurable macros for the asynchronous logger.
+ *  @{
+ */
+
+#ifndef ADI_LOG_CFG_H
+#define ADI_LOG_CFG_H
+
+/*!
+ * @brief Size of the log ring buffer in bytes.
+ *
+ * @details Must be a power of two. This is how much text can be queued
+ *          ahead of the UART before messages start being dropped.
+ */
+#define ADI_LOG_CFG_BUFFER_SIZE         (1024u)
+
+/*!
+ * @brief Longest formatted message in bytes, including the terminator.
+ *
+ * @details Bounds the formatting cost of a single call. Longer messages are
+ *          truncated and counted in #ADI_LOG_STATS::nTruncated.
+ */
+#define ADI_LOG_CFG_MAX_LINE_SIZE       (150u)
+
+/*!
+ * @brief Largest chunk handed to the UART in one transfer.
+ *
+ * @details Smaller chunks free ring space sooner; the DMA controller limits
+ *          a single descriptor to 1024 transfers.
+ */
+#define ADI_LOG_CFG_MAX_TRANSFER_SIZE   (256u)
+
+/*!
+ * @brief Use DMA for the UART transfers.
+ *
+ * @details 1u : the UART driver moves the data with DMA.
+ *          0u : the UART driver moves the data from its interrupt handler.
+ */
+#define ADI_LOG_CFG_USE_DMA             (1u)
+
+/****************** Macro Validation ******************/
+
+#if ((ADI_LOG_CFG_BUFFER_SIZE & (ADI_LOG_CFG_BUFFER_SIZE - 1u)) != 0u)
+#error "ADI_LOG_CFG_BUFFER_SIZE must be a power of two"
+#endif
+
+#if (ADI_LOG_CFG_MAX_LINE_SIZE > ADI_LOG_CFG_BUFFER_SIZE)
+#error "ADI_LOG_CFG_MAX_LINE_SIZE must not exceed ADI_LOG_CFG_BUFFER_SIZE"
+#endif
+
+#if ((ADI_LOG_CFG_MAX_TRANSFER_SIZE == 0u) || (ADI_LOG_CFG_MAX_TRANSFER_SIZE > 1024u))
+#error "ADI_LOG_CFG_MAX_TRANSFER_SIZE must be between 1 and 1024"
+#endif
+
+#endif /* ADI_LOG_CFG_H */
+/* @} */
@@ -0,0 +1,169 @@
+/*!
+ *****************************************************************************
+ * @file    adi_spi_dma.c
+ * @brief   DMA for large SPI transfers
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+#include <common/adi_spi_dma.h>
+#include <string.h>
+#include "adi_spi_dma_cfg.h"
+
+/* Replace the buffers of the caller that the DMA can not use */
+ADI_ALIGNED_PRAGMA(4)
+static uint8_t  aDmaTx[ADI_SPI_DMA_CFG_BUFFER_SIZE] ADI_ALIGNED_ATTRIBUTE(4);
+ADI_ALIGNED_PRAGMA(4)
+static uint8_t  aDmaRx[ADI_SPI_DMA_CFG_BUFFER_SIZE] ADI_ALIGNED_ATTRIBUTE(4);
+
+/* Number of transfers moved with DMA */
+static uint32_t nDmaCount;
+
+/* Half-word aligned */
+#define ADI_SPI_DMA_ALIGNED(p)     ((((uintptr_t)(p)) & 1u) == 0u)
+
+/*
+ * True when a side of the transfer can use DMA, from its own buffer or the static one
+ */
+static bool SideFits(const uint8_t *pBuffer, uint32_t nBytes, uint8_t nIncrement)
+{
+    if(nBytes == 0u) {
+        return(true);
+    }
+
+    if(((nBytes & 1u) != 0u) || (nIncrement != 1u)) {
+        return(false);
+    }
+
+    return(ADI_SPI_DMA_ALIGNED(pBuffer) || (nBytes <= ADI_SPI_DMA_CFG_BUFFER_SIZE));
+}
+
+
+/*!
+ * @brief  True when the transfer would be moved with DMA.
+ *
+ * @param  [in] pXfr : Transfer, bDMA set when DMA is allowed.
+ */
+bool adi_spi_dma_IsEligible(const ADI_SPI_TRANSCEIVER *const pXfr)
+{
+    uint32_t nBytes;
+
+    if(!pXfr->bDMA) {
+        return(false);
+    }
+
+    if(pXfr->bRD_CTL) {
+        /* The command goes through the FIFO, only the reply uses DMA */
+        return((pXfr->ReceiverBytes >= ADI_SPI_DMA_CFG_THRESHOLD) &&
+               SideFits(pXfr->pReceiver, pXfr->ReceiverBytes, pXfr->nRxIncrement));
+    }
+
+    nBytes = (pXfr->TransmitterBytes > pXfr->ReceiverBytes) ? pXfr->TransmitterBytes : pXfr->ReceiverBytes;
+
+    return((nBytes >= ADI_SPI_DMA_CFG_THRESHOLD) &&
+           SideFits(pXfr->pTransmitter, pXfr->TransmitterBytes, pXfr->nTxIncrement) &&
+           SideFits(pXfr->pReceiver, pXfr->ReceiverBytes, pXfr->nRxIncrement));
+}
+
+/*!
+ * @brief  Run a SPI transfer, with DMA when it is large enough.
+ *
+ * @param  [in] hDevice : Open SPI device in master mode.
+ * @param  [in] pXfr    : Transfer, see adi_spi_MasterReadWrite(). bDMA allows
+ *                        DMA, the transfer itself is not modified.
+ *
+ * @return ADI_SPI_RESULT of the driver.
+ *
+ * @details Blocks until the transfer is done. With DMA the core sleeps in WFI
+ *          until the channel completes.
+ */
+ADI_SPI_RESULT adi_spi_dma_ReadWrite(ADI_SPI_HANDLE const hDevice, ADI_SPI_TRANSCEIVER *const pXfr)
+{
+    ADI_SPI_TRANSCEIVER sXfr = *pXfr;
+    ADI_SPI_RESULT      eResult;
+    uint32_t            nHwErrors;
+    bool                bDone = false;
+    bool                bCopyRx = false;
+
+    if(!adi_spi_dma_IsEligible(pXfr)) {
+        sXfr.bDMA = false;
+        return(adi_spi_MasterReadWrite(hDevice, &sXfr));
+    }
+
+    if((sXfr.TransmitterBytes != 0u) && !ADI_SPI_DMA_ALIGNED(sXfr.pTransmitter)) {
+        memcpy(aDmaTx, sXfr.pTransmitter, sXfr.TransmitterBytes);
+        sXfr.pTransmitter = aDmaTx;
+    }
+
+    if((sXfr.ReceiverBytes != 0u) && !ADI_SPI_DMA_ALIGNED(sXfr.pReceiver)) {
+        sXfr.pReceiver = aDmaRx;
+        bCopyRx        = true;
+    }
+
+    if((eResult = adi_spi_MasterSubmitBuffer(hDevice, &sXfr)) != ADI_SPI_SUCCESS) {
+        return(eResult);
+    }
+
+    /* Interrupts stay pending while masked, so a completion between the check and WFI still wakes the core */
+    while(!bDone) {
+        __disable_irq();
+        if((adi_spi_isBufferAvailable(hDevice, &bDone) == ADI_SPI_SUCCESS) && !bDone) {
+            __WFI();
+        }
+        __enable_irq();
+    }
+
+    if((eResult = adi_spi_GetBuffer(hDevice, &nHwErrors)) == ADI_SPI_SUCCESS) {
+        if(bCopyRx) {
+            memcpy(pXfr->pReceiver, aDmaRx, sXfr.ReceiverBytes);
+        }
+        nDmaCount++;
+    }
+
+    return(eResult);
+}
+
+/*!
+ * @brief  Number of transfers moved with DMA since start up.
+ */
+uint32_t adi_spi_dma_GetCount(void)
+{
+    return(nDmaCount);
+}
@@ -0,0 +1,88 @@
+/*!
+ *****************************************************************************
+ * @file    adi_spi_dma_cfg.h
+ * @brief   Static configuration of the SPI DMA transfers
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+/*! @addtogroup common_spi_dma_static_config SPI DMA Static Configuration
+ *  @ingroup static_config
+ *  @brief Configurable macros for the SPI DMA transfers.
+ *  @{
+ */
+
+#ifndef ADI_SPI_DMA_CFG_H
+#define ADI_SPI_DMA_CFG_H
+
+/*!
+ * @brief Smallest transfer moved with DMA, bytes.
+ *
+ * @details Counts the larger of the transmit and receive bytes, or only the
+ *          receive bytes in read command mode. The PIO path refills the FIFO
+ *          from an interrupt every few bytes, so a 16-byte transfer costs the
+ *          core about as much as setting up the two channels. Set above
+ *          ADI_SPI_DMA_CFG_BUFFER_SIZE to disable DMA.
+ */
+#define ADI_SPI_DMA_CFG_THRESHOLD        (16u)
+
+/*!
+ * @brief Size of each static DMA buffer, bytes.
+ *
+ * @details One transmit and one receive buffer, used when the buffers of the
+ *          caller are not aligned. Larger transfers from unaligned buffers stay
+ *          on PIO. 512 bytes hold 256 of the 512 ADXL362 FIFO entries.
+ */
+#define ADI_SPI_DMA_CFG_BUFFER_SIZE      (512u)
+
+/****************** Macro Validation ******************/
+
+#if (ADI_SPI_DMA_CFG_BUFFER_SIZE % 4u) != 0u
+#error "ADI_SPI_DMA_CFG_BUFFER_SIZE must be a multiple of 4"
+#endif
+
+#if ADI_SPI_DMA_CFG_THRESHOLD < 2u
+#error "ADI_SPI_DMA_CFG_THRESHOLD must be at least 2"
+#endif
+
+#endif /* ADI_SPI_DMA_CFG_H */
+/* @} */
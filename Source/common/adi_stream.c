@@ -0,0 +1,202 @@
+/*!
+ *****************************************************************************
+ * @file    adi_stream.c
+ * @brief   Framed binary packet stream over the logger UART
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+#include <common/adi_stream.h>
+#include <string.h>
+#include "adi_stream_cfg.h"
+
+/* CRC-16/CCITT-FALSE, one nibble at a time */
+static const uint16_t aCrcTable[16] =
+{
+    0x0000u, 0x1021u, 0x2042u, 0x3063u, 0x4084u, 0x50A5u, 0x60C6u, 0x70E7u,
+    0x8108u, 0x9129u, 0xA14Au, 0xB16Bu, 0xC18Cu, 0xD1ADu, 0xE1CEu, 0xF1EFu
+};
+
+/* Sequence number of the next frame */
+static uint8_t nStreamSequence;
+
+
+/*!
+ * @brief  Prepare the logger UART for streaming.
+ *
+ * @details Waits for any queued text to go out and then applies the baud
+ *          rate from adi_stream_cfg.h. common_Init() must have been called.
+ *          A delimiter is queued so the first frame is not glued to
+ *          whatever was sent before.
+ */
+void adi_stream_Init(void)
+{
+    const uint8_t nDelimiter = ADI_STREAM_DELIMITER;
+
+    nStreamSequence = 0u;
+
+#if !defined(ADI_LOG_HOST) && (ADI_STREAM_CFG_SET_BAUD_RATE == 1u)
+    adi_log_Flush();
+    adi_uart_ConfigBaudRate(adi_log_GetPort(),
+                            ADI_STREAM_CFG_UART_DIV_C,
+                            ADI_STREAM_CFG_UART_DIV_M,
+                            ADI_STREAM_CFG_UART_DIV_N,
+                            ADI_STREAM_CFG_UART_OSR);
+#endif
+
+    adi_log_Write(&nDelimiter, 1u);
+}
+
+/*!
+ * @brief  Frame a packet and queue it.
+ *
+ * @param  [in] pPacket : Packet to send.
+ * @param  [in] nSize   : Packet size, at most #ADI_STREAM_MAX_PACKET_SIZE.
+ *
+ * @return ADI_LOG_RESULT, see adi_log_Write(). A dropped frame still uses up
+ *         a sequence number so the receiver can count it.
+ */
+ADI_LOG_RESULT adi_stream_Send(const void *pPacket, uint32_t nSize)
+{
+    uint8_t  aRaw[ADI_STREAM_MAX_PACKET_SIZE + ADI_STREAM_FRAME_OVERHEAD];
+    uint8_t  aFrame[ADI_STREAM_MAX_FRAME_SIZE];
+    uint16_t nCrc;
+    uint32_t nFrameSize;
+
+    if(nSize > ADI_STREAM_MAX_PACKET_SIZE) {
+        return(ADI_LOG_OVERFLOW);
+    }
+
+    aRaw[0] = nStreamSequence++;
+    memcpy(&aRaw[1], pPacket, nSize);
+
+    nCrc = adi_stream_Crc16(0xFFFFu, aRaw, nSize + 1u);
+    aRaw[nSize + 1u] = (uint8_t) (nCrc & 0xFFu);
+    aRaw[nSize + 2u] = (uint8_t) (nCrc >> 8u);
+
+    nFrameSize = adi_stream_CobsEncode(aRaw, nSize + ADI_STREAM_FRAME_OVERHEAD, aFrame);
+    aFrame[nFrameSize++] = ADI_STREAM_DELIMITER;
+
+    return(adi_log_Write(aFrame, nFrameSize));
+}
+
+/*!
+ * @brief  Update a CRC-16/CCITT-FALSE.
+ *
+ * @param  [in] nCrc  : Running CRC, 0xFFFF to start.
+ * @param  [in] pData : Data to add.
+ * @param  [in] nSize : Number of bytes.
+ *
+ * @return Updated CRC.
+ */
+uint16_t adi_stream_Crc16(uint16_t nCrc, const uint8_t *pData, uint32_t nSize)
+{
+    while(nSize-- != 0u) {
+        nCrc ^= (uint16_t) ((uint16_t) *pData++ << 8u);
+        nCrc  = (uint16_t) ((nCrc << 4u) ^ aCrcTable[nCrc >> 12u]);
+        nCrc  = (uint16_t) ((nCrc << 4u) ^ aCrcTable[nCrc >> 12u]);
+    }
+    return(nCrc);
+}
+
+/*!
+ * @brief  COBS encode a buffer.
+ *
+ * @param  [in]  pSrc  : Data to encode.
+ * @param  [in]  nSize : Number of bytes.
+ * @param  [out] pDst  : Encoded data, at least nSize + nSize / 254 + 1 bytes.
+ *
+ * @return Number of encoded bytes, the delimiter is not added.
+ */
+uint32_t adi_stream_CobsEncode(const uint8_t *pSrc, uint32_t nSize, uint8_t *pDst)
+{
+    uint32_t nCodeIndex = 0u;
+    uint32_t nOut       = 1u;
+    uint8_t  nCode      = 1u;
+
+    while(nSize-- != 0u) {
+        if(*pSrc != 0u) {
+            pDst[nOut++] = *pSrc;
+            nCode++;
+        }
+        if((*pSrc == 0u) || (nCode == 0xFFu)) {
+            pDst[nCodeIndex] = nCode;
+            nCodeIndex = nOut++;
+            nCode      = 1u;
+        }
+        pSrc++;
+    }
+    pDst[nCodeIndex] = nCode;
+
+    return(nOut);
+}
+
+/*!
+ * @brief  COBS decode a frame.
+ *
+ * @param  [in]  pSrc  : Encoded frame without the delimiter.
+ * @param  [in]  nSize : Number of bytes.
+ * @param  [out] pDst  : Decoded data, at least nSize bytes.
+ *
+ * @return Number of decoded bytes, or -1 if the frame is malformed.
+ */
+int32_t adi_stream_CobsDecode(const uint8_t *pSrc, uint32_t nSize, uint8_t *pDst)
+{
+    uint32_t nIn  = 0u;
+    uint32_t nOut = 0u;
+    uint8_t  nCode, nByte;
+
+    while(nIn < nSize) {
+        nCode = pSrc[nIn++];
+        if(nCode == 0u) {
+            return(-1);
+        }
+        for(nByte = 1u; nByte < nCode; nByte++) {
+            if((nIn >= nSize) || (pSrc[nIn] == 0u)) {
+                return(-1);
+            }
+            pDst[nOut++] = pSrc[nIn++];
+        }
+        if((nCode != 0xFFu) && (nIn < nSize)) {
+            pDst[nOut++] = 0u;
+        }
+    }
+    return((int32_t) nOut);
+}
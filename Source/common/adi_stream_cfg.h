@@ -0,0 +1,92 @@
+/*!
+ *****************************************************************************
+ * @file    adi_stream_cfg.h
+ * @brief   Static configuration of the packet stream
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+/*! @addtogroup common_stream_static_config Packet Stream Static Configuration
+ *  @ingroup static_config
+ *  @brief Configurable macros for the packet stream.
+ *  @{
+ */
+
+#ifndef ADI_STREAM_CFG_H
+#define ADI_STREAM_CFG_H
+
+/*!
+ * @brief Reconfigure the UART baud rate in adi_stream_Init().
+ *
+ * @details 1u : apply the divider settings below.
+ *          0u : keep the baud rate the UART was opened with (9600).
+ */
+#define ADI_STREAM_CFG_SET_BAUD_RATE     (1u)
+
+/*!
+ * @brief UART baud rate divider settings.
+ *
+ * @details Baud rate = PCLK / (2^(OSR + 2) * DIV_C * (DIV_M + DIV_N / 2048)).
+ *          The default gives 115200 baud with a 26 MHz PCLK, enough for a
+ *          24-byte frame at 400 Hz.
+ */
+#define ADI_STREAM_CFG_UART_DIV_C        (3u)
+#define ADI_STREAM_CFG_UART_DIV_M        (2u)    /*!< Fractional divider M, 1 to 3   */
+#define ADI_STREAM_CFG_UART_DIV_N        (719u)  /*!< Fractional divider N, 0 to 2047 */
+#define ADI_STREAM_CFG_UART_OSR          (3u)    /*!< Over sample rate, 0 to 3        */
+
+/****************** Macro Validation ******************/
+
+#if ((ADI_STREAM_CFG_UART_DIV_M < 1u) || (ADI_STREAM_CFG_UART_DIV_M > 3u))
+#error "ADI_STREAM_CFG_UART_DIV_M must be between 1 and 3"
+#endif
+
+#if (ADI_STREAM_CFG_UART_DIV_N > 2047u)
+#error "ADI_STREAM_CFG_UART_DIV_N must be between 0 and 2047"
+#endif
+
+#if (ADI_STREAM_CFG_UART_OSR > 3u)
+#error "ADI_STREAM_CFG_UART_OSR must be between 0 and 3"
+#endif
+
+#endif /* ADI_STREAM_CFG_H */
+/* @} */
@@ -0,0 +1,332 @@
+/*!
+ *****************************************************************************
+ * @file    adi_time.c
+ * @brief   Monotonic time and deadline waits
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+#include <common/adi_time.h>
+#include <drivers/general/adi_drivers_general.h>
+#include <drivers/tmr/adi_tmr.h>
+#include <drivers/pwr/adi_pwr.h>
+#include "adi_time_cfg.h"
+
+/* Both timers count HFOSC / 256, 101.5625 kHz or 13 counts per 128 us */
+#define ADI_TIME_COUNTS_PER_WRAP   (0x10000u)
+
+/* Wraps of the time base count */
+static volatile uint32_t nWraps;
+
+/* Last count returned by adi_time_GetUs64(), never goes back */
+static uint64_t nLastCounts;
+
+/* Set by the callbacks that end a flexi mode sleep */
+static volatile uint32_t nWakeFlag;
+
+/* Set by adi_time_Wake(), ends the next or current sleep */
+static volatile bool bWakeRequest;
+
+/* Set once the timers run */
+static bool bStarted;
+
+/* Time asleep since nWindowStart, for adi_time_GetDutyCycle() */
+static uint32_t nSleptUs;
+static uint32_t nWindowStart;
+
+/*
+ * Time base callback, counts the wraps
+ */
+static void WrapCallback(void *pCBParam, uint32_t Event, void *pArg)
+{
+    (void) pCBParam;
+    (void) pArg;
+
+    if((Event & ADI_TMR_EVENT_TIMEOUT) != 0u) {
+        nWraps++;
+    }
+}
+
+/*
+ * Wake timer callback, the deadline of the sleep is reached
+ */
+static void WakeCallback(void *pCBParam, uint32_t Event, void *pArg)
+{
+    (void) pCBParam;
+    (void) pArg;
+
+    if((Event & ADI_TMR_EVENT_TIMEOUT) != 0u) {
+        adi_tmr_Enable(ADI_TIME_CFG_WAKE_TIMER, false);
+        adi_pwr_ExitLowPowerMode(&nWakeFlag);
+    }
+}
+
+/*
+ * Timer setup shared by both timers, nLoad counts down to the timeout
+ */
+static ADI_TMR_RESULT ConfigTimer(ADI_TMR_DEVICE eDevice, uint16_t nLoad)
+{
+    ADI_TMR_CONFIG sConfig;
+
+    sConfig.bCountingUp  = false;
+    sConfig.bPeriodic    = true;
+    sConfig.ePrescaler   = ADI_TMR_PRESCALER_256;
+    sConfig.eClockSource = ADI_TMR_CLOCK_HFOSC;
+    sConfig.nLoad        = nLoad;
+    sConfig.nAsyncLoad   = nLoad;
+    sConfig.bReloading   = false;
+    sConfig.bSyncBypass  = false;
+
+    return(adi_tmr_ConfigTimer(eDevice, &sConfig));
+}
+
+
+/*!
+ * @brief  Starts the time base.
+ *
+ * @return true when the timers run.
+ *
+ * @details Called by the other functions when needed, the application may
+ *          call it earlier to keep the setup out of the first timeout.
+ */
+bool adi_time_Init(void)
+{
+    if(bStarted) {
+        return(true);
+    }
+
+    if((adi_tmr_Init(ADI_TIME_CFG_TIMER, WrapCallback, NULL, true) != ADI_TMR_SUCCESS)      ||
+       (ConfigTimer(ADI_TIME_CFG_TIMER, (uint16_t) (ADI_TIME_COUNTS_PER_WRAP - 1u)) != ADI_TMR_SUCCESS) ||
+       (adi_tmr_Init(ADI_TIME_CFG_WAKE_TIMER, WakeCallback, NULL, true) != ADI_TMR_SUCCESS) ||
+       (adi_tmr_Enable(ADI_TIME_CFG_TIMER, true) != ADI_TMR_SUCCESS)) {
+        return(false);
+    }
+
+    bStarted     = true;
+    nWindowStart = adi_time_GetUs();
+
+    return(true);
+}
+
+
+/*!
+ * @brief  Microseconds since the time base started.
+ *
+ * @return Time, wraps after 2^32 us.
+ */
+uint32_t adi_time_GetUs(void)
+{
+    return((uint32_t) adi_time_GetUs64());
+}
+
+
+/*!
+ * @brief  Microseconds since the time base started, without the wrap.
+ *
+ * @return Time, 64-bit.
+ *
+ * @details Also correct with interrupts masked or in an interrupt handler,
+ *          where the wrap interrupt cannot run, as long as such calls are
+ *          less than a wrap of the count, 645 ms, apart.
+ */
+uint64_t adi_time_GetUs64(void)
+{
+    uint16_t nCount;
+    uint64_t nCounts;
+
+    ADI_INT_STATUS_ALLOC();
+
+    if(!bStarted && !adi_time_Init()) {
+        return(0u);
+    }
+
+    ADI_ENTER_CRITICAL_REGION();
+
+    adi_tmr_GetCurrentCount(ADI_TIME_CFG_TIMER, &nCount);
+    nCounts = ((uint64_t) nWraps * ADI_TIME_COUNTS_PER_WRAP) + ((ADI_TIME_COUNTS_PER_WRAP - 1u) - nCount);
+
+    /* The count wrapped but its interrupt is still pending */
+    if(nCounts < nLastCounts) {
+        nCounts += ADI_TIME_COUNTS_PER_WRAP;
+    }
+    nLastCounts = nCounts;
+
+    ADI_EXIT_CRITICAL_REGION();
+
+    return((nCounts * 128u) / 13u);
+}
+
+
+/*!
+ * @brief  Deadline a timeout from now.
+ *
+ * @param  [in] nTimeoutUs : Timeout, us, at most 2^31 - 1.
+ *
+ * @return Time of the deadline for adi_time_IsExpired() and adi_time_SleepUntil().
+ */
+uint32_t adi_time_Deadline(uint32_t nTimeoutUs)
+{
+    return(adi_time_GetUs() + nTimeoutUs);
+}
+
+
+/*!
+ * @brief  True once the time reached the deadline.
+ *
+ * @param  [in] nDeadline : From adi_time_Deadline().
+ */
+bool adi_time_IsExpired(uint32_t nDeadline)
+{
+    return((int32_t) (adi_time_GetUs() - nDeadline) >= 0);
+}
+
+
+/*!
+ * @brief  Sleeps for ADI_TIME_CFG_POLL_US.
+ *
+ * @details For a poll loop that has nothing to do until the next status read.
+ */
+void adi_time_Sleep(void)
+{
+    adi_time_SleepUntil(adi_time_Deadline(ADI_TIME_CFG_POLL_US));
+}
+
+
+/*!
+ * @brief  Sleeps in flexi mode until the deadline.
+ *
+ * @param  [in] nDeadline : From adi_time_Deadline().
+ *
+ * @return true at the deadline, false when adi_time_Wake() ended the sleep.
+ *
+ * @details The wake timer covers at most one wrap of its count, longer
+ *          sleeps rearm it. Interrupts that do not call adi_time_Wake() run
+ *          their callbacks and the core goes back to sleep.
+ */
+bool adi_time_SleepUntil(uint32_t nDeadline)
+{
+    int32_t  nRemaining;
+    uint32_t nStart  = adi_time_GetUs();
+    uint64_t nCounts;
+    bool     bReached = true;
+
+    while((nRemaining = (int32_t) (nDeadline - adi_time_GetUs())) > 0) {
+        /* Cleared before the request is checked, a wake in between still ends the sleep */
+        nWakeFlag = 0u;
+
+        if(bWakeRequest) {
+            bWakeRequest = false;
+            bReached     = false;
+            break;
+        }
+
+        /* Round up, the core must not wake before the deadline */
+        nCounts = (((uint64_t) nRemaining * 13u) + 127u) / 128u;
+        if(nCounts > (ADI_TIME_COUNTS_PER_WRAP - 1u)) {
+            nCounts = ADI_TIME_COUNTS_PER_WRAP - 1u;
+        }
+
+        if((ConfigTimer(ADI_TIME_CFG_WAKE_TIMER, (uint16_t) nCounts) != ADI_TMR_SUCCESS) ||
+           (adi_tmr_Enable(ADI_TIME_CFG_WAKE_TIMER, true) != ADI_TMR_SUCCESS)) {
+            /* Without the wake timer the wraps of the time base still end a WFI */
+            __WFI();
+            continue;
+        }
+
+        adi_pwr_EnterLowPowerMode(ADI_PWR_MODE_FLEXI, &nWakeFlag, 0u);
+        adi_tmr_Enable(ADI_TIME_CFG_WAKE_TIMER, false);
+    }
+
+    nSleptUs += adi_time_GetUs() - nStart;
+
+    return(bReached);
+}
+
+
+/*!
+ * @brief  Sleeps in flexi mode for a delay.
+ *
+ * @param  [in] nMilliseconds : Delay, ms, at most 2147483.
+ *
+ * @return true after the delay, false when adi_time_Wake() ended it early.
+ */
+bool adi_time_DelayMs(uint32_t nMilliseconds)
+{
+    return(adi_time_SleepUntil(adi_time_Deadline(nMilliseconds * 1000u)));
+}
+
+
+/*!
+ * @brief  Ends the current sleep, or the next one if the core is awake.
+ *
+ * @details Call from a GPIO or other callback whose event the main loop
+ *          must handle before the deadline.
+ */
+void adi_time_Wake(void)
+{
+    bWakeRequest = true;
+    adi_pwr_ExitLowPowerMode(&nWakeFlag);
+}
+
+
+/*!
+ * @brief  Share of the time the core was awake since the last call.
+ *
+ * @return Awake time, per mille of the time since the last call or the start.
+ *
+ * @details Counts the time spent in adi_time_SleepUntil(), which every
+ *          delay and driver wait of the sensor pack goes through.
+ */
+uint32_t adi_time_GetDutyCycle(void)
+{
+    uint32_t nNow     = adi_time_GetUs();
+    uint32_t nElapsed = nNow - nWindowStart;
+    uint32_t nSlept   = (nSleptUs < nElapsed) ? nSleptUs : nElapsed;
+    uint32_t nDuty    = 1000u;
+
+    if(nElapsed != 0u) {
+        nDuty = (uint32_t) (((uint64_t) (nElapsed - nSlept) * 1000u) / nElapsed);
+    }
+
+    nWindowStart = nNow;
+    nSleptUs     = 0u;
+
+    return(nDuty);
+}
@@ -0,0 +1,88 @@
+/*!
+ *****************************************************************************
+ * @file    adi_time_cfg.h
+ * @brief   Static configuration of the monotonic time base
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+/*! @addtogroup common_time_static_config Monotonic Time Static Configuration
+ *  @ingroup static_config
+ *  @brief Configurable macros for the monotonic time base.
+ *  @{
+ */
+
+#ifndef ADI_TIME_CFG_H
+#define ADI_TIME_CFG_H
+
+/*!
+ * @brief General purpose timer used for the time base.
+ *
+ * @details ADI_TMR_DEVICE_GP0 to ADI_TMR_DEVICE_GP2. No other code of the
+ *          sensor pack uses the timers.
+ */
+#define ADI_TIME_CFG_TIMER               (ADI_TMR_DEVICE_GP2)
+
+/*!
+ * @brief General purpose timer that ends a sleep at its deadline.
+ *
+ * @details Must not be ADI_TIME_CFG_TIMER.
+ */
+#define ADI_TIME_CFG_WAKE_TIMER          (ADI_TMR_DEVICE_GP1)
+
+/*!
+ * @brief Sleep between two status reads of a driver, us.
+ *
+ * @details adi_time_Sleep() sleeps this long while a driver polls a ready
+ *          bit. Longer sleeps read the bus less often, and add up to this
+ *          much latency to each conversion.
+ */
+#define ADI_TIME_CFG_POLL_US             (1000u)
+
+/****************** Macro Validation ******************/
+
+#if (ADI_TIME_CFG_POLL_US < 20u) || (ADI_TIME_CFG_POLL_US > 100000u)
+#error "ADI_TIME_CFG_POLL_US must be between 20 and 100000"
+#endif
+
+#endif /* ADI_TIME_CFG_H */
+/* @} */
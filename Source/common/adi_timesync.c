@@ -0,0 +1,335 @@
+/*!
+ *****************************************************************************
+ * @file    adi_timesync.c
+ * @brief   Sample timestamps and clock sync with the central
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+#include <stddef.h>
+#include <common/adi_timesync.h>
+#include <common/adi_time.h>
+#include "adi_timesync_cfg.h"
+
+/* Sample periods are kept in 1/256 us */
+#define ADI_TSYNC_PERIOD_SCALE      (256u)
+
+/* Largest drift the fit reports, ppb. Steeper slopes come from points too close together */
+#define ADI_TSYNC_MAX_DRIFT         (100000000.0f)
+
+
+/*!
+ * @brief  Records the time of an edge.
+ *
+ * @param  [in] pEdge : Edge to update.
+ *
+ * @details Call first thing in the interrupt callback of the line.
+ */
+void adi_tsync_Stamp(ADI_TSYNC_EDGE *pEdge)
+{
+    pEdge->nTime = adi_time_GetUs64();
+    pEdge->nCount++;
+}
+
+
+/*!
+ * @brief  GPIO callback that stamps an edge.
+ *
+ * @param  [in] pCBParam : The #ADI_TSYNC_EDGE to update.
+ * @param  [in] Event    : Unused.
+ * @param  [in] pArg     : Unused.
+ *
+ * @details For lines that need no other handling, register it with
+ *          adi_gpio_RegisterCallback().
+ */
+void adi_tsync_EdgeCallback(void *pCBParam, uint32_t Event, void *pArg)
+{
+    (void) Event;
+    (void) pArg;
+
+    adi_tsync_Stamp((ADI_TSYNC_EDGE *) pCBParam);
+}
+
+
+/*!
+ * @brief  Reads the time of the last edge.
+ *
+ * @param  [in]  pEdge : Edge stamped by adi_tsync_Stamp().
+ * @param  [out] pTime : Time of the last edge, us.
+ *
+ * @return Edges stamped so far, 0 when pTime is not valid yet.
+ *
+ * @details Reads again when an edge comes in during the read, the 64-bit
+ *          time is not written in one access.
+ */
+uint32_t adi_tsync_GetEdge(const ADI_TSYNC_EDGE *pEdge, uint64_t *pTime)
+{
+    uint32_t nCount;
+
+    do {
+        nCount = pEdge->nCount;
+        *pTime = pEdge->nTime;
+    }
+    while(nCount != pEdge->nCount);
+
+    return(nCount);
+}
+
+
+/*!
+ * @brief  Starts timing FIFO batches.
+ *
+ * @param  [out] pBatch    : Batch state.
+ * @param  [in]  nPeriodUs : Nominal sample period, us, at most 16 s.
+ *
+ * @details Call again after the output data rate changed.
+ */
+void adi_tsync_BatchInit(ADI_TSYNC_BATCH *pBatch, uint32_t nPeriodUs)
+{
+    pBatch->nAnchorTime = 0u;
+    pBatch->nAnchor     = 0u;
+    pBatch->nSamples    = 0u;
+    pBatch->nNominal    = nPeriodUs * ADI_TSYNC_PERIOD_SCALE;
+    pBatch->nPeriod     = pBatch->nNominal;
+    pBatch->bValid      = false;
+}
+
+
+/*!
+ * @brief  Adds the batch just read.
+ *
+ * @param  [in,out] pBatch    : Batch state.
+ * @param  [in]     nEdgeTime : Time of the edge, from adi_tsync_GetEdge().
+ * @param  [in]     nAnchor   : Index of the sample that raised the edge, the
+ *                              watermark sample minus one, or 0 for data ready.
+ * @param  [in]     nSamples  : Samples in the batch, more than nAnchor.
+ *
+ * @details Samples read after the edge are later than the anchor, samples
+ *          before it earlier. The time between the anchors of two batches
+ *          updates the sample period, unless it shows lost samples.
+ */
+void adi_tsync_BatchAdd(ADI_TSYNC_BATCH *pBatch, uint64_t nEdgeTime, uint32_t nAnchor, uint32_t nSamples)
+{
+    uint32_t nSince;
+    uint64_t nMeasured;
+    uint64_t nLow;
+    uint64_t nHigh;
+
+    if(pBatch->bValid && (nEdgeTime > pBatch->nAnchorTime)) {
+        /* Samples from the last anchor to this one */
+        nSince    = (pBatch->nSamples - pBatch->nAnchor - 1u) + nAnchor + 1u;
+        nMeasured = ((nEdgeTime - pBatch->nAnchorTime) * ADI_TSYNC_PERIOD_SCALE) / nSince;
+
+        nLow  = ((uint64_t) pBatch->nNominal * (100u - ADI_TSYNC_CFG_PERIOD_TOLERANCE)) / 100u;
+        nHigh = ((uint64_t) pBatch->nNominal * (100u + ADI_TSYNC_CFG_PERIOD_TOLERANCE)) / 100u;
+
+        if((nMeasured >= nLow) && (nMeasured <= nHigh)) {
+            pBatch->nPeriod = (uint32_t) ((int64_t) pBatch->nPeriod +
+                              (((int64_t) nMeasured - (int64_t) pBatch->nPeriod) / (1 << ADI_TSYNC_CFG_PERIOD_SHIFT)));
+        }
+    }
+
+    pBatch->nAnchorTime = nEdgeTime;
+    pBatch->nAnchor     = nAnchor;
+    pBatch->nSamples    = nSamples;
+    pBatch->bValid      = true;
+}
+
+
+/*!
+ * @brief  Time of a sample of the last batch.
+ *
+ * @param  [in] pBatch : Batch state.
+ * @param  [in] nIndex : Index of the sample in the batch.
+ *
+ * @return Time of the sample, us.
+ */
+uint64_t adi_tsync_BatchTime(const ADI_TSYNC_BATCH *pBatch, uint32_t nIndex)
+{
+    int64_t nDistance = (int64_t) nIndex - (int64_t) pBatch->nAnchor;
+
+    return(pBatch->nAnchorTime + (uint64_t) ((nDistance * (int64_t) pBatch->nPeriod) / (int64_t) ADI_TSYNC_PERIOD_SCALE));
+}
+
+
+/*!
+ * @brief  Measured sample period, us.
+ *
+ * @param  [in] pBatch : Batch state.
+ */
+uint32_t adi_tsync_BatchPeriod(const ADI_TSYNC_BATCH *pBatch)
+{
+    return((pBatch->nPeriod + (ADI_TSYNC_PERIOD_SCALE / 2u)) / ADI_TSYNC_PERIOD_SCALE);
+}
+
+
+/*!
+ * @brief  Starts a clock estimate without sync points.
+ *
+ * @param  [out] pClock : Clock state.
+ *
+ * @details Call when a connection is made, the next central may run on a
+ *          different clock.
+ */
+void adi_tsync_ClockInit(ADI_TSYNC_CLOCK *pClock)
+{
+    pClock->nPoints    = 0u;
+    pClock->nNext      = 0u;
+    pClock->nRejects   = 0u;
+    pClock->nReference = 0u;
+    pClock->nOffset    = 0;
+    pClock->nDrift     = 0;
+}
+
+
+/*!
+ * @brief  Adds a sync point and fits offset and drift again.
+ *
+ * @param  [in,out] pClock   : Clock state.
+ * @param  [in]     nLocal   : Local time of the connection event, us.
+ * @param  [in]     nCentral : Central's time of the same event, us.
+ *
+ * @return true when the point was used, false when it was rejected.
+ *
+ * @details The first point sets the offset, the following ones the drift.
+ *          Once three points agree, points further than
+ *          ADI_TSYNC_CFG_OUTLIER_US from the fit are rejected, and
+ *          ADI_TSYNC_CFG_MAX_REJECTS of them in a row restart it.
+ */
+bool adi_tsync_ClockAdd(ADI_TSYNC_CLOCK *pClock, uint64_t nLocal, uint64_t nCentral)
+{
+    int64_t  nResidual;
+    int64_t  nMeanX = 0;
+    int64_t  nMeanY = 0;
+    int64_t  nX;
+    int64_t  nY;
+    int64_t  nSxx = 0;
+    int64_t  nSxy = 0;
+    float    fDrift;
+    uint32_t i;
+
+    if(pClock->nPoints >= 3u) {
+        nResidual = (int64_t) (nCentral - adi_tsync_ToCentral(pClock, nLocal));
+
+        if((nResidual > (int64_t) ADI_TSYNC_CFG_OUTLIER_US) || (nResidual < -(int64_t) ADI_TSYNC_CFG_OUTLIER_US)) {
+            if(++pClock->nRejects < ADI_TSYNC_CFG_MAX_REJECTS) {
+                return(false);
+            }
+            adi_tsync_ClockInit(pClock);
+        }
+    }
+
+    pClock->nRejects               = 0u;
+    pClock->aLocal[pClock->nNext]  = nLocal;
+    pClock->aOffset[pClock->nNext] = (int64_t) (nCentral - nLocal);
+    pClock->nNext                  = (pClock->nNext + 1u) % ADI_TSYNC_MAX_POINTS;
+    if(pClock->nPoints < ADI_TSYNC_MAX_POINTS) {
+        pClock->nPoints++;
+    }
+
+    /* Means relative to the newest point, which keeps the numbers small */
+    for(i = 0u; i < pClock->nPoints; i++) {
+        nMeanX += (int64_t) (pClock->aLocal[i] - nLocal);
+        nMeanY += pClock->aOffset[i];
+    }
+    nMeanX /= (int64_t) pClock->nPoints;
+    nMeanY /= (int64_t) pClock->nPoints;
+
+    /* Least squares slope, the local time in units of 1024 us so the sums cannot overflow */
+    for(i = 0u; i < pClock->nPoints; i++) {
+        nX    = ((int64_t) (pClock->aLocal[i] - nLocal) - nMeanX) / 1024;
+        nY    = pClock->aOffset[i] - nMeanY;
+        nSxx += nX * nX;
+        nSxy += nX * nY;
+    }
+
+    fDrift = 0.0f;
+    if(nSxx > 0) {
+        fDrift = ((float) nSxy / (float) nSxx) * (1000000000.0f / 1024.0f);
+        if(fDrift > ADI_TSYNC_MAX_DRIFT) {
+            fDrift = ADI_TSYNC_MAX_DRIFT;
+        }
+        else if(fDrift < -ADI_TSYNC_MAX_DRIFT) {
+            fDrift = -ADI_TSYNC_MAX_DRIFT;
+        }
+    }
+
+    pClock->nReference = nLocal + (uint64_t) nMeanX;
+    pClock->nOffset    = nMeanY;
+    pClock->nDrift     = (int32_t) fDrift;
+
+    return(true);
+}
+
+
+/*!
+ * @brief  True once offset and drift are estimated.
+ *
+ * @param  [in] pClock : Clock state.
+ */
+bool adi_tsync_IsSynced(const ADI_TSYNC_CLOCK *pClock)
+{
+    return(pClock->nPoints >= 2u);
+}
+
+
+/*!
+ * @brief  Converts a local time to the central's time.
+ *
+ * @param  [in] pClock : Clock state.
+ * @param  [in] nLocal : Local time, us.
+ *
+ * @return The central's time, us. The local time until a sync point was added.
+ */
+uint64_t adi_tsync_ToCentral(const ADI_TSYNC_CLOCK *pClock, uint64_t nLocal)
+{
+    int64_t nDistance = (int64_t) (nLocal - pClock->nReference);
+    int64_t nCorrection;
+
+    if(pClock->nPoints == 0u) {
+        return(nLocal);
+    }
+
+    /* Split in seconds and microseconds, the product would overflow after hours */
+    nCorrection = (((nDistance / 1000000) * pClock->nDrift) / 1000) +
+                  (((nDistance % 1000000) * pClock->nDrift) / 1000000000);
+
+    return(nLocal + (uint64_t) (pClock->nOffset + nCorrection));
+}
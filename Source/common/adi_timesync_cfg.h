@@ -0,0 +1,109 @@
+/*!
+ *****************************************************************************
+ * @file    adi_timesync_cfg.h
+ * @brief   Static configuration of the timestamp service
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+
+
+/*! @addtogroup common_timesync_static_config Timestamp Service Static Configuration
+ *  @ingroup static_config
+ *  @brief Configurable macros for the timestamp service.
+ *  @{
+ */
+
+#ifndef ADI_TIMESYNC_CFG_H
+#define ADI_TIMESYNC_CFG_H
+
+/*!
+ * @brief Largest deviation of a measured sample period from the nominal one, percent.
+ *
+ * @details The ADXL362 output data rate is accurate to 10 %. A longer gap
+ *          between two batches means samples were lost, the period is not
+ *          updated from it.
+ */
+#define ADI_TSYNC_CFG_PERIOD_TOLERANCE   (15u)
+
+/*!
+ * @brief Weight of a new period measurement, 1 / 2^n.
+ *
+ * @details Averages out the latency of the edge interrupt. Larger values
+ *          settle slower.
+ */
+#define ADI_TSYNC_CFG_PERIOD_SHIFT       (3u)
+
+/*!
+ * @brief Sync points further from the fit than this are rejected, us.
+ *
+ * @details A sync point stamped late, for example behind another interrupt,
+ *          would pull the fit. Must cover the drift between two points.
+ */
+#define ADI_TSYNC_CFG_OUTLIER_US         (2000u)
+
+/*!
+ * @brief Consecutive rejected points that restart the fit.
+ *
+ * @details The central's clock was set, or the node missed points for long
+ *          enough that the fit no longer predicts them.
+ */
+#define ADI_TSYNC_CFG_MAX_REJECTS        (3u)
+
+/****************** Macro Validation ******************/
+
+#if (ADI_TSYNC_CFG_PERIOD_TOLERANCE < 1u) || (ADI_TSYNC_CFG_PERIOD_TOLERANCE > 50u)
+#error "ADI_TSYNC_CFG_PERIOD_TOLERANCE must be between 1 and 50"
+#endif
+
+#if (ADI_TSYNC_CFG_PERIOD_SHIFT > 8u)
+#error "ADI_TSYNC_CFG_PERIOD_SHIFT must be 8 or less"
+#endif
+
+#if (ADI_TSYNC_CFG_OUTLIER_US < 100u)
+#error "ADI_TSYNC_CFG_OUTLIER_US must be at least 100"
+#endif
+
+#if (ADI_TSYNC_CFG_MAX_REJECTS < 1u)
+#error "ADI_TSYNC_CFG_MAX_REJECTS must be at least 1"
+#endif
+
+#endif /* ADI_TIMESYNC_CFG_H */
+/* @} */
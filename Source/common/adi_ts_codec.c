@@ -0,0 +1,466 @@
+/*!
+ *****************************************************************************
+ * @file    adi_ts_codec.c
+ * @brief   Time series compression for sensor payloads
+ *-----------------------------------------------------------------------------
+ *
+
+Copyright (c) 2017 Analog Devices, Inc.
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+  - Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+  - Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+  - Modified versions of the software must be conspicuously marked as such.
+  - This software is licensed solely and exclusively for use with processors
+    manufactured by or for Analog Devices, Inc.
+  - This software may not be combined or merged with other code in any manner
+    that would cause the software to become subject to terms and conditions
+    which differ from those listed here.
+  - Neither the name of Analog Devices, Inc. nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+  - The use of this software may or may not infringe the patent rights of one
+    or more patent holders.  This license does not release you from the
+    requirement that you obtain separate licenses from these patent holders
+    to use this software.
+
+THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. AND CONTRIBUTORS "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+TITLE, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL ANALOG DEVICES, INC. OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, PUNITIVE OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, DAMAGES ARISING OUT OF CLAIMS OF INTELLECTUAL
+PROPERTY RIGHTS INFRINGEMENT; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*****************************************************************************/
+#include <common/adi_ts_codec.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* ADI_DATA_TYPE_KEY values, adi_sensor_packet.h can not be included from C */
+#define TSC_KEY_BYTE    (0x00u)
+#define TSC_KEY_SHORT   (0x01u)
+#define TSC_KEY_INT     (0x02u)
+#define TSC_KEY_FLOAT   (0x04u)
+#define TSC_KEY_CHAR    (0x06u)
+
+/* No XOR window stored yet */
+#define TSC_NO_WINDOW   (0xFFu)
+
+
+/* Append the nBits low bits of nValue, most significant bit first. The block
+ * is zeroed by adi_tsc_EncoderInit() so bits are OR'ed in. Nothing is written
+ * if the bits do not fit. */
+static bool PutBits(uint8_t *pStream, ADI_TSC_STATE *pState, uint32_t nValue, uint32_t nBits)
+{
+    uint32_t nPos = pState->nBitPos;
+
+    if((nPos + nBits) > (pState->nSize * 8u)) {
+        return(false);
+    }
+
+    while(nBits != 0u) {
+        const uint32_t nFree  = 8u - (nPos & 7u);
+        const uint32_t nTake  = (nBits < nFree) ? nBits : nFree;
+        const uint32_t nChunk = (nValue >> (nBits - nTake)) & ((1u << nTake) - 1u);
+
+        pStream[nPos >> 3u] |= (uint8_t) (nChunk << (nFree - nTake));
+        nPos  += nTake;
+        nBits -= nTake;
+    }
+    pState->nBitPos = nPos;
+    return(true);
+}
+
+/* Read nBits bits, most significant bit first */
+static uint32_t GetBits(const uint8_t *pStream, ADI_TSC_STATE *pState, uint32_t nBits, bool *pError)
+{
+    uint32_t nPos   = pState->nBitPos;
+    uint32_t nValue = 0u;
+
+    if((nPos + nBits) > (pState->nSize * 8u)) {
+        *pError = true;
+        return(0u);
+    }
+
+    while(nBits != 0u) {
+        const uint32_t nFree = 8u - (nPos & 7u);
+        const uint32_t nTake = (nBits < nFree) ? nBits : nFree;
+        const uint32_t nByte = pStream[nPos >> 3u];
+
+        /* Two shifts, a single shift by 32 is undefined */
+        nValue  = (nValue << (nTake - 1u)) << 1u;
+        nValue |= (nByte >> (nFree - nTake)) & ((1u << nTake) - 1u);
+        nPos   += nTake;
+        nBits  -= nTake;
+    }
+    pState->nBitPos = nPos;
+    return(nValue);
+}
+
+/* Field value as a 32-bit pattern, integers sign extended */
+static uint32_t LoadField(const uint8_t *pSrc, const ADI_TSC_FIELD *pField)
+{
+    switch(pField->nKey) {
+    case TSC_KEY_BYTE:
+    case TSC_KEY_CHAR:
+        return((uint32_t) (int32_t) (int8_t) pSrc[0]);
+    case TSC_KEY_SHORT:
+        return((uint32_t) (int32_t) (int16_t) (pSrc[0] | (pSrc[1] << 8u)));
+    default:
+        return((uint32_t) pSrc[0] | ((uint32_t) pSrc[1] << 8u) | ((uint32_t) pSrc[2] << 16u) | ((uint32_t) pSrc[3] << 24u));
+    }
+}
+
+static void StoreField(uint8_t *pDst, const ADI_TSC_FIELD *pField, uint32_t nValue)
+{
+    uint32_t i;
+
+    for(i = 0u; i < pField->nSize; i++) {
+        pDst[i] = (uint8_t) (nValue >> (8u * i));
+    }
+}
+
+static uint32_t LeadingZeros(uint32_t nValue)
+{
+    uint32_t n = 0u;
+
+    while((nValue & 0x80000000u) == 0u) {
+        nValue <<= 1u;
+        n++;
+    }
+    return(n);
+}
+
+static uint32_t TrailingZeros(uint32_t nValue)
+{
+    uint32_t n = 0u;
+
+    while((nValue & 1u) == 0u) {
+        nValue >>= 1u;
+        n++;
+    }
+    return(n);
+}
+
+/* Check the keys and set up the field state */
+static ADI_TSC_RESULT InitState(ADI_TSC_STATE *pState, uint32_t nSize, const uint8_t *pKeys, uint32_t nNumFields)
+{
+    uint32_t i;
+
+    if((nNumFields == 0u) || (nNumFields > ADI_TSC_MAX_FIELDS) || (nSize < ADI_TSC_HEADER_SIZE(nNumFields))) {
+        return(ADI_TSC_INVALID);
+    }
+
+    memset(pState, 0, sizeof(*pState));
+    pState->nSize      = nSize - ADI_TSC_HEADER_SIZE(nNumFields);
+    pState->nNumFields = (uint8_t) nNumFields;
+
+    for(i = 0u; i < nNumFields; i++) {
+        ADI_TSC_FIELD *pField = &pState->aField[i];
+
+        switch(pKeys[i]) {
+        case TSC_KEY_BYTE:
+        case TSC_KEY_CHAR:
+            pField->nSize = 1u;
+            break;
+        case TSC_KEY_SHORT:
+            pField->nSize = 2u;
+            break;
+        case TSC_KEY_INT:
+        case TSC_KEY_FLOAT:
+            pField->nSize = 4u;
+            break;
+        default:
+            return(ADI_TSC_INVALID);
+        }
+        pField->nKey         = pKeys[i];
+        pField->nTrailing    = TSC_NO_WINDOW;
+        pState->nPayloadSize = (uint8_t) (pState->nPayloadSize + pField->nSize);
+    }
+    return(ADI_TSC_SUCCESS);
+}
+
+/*!
+ * @brief  Start a new block.
+ *
+ * @param  [out] pEncoder   : Encoder instance.
+ * @param  [in]  pBlock     : Block memory, cleared here.
+ * @param  [in]  nSize      : Block size in bytes.
+ * @param  [in]  pKeys      : ADI_DATA_TYPE_KEY of each payload field.
+ * @param  [in]  nNumFields : Number of fields, at most #ADI_TSC_MAX_FIELDS.
+ *
+ * @return ADI_TSC_INVALID for an unsupported key or a block smaller than its header.
+ */
+ADI_TSC_RESULT adi_tsc_EncoderInit(ADI_TSC_ENCODER *pEncoder, uint8_t *pBlock, uint32_t nSize,
+                                   const uint8_t *pKeys, uint32_t nNumFields)
+{
+    ADI_TSC_RESULT eResult = InitState(&pEncoder->sState, nSize, pKeys, nNumFields);
+
+    if(eResult != ADI_TSC_SUCCESS) {
+        return(eResult);
+    }
+
+    memset(pBlock, 0, nSize);
+    pBlock[2] = (uint8_t) nNumFields;
+    memcpy(&pBlock[3], pKeys, nNumFields);
+    pEncoder->pBlock = pBlock;
+    return(ADI_TSC_SUCCESS);
+}
+
+/*!
+ * @brief  Add a sample to the block.
+ *
+ * @param  [in] pEncoder   : Encoder instance.
+ * @param  [in] nTimestamp : Sample timestamp.
+ * @param  [in] pPayload   : Fields in ADI_DATA_PACKET payload layout.
+ *
+ * @return ADI_TSC_FULL if the sample does not fit. The block is left as it was
+ *         and can be sent; start a new block for the sample.
+ */
+ADI_TSC_RESULT adi_tsc_Encode(ADI_TSC_ENCODER *pEncoder, uint32_t nTimestamp, const void *pPayload)
+{
+    ADI_TSC_STATE  *pState   = &pEncoder->sState;
+    uint8_t        *pStream  = &pEncoder->pBlock[ADI_TSC_HEADER_SIZE(pState->nNumFields)];
+    const uint8_t  *pSrc     = (const uint8_t *) pPayload;
+    ADI_TSC_STATE   sSaved;
+    bool            bFit     = true;
+    uint32_t        i;
+
+    if(pState->nCount == ADI_TSC_MAX_SAMPLES) {
+        return(ADI_TSC_FULL);
+    }
+
+    sSaved = *pState;
+
+    if(pState->nCount == 0u) {
+        bFit = PutBits(pStream, pState, nTimestamp, 32u);
+        for(i = 0u; bFit && (i < pState->nNumFields); i++) {
+            ADI_TSC_FIELD *pField = &pState->aField[i];
+
+            pField->nPrev = LoadField(pSrc, pField);
+            bFit = PutBits(pStream, pState, pField->nPrev, 8u * pField->nSize);
+            pSrc += pField->nSize;
+        }
+    } else {
+        const int32_t nDelta = (int32_t) (nTimestamp - pState->nPrevTime);
+        const int32_t nDod   = (int32_t) ((uint32_t) nDelta - (uint32_t) pState->nPrevDelta);
+
+        if(nDod == 0) {
+            bFit = PutBits(pStream, pState, 0x0u, 1u);
+        } else if((nDod >= -63) && (nDod <= 64)) {
+            bFit = PutBits(pStream, pState, 0x2u, 2u) && PutBits(pStream, pState, (uint32_t) (nDod + 63), 7u);
+        } else if((nDod >= -255) && (nDod <= 256)) {
+            bFit = PutBits(pStream, pState, 0x6u, 3u) && PutBits(pStream, pState, (uint32_t) (nDod + 255), 9u);
+        } else if((nDod >= -2047) && (nDod <= 2048)) {
+            bFit = PutBits(pStream, pState, 0xEu, 4u) && PutBits(pStream, pState, (uint32_t) (nDod + 2047), 12u);
+        } else {
+            bFit = PutBits(pStream, pState, 0xFu, 4u) && PutBits(pStream, pState, (uint32_t) nDod, 32u);
+        }
+        pState->nPrevDelta = nDelta;
+
+        for(i = 0u; bFit && (i < pState->nNumFields); i++) {
+            ADI_TSC_FIELD *pField = &pState->aField[i];
+            const uint32_t nValue = LoadField(pSrc, pField);
+
+            pSrc += pField->nSize;
+
+            if(pField->nKey == TSC_KEY_FLOAT) {
+                const uint32_t nXor = nValue ^ pField->nPrev;
+
+                if(nXor == 0u) {
+                    bFit = PutBits(pStream, pState, 0x0u, 1u);
+                } else {
+                    uint32_t nLeading  = LeadingZeros(nXor);
+                    uint32_t nTrailing = TrailingZeros(nXor);
+
+                    if((pField->nTrailing != TSC_NO_WINDOW) && (nLeading >= pField->nLeading) && (nTrailing >= pField->nTrailing)) {
+                        /* Fits in the previous window, store only the bits */
+                        const uint32_t nBits = 32u - pField->nLeading - pField->nTrailing;
+                        bFit = PutBits(pStream, pState, 0x2u, 2u) && PutBits(pStream, pState, nXor >> pField->nTrailing, nBits);
+                    } else {
+                        const uint32_t nBits = 32u - nLeading - nTrailing;
+                        bFit = PutBits(pStream, pState, 0x3u, 2u) &&
+                               PutBits(pStream, pState, nLeading, 5u) &&
+                               PutBits(pStream, pState, nBits - 1u, 5u) &&
+                               PutBits(pStream, pState, nXor >> nTrailing, nBits);
+                        pField->nLeading  = (uint8_t) nLeading;
+                        pField->nTrailing = (uint8_t) nTrailing;
+                    }
+                }
+            } else {
+                const uint32_t nDiff   = nValue - pField->nPrev;
+                const uint32_t nZigzag = (nDiff << 1u) ^ (uint32_t) ((int32_t) nDiff >> 31u);
+
+                if(nZigzag == 0u) {
+                    bFit = PutBits(pStream, pState, 0x0u, 1u);
+                } else if(nZigzag < (1u << 6u)) {
+                    bFit = PutBits(pStream, pState, 0x2u, 2u) && PutBits(pStream, pState, nZigzag, 6u);
+                } else if(nZigzag < (1u << 13u)) {
+                    bFit = PutBits(pStream, pState, 0x6u, 3u) && PutBits(pStream, pState, nZigzag, 13u);
+                } else if(nZigzag < (1u << 20u)) {
+                    bFit = PutBits(pStream, pState, 0xEu, 4u) && PutBits(pStream, pState, nZigzag, 20u);
+                } else {
+                    bFit = PutBits(pStream, pState, 0xFu, 4u) && PutBits(pStream, pState, nZigzag, 32u);
+                }
+            }
+            pField->nPrev = nValue;
+        }
+    }
+
+    if(!bFit) {
+        /* Clear the bits of the partial sample and restore the state */
+        const uint32_t nFirst = sSaved.nBitPos >> 3u;
+        const uint32_t nLast  = (pState->nBitPos + 7u) >> 3u;
+
+        if(nLast > nFirst) {
+            pStream[nFirst] &= (uint8_t) (0xFF00u >> (sSaved.nBitPos & 7u));
+            if(nLast > (nFirst + 1u)) {
+                memset(&pStream[nFirst + 1u], 0, nLast - nFirst - 1u);
+            }
+        }
+        *pState = sSaved;
+        return(ADI_TSC_FULL);
+    }
+
+    pState->nPrevTime = nTimestamp;
+    pState->nCount++;
+    pEncoder->pBlock[0] = (uint8_t) (pState->nCount & 0xFFu);
+    pEncoder->pBlock[1] = (uint8_t) (pState->nCount >> 8u);
+    return(ADI_TSC_SUCCESS);
+}
+
+/*!
+ * @brief  Number of bytes of the block in use, the part to send or store.
+ */
+uint32_t adi_tsc_GetSize(const ADI_TSC_ENCODER *pEncoder)
+{
+    return(ADI_TSC_HEADER_SIZE(pEncoder->sState.nNumFields) + ((pEncoder->sState.nBitPos + 7u) >> 3u));
+}
+
+/*!
+ * @brief  Start reading a block.
+ *
+ * @param  [out] pDecoder : Decoder instance.
+ * @param  [in]  pBlock   : Block, as written by the encoder.
+ * @param  [in]  nSize    : Number of bytes available, at least adi_tsc_GetSize().
+ *
+ * @return ADI_TSC_INVALID if the header is not valid.
+ */
+ADI_TSC_RESULT adi_tsc_DecoderInit(ADI_TSC_DECODER *pDecoder, const uint8_t *pBlock, uint32_t nSize)
+{
+    ADI_TSC_RESULT eResult;
+
+    if(nSize < ADI_TSC_HEADER_SIZE(0u)) {
+        return(ADI_TSC_INVALID);
+    }
+
+    eResult = InitState(&pDecoder->sState, nSize, &pBlock[3], pBlock[2]);
+    if(eResult == ADI_TSC_SUCCESS) {
+        pDecoder->pBlock        = pBlock;
+        pDecoder->sState.nTotal = (uint16_t) (pBlock[0] | (pBlock[1] << 8u));
+    }
+    return(eResult);
+}
+
+/*!
+ * @brief  Read the next sample.
+ *
+ * @param  [in]  pDecoder   : Decoder instance.
+ * @param  [out] pTimestamp : Sample timestamp.
+ * @param  [out] pPayload   : Fields in ADI_DATA_PACKET payload layout.
+ *
+ * @return ADI_TSC_END once all samples have been read, ADI_TSC_INVALID if the
+ *         bit stream ends early.
+ */
+ADI_TSC_RESULT adi_tsc_Decode(ADI_TSC_DECODER *pDecoder, uint32_t *pTimestamp, void *pPayload)
+{
+    ADI_TSC_STATE  *pState  = &pDecoder->sState;
+    const uint8_t  *pStream = &pDecoder->pBlock[ADI_TSC_HEADER_SIZE(pState->nNumFields)];
+    uint8_t        *pDst    = (uint8_t *) pPayload;
+    bool            bError  = false;
+    uint32_t        i;
+
+    if(pState->nCount >= pState->nTotal) {
+        return(ADI_TSC_END);
+    }
+
+    if(pState->nCount == 0u) {
+        pState->nPrevTime = GetBits(pStream, pState, 32u, &bError);
+        for(i = 0u; i < pState->nNumFields; i++) {
+            ADI_TSC_FIELD *pField = &pState->aField[i];
+
+            pField->nPrev = GetBits(pStream, pState, 8u * pField->nSize, &bError);
+            StoreField(pDst, pField, pField->nPrev);
+            pDst += pField->nSize;
+        }
+    } else {
+        int32_t nDod;
+
+        if(GetBits(pStream, pState, 1u, &bError) == 0u) {
+            nDod = 0;
+        } else if(GetBits(pStream, pState, 1u, &bError) == 0u) {
+            nDod = (int32_t) GetBits(pStream, pState, 7u, &bError) - 63;
+        } else if(GetBits(pStream, pState, 1u, &bError) == 0u) {
+            nDod = (int32_t) GetBits(pStream, pState, 9u, &bError) - 255;
+        } else if(GetBits(pStream, pState, 1u, &bError) == 0u) {
+            nDod = (int32_t) GetBits(pStream, pState, 12u, &bError) - 2047;
+        } else {
+            nDod = (int32_t) GetBits(pStream, pState, 32u, &bError);
+        }
+        pState->nPrevDelta = (int32_t) ((uint32_t) pState->nPrevDelta + (uint32_t) nDod);
+        pState->nPrevTime += (uint32_t) pState->nPrevDelta;
+
+        for(i = 0u; i < pState->nNumFields; i++) {
+            ADI_TSC_FIELD *pField = &pState->aField[i];
+
+            if(pField->nKey == TSC_KEY_FLOAT) {
+                if(GetBits(pStream, pState, 1u, &bError) != 0u) {
+                    if(GetBits(pStream, pState, 1u, &bError) != 0u) {
+                        pField->nLeading  = (uint8_t) GetBits(pStream, pState, 5u, &bError);
+                        pField->nTrailing = (uint8_t) (32u - pField->nLeading - (GetBits(pStream, pState, 5u, &bError) + 1u));
+                    }
+                    if(pField->nTrailing > 31u) {
+                        return(ADI_TSC_INVALID);
+                    }
+                    pField->nPrev ^= GetBits(pStream, pState, 32u - pField->nLeading - pField->nTrailing, &bError) << pField->nTrailing;
+                }
+            } else {
+                uint32_t nZigzag;
+
+                if(GetBits(pStream, pState, 1u, &bError) == 0u) {
+                    nZigzag = 0u;
+                } else if(GetBits(pStream, pState, 1u, &bError) == 0u) {
+                    nZigzag = GetBits(pStream, pState, 6u, &bError);
+                } else if(GetBits(pStream, pState, 1u, &bError) == 0u) {
+                    nZigzag = GetBits(pStream, pState, 13u, &bError);
+                } else if(GetBits(pStream, pState, 1u, &bError) == 0u) {
+                    nZigzag = GetBits(pStream, pState, 20u, &bError);
+                } else {
+                    nZigzag = GetBits(pStream, pState, 32u, &bError);
+                }
+                pField->nPrev += (nZigzag >> 1u) ^ (0u - (nZigzag & 1u));
+            }
+            StoreField(pDst, pField, pField->nPrev);
+            pDst += pField->nSize;
+        }
+    }
+
+    if(bError) {
+        return(ADI_TSC_INVALID);
+    }
+
+    *pTimestamp = pState->nPrevTime;
+    pState->nCount++;
+    return(ADI_TSC_SUCCESS);
+}
@@ -48,18 +48,47 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include <temp/adt7420/adi_adt7420.h>
 #include <base_sensor/adi_sensor_errors.h>
+#include <base_sensor/adi_sensor_convert.h>
+#include <common/adi_i2c_bus.h>
+#include <common/adi_time.h>
 #include "adi_adt7420_cfg.h"
 
 namespace adi_sensor_swpack {
+    /*
+     * Constructor
+     */
+    ADT7420::ADT7420(const uint8_t nAddress)
+    {
+        m_slave_addr       = nAddress;
+        m_sRequest.eState  = ADI_I2C_BUS_IDLE;
+        setType(ADI_TEMPERATURE_TYPE);
+    }
+
     /*
      * Opend ADT7420 temperature sensor
      */
     SENSOR_RESULT ADT7420::open(void)
     {
+        SENSOR_RESULT eResult;
+
+        ASSERT((m_slave_addr >= ADT7420_ADDRESS_BASE) && (m_slave_addr <= ADT7420_ADDRESS_MAX));
+
         pADI_GPIO0->DS |= (1 << 4) | (1 << 5);
-        m_slave_addr = ADI_CFG_I2C_ADDR;
 
-        return(this->InitI2C());
+        m_eResolution     = ADI_CFG_ADT7420_RESOLUTION;
+        m_eMode           = ADI_CFG_ADT7420_MODE;
+        m_bStarted        = false;
+        m_bPending        = false;
+        m_nConfig         = ADI_CFG_ADT7420_FAULT_QUEUE;
+        m_bAlarm          = false;
+        m_pfAlarmCallback = NULL;
+
+        if((eResult = this->InitI2C()) == SENSOR_ERROR_NONE) {
+            /* No conversions until start */
+            eResult = WriteConfig(MODE_SHUTDOWN);
+        }
+
+        return(eResult);
     }
 
     /*
@@ -67,7 +96,13 @@ namespace adi_sensor_swpack {
      */
     SENSOR_RESULT   ADT7420::start()
     {
-        return(SENSOR_ERROR_NONE);
+        SENSOR_RESULT eResult;
+
+        if((eResult = WriteConfig(m_eMode)) == SENSOR_ERROR_NONE) {
+            m_bStarted = true;
+        }
+
+        return(eResult);
     }
 
     /*
@@ -75,7 +110,13 @@ namespace adi_sensor_swpack {
      */
     SENSOR_RESULT   ADT7420::stop()
     {
-        return(SENSOR_ERROR_NONE);
+        SENSOR_RESULT eResult;
+
+        if((eResult = WriteConfig(MODE_SHUTDOWN)) == SENSOR_ERROR_NONE) {
+            m_bStarted = false;
+        }
+
+        return(eResult);
     }
 
     /*
@@ -85,7 +126,8 @@ namespace adi_sensor_swpack {
     {
         ADI_I2C_RESULT eI2cResult;
 
-        if((eI2cResult = adi_i2c_Close(m_i2c_handle)) == ADI_I2C_SUCCESS)
+        /* The driver stays open while other sensors use the bus */
+        if((eI2cResult = adi_i2c_bus_Close()) == ADI_I2C_SUCCESS)
             return SENSOR_ERROR_NONE;
         else
             return SET_SENSOR_ERROR(SENSOR_ERROR_I2C, eI2cResult);
@@ -120,8 +162,7 @@ namespace adi_sensor_swpack {
         SENSOR_RESULT Result = this->ReadTemperature(pBuffer, 2u);
 
         if(Result == SENSOR_ERROR_NONE) {
-            uint16_t nTemp = ((pBuffer[0] << 8) | (pBuffer[1]));
-            *pTemperature = (nTemp >> 3u) / 16.0F;
+            *pTemperature = ToMilliCelsius(pBuffer) / 1000.0F;
         }
 
         return Result;
@@ -143,33 +184,101 @@ namespace adi_sensor_swpack {
         SENSOR_RESULT Result = this->ReadTemperature(pBuffer, 2u);
 
         if(Result == SENSOR_ERROR_NONE) {
-            uint16_t nTemp = ((pBuffer[0] << 8) | (pBuffer[1]));
-            float nTempCel = (nTemp >> 3u) / 16.0F;
+            float nTempCel = ToMilliCelsius(pBuffer) / 1000.0F;
             *pTemperature = (9.0F / 5.0F) * nTempCel + 32.0F;
         }
 
         return (Result);
     }
 
+    /*
+     * Sets the resolution
+     */
+    SENSOR_RESULT ADT7420::setResolution(const RESOLUTION eResolution)
+    {
+        m_eResolution = eResolution;
+
+        return(WriteConfig(m_bStarted ? m_eMode : MODE_SHUTDOWN));
+    }
+
+    /*
+     * Sets the conversion mode
+     */
+    SENSOR_RESULT ADT7420::setOperationMode(const OPERATION_MODE eMode)
+    {
+        m_eMode = eMode;
+
+        if(m_bStarted) {
+            return(WriteConfig(m_eMode));
+        }
+
+        return(SENSOR_ERROR_NONE);
+    }
+
+    /*
+     * Starts a one-shot conversion
+     */
+    SENSOR_RESULT ADT7420::startConversion()
+    {
+        if(m_bStarted && (m_eMode == MODE_ONE_SHOT) && !m_bPending) {
+            return(WriteConfig(MODE_ONE_SHOT));
+        }
+
+        return(SENSOR_ERROR_NONE);
+    }
+
+    /*
+     * Checks the RDY bit
+     */
+    SENSOR_RESULT ADT7420::isConversionReady(bool *pbReady)
+    {
+        uint8_t       nStatus;
+        SENSOR_RESULT eResult;
+
+        ASSERT(pbReady != NULL);
+
+        if((eResult = ReadRegister(REG_STATUS, &nStatus, 1u)) == SENSOR_ERROR_NONE) {
+            *pbReady = ((nStatus & ADT7420_STATUS_RDY) == 0u);
+        }
+
+        return(eResult);
+    }
+
+    /*
+     * Conversion time of the current mode
+     */
+    uint32_t ADT7420::getConversionTime()
+    {
+        if(!m_bStarted) {
+            return(0u);
+        }
+
+        switch(m_eMode) {
+            case MODE_CONTINUOUS:
+            case MODE_ONE_SHOT:
+                return(ADT7420_CONVERSION_TIME);
+
+            case MODE_1SPS:
+                return(ADT7420_1SPS_CONVERSION_TIME);
+
+            default:
+                return(0u);
+        }
+    }
+
     /**
-     * @brief  Returns the temperature value
+     * @brief  Opens the shared I2C bus
      *
      * @return SENSOR_RESULT
      *
-     * @details
+     * @details The first sensor on the bus sets the bit rate
      */
     SENSOR_RESULT ADT7420::InitI2C()
     {
         ADI_I2C_RESULT eI2cResult = ADI_I2C_SUCCESS;
 
-        eI2cResult = adi_i2c_Open(m_slave_addr, &m_I2C_memory, ADI_I2C_MEMORY_SIZE, &m_i2c_handle);
-
-        if(eI2cResult == ADI_I2C_SUCCESS) {
-            if((eI2cResult = adi_i2c_Reset(m_i2c_handle)) == ADI_I2C_SUCCESS) {
-                if((eI2cResult = adi_i2c_SetBitRate(m_i2c_handle, ADI_CFG_I2C_BIT_RATE))  == ADI_I2C_SUCCESS) {
-                    return (SENSOR_ERROR_NONE);
-                }
-            }
+        if((eI2cResult = adi_i2c_bus_Open(ADI_CFG_I2C_BIT_RATE)) == ADI_I2C_SUCCESS) {
+            return (SENSOR_ERROR_NONE);
         }
 
         return (SET_SENSOR_ERROR(SENSOR_ERROR_I2C, eI2cResult));
@@ -186,36 +295,420 @@ namespace adi_sensor_swpack {
      * @details
      */
     SENSOR_RESULT ADT7420::ReadTemperature(uint8_t *pTemperature, const uint32_t sizeInBytes)
+    {
+        SENSOR_RESULT eResult;
+
+        ASSERT(sizeInBytes >= 2u);
+        ASSERT(pTemperature != NULL);
+
+        if(m_bStarted && (m_eMode == MODE_ONE_SHOT)) {
+            /* Convert now unless startConversion() already did */
+            if((eResult = startConversion()) != SENSOR_ERROR_NONE) {
+                return(eResult);
+            }
+            if((eResult = WaitReady(ADT7420_READY_TIMEOUT)) != SENSOR_ERROR_NONE) {
+                return(eResult);
+            }
+            m_bPending = false;
+        }
+
+        /* Read temperature registers, the first temperature register is at address 0 */
+        return(ReadRegister(REG_TEMP_MSB, pTemperature, 2u));
+    }
+
+    /**
+     * @brief  Reads consecutive registers
+     */
+    SENSOR_RESULT ADT7420::ReadRegister(const uint8_t nReg, uint8_t *pData, const uint32_t sizeInBytes)
     {
         ADI_I2C_TRANSACTION sTransfer;
         ADI_I2C_RESULT      eI2cResult = ADI_I2C_SUCCESS;
         uint32_t            nHwErrors;
-        uint8_t             aPrologueData[5u];
+        uint8_t             aPrologueData[1u];
 
-        ASSERT(sizeInBytes >= 2u);
-        ASSERT(pTemperature != NULL);
+        aPrologueData[0]          = nReg;
+        sTransfer.pPrologue       = &aPrologueData[0u];
+        sTransfer.nPrologueSize   = 1u;
+        sTransfer.pData           = pData;
+        sTransfer.nDataSize       = sizeInBytes;
+        sTransfer.bReadNotWrite   = true;
+        sTransfer.bRepeatStart    = true;
+
+        /* The bus only reprograms the slave address when another sensor was accessed last */
+        eI2cResult = adi_i2c_bus_ReadWrite(m_slave_addr, &sTransfer, &nHwErrors);
 
-        /* Set slave address for ADI ADT7420 */
-        eI2cResult = adi_i2c_SetSlaveAddress(m_i2c_handle, 0x48);
+        if(eI2cResult == ADI_I2C_SUCCESS) {
+            return(SENSOR_ERROR_NONE);
+        }
+
+        return (SET_SENSOR_ERROR(SENSOR_ERROR_I2C, eI2cResult));
+    }
+
+    /**
+     * @brief  Writes consecutive registers
+     */
+    SENSOR_RESULT ADT7420::WriteRegister(const uint8_t nReg, const uint8_t *pData, const uint32_t sizeInBytes)
+    {
+        ADI_I2C_TRANSACTION sTransfer;
+        ADI_I2C_RESULT      eI2cResult = ADI_I2C_SUCCESS;
+        uint32_t            nHwErrors;
+        uint8_t             aPrologueData[1u];
+
+        aPrologueData[0]          = nReg;
+        sTransfer.pPrologue       = &aPrologueData[0u];
+        sTransfer.nPrologueSize   = 1u;
+        sTransfer.pData           = (uint8_t*) pData;
+        sTransfer.nDataSize       = sizeInBytes;
+        sTransfer.bReadNotWrite   = false;
+        sTransfer.bRepeatStart    = false;
+
+        eI2cResult = adi_i2c_bus_ReadWrite(m_slave_addr, &sTransfer, &nHwErrors);
 
         if(eI2cResult == ADI_I2C_SUCCESS) {
-            /* Read temperature registers, the first temperature register is at address 0 */
-            aPrologueData[0]           = 0u;
-            sTransfer.pPrologue       = &aPrologueData[0u];
-            sTransfer.nPrologueSize   = 1u;
-            sTransfer.pData           = pTemperature;
-            sTransfer.nDataSize       = 2u;
-            sTransfer.bReadNotWrite   = true;
-            sTransfer.bRepeatStart    = true;
-
-            eI2cResult = adi_i2c_ReadWrite(m_i2c_handle, &sTransfer, &nHwErrors);
-
-            if(eI2cResult == ADI_I2C_SUCCESS) {
+            return(SENSOR_ERROR_NONE);
+        }
+
+        return (SET_SENSOR_ERROR(SENSOR_ERROR_I2C, eI2cResult));
+    }
+
+    /**
+     * @brief  Writes the resolution and the given mode to the configuration register
+     *
+     * @details Writing the one-shot mode starts a conversion, the part shuts down
+     *          again when it is done. A result left from an earlier mode is read
+     *          first so RDY does not report it.
+     */
+    SENSOR_RESULT ADT7420::WriteConfig(const OPERATION_MODE eMode)
+    {
+        SENSOR_RESULT eResult;
+        uint8_t       nConfig;
+        uint8_t       aStale[2];
+
+        if(eMode == MODE_ONE_SHOT) {
+            /* Reading the temperature sets RDY, so it only goes low for the new conversion */
+            if((eResult = ReadRegister(REG_TEMP_MSB, aStale, 2u)) != SENSOR_ERROR_NONE) {
+                return(eResult);
+            }
+        }
+
+        nConfig = (uint8_t)((m_nConfig & ~((1u << ADT7420_CONFIG_RESOLUTION_BITPOS) | ADT7420_CONFIG_MODE_MASK)) |
+                            ((uint32_t) m_eResolution << ADT7420_CONFIG_RESOLUTION_BITPOS) |
+                            ((uint32_t) eMode << ADT7420_CONFIG_MODE_BITPOS));
+
+        if((eResult = WriteRegister(REG_CONFIG, &nConfig, 1u)) == SENSOR_ERROR_NONE) {
+            m_bPending = (eMode == MODE_ONE_SHOT);
+            if(m_bPending) {
+                m_nConversionEnd = adi_time_Deadline(ADT7420_CONVERSION_TIME * 1000u);
+                m_nReadyDeadline = adi_time_Deadline(ADT7420_READY_TIMEOUT * 1000u);
+            }
+        }
+
+        return(eResult);
+    }
+
+    /**
+     * @brief  Polls RDY, which goes low when a result is written to the temperature registers
+     */
+    SENSOR_RESULT ADT7420::WaitReady(const uint32_t nTimeoutMs)
+    {
+        SENSOR_RESULT eResult;
+        bool          bReady    = false;
+        uint32_t      nDeadline = adi_time_Deadline(nTimeoutMs * 1000u);
+
+        for(;;) {
+            if((eResult = isConversionReady(&bReady)) != SENSOR_ERROR_NONE) {
+                return(eResult);
+            }
+            if(bReady) {
                 return(SENSOR_ERROR_NONE);
             }
+            if(adi_time_IsExpired(nDeadline)) {
+                return(SET_SENSOR_ERROR(SENSOR_ERROR_TEMP, ERROR_CODE_RDY_TIMEOUT));
+            }
+            adi_time_Sleep();
         }
+    }
 
-        return (SET_SENSOR_ERROR(SENSOR_ERROR_I2C, eI2cResult));
+    /**
+     * @brief  Converts the temperature registers, MSB first, at the current resolution
+     */
+    int32_t ADT7420::ToMilliCelsius(const uint8_t *pBuffer)
+    {
+        uint16_t nTemp = (uint16_t)((pBuffer[0] << 8) | (pBuffer[1]));
+        int32_t  nMilliCelsius;
+
+        if(m_eResolution == RESOLUTION_16BIT) {
+            Adt7420Convert<16u>::toMilliCelsius(&nTemp, &nMilliCelsius, 1u);
+        }
+        else {
+            Adt7420Convert<13u>::toMilliCelsius(&nTemp, &nMilliCelsius, 1u);
+        }
+
+        return(nMilliCelsius);
+    }
+
+    /*
+     * Reads several sensors, one-shot conversions overlapped
+     */
+    SENSOR_RESULT ADT7420::readTemperatures(ADT7420 *const *ppSensors, const uint32_t nSensors,
+                                            int32_t *pMilliCelsius)
+    {
+        SENSOR_RESULT eResult;
+        uint8_t       aBuffer[2];
+        uint32_t      nSensor;
+
+        ASSERT(ppSensors != NULL);
+        ASSERT(pMilliCelsius != NULL);
+
+        for(nSensor = 0u; nSensor < nSensors; nSensor++) {
+            if((eResult = ppSensors[nSensor]->startConversion()) != SENSOR_ERROR_NONE) {
+                return(eResult);
+            }
+        }
+
+        for(nSensor = 0u; nSensor < nSensors; nSensor++) {
+            if((eResult = ppSensors[nSensor]->ReadTemperature(aBuffer, 2u)) != SENSOR_ERROR_NONE) {
+                return(eResult);
+            }
+            pMilliCelsius[nSensor] = ppSensors[nSensor]->ToMilliCelsius(aBuffer);
+        }
+
+        return(SENSOR_ERROR_NONE);
+    }
+
+    /*
+     * Queues a read of the temperature registers
+     */
+    SENSOR_RESULT ADT7420::readTemperatureAsync(ADI_CALLBACK const pfCallback, void *const pCBParam)
+    {
+        SENSOR_RESULT eResult;
+
+        if(isReadPending()) {
+            return(SET_SENSOR_ERROR(SENSOR_ERROR_TEMP, ERROR_CODE_READ_BUSY));
+        }
+
+        m_pfReadCallback = pfCallback;
+        m_pReadCBParam   = pCBParam;
+
+        /* A one-shot conversion still running is waited for on the bus, by polling RDY */
+        if(m_bPending && !adi_time_IsExpired(m_nConversionEnd)) {
+            return(SubmitRead(REG_STATUS, 1u));
+        }
+
+        if((eResult = SubmitRead(REG_TEMP_MSB, 2u)) == SENSOR_ERROR_NONE) {
+            m_bPending = false;
+        }
+
+        return(eResult);
+    }
+
+    /**
+     * @brief  Queues a read of nSize registers from nReg for ReadCallback
+     */
+    SENSOR_RESULT ADT7420::SubmitRead(const uint8_t nReg, const uint16_t nSize)
+    {
+        ADI_I2C_RESULT eI2cResult;
+
+        m_nRequestReg = nReg;
+
+        m_sRequest.nAddress                   = m_slave_addr;
+        m_sRequest.sTransaction.pPrologue     = &m_nRequestReg;
+        m_sRequest.sTransaction.nPrologueSize = 1u;
+        m_sRequest.sTransaction.pData         = m_aRequestData;
+        m_sRequest.sTransaction.nDataSize     = nSize;
+        m_sRequest.sTransaction.bReadNotWrite = true;
+        m_sRequest.sTransaction.bRepeatStart  = true;
+        m_sRequest.pfCallback                 = ReadCallback;
+        m_sRequest.pCBParam                   = this;
+
+        if((eI2cResult = adi_i2c_bus_Submit(&m_sRequest)) != ADI_I2C_SUCCESS) {
+            return(SET_SENSOR_ERROR(SENSOR_ERROR_I2C, eI2cResult));
+        }
+
+        return(SENSOR_ERROR_NONE);
+    }
+
+    /**
+     * @brief  Converts the registers read and hands them to the application
+     */
+    void ADT7420::ReadCallback(ADI_I2C_BUS_REQUEST *pRequest)
+    {
+        ADT7420      *pSensor = (ADT7420*) pRequest->pCBParam;
+        SENSOR_RESULT eResult = SENSOR_ERROR_NONE;
+
+        if(pRequest->eResult != ADI_I2C_SUCCESS) {
+            eResult = SET_SENSOR_ERROR(SENSOR_ERROR_I2C, pRequest->eResult);
+        }
+        else if(pSensor->m_nRequestReg == REG_STATUS) {
+            /* RDY goes low when the conversion is written, then the result is read */
+            if((pSensor->m_aRequestData[0] & ADT7420_STATUS_RDY) == 0u) {
+                if((eResult = pSensor->SubmitRead(REG_TEMP_MSB, 2u)) == SENSOR_ERROR_NONE) {
+                    pSensor->m_bPending = false;
+                    return;
+                }
+            }
+            else if(!adi_time_IsExpired(pSensor->m_nReadyDeadline)) {
+                if((eResult = pSensor->SubmitRead(REG_STATUS, 1u)) == SENSOR_ERROR_NONE) {
+                    return;
+                }
+            }
+            else {
+                eResult = SET_SENSOR_ERROR(SENSOR_ERROR_TEMP, ERROR_CODE_RDY_TIMEOUT);
+            }
+        }
+        else {
+            pSensor->m_nRequestMilliCelsius = pSensor->ToMilliCelsius(pSensor->m_aRequestData);
+        }
+
+        if(pSensor->m_pfReadCallback != NULL) {
+            pSensor->m_pfReadCallback(pSensor->m_pReadCBParam, (uint32_t) eResult, &pSensor->m_nRequestMilliCelsius);
+        }
+    }
+
+    /*
+     * Programs T_LOW, T_HIGH, T_CRIT and T_HYST
+     */
+    SENSOR_RESULT ADT7420::setAlarmLimits(const int32_t nLow, const int32_t nHigh, const int32_t nCritical,
+                                          const uint32_t nHysteresis)
+    {
+        SENSOR_RESULT eResult;
+        uint8_t       nHyst = (uint8_t) nHysteresis;
+
+        ASSERT(nLow < nHigh);
+        ASSERT(nHigh <= nCritical);
+        ASSERT(nHysteresis <= ADT7420_HYSTERESIS_MAX);
+
+        if((eResult = WriteLimit(REG_T_LOW, nLow)) == SENSOR_ERROR_NONE) {
+            if((eResult = WriteLimit(REG_T_HIGH, nHigh)) == SENSOR_ERROR_NONE) {
+                if((eResult = WriteLimit(REG_T_CRIT, nCritical)) == SENSOR_ERROR_NONE) {
+                    eResult = WriteRegister(REG_T_HYST, &nHyst, 1u);
+                }
+            }
+        }
+
+        return(eResult);
+    }
+
+    /*
+     * Hooks the INT pin to a GPIO group interrupt
+     */
+    SENSOR_RESULT ADT7420::enableAlarm(ADI_CALLBACK const pfCallback, void *const pCBParam)
+    {
+        ADI_GPIO_RESULT eGpioResult;
+        SENSOR_RESULT   eResult;
+        uint8_t         nStatus;
+
+        m_pfAlarmCallback = pfCallback;
+        m_pAlarmCBParam   = pCBParam;
+        m_bAlarm          = false;
+
+        eGpioResult = adi_gpio_Init(m_gpio_memory, ADI_GPIO_MEMORY_SIZE);
+
+        if(eGpioResult == ADI_GPIO_SUCCESS) {
+            if((eGpioResult = adi_gpio_InputEnable(ADI_CFG_ADT7420_INT_PORT, ADI_CFG_ADT7420_INT_PIN, true)) == ADI_GPIO_SUCCESS) {
+                if((eGpioResult = adi_gpio_RegisterCallback(ADI_CFG_ADT7420_INT_IRQ, AlarmCallback, this)) == ADI_GPIO_SUCCESS) {
+                    /* INT is active low */
+                    eGpioResult = adi_gpio_SetGroupInterruptPolarity(ADI_CFG_ADT7420_INT_PORT, ADI_CFG_ADT7420_INT_PIN);
+                }
+            }
+        }
+
+        if(eGpioResult != ADI_GPIO_SUCCESS) {
+            return(SET_SENSOR_ERROR(SENSOR_ERROR_GPIO, eGpioResult));
+        }
+
+        /* Interrupt mode, INT and CT active low, the fault queue from the configuration */
+        m_nConfig = ADI_CFG_ADT7420_FAULT_QUEUE & ADT7420_CONFIG_FAULT_QUEUE_MASK;
+
+        if((eResult = WriteConfig(m_bStarted ? m_eMode : MODE_SHUTDOWN)) == SENSOR_ERROR_NONE) {
+            /* Release INT in case a limit was crossed before */
+            if((eResult = ReadRegister(REG_STATUS, &nStatus, 1u)) == SENSOR_ERROR_NONE) {
+                eGpioResult = adi_gpio_SetGroupInterruptPins(ADI_CFG_ADT7420_INT_PORT, ADI_CFG_ADT7420_INT_IRQ, ADI_CFG_ADT7420_INT_PIN);
+
+                if(eGpioResult != ADI_GPIO_SUCCESS) {
+                    eResult = SET_SENSOR_ERROR(SENSOR_ERROR_GPIO, eGpioResult);
+                }
+            }
+        }
+
+        return(eResult);
+    }
+
+    /*
+     * Unhooks the INT pin
+     */
+    SENSOR_RESULT ADT7420::disableAlarm()
+    {
+        ADI_GPIO_RESULT eGpioResult;
+
+        eGpioResult = adi_gpio_SetGroupInterruptPins(ADI_CFG_ADT7420_INT_PORT, ADI_CFG_ADT7420_INT_IRQ, 0u);
+
+        m_pfAlarmCallback = NULL;
+        m_bAlarm          = false;
+
+        if(eGpioResult != ADI_GPIO_SUCCESS) {
+            return(SET_SENSOR_ERROR(SENSOR_ERROR_GPIO, eGpioResult));
+        }
+
+        return(SENSOR_ERROR_NONE);
+    }
+
+    /*
+     * Reads the limit flags of the status register
+     */
+    SENSOR_RESULT ADT7420::getAlarmStatus(uint8_t *pStatus)
+    {
+        SENSOR_RESULT eResult;
+        uint8_t       nStatus;
+
+        ASSERT(pStatus != NULL);
+
+        /* Clear first, an interrupt during the read is kept */
+        m_bAlarm = false;
+
+        if((eResult = ReadRegister(REG_STATUS, &nStatus, 1u)) == SENSOR_ERROR_NONE) {
+            *pStatus = nStatus & ADT7420_STATUS_ALARM_MASK;
+        }
+
+        return(eResult);
+    }
+
+    /**
+     * @brief  Writes a limit as 1/128 degree C, MSB first
+     */
+    SENSOR_RESULT ADT7420::WriteLimit(const uint8_t nReg, const int32_t nMilliCelsius)
+    {
+        int32_t nCode;
+        uint8_t aData[2];
+
+        /* 128 / 1000 = 16 / 125, rounded to the nearest code */
+        nCode = (nMilliCelsius * 16 + ((nMilliCelsius < 0) ? -62 : 62)) / 125;
+
+        if(nCode > 32767) {
+            nCode = 32767;
+        }
+        else if(nCode < -32768) {
+            nCode = -32768;
+        }
+
+        aData[0] = (uint8_t)((uint32_t) nCode >> 8u);
+        aData[1] = (uint8_t) nCode;
+
+        return(WriteRegister(nReg, aData, 2u));
+    }
+
+    /**
+     * @brief  INT pin interrupt
+     */
+    void ADT7420::AlarmCallback(void *pCBParam, uint32_t Event, void *pArg)
+    {
+        ADT7420 *pSensor = (ADT7420*) pCBParam;
+
+        pSensor->m_bAlarm = true;
+
+        if(pSensor->m_pfAlarmCallback != NULL) {
+            pSensor->m_pfAlarmCallback(pSensor->m_pAlarmCBParam, Event, pArg);
+        }
     }
 
 } /* namespace */
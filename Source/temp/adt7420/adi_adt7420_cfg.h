@@ -56,12 +56,52 @@ POSSIBILITY OF SUCH DAMAGE.
 #ifndef ADI_ADT7420_CFG_H
 #define ADI_ADT7420_CFG_H
 
-/*! I2C address */
-#define ADI_CFG_I2C_ADDR      (0u)
+#include <drivers/gpio/adi_gpio.h>
 
 /*! I2C bit rate */
 #define ADI_CFG_I2C_BIT_RATE  (400000u)
 
+/*!
+ * @brief  Temperature resolution after open, see ADT7420::setResolution().
+ *
+ * @details ADT7420::RESOLUTION_13BIT or ADT7420::RESOLUTION_16BIT.
+ */
+#define ADI_CFG_ADT7420_RESOLUTION  (ADT7420::RESOLUTION_13BIT)
+
+/*!
+ * @brief  Conversion mode after start, see ADT7420::setOperationMode().
+ *
+ * @details MODE_CONTINUOUS draws the conversion current all the time. For sample
+ *          periods of seconds or more MODE_ONE_SHOT keeps the part shut down
+ *          between readings, each reading then takes up to 240 ms.
+ */
+#define ADI_CFG_ADT7420_MODE        (ADT7420::MODE_CONTINUOUS)
+
+/*!
+ * @brief  GPIO port and pin wired to the ADT7420 INT output, see ADT7420::enableAlarm().
+ *
+ * @details INT is open drain and active low, the shield pulls it up. It
+ *          interrupts on the falling edge.
+ */
+#define ADI_CFG_ADT7420_INT_PORT    (ADI_GPIO_PORT1)
+#define ADI_CFG_ADT7420_INT_PIN     (ADI_GPIO_PIN_0)
+
+/*! GPIO group interrupt used for the INT pin */
+#define ADI_CFG_ADT7420_INT_IRQ     (ADI_GPIO_INTA_IRQ)
+
+/*!
+ * @brief  Consecutive out of limit conversions before an alarm.
+ *
+ * @details 0u : 1, 1u : 2, 2u : 3, 3u : 4 conversions.
+ */
+#define ADI_CFG_ADT7420_FAULT_QUEUE (0u)
+
+/****************** Macro Validation ******************/
+
+#if (ADI_CFG_ADT7420_FAULT_QUEUE > 3u)
+#error "Invalid fault queue configuration"
+#endif
+
 #endif /* ADI_ADT7420_CFG_H */
 
 
@@ -192,7 +192,8 @@ namespace adi_sensor_swpack {
 
     SENSOR_RESULT CN0397::convertToVoltage(uint16_t adcValue, float * voltage)
     {
-        *voltage = (float)(adcValue * AD7798_REFERENCE_VOLTAGE) / (float)(AD7798_2_TO_THE_RES * m_ad778.getGain());
+        /* GAIN_n holds log2(n) */
+        *voltage = (float)(adcValue * AD7798_REFERENCE_VOLTAGE) / (float)(AD7798_2_TO_THE_RES * (1u << m_ad778.getGain()));
 
         return(SENSOR_ERROR_NONE);
     }